@@ -0,0 +1,238 @@
+/*
+ * Copyright 2026 Aaron Barany
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "MeshGenerator.h"
+#include <VFC/Compression.h>
+#include <VFC/Converter.h>
+#include <benchmark/benchmark.h>
+#include <memory>
+#include <string>
+
+#if VFC_HAS_ZSTD
+#include <zstd.h>
+#endif
+
+namespace
+{
+
+const char* shapeNames[] = {"Grid", "Sphere", "Noise"};
+const std::uint64_t meshIndexCount = 1000000;
+
+enum class BufferType
+{
+	Vertices,
+	Indices
+};
+
+// Converted output for a generated mesh, which is what the tool would compress.
+struct ConvertedMesh
+{
+	vfc::MeshShape shape;
+	std::uint32_t vertexStride;
+	std::uint32_t vertexCount;
+	std::vector<std::uint8_t> vertices;
+	std::vector<std::uint32_t> indices;
+};
+
+const ConvertedMesh* getMesh(vfc::MeshShape shape)
+{
+	static std::unique_ptr<ConvertedMesh> convertedMesh;
+	if (convertedMesh && convertedMesh->shape == shape)
+		return convertedMesh.get();
+
+	convertedMesh.reset();
+	vfc::MeshOptions options;
+	options.shape = shape;
+	options.primitiveType = vfc::PrimitiveType::TriangleList;
+	options.indexCount = meshIndexCount;
+
+	vfc::GeneratedMesh mesh;
+	std::string error;
+	if (!vfc::generateMesh(mesh, options, error))
+		return nullptr;
+
+	vfc::VertexFormat vertexFormat;
+	vertexFormat.appendElement("position", vfc::ElementLayout::X32Y32Z32, vfc::ElementType::Float);
+	vertexFormat.appendElement("normal", vfc::ElementLayout::W2X10Y10Z10,
+		vfc::ElementType::SNorm);
+	vertexFormat.appendElement("texCoord", vfc::ElementLayout::X16Y16, vfc::ElementType::UNorm);
+
+	vfc::Converter converter(vertexFormat, vfc::IndexType::UInt32, mesh.primitiveType);
+	if (!vfc::addVertexStreams(converter, mesh) || !converter.convert() ||
+		converter.getIndices().size() != 1)
+	{
+		return nullptr;
+	}
+
+	convertedMesh.reset(new ConvertedMesh);
+	convertedMesh->shape = shape;
+	convertedMesh->vertexStride = static_cast<std::uint32_t>(vertexFormat.stride());
+	convertedMesh->vertexCount = converter.getVertexCount();
+	convertedMesh->vertices = converter.getVertices()[0];
+
+	const vfc::IndexData& indexData = converter.getIndices()[0];
+	auto indices = reinterpret_cast<const std::uint32_t*>(indexData.data);
+	convertedMesh->indices.assign(indices, indices + indexData.count);
+	return convertedMesh.get();
+}
+
+const void* getData(const ConvertedMesh& mesh, BufferType type, std::size_t& outSize)
+{
+	if (type == BufferType::Vertices)
+	{
+		outSize = mesh.vertices.size();
+		return mesh.vertices.data();
+	}
+
+	outSize = mesh.indices.size()*sizeof(std::uint32_t);
+	return mesh.indices.data();
+}
+
+bool compress(std::vector<std::uint8_t>& outData, const ConvertedMesh& mesh, BufferType type)
+{
+	if (type == BufferType::Vertices)
+	{
+		return vfc::compressVertices(outData, mesh.vertices.data(), mesh.vertexCount,
+			mesh.vertexStride);
+	}
+
+	return vfc::compressIndices(outData, mesh.indices.data(),
+		static_cast<std::uint32_t>(mesh.indices.size()), vfc::IndexType::UInt32);
+}
+
+void setResults(benchmark::State& state, const ConvertedMesh& mesh, BufferType type,
+	std::size_t size, std::size_t compressedSize)
+{
+	std::string label = shapeNames[static_cast<int>(mesh.shape)];
+	label += type == BufferType::Vertices ? " vertices" : " indices";
+	state.SetLabel(label);
+	state.SetBytesProcessed(state.iterations()*size);
+	state.counters["ratio"] = static_cast<double>(size)/static_cast<double>(compressedSize);
+}
+
+void BM_Compress(benchmark::State& state)
+{
+	const ConvertedMesh* mesh = getMesh(static_cast<vfc::MeshShape>(state.range(0)));
+	if (!mesh)
+	{
+		state.SkipWithError("Couldn't generate mesh.");
+		return;
+	}
+
+	auto type = static_cast<BufferType>(state.range(1));
+	std::vector<std::uint8_t> compressed;
+	for (auto _ : state)
+	{
+		if (!compress(compressed, *mesh, type))
+		{
+			state.SkipWithError("Compression failed.");
+			return;
+		}
+		benchmark::DoNotOptimize(compressed.data());
+	}
+
+	std::size_t size;
+	getData(*mesh, type, size);
+	setResults(state, *mesh, type, size, compressed.size());
+}
+
+void BM_Decompress(benchmark::State& state)
+{
+	const ConvertedMesh* mesh = getMesh(static_cast<vfc::MeshShape>(state.range(0)));
+	auto type = static_cast<BufferType>(state.range(1));
+	std::vector<std::uint8_t> compressed;
+	if (!mesh || !compress(compressed, *mesh, type))
+	{
+		state.SkipWithError("Couldn't compress mesh.");
+		return;
+	}
+
+	std::size_t size;
+	getData(*mesh, type, size);
+	std::vector<std::uint8_t> decompressed(size);
+	for (auto _ : state)
+	{
+		if (!vfc::decompress(decompressed.data(), size, compressed.data(), compressed.size()))
+		{
+			state.SkipWithError("Decompression failed.");
+			return;
+		}
+		benchmark::DoNotOptimize(decompressed.data());
+	}
+
+	setResults(state, *mesh, type, size, compressed.size());
+}
+
+#if VFC_HAS_ZSTD
+
+// Plain zstd at the default level on the same buffers as a baseline.
+void BM_ZstdDecompress(benchmark::State& state)
+{
+	const ConvertedMesh* mesh = getMesh(static_cast<vfc::MeshShape>(state.range(0)));
+	if (!mesh)
+	{
+		state.SkipWithError("Couldn't generate mesh.");
+		return;
+	}
+
+	auto type = static_cast<BufferType>(state.range(1));
+	std::size_t size;
+	const void* data = getData(*mesh, type, size);
+	std::vector<std::uint8_t> compressed(ZSTD_compressBound(size));
+	std::size_t compressedSize = ZSTD_compress(compressed.data(), compressed.size(), data, size,
+		ZSTD_CLEVEL_DEFAULT);
+	if (ZSTD_isError(compressedSize))
+	{
+		state.SkipWithError("Compression failed.");
+		return;
+	}
+
+	std::vector<std::uint8_t> decompressed(size);
+	for (auto _ : state)
+	{
+		std::size_t result = ZSTD_decompress(decompressed.data(), size, compressed.data(),
+			compressedSize);
+		if (result != size)
+		{
+			state.SkipWithError("Decompression failed.");
+			return;
+		}
+		benchmark::DoNotOptimize(decompressed.data());
+	}
+
+	setResults(state, *mesh, type, size, compressedSize);
+}
+
+#endif
+
+void setCompressionArgs(benchmark::internal::Benchmark* benchmark)
+{
+	benchmark->ArgNames({"shape", "type"});
+	for (vfc::MeshShape shape : {vfc::MeshShape::Grid, vfc::MeshShape::Sphere,
+			vfc::MeshShape::Noise})
+	{
+		for (BufferType type : {BufferType::Vertices, BufferType::Indices})
+			benchmark->Args({static_cast<std::int64_t>(shape), static_cast<std::int64_t>(type)});
+	}
+}
+
+} // namespace
+
+BENCHMARK(BM_Compress)->Apply(setCompressionArgs)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_Decompress)->Apply(setCompressionArgs)->Unit(benchmark::kMillisecond);
+#if VFC_HAS_ZSTD
+BENCHMARK(BM_ZstdDecompress)->Apply(setCompressionArgs)->Unit(benchmark::kMillisecond);
+#endif
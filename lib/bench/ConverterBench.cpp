@@ -0,0 +1,152 @@
+/*
+ * Copyright 2026 Aaron Barany
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "MeshGenerator.h"
+#include <VFC/Converter.h>
+#include <benchmark/benchmark.h>
+#include <string>
+
+namespace
+{
+
+// Only keep a single mesh to avoid holding onto the memory for the largest meshes.
+const vfc::GeneratedMesh* getMesh(vfc::PrimitiveType primitiveType, std::uint64_t indexCount,
+	double duplicateRatio)
+{
+	static vfc::MeshOptions meshOptions;
+	static vfc::GeneratedMesh mesh;
+	if (mesh.indexCount > 0 && meshOptions.primitiveType == primitiveType &&
+		meshOptions.indexCount == indexCount && meshOptions.duplicateRatio == duplicateRatio)
+	{
+		return &mesh;
+	}
+
+	meshOptions.primitiveType = primitiveType;
+	meshOptions.indexCount = indexCount;
+	meshOptions.duplicateRatio = duplicateRatio;
+
+	std::string error;
+	if (!vfc::generateMesh(mesh, meshOptions, error))
+	{
+		mesh = vfc::GeneratedMesh();
+		return nullptr;
+	}
+
+	return &mesh;
+}
+
+void BM_Convert(benchmark::State& state)
+{
+	auto indexCount = static_cast<std::uint64_t>(state.range(0));
+	auto primitiveType = static_cast<vfc::PrimitiveType>(state.range(1));
+	auto indexType = static_cast<vfc::IndexType>(state.range(2));
+	double duplicateRatio = static_cast<double>(state.range(3))/100.0;
+	const vfc::GeneratedMesh* mesh = getMesh(primitiveType, indexCount, duplicateRatio);
+	if (!mesh)
+	{
+		state.SkipWithError("Couldn't generate mesh.");
+		return;
+	}
+
+	vfc::VertexFormat vertexFormat;
+	vertexFormat.appendElement("position", vfc::ElementLayout::X32Y32Z32, vfc::ElementType::Float);
+	vertexFormat.appendElement("normal", vfc::ElementLayout::W2X10Y10Z10,
+		vfc::ElementType::SNorm);
+	vertexFormat.appendElement("texCoord", vfc::ElementLayout::X16Y16, vfc::ElementType::UNorm);
+
+	std::size_t vertexCount = 0;
+	for (auto _ : state)
+	{
+		vfc::Converter converter(vertexFormat, indexType, primitiveType);
+		if (!vfc::addVertexStreams(converter, *mesh) || !converter.convert())
+		{
+			state.SkipWithError("Conversion failed.");
+			return;
+		}
+
+		vertexCount = converter.getVertexCount();
+		benchmark::DoNotOptimize(converter.getVertices().data());
+	}
+
+	std::string label = vfc::primitiveTypeName(primitiveType);
+	label += indexType == vfc::IndexType::UInt16 ? " UInt16" :
+		indexType == vfc::IndexType::UInt32 ? " UInt32" : " NoIndices";
+	state.SetLabel(label);
+
+	// Each index is a vertex read from the input.
+	std::size_t inputStride = mesh->streams[0].vertexFormat.stride();
+	state.SetItemsProcessed(state.iterations()*mesh->indexCount);
+	state.SetBytesProcessed(state.iterations()*mesh->indexCount*inputStride);
+	state.counters["outputVertices"] = static_cast<double>(vertexCount);
+}
+
+const std::int64_t indexCounts[] = {1000, 10000, 100000, 1000000, 10000000};
+
+void setIndexCountArgs(benchmark::internal::Benchmark* benchmark)
+{
+	benchmark->ArgNames({"indices", "primitive", "indexType", "dup%"});
+	const auto triangleList = static_cast<std::int64_t>(vfc::PrimitiveType::TriangleList);
+	const auto uint16 = static_cast<std::int64_t>(vfc::IndexType::UInt16);
+	const auto uint32 = static_cast<std::int64_t>(vfc::IndexType::UInt32);
+	for (std::int64_t indexCount : indexCounts)
+	{
+		benchmark->Args({indexCount, triangleList, uint16, 0});
+		benchmark->Args({indexCount, triangleList, uint32, 0});
+		benchmark->Args({indexCount, triangleList, uint32, 100});
+	}
+}
+
+void setPrimitiveArgs(benchmark::internal::Benchmark* benchmark)
+{
+	benchmark->ArgNames({"indices", "primitive", "indexType", "dup%"});
+	const vfc::PrimitiveType primitiveTypes[] =
+	{
+		vfc::PrimitiveType::PointList,
+		vfc::PrimitiveType::LineList,
+		vfc::PrimitiveType::TriangleList,
+		vfc::PrimitiveType::TriangleStrip
+	};
+	const vfc::IndexType indexTypes[] =
+	{
+		vfc::IndexType::NoIndices,
+		vfc::IndexType::UInt16,
+		vfc::IndexType::UInt32
+	};
+	for (vfc::PrimitiveType primitiveType : primitiveTypes)
+	{
+		for (vfc::IndexType indexType : indexTypes)
+		{
+			// Generated strips restart at the end of each row, which requires indices for the
+			// output.
+			if (primitiveType == vfc::PrimitiveType::TriangleStrip &&
+				indexType == vfc::IndexType::NoIndices)
+			{
+				continue;
+			}
+
+			for (std::int64_t duplicates : {0, 100})
+			{
+				benchmark->Args({1000000, static_cast<std::int64_t>(primitiveType),
+					static_cast<std::int64_t>(indexType), duplicates});
+			}
+		}
+	}
+}
+
+} // namespace
+
+BENCHMARK(BM_Convert)->Apply(setIndexCountArgs)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_Convert)->Apply(setPrimitiveArgs)->Unit(benchmark::kMillisecond);
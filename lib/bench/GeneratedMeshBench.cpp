@@ -0,0 +1,135 @@
+/*
+ * Copyright 2026 Aaron Barany
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "MeshGenerator.h"
+#include <VFC/Converter.h>
+#include <benchmark/benchmark.h>
+#include <string>
+
+namespace
+{
+
+const char* shapeNames[] = {"Grid", "Sphere", "Noise"};
+
+// Only keep a single mesh to avoid holding onto the memory for the largest meshes.
+const vfc::GeneratedMesh* getMesh(const vfc::MeshOptions& options)
+{
+	static vfc::MeshOptions meshOptions;
+	static vfc::GeneratedMesh mesh;
+	if (mesh.indexCount > 0 && meshOptions.shape == options.shape &&
+		meshOptions.primitiveType == options.primitiveType &&
+		meshOptions.indexCount == options.indexCount &&
+		meshOptions.splitIndices == options.splitIndices &&
+		meshOptions.duplicateRatio == options.duplicateRatio &&
+		meshOptions.restartDensity == options.restartDensity)
+	{
+		return &mesh;
+	}
+
+	std::string error;
+	meshOptions = options;
+	if (!vfc::generateMesh(mesh, options, error))
+	{
+		mesh = vfc::GeneratedMesh();
+		return nullptr;
+	}
+
+	return &mesh;
+}
+
+void BM_ConvertGenerated(benchmark::State& state)
+{
+	vfc::MeshOptions options;
+	options.indexCount = static_cast<std::uint64_t>(state.range(0));
+	options.shape = static_cast<vfc::MeshShape>(state.range(1));
+	options.primitiveType = static_cast<vfc::PrimitiveType>(state.range(2));
+	options.splitIndices = state.range(3) != 0;
+	options.duplicateRatio = static_cast<double>(state.range(4))/100.0;
+	options.restartDensity = static_cast<double>(state.range(5))/100.0;
+	const vfc::GeneratedMesh* mesh = getMesh(options);
+	if (!mesh)
+	{
+		state.SkipWithError("Couldn't generate mesh.");
+		return;
+	}
+
+	vfc::VertexFormat vertexFormat;
+	vertexFormat.appendElement("position", vfc::ElementLayout::X32Y32Z32, vfc::ElementType::Float);
+	vertexFormat.appendElement("normal", vfc::ElementLayout::W2X10Y10Z10,
+		vfc::ElementType::SNorm);
+	vertexFormat.appendElement("texCoord", vfc::ElementLayout::X16Y16, vfc::ElementType::UNorm);
+
+	std::size_t vertexCount = 0;
+	for (auto _ : state)
+	{
+		vfc::Converter converter(vertexFormat, vfc::IndexType::UInt32, mesh->primitiveType);
+		if (!vfc::addVertexStreams(converter, *mesh) || !converter.convert())
+		{
+			state.SkipWithError("Conversion failed.");
+			return;
+		}
+
+		vertexCount = converter.getVertexCount();
+		benchmark::DoNotOptimize(converter.getVertices().data());
+	}
+
+	std::string label = shapeNames[static_cast<int>(options.shape)];
+	label += " ";
+	label += vfc::primitiveTypeName(options.primitiveType);
+	if (options.splitIndices)
+		label += " split";
+	state.SetLabel(label);
+
+	std::size_t inputStride = 0;
+	for (const vfc::GeneratedStream& stream : mesh->streams)
+		inputStride += stream.vertexFormat.stride();
+	state.SetItemsProcessed(state.iterations()*mesh->indexCount);
+	state.SetBytesProcessed(state.iterations()*mesh->indexCount*inputStride);
+	state.counters["outputVertices"] = static_cast<double>(vertexCount);
+}
+
+void setGeneratedArgs(benchmark::internal::Benchmark* benchmark)
+{
+	benchmark->ArgNames({"indices", "shape", "primitive", "split", "dup%", "restart%"});
+	const auto grid = static_cast<std::int64_t>(vfc::MeshShape::Grid);
+	const auto sphere = static_cast<std::int64_t>(vfc::MeshShape::Sphere);
+	const auto noise = static_cast<std::int64_t>(vfc::MeshShape::Noise);
+	const auto triangleList = static_cast<std::int64_t>(vfc::PrimitiveType::TriangleList);
+	const auto triangleStrip = static_cast<std::int64_t>(vfc::PrimitiveType::TriangleStrip);
+	const auto triangleFan = static_cast<std::int64_t>(vfc::PrimitiveType::TriangleFan);
+	const std::int64_t indexCount = 1000000;
+
+	// Split indices, like OBJ files, with increasing numbers of duplicates.
+	for (std::int64_t shape : {grid, sphere, noise})
+	{
+		for (std::int64_t split = 0; split < 2; ++split)
+		{
+			for (std::int64_t duplicates : {0, 25, 50})
+				benchmark->Args({indexCount, shape, triangleList, split, duplicates, 0});
+		}
+	}
+
+	// Strips and fans with increasing restart density.
+	for (std::int64_t primitiveType : {triangleStrip, triangleFan})
+	{
+		for (std::int64_t restarts : {0, 10, 50})
+			benchmark->Args({indexCount, noise, primitiveType, 0, 0, restarts});
+	}
+}
+
+} // namespace
+
+BENCHMARK(BM_ConvertGenerated)->Apply(setGeneratedArgs)->Unit(benchmark::kMillisecond);
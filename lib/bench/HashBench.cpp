@@ -0,0 +1,206 @@
+/*
+ * Copyright 2026 Aaron Barany
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "Hash.h"
+#include <benchmark/benchmark.h>
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <unordered_set>
+#include <vector>
+
+namespace
+{
+
+struct HashMesh
+{
+	std::vector<std::uint8_t> vertices;
+	std::vector<std::uint32_t> indices;
+	std::uint32_t stride;
+	std::uint32_t vertexCount;
+};
+
+// UV sphere with the position, normal, texture coordinate, and tangent for each vertex as floats,
+// truncated to the stride. This gives the typical distribution of values for mesh data, including
+// duplicate positions along the seam and poles.
+HashMesh createSphere(std::uint32_t stride, unsigned int rings, unsigned int segments)
+{
+	const float pi = 3.14159265358979323846f;
+	HashMesh mesh;
+	mesh.stride = stride;
+	mesh.vertexCount = (rings + 1)*(segments + 1);
+	mesh.vertices.resize(static_cast<std::size_t>(mesh.vertexCount)*stride);
+
+	std::uint8_t* vertex = mesh.vertices.data();
+	for (unsigned int i = 0; i <= rings; ++i)
+	{
+		float v = static_cast<float>(i)/static_cast<float>(rings);
+		float theta = v*pi;
+		for (unsigned int j = 0; j <= segments; ++j, vertex += stride)
+		{
+			float u = static_cast<float>(j)/static_cast<float>(segments);
+			float phi = u*2*pi;
+			float normal[3] = {std::sin(theta)*std::cos(phi), std::cos(theta),
+				std::sin(theta)*std::sin(phi)};
+			float values[12] =
+			{
+				normal[0]*10.0f, normal[1]*10.0f, normal[2]*10.0f,
+				normal[0], normal[1], normal[2],
+				u, v,
+				-std::sin(phi), 0.0f, std::cos(phi), 1.0f
+			};
+			std::memcpy(vertex, values, std::min(static_cast<std::size_t>(stride), sizeof(values)));
+		}
+	}
+
+	mesh.indices.reserve(rings*segments*6);
+	for (unsigned int i = 0; i < rings; ++i)
+	{
+		for (unsigned int j = 0; j < segments; ++j)
+		{
+			std::uint32_t first = i*(segments + 1) + j;
+			std::uint32_t second = first + segments + 1;
+			mesh.indices.insert(mesh.indices.end(),
+				{first, second, first + 1, second, second + 1, first + 1});
+		}
+	}
+
+	return mesh;
+}
+
+const HashMesh& getSphere(std::uint32_t stride)
+{
+	static std::vector<HashMesh> meshes;
+	for (const HashMesh& mesh : meshes)
+	{
+		if (mesh.stride == stride)
+			return mesh;
+	}
+
+	meshes.push_back(createSphere(stride, 256, 256));
+	return meshes.back();
+}
+
+struct KeyRef
+{
+	const std::uint8_t* data;
+	std::uint32_t size;
+
+	bool operator==(const KeyRef& other) const
+	{
+		return std::memcmp(data, other.data, size) == 0;
+	}
+};
+
+struct KeyHash
+{
+	vfc::HashFunction function;
+
+	std::size_t operator()(const KeyRef& key) const
+	{
+		return function(key.data, key.size);
+	}
+};
+
+vfc::HashFunction getHashFunction(bool fixed, std::uint32_t stride)
+{
+	return fixed ? vfc::fixedHashFunction(stride) : &vfc::murmurHash2;
+}
+
+void hash(benchmark::State& state, bool fixed)
+{
+	auto stride = static_cast<std::uint32_t>(state.range(0));
+	const HashMesh& mesh = getSphere(stride);
+	vfc::HashFunction function = getHashFunction(fixed, stride);
+	for (auto _ : state)
+	{
+		const std::uint8_t* vertex = mesh.vertices.data();
+		for (std::uint32_t i = 0; i < mesh.vertexCount; ++i, vertex += stride)
+			benchmark::DoNotOptimize(function(vertex, stride));
+	}
+
+	state.SetItemsProcessed(state.iterations()*mesh.vertexCount);
+	state.SetBytesProcessed(state.iterations()*mesh.vertices.size());
+}
+
+void dedup(benchmark::State& state, bool fixed)
+{
+	auto stride = static_cast<std::uint32_t>(state.range(0));
+	const HashMesh& mesh = getSphere(stride);
+	KeyHash keyHash{getHashFunction(fixed, stride)};
+	std::size_t uniqueCount = 0;
+	std::size_t bucketCollisions = 0;
+	for (auto _ : state)
+	{
+		std::unordered_set<KeyRef, KeyHash> keys(0, keyHash);
+		for (std::uint32_t index : mesh.indices)
+		{
+			keys.insert(
+				KeyRef{mesh.vertices.data() + static_cast<std::size_t>(index)*stride, stride});
+		}
+
+		uniqueCount = keys.size();
+		std::size_t usedBuckets = 0;
+		for (std::size_t i = 0; i < keys.bucket_count(); ++i)
+			usedBuckets += keys.bucket_size(i) > 0;
+		bucketCollisions = keys.size() - usedBuckets;
+	}
+
+	// Full hash collisions between unique keys.
+	std::unordered_set<std::size_t> hashes;
+	std::unordered_set<KeyRef, KeyHash> keys(0, keyHash);
+	const std::uint8_t* vertex = mesh.vertices.data();
+	for (std::uint32_t i = 0; i < mesh.vertexCount; ++i, vertex += stride)
+	{
+		if (keys.insert(KeyRef{vertex, stride}).second)
+			hashes.insert(keyHash.function(vertex, stride));
+	}
+
+	state.SetItemsProcessed(state.iterations()*mesh.indices.size());
+	state.SetBytesProcessed(state.iterations()*mesh.indices.size()*stride);
+	state.counters["uniqueVertices"] = static_cast<double>(uniqueCount);
+	state.counters["hashCollisions"] = static_cast<double>(keys.size() - hashes.size());
+	state.counters["bucketCollisions"] = static_cast<double>(bucketCollisions);
+}
+
+void BM_HashMurmur2(benchmark::State& state)
+{
+	hash(state, false);
+}
+
+void BM_HashFixed(benchmark::State& state)
+{
+	hash(state, true);
+}
+
+void BM_DedupMurmur2(benchmark::State& state)
+{
+	dedup(state, false);
+}
+
+void BM_DedupFixed(benchmark::State& state)
+{
+	dedup(state, true);
+}
+
+} // namespace
+
+#define HASH_STRIDES Arg(12)->Arg(16)->Arg(20)->Arg(24)->Arg(32)->Arg(36)->Arg(48)
+
+BENCHMARK(BM_HashMurmur2)->HASH_STRIDES;
+BENCHMARK(BM_HashFixed)->HASH_STRIDES;
+BENCHMARK(BM_DedupMurmur2)->HASH_STRIDES;
+BENCHMARK(BM_DedupFixed)->HASH_STRIDES;
@@ -0,0 +1,168 @@
+/*
+ * Copyright 2026 Aaron Barany
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "MeshGenerator.h"
+#include <VFC/Converter.h>
+#include <VFC/IndexCodec.h>
+#include <benchmark/benchmark.h>
+#include <memory>
+#include <string>
+
+namespace
+{
+
+const char* shapeNames[] = {"Grid", "Sphere", "Noise"};
+const std::uint64_t meshIndexCount = 1000000;
+
+// Converted indices for a generated mesh, which is what the tool would encode.
+struct ConvertedIndices
+{
+	vfc::MeshShape shape;
+	vfc::PrimitiveType primitiveType;
+	std::vector<std::uint32_t> indices;
+};
+
+const ConvertedIndices* getIndices(vfc::MeshShape shape, vfc::PrimitiveType primitiveType)
+{
+	static std::unique_ptr<ConvertedIndices> convertedIndices;
+	if (convertedIndices && convertedIndices->shape == shape &&
+		convertedIndices->primitiveType == primitiveType)
+	{
+		return convertedIndices.get();
+	}
+
+	convertedIndices.reset();
+	vfc::MeshOptions options;
+	options.shape = shape;
+	options.primitiveType = primitiveType;
+	options.indexCount = meshIndexCount;
+
+	vfc::GeneratedMesh mesh;
+	std::string error;
+	if (!vfc::generateMesh(mesh, options, error))
+		return nullptr;
+
+	vfc::VertexFormat vertexFormat;
+	vertexFormat.appendElement("position", vfc::ElementLayout::X32Y32Z32, vfc::ElementType::Float);
+	vertexFormat.appendElement("normal", vfc::ElementLayout::W2X10Y10Z10,
+		vfc::ElementType::SNorm);
+	vertexFormat.appendElement("texCoord", vfc::ElementLayout::X16Y16, vfc::ElementType::UNorm);
+
+	vfc::Converter converter(vertexFormat, vfc::IndexType::UInt32, mesh.primitiveType);
+	if (!vfc::addVertexStreams(converter, mesh) || !converter.convert() ||
+		converter.getIndices().size() != 1)
+	{
+		return nullptr;
+	}
+
+	convertedIndices.reset(new ConvertedIndices);
+	convertedIndices->shape = shape;
+	convertedIndices->primitiveType = primitiveType;
+
+	const vfc::IndexData& indexData = converter.getIndices()[0];
+	auto indices = reinterpret_cast<const std::uint32_t*>(indexData.data);
+	convertedIndices->indices.assign(indices, indices + indexData.count);
+	return convertedIndices.get();
+}
+
+bool encode(std::vector<std::uint8_t>& outData, const ConvertedIndices& indices)
+{
+	vfc::IndexData indexData = {indices.indices.data(), vfc::IndexType::UInt32,
+		static_cast<std::uint32_t>(indices.indices.size()), 0};
+	return vfc::encodeIndices(outData, indexData, indices.primitiveType);
+}
+
+void setResults(benchmark::State& state, const ConvertedIndices& indices,
+	std::size_t encodedSize)
+{
+	std::string label = shapeNames[static_cast<int>(indices.shape)];
+	label += indices.primitiveType == vfc::PrimitiveType::TriangleList ? " list" : " strip";
+	state.SetLabel(label);
+
+	std::size_t size = indices.indices.size()*sizeof(std::uint32_t);
+	state.SetBytesProcessed(state.iterations()*size);
+	state.counters["ratio"] = static_cast<double>(size)/static_cast<double>(encodedSize);
+}
+
+void BM_EncodeIndices(benchmark::State& state)
+{
+	const ConvertedIndices* indices = getIndices(static_cast<vfc::MeshShape>(state.range(0)),
+		static_cast<vfc::PrimitiveType>(state.range(1)));
+	if (!indices)
+	{
+		state.SkipWithError("Couldn't generate mesh.");
+		return;
+	}
+
+	std::vector<std::uint8_t> encoded;
+	for (auto _ : state)
+	{
+		if (!encode(encoded, *indices))
+		{
+			state.SkipWithError("Encoding failed.");
+			return;
+		}
+		benchmark::DoNotOptimize(encoded.data());
+	}
+
+	setResults(state, *indices, encoded.size());
+}
+
+void BM_DecodeIndices(benchmark::State& state)
+{
+	const ConvertedIndices* indices = getIndices(static_cast<vfc::MeshShape>(state.range(0)),
+		static_cast<vfc::PrimitiveType>(state.range(1)));
+	std::vector<std::uint8_t> encoded;
+	if (!indices || !encode(encoded, *indices))
+	{
+		state.SkipWithError("Couldn't encode mesh.");
+		return;
+	}
+
+	std::vector<std::uint32_t> decoded(indices->indices.size());
+	std::size_t size = decoded.size()*sizeof(std::uint32_t);
+	for (auto _ : state)
+	{
+		if (!vfc::decodeIndices(decoded.data(), size, encoded.data(), encoded.size()))
+		{
+			state.SkipWithError("Decoding failed.");
+			return;
+		}
+		benchmark::DoNotOptimize(decoded.data());
+	}
+
+	setResults(state, *indices, encoded.size());
+}
+
+void setIndexCodecArgs(benchmark::internal::Benchmark* benchmark)
+{
+	benchmark->ArgNames({"shape", "primitive"});
+	for (vfc::MeshShape shape : {vfc::MeshShape::Grid, vfc::MeshShape::Sphere,
+			vfc::MeshShape::Noise})
+	{
+		for (vfc::PrimitiveType primitiveType : {vfc::PrimitiveType::TriangleList,
+				vfc::PrimitiveType::TriangleStrip})
+		{
+			benchmark->Args({static_cast<std::int64_t>(shape),
+				static_cast<std::int64_t>(primitiveType)});
+		}
+	}
+}
+
+} // namespace
+
+BENCHMARK(BM_EncodeIndices)->Apply(setIndexCodecArgs)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_DecodeIndices)->Apply(setIndexCodecArgs)->Unit(benchmark::kMillisecond);
@@ -0,0 +1,102 @@
+/*
+ * Copyright 2026 Aaron Barany
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "MeshGenerator.h"
+#include <VFC/Converter.h>
+#include <VFC/Simplifier.h>
+#include <benchmark/benchmark.h>
+#include <memory>
+#include <string>
+
+namespace
+{
+
+const char* shapeNames[] = {"Grid", "Sphere", "Noise"};
+const std::uint64_t meshIndexCount = 1000000;
+
+// Converter with the converted mesh, which is what the tool would simplify.
+struct ConvertedMesh
+{
+	vfc::MeshShape shape;
+	std::unique_ptr<vfc::Converter> converter;
+};
+
+const vfc::Converter* getConverter(vfc::MeshShape shape)
+{
+	static ConvertedMesh convertedMesh;
+	if (convertedMesh.converter && convertedMesh.shape == shape)
+		return convertedMesh.converter.get();
+
+	convertedMesh.converter.reset();
+	vfc::MeshOptions options;
+	options.shape = shape;
+	options.indexCount = meshIndexCount;
+
+	vfc::GeneratedMesh mesh;
+	std::string error;
+	if (!vfc::generateMesh(mesh, options, error))
+		return nullptr;
+
+	vfc::VertexFormat vertexFormat;
+	vertexFormat.appendElement("position", vfc::ElementLayout::X32Y32Z32, vfc::ElementType::Float);
+	vertexFormat.appendElement("normal", vfc::ElementLayout::W2X10Y10Z10,
+		vfc::ElementType::SNorm);
+	vertexFormat.appendElement("texCoord", vfc::ElementLayout::X16Y16, vfc::ElementType::UNorm);
+
+	std::unique_ptr<vfc::Converter> converter(new vfc::Converter(vertexFormat,
+		vfc::IndexType::UInt32, mesh.primitiveType));
+	if (!vfc::addVertexStreams(*converter, mesh) || !converter->convert())
+		return nullptr;
+
+	convertedMesh.shape = shape;
+	convertedMesh.converter = std::move(converter);
+	return convertedMesh.converter.get();
+}
+
+void BM_Simplify(benchmark::State& state)
+{
+	auto shape = static_cast<vfc::MeshShape>(state.range(0));
+	const vfc::Converter* converter = getConverter(shape);
+	if (!converter)
+	{
+		state.SkipWithError("Couldn't generate mesh.");
+		return;
+	}
+
+	const std::vector<double> ratios = {0.5, 0.25, 0.1};
+	vfc::Simplifier simplifier;
+	for (auto _ : state)
+	{
+		if (!simplifier.simplify(*converter, "position", ratios))
+		{
+			state.SkipWithError("Simplifying failed.");
+			return;
+		}
+		benchmark::DoNotOptimize(simplifier.getLodIndices(0).data());
+	}
+
+	std::uint64_t triangleCount = 0;
+	for (const vfc::IndexData& indexData : converter->getIndices())
+		triangleCount += indexData.count/3;
+
+	state.SetLabel(shapeNames[static_cast<int>(shape)]);
+	state.SetItemsProcessed(state.iterations()*triangleCount);
+	state.counters["error"] = simplifier.getLodError(simplifier.getLodCount() - 1);
+}
+
+} // namespace
+
+BENCHMARK(BM_Simplify)->ArgName("shape")->DenseRange(0, 2)->Unit(benchmark::kMillisecond);
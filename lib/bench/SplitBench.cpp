@@ -0,0 +1,152 @@
+/*
+ * Copyright 2026 Aaron Barany
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <VFC/Converter.h>
+#include <benchmark/benchmark.h>
+#include <cmath>
+#include <vector>
+
+namespace
+{
+
+struct SplitMesh
+{
+	std::vector<float> vertices;
+	std::vector<std::uint32_t> indices;
+	std::uint32_t vertexCount;
+};
+
+const std::uint32_t primitiveRestart = 0xFFFFFFFF;
+
+void addVertex(SplitMesh& mesh, float x, float y, float u, float v)
+{
+	mesh.vertices.insert(mesh.vertices.end(), {x, y, 0.0f, u, v});
+	++mesh.vertexCount;
+}
+
+// Grid of rows, each drawn as a separate triangle strip.
+SplitMesh createStripGrid(unsigned int rows, unsigned int columns)
+{
+	SplitMesh mesh;
+	mesh.vertexCount = 0;
+	for (unsigned int i = 0; i <= rows; ++i)
+	{
+		float v = static_cast<float>(i)/static_cast<float>(rows);
+		for (unsigned int j = 0; j <= columns; ++j)
+		{
+			float u = static_cast<float>(j)/static_cast<float>(columns);
+			addVertex(mesh, u*100.0f, v*100.0f, u, v);
+		}
+	}
+
+	for (unsigned int i = 0; i < rows; ++i)
+	{
+		if (i > 0)
+			mesh.indices.push_back(primitiveRestart);
+		for (unsigned int j = 0; j <= columns; ++j)
+		{
+			mesh.indices.push_back(i*(columns + 1) + j);
+			mesh.indices.push_back((i + 1)*(columns + 1) + j);
+		}
+	}
+
+	return mesh;
+}
+
+// Separate discs, each drawn as a triangle fan.
+SplitMesh createFanDiscs(unsigned int discs, unsigned int segments)
+{
+	const float pi = 3.14159265358979323846f;
+	SplitMesh mesh;
+	mesh.vertexCount = 0;
+	for (unsigned int i = 0; i < discs; ++i)
+	{
+		if (i > 0)
+			mesh.indices.push_back(primitiveRestart);
+
+		float centerX = static_cast<float>(i % 64)*3.0f;
+		float centerY = static_cast<float>(i/64)*3.0f;
+		mesh.indices.push_back(mesh.vertexCount);
+		addVertex(mesh, centerX, centerY, 0.5f, 0.5f);
+		for (unsigned int j = 0; j <= segments; ++j)
+		{
+			float angle = static_cast<float>(j % segments)/static_cast<float>(segments)*2*pi;
+			float x = std::cos(angle), y = std::sin(angle);
+			if (j < segments)
+			{
+				mesh.indices.push_back(mesh.vertexCount);
+				addVertex(mesh, centerX + x, centerY + y, x*0.5f + 0.5f, y*0.5f + 0.5f);
+			}
+			else
+				mesh.indices.push_back(mesh.indices[mesh.indices.size() - segments]);
+		}
+	}
+
+	return mesh;
+}
+
+void convertSplits(benchmark::State& state, const SplitMesh& mesh, vfc::PrimitiveType primitiveType)
+{
+	vfc::VertexFormat inputFormat;
+	inputFormat.appendElement("position", vfc::ElementLayout::X32Y32Z32, vfc::ElementType::Float);
+	inputFormat.appendElement("texCoord", vfc::ElementLayout::X32Y32, vfc::ElementType::Float);
+
+	vfc::VertexFormat vertexFormat;
+	vertexFormat.appendElement("position", vfc::ElementLayout::X16Y16Z16W16,
+		vfc::ElementType::Float);
+	vertexFormat.appendElement("texCoord", vfc::ElementLayout::X16Y16, vfc::ElementType::UNorm);
+
+	auto maxIndexValue = static_cast<std::uint32_t>(state.range(0));
+	std::size_t indexBufferCount = 0;
+	for (auto _ : state)
+	{
+		vfc::Converter converter(vertexFormat, vfc::IndexType::UInt16, primitiveType, 0,
+			maxIndexValue);
+		converter.addVertexStream(inputFormat, mesh.vertices.data(), mesh.vertexCount,
+			vfc::IndexType::UInt32, mesh.indices.data(),
+			static_cast<std::uint32_t>(mesh.indices.size()));
+		if (!converter.convert())
+		{
+			state.SkipWithError("Conversion failed.");
+			return;
+		}
+
+		indexBufferCount = converter.getIndices().size();
+		benchmark::DoNotOptimize(converter.getVertices().data());
+	}
+
+	state.SetItemsProcessed(state.iterations()*mesh.indices.size());
+	state.counters["indexBuffers"] = static_cast<double>(indexBufferCount);
+}
+
+void BM_SplitTriangleStrip(benchmark::State& state)
+{
+	static const SplitMesh mesh = createStripGrid(512, 512);
+	convertSplits(state, mesh, vfc::PrimitiveType::TriangleStrip);
+}
+
+void BM_SplitTriangleFan(benchmark::State& state)
+{
+	static const SplitMesh mesh = createFanDiscs(4096, 63);
+	convertSplits(state, mesh, vfc::PrimitiveType::TriangleFan);
+}
+
+} // namespace
+
+#define SPLIT_MAX_INDEX_VALUES Arg(0xFFFF)->Arg(4095)->Arg(1023)->Arg(255)
+
+BENCHMARK(BM_SplitTriangleStrip)->SPLIT_MAX_INDEX_VALUES->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_SplitTriangleFan)->SPLIT_MAX_INDEX_VALUES->Unit(benchmark::kMillisecond);
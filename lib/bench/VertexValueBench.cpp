@@ -0,0 +1,153 @@
+/*
+ * Copyright 2026 Aaron Barany
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <VFC/VertexFormat.h>
+#include <VFC/VertexValue.h>
+#include <benchmark/benchmark.h>
+#include <string>
+#include <vector>
+
+namespace
+{
+
+const std::size_t valueCount = 4096;
+
+vfc::ElementLayout getLayout(const benchmark::State& state)
+{
+	return static_cast<vfc::ElementLayout>(state.range(0));
+}
+
+vfc::ElementType getType(const benchmark::State& state)
+{
+	return static_cast<vfc::ElementType>(state.range(1));
+}
+
+void setLabel(benchmark::State& state)
+{
+	std::string label = vfc::elementLayoutName(getLayout(state));
+	label += ' ';
+	label += vfc::elementTypeName(getType(state));
+	state.SetLabel(label);
+}
+
+// Values that are within range for all types, including normalized and unsigned types.
+std::vector<vfc::VertexValue> createValues()
+{
+	std::vector<vfc::VertexValue> values(valueCount);
+	for (std::size_t i = 0; i < valueCount; ++i)
+	{
+		for (unsigned int j = 0; j < vfc::VertexValue::count; ++j)
+			values[i][j] = static_cast<double>((i*7 + j*13) % 101)/100.0;
+	}
+	return values;
+}
+
+void setFormatArgs(benchmark::internal::Benchmark* benchmark)
+{
+	benchmark->ArgNames({"layout", "type"});
+	for (unsigned int i = 0; i < vfc::elementLayoutCount; ++i)
+	{
+		for (unsigned int j = 0; j < vfc::elementTypeCount; ++j)
+		{
+			if (vfc::isElementValid(static_cast<vfc::ElementLayout>(i),
+					static_cast<vfc::ElementType>(j)))
+			{
+				benchmark->Args({i, j});
+			}
+		}
+	}
+}
+
+void setThroughput(benchmark::State& state)
+{
+	state.SetItemsProcessed(state.iterations()*valueCount);
+	state.SetBytesProcessed(
+		state.iterations()*valueCount*vfc::elementLayoutSize(getLayout(state)));
+}
+
+void BM_VertexValueFromData(benchmark::State& state)
+{
+	vfc::ElementLayout layout = getLayout(state);
+	vfc::ElementType type = getType(state);
+	std::uint32_t size = vfc::elementLayoutSize(layout);
+
+	std::vector<vfc::VertexValue> values = createValues();
+	std::vector<std::uint8_t> data(valueCount*size);
+	for (std::size_t i = 0; i < valueCount; ++i)
+		values[i].toData(data.data() + i*size, layout, type);
+
+	for (auto _ : state)
+	{
+		for (std::size_t i = 0; i < valueCount; ++i)
+			values[i].fromData(data.data() + i*size, layout, type);
+		benchmark::DoNotOptimize(values.data());
+		benchmark::ClobberMemory();
+	}
+
+	setLabel(state);
+	setThroughput(state);
+}
+
+void BM_VertexValueToData(benchmark::State& state)
+{
+	vfc::ElementLayout layout = getLayout(state);
+	vfc::ElementType type = getType(state);
+	std::uint32_t size = vfc::elementLayoutSize(layout);
+
+	std::vector<vfc::VertexValue> values = createValues();
+	std::vector<std::uint8_t> data(valueCount*size);
+	for (auto _ : state)
+	{
+		for (std::size_t i = 0; i < valueCount; ++i)
+			values[i].toData(data.data() + i*size, layout, type);
+		benchmark::DoNotOptimize(data.data());
+		benchmark::ClobberMemory();
+	}
+
+	setLabel(state);
+	setThroughput(state);
+}
+
+void BM_VertexValueToDataBounds(benchmark::State& state)
+{
+	vfc::ElementLayout layout = getLayout(state);
+	vfc::ElementType type = getType(state);
+	std::uint32_t size = vfc::elementLayoutSize(layout);
+
+	std::vector<vfc::VertexValue> values = createValues();
+	vfc::VertexValue minVal = vfc::VertexValue::initialBoundsMin;
+	vfc::VertexValue maxVal = vfc::VertexValue::initialBoundsMax;
+	for (const vfc::VertexValue& value : values)
+		value.expandBounds(minVal, maxVal);
+
+	std::vector<std::uint8_t> data(valueCount*size);
+	for (auto _ : state)
+	{
+		for (std::size_t i = 0; i < valueCount; ++i)
+			values[i].toData(data.data() + i*size, layout, type, minVal, maxVal);
+		benchmark::DoNotOptimize(data.data());
+		benchmark::ClobberMemory();
+	}
+
+	setLabel(state);
+	setThroughput(state);
+}
+
+} // namespace
+
+BENCHMARK(BM_VertexValueFromData)->Apply(setFormatArgs);
+BENCHMARK(BM_VertexValueToData)->Apply(setFormatArgs);
+BENCHMARK(BM_VertexValueToDataBounds)->Apply(setFormatArgs);
@@ -0,0 +1,520 @@
+/*
+ * Copyright 2026 Aaron Barany
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "MeshGenerator.h"
+
+#include <VFC/Converter.h>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <unordered_map>
+
+namespace vfc
+{
+
+namespace
+{
+
+const std::uint32_t restartIndex = std::numeric_limits<std::uint32_t>::max();
+const unsigned int floatsPerVertex = 8;
+const unsigned int positionOffset = 0;
+const unsigned int normalOffset = 3;
+const unsigned int texCoordOffset = 6;
+
+// Own random number generator rather than the standard distributions, which are implementation
+// defined, so the same mesh is generated on all platforms.
+// http://prng.di.unimi.it/splitmix64.c
+class Random
+{
+public:
+	explicit Random(std::uint64_t seed)
+		: m_state(seed)
+	{
+	}
+
+	std::uint64_t next()
+	{
+		std::uint64_t z = (m_state += 0x9e3779b97f4a7c15ULL);
+		z = (z ^ (z >> 30))*0xbf58476d1ce4e5b9ULL;
+		z = (z ^ (z >> 27))*0x94d049bb133111ebULL;
+		return z ^ (z >> 31);
+	}
+
+	// Value in the range [0, 1).
+	double nextDouble()
+	{
+		return static_cast<double>(next() >> 11)*(1.0/9007199254740992.0);
+	}
+
+	bool chance(double probability)
+	{
+		return probability > 0 && nextDouble() < probability;
+	}
+
+private:
+	std::uint64_t m_state;
+};
+
+struct Grid
+{
+	std::uint32_t columns;
+	std::uint32_t rows;
+
+	std::uint32_t vertex(std::uint32_t x, std::uint32_t y) const
+	{
+		return y*(columns + 1) + x;
+	}
+
+	std::uint32_t vertexCount() const
+	{
+		return (columns + 1)*(rows + 1);
+	}
+};
+
+double latticeValue(std::int64_t x, std::int64_t y, std::uint32_t seed)
+{
+	Random random(static_cast<std::uint64_t>(x)*0x9e3779b1ULL ^
+		static_cast<std::uint64_t>(y)*0x85ebca77c2b2ae63ULL ^ seed);
+	return random.nextDouble();
+}
+
+// Smoothly interpolated value noise with a few octaves.
+double noiseHeight(double x, double y, std::uint32_t seed)
+{
+	double height = 0;
+	double amplitude = 1;
+	double frequency = 1.0/8.0;
+	for (unsigned int octave = 0; octave < 3; ++octave)
+	{
+		double fx = x*frequency, fy = y*frequency;
+		double cellX = std::floor(fx), cellY = std::floor(fy);
+		double tx = fx - cellX, ty = fy - cellY;
+		tx = tx*tx*(3 - 2*tx);
+		ty = ty*ty*(3 - 2*ty);
+
+		auto ix = static_cast<std::int64_t>(cellX), iy = static_cast<std::int64_t>(cellY);
+		std::uint32_t octaveSeed = seed + octave*0x632be5abU;
+		double v00 = latticeValue(ix, iy, octaveSeed);
+		double v10 = latticeValue(ix + 1, iy, octaveSeed);
+		double v01 = latticeValue(ix, iy + 1, octaveSeed);
+		double v11 = latticeValue(ix + 1, iy + 1, octaveSeed);
+		double top = v00 + (v10 - v00)*tx;
+		double bottom = v01 + (v11 - v01)*tx;
+		height += (top + (bottom - top)*ty)*amplitude;
+
+		amplitude *= 0.5;
+		frequency *= 2;
+	}
+
+	return height*4.0;
+}
+
+Grid createGrid(const MeshOptions& options)
+{
+	double indicesPerQuad;
+	switch (options.primitiveType)
+	{
+		case PrimitiveType::PointList:
+		case PrimitiveType::LineStrip:
+			indicesPerQuad = 1.0;
+			break;
+		case PrimitiveType::LineList:
+			indicesPerQuad = 4.0;
+			break;
+		case PrimitiveType::TriangleStrip:
+			indicesPerQuad = 2.0;
+			break;
+		case PrimitiveType::TriangleFan:
+			indicesPerQuad = 2.5;
+			break;
+		default:
+			indicesPerQuad = 6.0;
+			break;
+	}
+
+	double quadCount = std::max(static_cast<double>(options.indexCount)/indicesPerQuad, 4.0);
+	double rows;
+	if (options.shape == MeshShape::Sphere)
+		rows = std::ceil(std::sqrt(quadCount/2));
+	else
+		rows = std::ceil(std::sqrt(quadCount));
+	double columns = options.shape == MeshShape::Sphere ? rows*2 : rows;
+
+	// Even number of quads for fans, which cover 2x2 quads.
+	const double maxDimension = 0x7FFFFFFE;
+	Grid grid;
+	grid.rows = static_cast<std::uint32_t>(std::min(rows + std::fmod(rows, 2.0), maxDimension));
+	grid.columns =
+		static_cast<std::uint32_t>(std::min(columns + std::fmod(columns, 2.0), maxDimension));
+	return grid;
+}
+
+void createVertices(std::vector<float>& outValues, const Grid& grid, const MeshOptions& options)
+{
+	const double pi = 3.14159265358979323846;
+	outValues.resize(static_cast<std::size_t>(grid.vertexCount())*floatsPerVertex);
+	float* values = outValues.data();
+	for (std::uint32_t y = 0; y <= grid.rows; ++y)
+	{
+		double v = static_cast<double>(y)/grid.rows;
+		for (std::uint32_t x = 0; x <= grid.columns; ++x, values += floatsPerVertex)
+		{
+			double u = static_cast<double>(x)/grid.columns;
+			double position[3];
+			double normal[3];
+			switch (options.shape)
+			{
+				case MeshShape::Sphere:
+				{
+					double theta = v*pi;
+					double phi = u*2*pi;
+					// Exact values at the poles and seam so the positions are shared.
+					double sinTheta = y == 0 || y == grid.rows ? 0.0 : std::sin(theta);
+					double cosTheta = y == 0 ? 1.0 : y == grid.rows ? -1.0 : std::cos(theta);
+					double sinPhi = x == grid.columns ? 0.0 : std::sin(phi);
+					double cosPhi = x == grid.columns ? 1.0 : std::cos(phi);
+					normal[0] = sinTheta*cosPhi;
+					normal[1] = cosTheta;
+					normal[2] = sinTheta*sinPhi;
+					for (unsigned int i = 0; i < 3; ++i)
+						position[i] = normal[i]*10.0;
+					break;
+				}
+				case MeshShape::Noise:
+				{
+					double height = noiseHeight(x, y, options.seed);
+					double dx = noiseHeight(x + 0.5, y, options.seed) -
+						noiseHeight(x - 0.5, y, options.seed);
+					double dy = noiseHeight(x, y + 0.5, options.seed) -
+						noiseHeight(x, y - 0.5, options.seed);
+					position[0] = x;
+					position[1] = height;
+					position[2] = y;
+					double length = std::sqrt(dx*dx + 1 + dy*dy);
+					normal[0] = -dx/length;
+					normal[1] = 1/length;
+					normal[2] = -dy/length;
+					break;
+				}
+				default:
+					position[0] = x;
+					position[1] = 0;
+					position[2] = y;
+					normal[0] = 0;
+					normal[1] = 1;
+					normal[2] = 0;
+					break;
+			}
+
+			for (unsigned int i = 0; i < 3; ++i)
+			{
+				values[positionOffset + i] = static_cast<float>(position[i]);
+				values[normalOffset + i] = static_cast<float>(normal[i]);
+			}
+			values[texCoordOffset] = static_cast<float>(u);
+			values[texCoordOffset + 1] = static_cast<float>(v);
+		}
+	}
+}
+
+void createIndices(std::vector<std::uint32_t>& indices, const Grid& grid,
+	const MeshOptions& options, Random& random)
+{
+	switch (options.primitiveType)
+	{
+		case PrimitiveType::PointList:
+			for (std::uint32_t i = 0; i < grid.vertexCount(); ++i)
+				indices.push_back(i);
+			break;
+		case PrimitiveType::LineList:
+			for (std::uint32_t y = 0; y <= grid.rows; ++y)
+			{
+				for (std::uint32_t x = 0; x <= grid.columns; ++x)
+				{
+					std::uint32_t vertex = grid.vertex(x, y);
+					if (x < grid.columns)
+						indices.insert(indices.end(), {vertex, vertex + 1});
+					if (y < grid.rows)
+						indices.insert(indices.end(), {vertex, grid.vertex(x, y + 1)});
+				}
+			}
+			break;
+		case PrimitiveType::LineStrip:
+			for (std::uint32_t y = 0; y <= grid.rows; ++y)
+			{
+				if (y > 0)
+					indices.push_back(restartIndex);
+				for (std::uint32_t x = 0; x <= grid.columns; ++x)
+				{
+					indices.push_back(grid.vertex(x, y));
+					if (x > 0 && x < grid.columns && random.chance(options.restartDensity))
+						indices.insert(indices.end(), {restartIndex, grid.vertex(x, y)});
+				}
+			}
+			break;
+		case PrimitiveType::TriangleStrip:
+			for (std::uint32_t y = 0; y < grid.rows; ++y)
+			{
+				if (y > 0)
+					indices.push_back(restartIndex);
+				for (std::uint32_t x = 0; x <= grid.columns; ++x)
+				{
+					std::uint32_t first = grid.vertex(x, y);
+					std::uint32_t second = grid.vertex(x, y + 1);
+					indices.insert(indices.end(), {first, second});
+					if (x > 0 && x < grid.columns && random.chance(options.restartDensity))
+						indices.insert(indices.end(), {restartIndex, first, second});
+				}
+			}
+			break;
+		case PrimitiveType::TriangleFan:
+		{
+			// Each fan covers 2x2 quads, with the vertices around the center in the same winding
+			// order as the other primitive types.
+			const int ring[][2] = {{-1, -1}, {-1, 0}, {-1, 1}, {0, 1}, {1, 1}, {1, 0}, {1, -1},
+				{0, -1}};
+			const unsigned int ringCount = 8;
+			for (std::uint32_t y = 1; y < grid.rows; y += 2)
+			{
+				for (std::uint32_t x = 1; x < grid.columns; x += 2)
+				{
+					if (!indices.empty())
+						indices.push_back(restartIndex);
+
+					std::uint32_t center = grid.vertex(x, y);
+					indices.insert(indices.end(),
+						{center, grid.vertex(x + ring[0][0], y + ring[0][1])});
+					for (unsigned int i = 1; i <= ringCount; ++i)
+					{
+						const int* offset = ring[i % ringCount];
+						std::uint32_t vertex = grid.vertex(x + offset[0], y + offset[1]);
+						indices.push_back(vertex);
+						if (i < ringCount && random.chance(options.restartDensity))
+							indices.insert(indices.end(), {restartIndex, center, vertex});
+					}
+				}
+			}
+			break;
+		}
+		default:
+			for (std::uint32_t y = 0; y < grid.rows; ++y)
+			{
+				for (std::uint32_t x = 0; x < grid.columns; ++x)
+				{
+					std::uint32_t first = grid.vertex(x, y);
+					std::uint32_t second = grid.vertex(x, y + 1);
+					indices.insert(indices.end(),
+						{first, second, first + 1, second, second + 1, first + 1});
+				}
+			}
+			break;
+	}
+}
+
+struct ValueKey
+{
+	std::array<std::uint32_t, 3> bits;
+
+	bool operator==(const ValueKey& other) const
+	{
+		return bits == other.bits;
+	}
+};
+
+struct ValueKeyHash
+{
+	std::size_t operator()(const ValueKey& key) const
+	{
+		std::uint64_t hash = 0;
+		for (std::uint32_t value : key.bits)
+			hash = (hash ^ value)*0x9e3779b97f4a7c15ULL;
+		return static_cast<std::size_t>(hash ^ (hash >> 32));
+	}
+};
+
+// Separate stream for a single element, where identical values share the same index.
+void createSplitStream(GeneratedStream& stream, std::vector<std::uint32_t>& streamIndices,
+	const std::vector<float>& values, unsigned int offset, unsigned int count,
+	const std::vector<std::uint32_t>& indices)
+{
+	std::size_t gridVertexCount = values.size()/floatsPerVertex;
+	std::vector<std::uint32_t> remap(gridVertexCount);
+	std::unordered_map<ValueKey, std::uint32_t, ValueKeyHash> uniqueValues;
+	std::vector<float> streamValues;
+	for (std::size_t i = 0; i < gridVertexCount; ++i)
+	{
+		ValueKey key = {{0, 0, 0}};
+		const float* value = values.data() + i*floatsPerVertex + offset;
+		std::memcpy(key.bits.data(), value, count*sizeof(float));
+		auto inserted = uniqueValues.emplace(key, static_cast<std::uint32_t>(uniqueValues.size()));
+		if (inserted.second)
+			streamValues.insert(streamValues.end(), value, value + count);
+		remap[i] = inserted.first->second;
+	}
+
+	stream.vertexCount = static_cast<std::uint32_t>(uniqueValues.size());
+	stream.vertices.resize(streamValues.size()*sizeof(float));
+	std::memcpy(stream.vertices.data(), streamValues.data(), stream.vertices.size());
+
+	streamIndices.resize(indices.size());
+	for (std::size_t i = 0; i < indices.size(); ++i)
+		streamIndices[i] = indices[i] == restartIndex ? restartIndex : remap[indices[i]];
+}
+
+void addDuplicates(GeneratedStream& stream, std::vector<std::uint32_t>& indices,
+	double duplicateRatio, Random& random)
+{
+	if (duplicateRatio <= 0)
+		return;
+
+	std::uint32_t stride = stream.vertexFormat.stride();
+	for (std::uint32_t& index : indices)
+	{
+		if (index == restartIndex || !random.chance(duplicateRatio))
+			continue;
+
+		std::size_t offset = stream.vertices.size();
+		stream.vertices.resize(offset + stride);
+		std::memcpy(stream.vertices.data() + offset,
+			stream.vertices.data() + static_cast<std::size_t>(index)*stride, stride);
+		index = stream.vertexCount++;
+	}
+}
+
+} // namespace
+
+bool generateMesh(GeneratedMesh& outMesh, const MeshOptions& options, std::string& outError)
+{
+	if (options.primitiveType == PrimitiveType::Invalid ||
+		options.primitiveType == PrimitiveType::PatchList)
+	{
+		outError = "Unsupported primitive type for generated mesh.";
+		return false;
+	}
+
+	if (options.indexType == IndexType::NoIndices)
+	{
+		outError = "Generated meshes must have indices.";
+		return false;
+	}
+
+	if (!(options.duplicateRatio >= 0 && options.duplicateRatio <= 1) ||
+		!(options.restartDensity >= 0 && options.restartDensity <= 1))
+	{
+		outError = "Duplicate ratio and restart density must be in the range [0, 1].";
+		return false;
+	}
+
+	Grid grid = createGrid(options);
+	double maxIndexCount = static_cast<double>(std::numeric_limits<std::uint32_t>::max() - 1);
+	if ((static_cast<double>(grid.columns) + 1)*(static_cast<double>(grid.rows) + 1) >
+			maxIndexCount || static_cast<double>(options.indexCount)*2 > maxIndexCount)
+	{
+		outError = "Too many indices for generated mesh.";
+		return false;
+	}
+
+	Random random(options.seed);
+	std::vector<float> values;
+	createVertices(values, grid, options);
+	std::vector<std::uint32_t> indices;
+	createIndices(indices, grid, options, random);
+	if (static_cast<double>(indices.size()) > maxIndexCount)
+	{
+		outError = "Too many indices for generated mesh.";
+		return false;
+	}
+
+	outMesh = GeneratedMesh();
+	outMesh.primitiveType = options.primitiveType;
+	outMesh.indexType = options.indexType;
+	outMesh.indexCount = static_cast<std::uint32_t>(indices.size());
+
+	std::vector<std::vector<std::uint32_t>> streamIndices;
+	if (options.splitIndices)
+	{
+		const char* names[] = {"position", "normal", "texCoord"};
+		const unsigned int offsets[] = {positionOffset, normalOffset, texCoordOffset};
+		const unsigned int counts[] = {3, 3, 2};
+		outMesh.streams.resize(3);
+		streamIndices.resize(3);
+		for (unsigned int i = 0; i < 3; ++i)
+		{
+			GeneratedStream& stream = outMesh.streams[i];
+			stream.vertexFormat.appendElement(names[i],
+				counts[i] == 3 ? ElementLayout::X32Y32Z32 : ElementLayout::X32Y32,
+				ElementType::Float);
+			createSplitStream(stream, streamIndices[i], values, offsets[i], counts[i], indices);
+		}
+	}
+	else
+	{
+		outMesh.streams.resize(1);
+		GeneratedStream& stream = outMesh.streams[0];
+		stream.vertexFormat.appendElement("position", ElementLayout::X32Y32Z32,
+			ElementType::Float);
+		stream.vertexFormat.appendElement("normal", ElementLayout::X32Y32Z32,
+			ElementType::Float);
+		stream.vertexFormat.appendElement("texCoord", ElementLayout::X32Y32, ElementType::Float);
+		stream.vertexCount = grid.vertexCount();
+		stream.vertices.resize(values.size()*sizeof(float));
+		std::memcpy(stream.vertices.data(), values.data(), stream.vertices.size());
+		streamIndices.push_back(std::move(indices));
+	}
+
+	std::uint32_t primitiveRestart = primitiveRestartIndexValue(options.indexType);
+	unsigned int sizeofIndex = indexSize(options.indexType);
+	for (std::size_t i = 0; i < outMesh.streams.size(); ++i)
+	{
+		GeneratedStream& stream = outMesh.streams[i];
+		std::vector<std::uint32_t>& curIndices = streamIndices[i];
+		addDuplicates(stream, curIndices, options.duplicateRatio, random);
+		if (stream.vertexCount > primitiveRestart)
+		{
+			outError = "Too many vertices for the index type of the generated mesh.";
+			return false;
+		}
+
+		stream.indices.resize(curIndices.size()*sizeofIndex);
+		for (std::size_t j = 0; j < curIndices.size(); ++j)
+		{
+			std::uint32_t index = curIndices[j];
+			setIndexValue(options.indexType, stream.indices.data(), j,
+				index == restartIndex ? primitiveRestart : index);
+		}
+	}
+
+	return true;
+}
+
+bool addVertexStreams(Converter& converter, const GeneratedMesh& mesh)
+{
+	for (const GeneratedStream& stream : mesh.streams)
+	{
+		if (!converter.addVertexStream(stream.vertexFormat, stream.vertices.data(),
+				stream.vertexCount, mesh.indexType, stream.indices.data(), mesh.indexCount))
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
+
+} // namespace vfc
@@ -0,0 +1,171 @@
+/*
+ * Copyright 2026 Aaron Barany
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <VFC/Config.h>
+#include <VFC/IndexData.h>
+#include <VFC/VertexFormat.h>
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace vfc
+{
+
+class Converter;
+
+/**
+ * @brief Enum for the shape of a generated mesh.
+ */
+enum class MeshShape
+{
+	Grid,   ///< Flat grid.
+	Sphere, ///< UV sphere, with shared positions along the seam and poles.
+	Noise   ///< Grid displaced by noise, with irregular normals.
+};
+
+/**
+ * @brief Options for generating a synthetic mesh.
+ *
+ * The mesh is built from a grid of vertices, with the indices laid out based on the primitive
+ * type. All values are deterministic based on the options, including the seed.
+ */
+struct MeshOptions
+{
+	/**
+	 * @brief The shape of the mesh.
+	 */
+	MeshShape shape = MeshShape::Grid;
+
+	/**
+	 * @brief The primitive type. PatchList isn't supported.
+	 */
+	PrimitiveType primitiveType = PrimitiveType::TriangleList;
+
+	/**
+	 * @brief The approximate number of indices to generate.
+	 */
+	std::uint64_t indexCount = 6000;
+
+	/**
+	 * @brief The index type for the generated indices.
+	 */
+	IndexType indexType = IndexType::UInt32;
+
+	/**
+	 * @brief Whether to have separate position, normal, and texture coordinate streams, each
+	 *     with their own indices similar to OBJ files.
+	 *
+	 * When false, a single interleaved vertex stream is generated.
+	 */
+	bool splitIndices = false;
+
+	/**
+	 * @brief The fraction of indices, in the range [0, 1], that reference a duplicate copy of a
+	 *     vertex rather than the original.
+	 */
+	double duplicateRatio = 0.0;
+
+	/**
+	 * @brief The probability, in the range [0, 1], of ending a strip or fan after each primitive
+	 *     with a primitive restart.
+	 *
+	 * Strips always restart at the end of each row of the grid, and fans after each fan, so
+	 * indices must be output when converting them.
+	 */
+	double restartDensity = 0.0;
+
+	/**
+	 * @brief The seed for random values.
+	 */
+	std::uint32_t seed = 0;
+};
+
+/**
+ * @brief Struct containing a generated vertex stream.
+ */
+struct GeneratedStream
+{
+	/**
+	 * @brief The vertex format of the stream.
+	 */
+	VertexFormat vertexFormat;
+
+	/**
+	 * @brief The vertex data.
+	 */
+	std::vector<std::uint8_t> vertices;
+
+	/**
+	 * @brief The number of vertices.
+	 */
+	std::uint32_t vertexCount = 0;
+
+	/**
+	 * @brief The index data, using the index type from the options.
+	 */
+	std::vector<std::uint8_t> indices;
+};
+
+/**
+ * @brief Struct containing a generated mesh.
+ */
+struct GeneratedMesh
+{
+	/**
+	 * @brief The primitive type.
+	 */
+	PrimitiveType primitiveType = PrimitiveType::Invalid;
+
+	/**
+	 * @brief The index type for each stream.
+	 */
+	IndexType indexType = IndexType::NoIndices;
+
+	/**
+	 * @brief The number of indices for each stream.
+	 */
+	std::uint32_t indexCount = 0;
+
+	/**
+	 * @brief The vertex streams.
+	 *
+	 * A single stream contains the elements "position", "normal", and "texCoord". With split
+	 * indices, a separate stream is used for each element in that order.
+	 */
+	std::vector<GeneratedStream> streams;
+};
+
+/**
+ * @brief Generates a synthetic mesh.
+ * @param[out] outMesh The generated mesh.
+ * @param options The options for the mesh.
+ * @param[out] outError The error message when generation fails.
+ * @return False if the options are invalid.
+ */
+bool generateMesh(GeneratedMesh& outMesh, const MeshOptions& options, std::string& outError);
+
+/**
+ * @brief Adds the vertex streams for a generated mesh to a converter.
+ * @param converter The converter to add the streams to.
+ * @param mesh The mesh to add.
+ * @return False if the streams couldn't be added.
+ */
+bool addVertexStreams(Converter& converter, const GeneratedMesh& mesh);
+
+} // namespace vfc
@@ -0,0 +1,158 @@
+/*
+ * Copyright 2026 Aaron Barany
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <VFC/Config.h>
+#include <VFC/Export.h>
+#include <VFC/IndexData.h>
+#include <cstdint>
+#include <vector>
+
+/**
+ * @file
+ * @brief Functions for compressing vertex and index data.
+ *
+ * Compressed data starts with a CompressedHeader, followed by blocks of up to
+ * compressedBlockSize vertices or indices that may be decoded independently. Each block starts
+ * with its size in bytes as a 32-bit value. Within a block, the data is split into byte planes,
+ * with one plane for each byte of the vertex or index, so bytes with similar statistics are coded
+ * together. For example, the sign and exponent bytes of float positions are often identical
+ * between neighboring vertices, while the low bytes of the mantissa are closer to random.
+ *
+ * Each plane is either a constant byte, stored as-is, or entropy coded with a canonical Huffman
+ * code. Vertex planes may first have the previous vertex's byte subtracted when that gives better
+ * compression, which is typical for positions and texture coordinates after the vertices have
+ * been ordered by first use. Indices are stored as the zigzag-encoded difference from the
+ * previous index before splitting into planes, so the upper bytes are mostly zero.
+ *
+ * All values are little-endian. Decompressing is fully validated, so corrupt or malicious data
+ * fails rather than reading or writing out of bounds.
+ */
+
+namespace vfc
+{
+
+/**
+ * @brief The magic number at the start of compressed data.
+ */
+constexpr char compressedMagic[4] = {'V', 'F', 'C', 'Z'};
+
+/**
+ * @brief The current version of the compressed data format.
+ */
+constexpr std::uint8_t compressedVersion = 1;
+
+/**
+ * @brief The maximum number of vertices or indices in each compressed block.
+ */
+constexpr std::uint32_t compressedBlockSize = 16384;
+
+/**
+ * @brief Enum for the type of compressed data.
+ */
+enum class CompressedDataType : std::uint8_t
+{
+	Vertices, ///< Vertex data, with the element size as the vertex stride.
+	Indices   ///< Index data, with the element size as the index size.
+};
+
+/**
+ * @brief The header at the start of compressed data.
+ */
+struct CompressedHeader
+{
+	/**
+	 * @brief The magic number, which is always compressedMagic.
+	 */
+	char magic[4];
+
+	/**
+	 * @brief The version of the compressed data format.
+	 */
+	std::uint8_t version;
+
+	/**
+	 * @brief The type of the compressed data.
+	 */
+	CompressedDataType type;
+
+	/**
+	 * @brief The size of each vertex or index in bytes.
+	 */
+	std::uint16_t elementSize;
+
+	/**
+	 * @brief The number of vertices or indices.
+	 */
+	std::uint32_t count;
+
+	/**
+	 * @brief The number of blocks that follow the header.
+	 */
+	std::uint32_t blockCount;
+};
+
+static_assert(sizeof(CompressedHeader) == 16, "Unexpected CompressedHeader size.");
+
+/**
+ * @brief Compresses vertex data.
+ * @param[out] outData The compressed data.
+ * @param vertices The vertex data.
+ * @param vertexCount The number of vertices.
+ * @param vertexStride The size of each vertex in bytes. This must be in the range [1, 65535].
+ * @return False if the parameters are invalid.
+ */
+VFC_EXPORT bool compressVertices(std::vector<std::uint8_t>& outData, const void* vertices,
+	std::uint32_t vertexCount, std::uint32_t vertexStride);
+
+/**
+ * @brief Compresses index data.
+ * @param[out] outData The compressed data.
+ * @param indices The index data.
+ * @param indexCount The number of indices.
+ * @param indexType The type of the indices.
+ * @return False if the parameters are invalid.
+ */
+VFC_EXPORT bool compressIndices(std::vector<std::uint8_t>& outData, const void* indices,
+	std::uint32_t indexCount, IndexType indexType);
+
+/**
+ * @brief Reads the header for compressed data.
+ *
+ * This may be used to find the size to decompress to, which is the count multiplied by the element
+ * size.
+ *
+ * @param[out] outHeader The header.
+ * @param data The compressed data.
+ * @param size The size of the compressed data in bytes.
+ * @return False if the data doesn't start with a valid header.
+ */
+VFC_EXPORT bool readCompressedHeader(CompressedHeader& outHeader, const void* data,
+	std::size_t size);
+
+/**
+ * @brief Decompresses vertex or index data.
+ * @param[out] outData The data to decompress to.
+ * @param outSize The size of outData in bytes. This must match the count multiplied by the
+ *     element size from the header.
+ * @param data The compressed data.
+ * @param size The size of the compressed data in bytes.
+ * @return False if the data is invalid or the size doesn't match.
+ */
+VFC_EXPORT bool decompress(void* outData, std::size_t outSize, const void* data, std::size_t size);
+
+} // namespace vfc
@@ -0,0 +1,448 @@
+/*
+ * Copyright 2026 Aaron Barany
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <VFC/Config.h>
+#include <VFC/Export.h>
+#include <VFC/IndexData.h>
+#include <VFC/VertexFormat.h>
+#include <VFC/VertexValue.h>
+#include <cstdint>
+#include <vector>
+
+/**
+ * @file
+ * @brief Types and classes for the binary container that holds converted vertex and index data.
+ *
+ * The container is a single file with a header that describes the vertex formats, bounds, and
+ * index buffers, followed by the data for each vertex stream and index buffer. All values are
+ * little-endian. The file is laid out as follows:
+ * - ContainerHeader
+ * - ContainerVertexStream for each vertex stream.
+ * - ContainerElement for each vertex element across all vertex streams.
+ * - ContainerIndexBuffer for each index buffer.
+ * - The string table with the null-terminated names of the vertex elements.
+ * - Padding to the section alignment, then the data for each vertex stream and index buffer, each
+ *   starting at a multiple of the section alignment.
+ *
+ * Each struct has a fixed size and is aligned to 8 bytes, so the tables may be accessed in place
+ * when the container is memory-mapped. The data sections may then be uploaded directly without
+ * parsing.
+ */
+
+namespace vfc
+{
+
+/**
+ * @brief The magic number at the start of a container.
+ */
+constexpr char containerMagic[4] = {'V', 'F', 'C', 'B'};
+
+/**
+ * @brief The current version of the container format.
+ */
+constexpr std::uint32_t containerVersion = 1;
+
+/**
+ * @brief The default alignment for data sections within the container.
+ *
+ * This satisfies the offset alignment requirements of common graphics APIs.
+ */
+constexpr std::uint32_t defaultContainerAlignment = 256;
+
+/**
+ * @brief The header at the start of the container.
+ */
+struct ContainerHeader
+{
+	/**
+	 * @brief The magic number, which is always containerMagic.
+	 */
+	char magic[4];
+
+	/**
+	 * @brief The version of the container format.
+	 */
+	std::uint32_t version;
+
+	/**
+	 * @brief The size of the full container in bytes.
+	 */
+	std::uint64_t fileSize;
+
+	/**
+	 * @brief The size in bytes of the header, tables, and string table, including padding.
+	 *
+	 * This is the offset to the first data section.
+	 */
+	std::uint32_t headerSize;
+
+	/**
+	 * @brief The alignment in bytes of each data section. This is a power of two.
+	 */
+	std::uint32_t sectionAlignment;
+
+	/**
+	 * @brief The number of vertices in each vertex stream.
+	 */
+	std::uint32_t vertexCount;
+
+	/**
+	 * @brief The number of vertex streams.
+	 */
+	std::uint32_t vertexStreamCount;
+
+	/**
+	 * @brief The number of vertex elements across all vertex streams.
+	 */
+	std::uint32_t elementCount;
+
+	/**
+	 * @brief The number of index buffers.
+	 */
+	std::uint32_t indexBufferCount;
+
+	/**
+	 * @brief The size of the string table in bytes.
+	 */
+	std::uint32_t stringTableSize;
+
+	/**
+	 * @brief The type of the indices.
+	 */
+	IndexType indexType;
+
+	/**
+	 * @brief The type of the primitive.
+	 */
+	PrimitiveType primitiveType;
+
+	/**
+	 * @brief The number of patch points when primitiveType is PatchList.
+	 */
+	std::uint16_t patchPoints;
+};
+
+static_assert(sizeof(ContainerHeader) == 48, "Unexpected ContainerHeader size.");
+
+/**
+ * @brief A vertex stream within the container.
+ */
+struct ContainerVertexStream
+{
+	/**
+	 * @brief The offset in bytes from the start of the container to the vertex data.
+	 */
+	std::uint64_t dataOffset;
+
+	/**
+	 * @brief The size of the vertex data in bytes.
+	 */
+	std::uint64_t dataSize;
+
+	/**
+	 * @brief The size of each vertex in bytes.
+	 */
+	std::uint32_t stride;
+
+	/**
+	 * @brief The index of the first element in the element table.
+	 */
+	std::uint32_t firstElement;
+
+	/**
+	 * @brief The number of elements in the vertex format.
+	 */
+	std::uint32_t elementCount;
+
+	/**
+	 * @brief Reserved for future use. This is always 0.
+	 */
+	std::uint32_t reserved;
+};
+
+static_assert(sizeof(ContainerVertexStream) == 32, "Unexpected ContainerVertexStream size.");
+
+/**
+ * @brief A vertex element within the container.
+ */
+struct ContainerElement
+{
+	/**
+	 * @brief The offset of the null-terminated name within the string table.
+	 */
+	std::uint32_t nameOffset;
+
+	/**
+	 * @brief The length of the name, not including the null terminator.
+	 */
+	std::uint32_t nameLength;
+
+	/**
+	 * @brief The offset in bytes from the start of the vertex to this element.
+	 */
+	std::uint32_t offset;
+
+	/**
+	 * @brief The layout of the element.
+	 */
+	ElementLayout layout;
+
+	/**
+	 * @brief The type of the element.
+	 */
+	ElementType type;
+
+	/**
+	 * @brief Reserved for future use. This is always 0.
+	 */
+	std::uint16_t reserved;
+
+	/**
+	 * @brief The minimum value of the element, before any transforms were applied.
+	 */
+	double minValue[4];
+
+	/**
+	 * @brief The maximum value of the element, before any transforms were applied.
+	 */
+	double maxValue[4];
+};
+
+static_assert(sizeof(ContainerElement) == 80, "Unexpected ContainerElement size.");
+
+/**
+ * @brief An index buffer within the container.
+ */
+struct ContainerIndexBuffer
+{
+	/**
+	 * @brief The offset in bytes from the start of the container to the index data.
+	 */
+	std::uint64_t dataOffset;
+
+	/**
+	 * @brief The size of the index data in bytes.
+	 */
+	std::uint64_t dataSize;
+
+	/**
+	 * @brief The number of indices.
+	 */
+	std::uint32_t count;
+
+	/**
+	 * @brief The base vertex to add to each index value.
+	 */
+	std::int32_t baseVertex;
+};
+
+static_assert(sizeof(ContainerIndexBuffer) == 24, "Unexpected ContainerIndexBuffer size.");
+
+/**
+ * @brief Class to write the converted data to a container.
+ *
+ * The vertex streams and index buffers are referenced by pointer, and must remain valid until the
+ * container is written.
+ */
+class VFC_EXPORT ContainerWriter
+{
+public:
+	/**
+	 * @brief Constructs the container writer.
+	 * @param vertexCount The number of vertices in each vertex stream.
+	 * @param indexType The type of the indices.
+	 * @param primitiveType The type of the primitive.
+	 * @param patchPoints The number of patch points when primitiveType is PatchList.
+	 * @param sectionAlignment The alignment of each data section. This must be a power of two.
+	 */
+	ContainerWriter(std::uint32_t vertexCount, IndexType indexType,
+		PrimitiveType primitiveType, unsigned int patchPoints = 0,
+		std::uint32_t sectionAlignment = defaultContainerAlignment);
+
+	/**
+	 * @brief Adds a vertex stream.
+	 * @param vertexFormat The vertex format.
+	 * @param minValues The minimum value for each element in the vertex format.
+	 * @param maxValues The maximum value for each element in the vertex format.
+	 * @param data The vertex data.
+	 * @param size The size of the vertex data in bytes.
+	 */
+	void addVertexStream(const VertexFormat& vertexFormat, const VertexValue* minValues,
+		const VertexValue* maxValues, const void* data, std::size_t size);
+
+	/**
+	 * @brief Adds an index buffer.
+	 * @param indexData The index data. The type must match the index type of the container.
+	 */
+	void addIndexBuffer(const IndexData& indexData);
+
+	/**
+	 * @brief Gets the size of the container.
+	 * @return The size in bytes.
+	 */
+	std::size_t getSize() const;
+
+	/**
+	 * @brief Writes the container.
+	 * @param[out] outData The data to write to. This must be at least getSize() bytes.
+	 * @param size The size of outData in bytes.
+	 * @return False if the size is too small or the data is invalid.
+	 */
+	bool write(void* outData, std::size_t size) const;
+
+private:
+	struct VertexStream
+	{
+		const VertexFormat* vertexFormat;
+		const VertexValue* minValues;
+		const VertexValue* maxValues;
+		const void* data;
+		std::size_t size;
+	};
+
+	std::uint64_t getHeaderSize() const;
+	std::uint64_t alignSize(std::uint64_t size) const;
+	std::uint64_t writeSection(std::uint8_t* data, std::uint64_t offset, const void* sectionData,
+		std::uint64_t size) const;
+
+	std::uint32_t m_vertexCount;
+	IndexType m_indexType;
+	PrimitiveType m_primitiveType;
+	unsigned int m_patchPoints;
+	std::uint32_t m_sectionAlignment;
+	std::vector<VertexStream> m_vertexStreams;
+	std::vector<IndexData> m_indexBuffers;
+};
+
+/**
+ * @brief Class to read a container.
+ *
+ * The container is validated when opened, after which the tables and data are accessed in place.
+ * The container data should be aligned to the section alignment, for example by memory-mapping
+ * the file, so the data for each section is aligned in memory.
+ */
+class VFC_EXPORT ContainerReader
+{
+public:
+	/**
+	 * @brief Opens a container.
+	 * @param data The container data. This must remain valid while the reader is used.
+	 * @param size The size of the data in bytes.
+	 * @return False if the data isn't a valid container.
+	 */
+	bool open(const void* data, std::size_t size);
+
+	/**
+	 * @brief Gets the header for the container.
+	 * @return The header, or nullptr if a container isn't open.
+	 */
+	const ContainerHeader* getHeader() const
+	{
+		return m_header;
+	}
+
+	/**
+	 * @brief Gets the number of vertices in each vertex stream.
+	 * @return The vertex count.
+	 */
+	std::uint32_t getVertexCount() const
+	{
+		return m_header ? m_header->vertexCount : 0;
+	}
+
+	/**
+	 * @brief Gets the type of the indices.
+	 * @return The index type.
+	 */
+	IndexType getIndexType() const
+	{
+		return m_header ? m_header->indexType : IndexType::NoIndices;
+	}
+
+	/**
+	 * @brief Gets the type of the primitive.
+	 * @return The primitive type.
+	 */
+	PrimitiveType getPrimitiveType() const
+	{
+		return m_header ? m_header->primitiveType : PrimitiveType::Invalid;
+	}
+
+	/**
+	 * @brief Gets the number of patch points.
+	 * @return The patch points.
+	 */
+	unsigned int getPatchPoints() const
+	{
+		return m_header ? m_header->patchPoints : 0;
+	}
+
+	/**
+	 * @brief Gets the vertex formats for each vertex stream.
+	 * @return The vertex formats.
+	 */
+	const std::vector<VertexFormat>& getVertexFormat() const
+	{
+		return m_vertexFormat;
+	}
+
+	/**
+	 * @brief Gets the bounds for a vertex element.
+	 * @param[out] outMin The minimum value for the bounds.
+	 * @param[out] outMax The maximum value for the bounds.
+	 * @param stream The index of the vertex stream.
+	 * @param element The index of the vertex element within the vertex stream.
+	 */
+	void getVertexElementBounds(VertexValue& outMin, VertexValue& outMax, std::size_t stream,
+		std::size_t element) const;
+
+	/**
+	 * @brief Gets the data for a vertex stream.
+	 * @param stream The index of the vertex stream.
+	 * @return The vertex data.
+	 */
+	const void* getVertexData(std::size_t stream) const;
+
+	/**
+	 * @brief Gets the size of the data for a vertex stream.
+	 * @param stream The index of the vertex stream.
+	 * @return The size in bytes.
+	 */
+	std::size_t getVertexDataSize(std::size_t stream) const;
+
+	/**
+	 * @brief Gets the index buffers.
+	 * @return The index data for each index buffer.
+	 */
+	const std::vector<IndexData>& getIndices() const
+	{
+		return m_indexData;
+	}
+
+private:
+	bool validate(std::size_t size);
+
+	const std::uint8_t* m_data = nullptr;
+	const ContainerHeader* m_header = nullptr;
+	const ContainerVertexStream* m_vertexStreams = nullptr;
+	const ContainerElement* m_elements = nullptr;
+	std::vector<VertexFormat> m_vertexFormat;
+	std::vector<IndexData> m_indexData;
+};
+
+} // namespace vfc
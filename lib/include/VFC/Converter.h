@@ -1,5 +1,5 @@
 /*
- * Copyright 2020-2021 Aaron Barany
+ * Copyright 2020-2026 Aaron Barany
  *
  * Licensed under the Apache License, Version 2.0 (the "License");
  * you may not use this file except in compliance with the License.
@@ -23,6 +23,7 @@
 #include <VFC/VertexValue.h>
 #include <cstdint>
 #include <functional>
+#include <future>
 #include <vector>
 
 namespace vfc
@@ -54,12 +55,150 @@ public:
 		SNormToUNorm  ///< Converts a value in the range [-1, 1] to the range [0, 1].
 	};
 
+	/**
+	 * @brief Enum for how to reserve memory for the converted vertices.
+	 *
+	 * Index data is always reserved for the number of input indices.
+	 */
+	enum class ReservePolicy
+	{
+		None,             ///< Don't reserve memory, growing the vertices as they're added.
+		/**
+		 * Reserves the largest vertex count of the input vertex streams. This is exact for a
+		 * single vertex stream without duplicate vertices.
+		 */
+		InputVertexCount,
+		/**
+		 * Estimates the number of unique vertices based on the indices of the vertex streams. This
+		 * requires an extra pass over the indices, but avoids repeated re-allocations when vertex
+		 * streams have independent indices.
+		 */
+		Estimate
+	};
+
+	/**
+	 * @brief Enum for the type of an output buffer.
+	 */
+	enum class OutputBufferType
+	{
+		Vertices, ///< Vertex data for a vertex stream.
+		Indices   ///< Index data for an index buffer.
+	};
+
+	/**
+	 * @brief Struct containing statistics for a conversion.
+	 *
+	 * Times are the wall time in seconds for each phase of convert(). Timing the encode and dedup
+	 * phases requires timing each vertex, so requesting stats adds some overhead to the conversion.
+	 */
+	struct Stats
+	{
+		/**
+		 * @brief The time to validate the vertex elements and set up welding.
+		 */
+		double validateTime = 0;
+
+		/**
+		 * @brief The time to compute the bounds of the input elements. This includes checking the
+		 *     input index values are in range. The bounds are computed when each vertex stream is
+		 *     added, so this only includes the time to wait for background validation when
+		 *     enabled.
+		 */
+		double boundsTime = 0;
+
+		/**
+		 * @brief The time to estimate the vertex count and reserve memory.
+		 */
+		double reserveTime = 0;
+
+		/**
+		 * @brief The time to read and encode the vertex elements into the output formats.
+		 */
+		double encodeTime = 0;
+
+		/**
+		 * @brief The time to find duplicate vertices and add the vertices and indices.
+		 */
+		double dedupTime = 0;
+
+		/**
+		 * @brief The time to start new index buffers, including copying the vertices carried over
+		 *     from the previous index buffer.
+		 */
+		double carryOverTime = 0;
+
+		/**
+		 * @brief The time to split the staged vertices into the output vertex streams.
+		 */
+		double splitStreamsTime = 0;
+
+		/**
+		 * @brief The total time for convert().
+		 */
+		double totalTime = 0;
+
+		/**
+		 * @brief The number of full vertex comparisons made by the hash table used to de-duplicate
+		 *     vertices, including vertices carried over between index buffers.
+		 *
+		 * Each duplicate vertex requires a comparison, so comparisons beyond dedupHits are from
+		 * hash collisions.
+		 */
+		std::uint64_t hashProbes = 0;
+
+		/**
+		 * @brief The number of vertices that were replaced with a previous vertex, either as an
+		 *     exact duplicate or with welding.
+		 */
+		std::uint64_t dedupHits = 0;
+
+		/**
+		 * @brief The number of unique vertices added, not including carried over vertices.
+		 */
+		std::uint64_t uniqueVertices = 0;
+
+		/**
+		 * @brief The number of vertices copied to new index buffers.
+		 */
+		std::uint64_t carriedOverVertices = 0;
+
+		/**
+		 * @brief The number of index buffers output.
+		 */
+		std::uint64_t indexBuffers = 0;
+
+		/**
+		 * @brief The peak number of bytes allocated for vertices, including the staged vertices.
+		 */
+		std::uint64_t peakVertexBytes = 0;
+
+		/**
+		 * @brief The peak number of bytes allocated for indices.
+		 */
+		std::uint64_t peakIndexBytes = 0;
+	};
+
 	/**
 	 * @brief Type for a function to handle errors.
 	 * @param message The message to log.
 	 */
 	using ErrorFunction = std::function<void(const char* message)>;
 
+	/**
+	 * @brief Type for a function to provide the buffer to write converted data to.
+	 *
+	 * This can be used to write the converted data directly to its destination, such as a memory
+	 * mapped file, rather than keeping a copy in the converter.
+	 *
+	 * @param type The type of the buffer.
+	 * @param index The index of the vertex stream for vertices or the index buffer for indices.
+	 * @param size The size of the data in bytes.
+	 * @return The buffer to write to, which must be at least size bytes. Returning nullptr will
+	 *     cause the conversion to fail, unless size is 0.
+	 */
+	using OutputBufferFunction =
+		std::function<void*(OutputBufferType type, std::size_t index, std::size_t size)>;
+
 	/**
 	 * @brief Error function that prints the message to stderr.
 	 * @param message The message to log.
@@ -136,12 +275,20 @@ public:
 
 	/**
 	 * @brief Move constructor.
+	 *
+	 * Background validation that's still in progress is moved with the vertex streams, since it
+	 * doesn't refer to the converter.
+	 *
 	 * @param other The other instance to move.
 	 */
 	Converter(Converter&& other) = default;
 
 	/**
 	 * @brief Move assignment.
+	 *
+	 * Background validation that's still in progress is moved with the vertex streams. This waits
+	 * for any background validation of the vertex streams that are replaced.
+	 *
 	 * @param other The other instance to move.
 	 * @return A reference to this.
 	 */
@@ -165,6 +312,41 @@ public:
 		return isValid();
 	}
 
+	/**
+	 * @brief Resets the converter to convert new geometry.
+	 *
+	 * This restores the converter to the same state as if it was newly constructed, but keeps the
+	 * memory allocated by previous conversions to be re-used. The error function, reserve policy,
+	 * and output buffer function are kept. This uses the default maximum index value.
+	 *
+	 * isValid() may be checked afterward to see if the new parameters are valid.
+	 *
+	 * @param vertexFormat The vertex format to convert to. This has multiple formats used to
+	 *     populate multiple output streams.
+	 * @param indexType The index type to convert to.
+	 * @param primitiveType The primitive type for the geometry.
+	 * @param patchPoints The number of points when primitiveType is PrimitiveType::PatchList.
+	 */
+	void reset(std::vector<VertexFormat> vertexFormat, IndexType indexType,
+		PrimitiveType primitiveType, unsigned int patchPoints = 0);
+
+	/**
+	 * @brief Resets the converter to convert new geometry.
+	 *
+	 * This restores the converter to the same state as if it was newly constructed, but keeps the
+	 * memory allocated by previous conversions to be re-used. The error function, reserve policy,
+	 * and output buffer function are kept.
+	 *
+	 * @param vertexFormat The vertex format to convert to. This has multiple formats used to
+	 *     populate multiple output streams.
+	 * @param indexType The index type to convert to.
+	 * @param primitiveType The primitive type for the geometry.
+	 * @param patchPoints The number of points when primitiveType is PrimitiveType::PatchList.
+	 * @param maxIndexValue The maximum index value to use.
+	 */
+	void reset(std::vector<VertexFormat> vertexFormat, IndexType indexType,
+		PrimitiveType primitiveType, unsigned int patchPoints, std::uint32_t maxIndexValue);
+
 	/**
 	 * @brief Gets the vertex format to convert to.
 	 * @return The vertex format.
@@ -210,6 +392,90 @@ public:
 		return m_maxIndexValue;
 	}
 
+	/**
+	 * @brief Gets the policy for reserving memory for the converted vertices.
+	 * @return The reserve policy.
+	 */
+	ReservePolicy getReservePolicy() const
+	{
+		return m_reservePolicy;
+	}
+
+	/**
+	 * @brief Sets the policy for reserving memory for the converted vertices.
+	 *
+	 * The default is ReservePolicy::Estimate.
+	 *
+	 * @param policy The reserve policy.
+	 */
+	void setReservePolicy(ReservePolicy policy)
+	{
+		m_reservePolicy = policy;
+	}
+
+	/**
+	 * @brief Gets whether or not vertex streams are validated on a background task.
+	 * @return True if background validation is enabled.
+	 */
+	bool isBackgroundValidationEnabled() const
+	{
+		return m_backgroundValidation;
+	}
+
+	/**
+	 * @brief Sets whether or not vertex streams are validated on a background task.
+	 *
+	 * The index values for each vertex stream are checked and the bounds of the vertex elements
+	 * are gathered when the vertex stream is added. When enabled, this is done on a background task
+	 * so the caller may load the next vertex stream at the same time. The data for the vertex
+	 * streams must then remain valid until convert(), waitForValidation(), or reset() is called or
+	 * the converter is destroyed. The default is disabled.
+	 *
+	 * @param enabled True to validate on a background task.
+	 */
+	void setBackgroundValidationEnabled(bool enabled)
+	{
+		m_backgroundValidation = enabled;
+	}
+
+	/**
+	 * @brief Waits for the vertex streams being validated on a background task to finish.
+	 *
+	 * This should be called before freeing the data for the vertex streams when convert() isn't
+	 * called. Any errors will be reported when calling convert().
+	 */
+	void waitForValidation();
+
+	/**
+	 * @brief Gets the function to provide the buffers for the converted data.
+	 * @return The output buffer function.
+	 */
+	const OutputBufferFunction& getOutputBufferFunction() const
+	{
+		return m_outputBufferFunction;
+	}
+
+	/**
+	 * @brief Sets the function to provide the buffers for the converted data.
+	 *
+	 * When set, the indices for each index buffer are copied to the buffers returned by the
+	 * function once their sizes are known at the end of conversion, and the data pointers from
+	 * getIndices() will point to the provided buffers. The converter's own copy of the indices is
+	 * freed once copied. This must be set before calling convert().
+	 *
+	 * With multiple vertex streams, the final vertices for each stream are also copied to buffers
+	 * returned by the function and getVertices() will have an empty vector for each stream. A
+	 * single vertex stream is already in its final layout, so it's moved to getVertices() instead
+	 * and the function isn't called for vertices.
+	 *
+	 * @param function The output buffer function, or an empty function to keep the data in the
+	 *     converter.
+	 */
+	void setOutputBufferFunction(OutputBufferFunction function)
+	{
+		m_outputBufferFunction = std::move(function);
+	}
+
 	/**
 	 * @brief Gets the transform for a vertex element by index.
 	 * @param stream The index of the vertex stream. (i.e. which vertex format in the vector)
@@ -272,6 +538,127 @@ public:
 		return setElementTransform(name.c_str(), transform);
 	}
 
+	/**
+	 * @brief Gets the tolerance when welding a vertex element by index.
+	 * @param stream The index of the vertex stream. (i.e. which vertex format in the vector)
+	 * @param element The index of the vertex element within the vertex stream.
+	 * @return The weld tolerance.
+	 */
+	double getElementWeldTolerance(std::size_t stream, std::size_t element) const
+	{
+		assert(stream < m_elementMapping.size());
+		assert(element < m_elementMapping[stream].size());
+		return m_elementMapping[stream][element].weldTolerance;
+	}
+
+	/**
+	 * @brief Gets the tolerance when welding a vertex element by name.
+	 * @param name The name of the element.
+	 * @return The weld tolerance.
+	 */
+	double getElementWeldTolerance(const char* name) const;
+
+	/**
+	 * @brief Gets the tolerance when welding a vertex element by name.
+	 * @param name The name of the element.
+	 * @return The weld tolerance.
+	 */
+	double getElementWeldTolerance(const std::string& name) const
+	{
+		return getElementWeldTolerance(name.c_str());
+	}
+
+	/**
+	 * @brief Sets the tolerance when welding a vertex element by index.
+	 *
+	 * Vertices are only welded when each component of every element is within the tolerance of
+	 * the other vertex. The tolerance is applied to the input values before any transforms. The
+	 * default tolerance is 0, requiring the values to be identical.
+	 *
+	 * @param stream The index of the vertex stream. (i.e. which vertex format in the vector)
+	 * @param element The index of the vertex element within the vertex stream.
+	 * @param tolerance The weld tolerance.
+	 */
+	void setElementWeldTolerance(std::size_t stream, std::size_t element, double tolerance)
+	{
+		assert(stream < m_elementMapping.size());
+		assert(element < m_elementMapping[stream].size());
+		m_elementMapping[stream][element].weldTolerance = tolerance;
+	}
+
+	/**
+	 * @brief Sets the tolerance when welding a vertex element by name.
+	 * @param name The name of the element.
+	 * @param tolerance The weld tolerance.
+	 * @return False if the element wasn't found.
+	 */
+	bool setElementWeldTolerance(const char* name, double tolerance);
+
+	/**
+	 * @brief Sets the tolerance when welding a vertex element by name.
+	 * @param name The name of the element.
+	 * @param tolerance The weld tolerance.
+	 * @return False if the element wasn't found.
+	 */
+	bool setElementWeldTolerance(const std::string& name, double tolerance)
+	{
+		return setElementWeldTolerance(name.c_str(), tolerance);
+	}
+
+	/**
+	 * @brief Returns whether or not vertices will be welded.
+	 * @return True if a position element has been set for welding.
+	 */
+	bool isWeldingEnabled() const
+	{
+		return m_weldStream < m_elementMapping.size();
+	}
+
+	/**
+	 * @brief Sets the position element used to weld vertices by index.
+	 *
+	 * When set, vertices that aren't identical but have all elements within their weld tolerance
+	 * will be merged into a single vertex, using the values of the first vertex encountered. The
+	 * XYZ values of the position element are used to find nearby vertices, and must have a weld
+	 * tolerance greater than 0. Welding is only performed when indices are output.
+	 *
+	 * @param stream The index of the vertex stream. (i.e. which vertex format in the vector)
+	 * @param element The index of the vertex element within the vertex stream.
+	 */
+	void setWeldPositionElement(std::size_t stream, std::size_t element)
+	{
+		assert(stream < m_elementMapping.size());
+		assert(element < m_elementMapping[stream].size());
+		m_weldStream = stream;
+		m_weldElement = element;
+	}
+
+	/**
+	 * @brief Sets the position element used to weld vertices by name.
+	 * @param name The name of the element.
+	 * @return False if the element wasn't found.
+	 */
+	bool setWeldPositionElement(const char* name);
+
+	/**
+	 * @brief Sets the position element used to weld vertices by name.
+	 * @param name The name of the element.
+	 * @return False if the element wasn't found.
+	 */
+	bool setWeldPositionElement(const std::string& name)
+	{
+		return setWeldPositionElement(name.c_str());
+	}
+
+	/**
+	 * @brief Disables welding of vertices.
+	 */
+	void disableWelding()
+	{
+		m_weldStream = noWeldElement;
+		m_weldElement = noWeldElement;
+	}
+
 	/**
 	 * @brief Adds a vertex stream to convert without indices.
 	 * @param vertexFormat The vertex format.
@@ -288,6 +675,11 @@ public:
 
 	/**
 	 * @brief Adds a vertex stream to convert with indices.
+	 *
+	 * The index values are checked to be in range and the bounds for the vertex elements are
+	 * gathered immediately, or on a background task if background validation is enabled. Errors
+	 * for the index values are reported when calling convert().
+	 *
 	 * @param vertexFormat The vertex format.
 	 * @param vertexData The vertex data.
 	 * @param vertexCount The number of vertices.
@@ -302,9 +694,10 @@ public:
 
 	/**
 	 * @brief Performs the conversion from the input streams to the converted vertex and index data.
+	 * @param[out] outStats Optional statistics to fill for the conversion.
 	 * @return False if an error occurred.
 	 */
-	bool convert();
+	bool convert(Stats* outStats = nullptr);
 
 	/**
 	 * @brief Gets the converted indices.
@@ -365,8 +758,24 @@ public:
 		return getVertexElementBounds(outMin, outMax, name.c_str());
 	}
 
+	/**
+	 * @brief Gets the number of vertices that were welded during conversion.
+	 *
+	 * This counts vertices that were merged with another vertex within the weld tolerances that
+	 * wouldn't have been merged otherwise.
+	 *
+	 * @return The number of welded vertices.
+	 */
+	std::uint32_t getWeldedVertexCount() const
+	{
+		return m_weldedVertexCount;
+	}
+
 	/**
 	 * @brief Gets the converted vertices.
+	 *
+	 * The vector for each vertex stream will be empty when an output buffer function is set.
+	 *
 	 * @return The vertices as an array of bytes.
 	 */
 	const std::vector<std::vector<std::uint8_t>>& getVertices() const
@@ -380,13 +789,30 @@ public:
 	 */
 	std::uint32_t getVertexCount() const
 	{
-		if (m_vertices.empty())
-			return 0;
-		return static_cast<std::uint32_t>(m_vertices[0].size()/m_vertexFormat[0].stride());
+		return m_vertexCount;
 	}
 
 private:
+	static constexpr std::size_t noWeldElement = static_cast<std::size_t>(-1);
+
 	void logError(const char* message) const;
+	void initialize();
+	std::size_t estimateVertexCount() const;
+
+	enum class StreamError
+	{
+		None,
+		OutOfRange,
+		PrimitiveRestart
+	};
+
+	// Bounds for the elements of an input vertex stream, indexed by the input element.
+	struct StreamBounds
+	{
+		std::vector<VertexValue> minVals;
+		std::vector<VertexValue> maxVals;
+		StreamError error;
+	};
 
 	struct VertexStream
 	{
@@ -395,8 +821,15 @@ private:
 		VertexFormat vertexFormat;
 		std::uint32_t vertexCount;
 		IndexType indexType;
+		StreamBounds bounds;
+		std::future<StreamBounds> pendingBounds;
 	};
 
+	static StreamBounds gatherStreamBounds(const std::uint8_t* vertexData,
+		const void* indexData, const VertexFormat& vertexFormat, std::uint32_t vertexCount,
+		IndexType indexType, std::uint32_t indexCount, const std::vector<std::size_t>& elements,
+		PrimitiveType primitiveType, bool allowPrimitiveRestart);
+
 	struct VertexElementRef
 	{
 		std::uint32_t streamIndex;
@@ -404,6 +837,7 @@ private:
 		Transform transform;
 		VertexValue minVal;
 		VertexValue maxVal;
+		double weldTolerance;
 	};
 
 	std::vector<VertexFormat> m_vertexFormat;
@@ -412,13 +846,21 @@ private:
 	unsigned int m_patchPoints;
 	std::uint32_t m_maxIndexValue;
 	ErrorFunction m_errorFunction;
+	ReservePolicy m_reservePolicy;
+	bool m_backgroundValidation;
+	OutputBufferFunction m_outputBufferFunction;
+	std::size_t m_weldStream;
+	std::size_t m_weldElement;
 
 	std::vector<VertexStream> m_vertexStreams;
 	std::vector<std::vector<VertexElementRef>> m_elementMapping;
 	std::vector<std::vector<std::uint8_t>> m_vertices;
+	std::vector<std::uint8_t> m_stagingVertices;
 	std::vector<std::uint8_t> m_indices;
 	std::vector<IndexData> m_indexData;
 	std::uint32_t m_indexCount;
+	std::uint32_t m_vertexCount;
+	std::uint32_t m_weldedVertexCount;
 };
 
 } // namespace vfc
@@ -0,0 +1,158 @@
+/*
+ * Copyright 2026 Aaron Barany
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <VFC/Config.h>
+#include <VFC/Export.h>
+#include <VFC/IndexData.h>
+#include <VFC/VertexFormat.h>
+#include <cstdint>
+#include <vector>
+
+/**
+ * @file
+ * @brief Functions for encoding and decoding triangle index data.
+ *
+ * The encoding takes advantage of the structure of index data after the vertices have been ordered
+ * by first use, as done by Converter. Each index is typically either the next vertex that hasn't
+ * been referenced yet or a vertex that was referenced recently, and with triangle lists most
+ * triangles share an edge with a recent triangle. Each IndexData buffer is encoded separately, so
+ * the buffers for a split mesh may be decoded independently and in parallel.
+ *
+ * Encoded data starts with an EncodedIndicesHeader, followed by a code stream and a data stream.
+ * Recently referenced vertices are kept in a FIFO of 16 vertices, and triangle lists also keep a
+ * FIFO of 16 recent edges.
+ *
+ * For triangle lists there's a code byte for each triangle. When the upper 4 bits are less than
+ * 15, the triangle starts with the reversed edge at that position in the edge FIFO, and the lower 4
+ * bits are the code for the third vertex. Otherwise the lower 4 bits are the code for the first
+ * vertex and the codes for the second and third vertices are in the upper and lower 4 bits of a
+ * byte in the data stream. Vertex codes are:
+ * - 0: the next vertex, one past the largest new vertex so far.
+ * - 1-14: the vertex at that position in the vertex FIFO, starting from the most recent.
+ * - 15: an explicit vertex in the data stream.
+ *
+ * Triangle lists may have the vertices of each triangle rotated to start with a shared edge. The
+ * winding order is preserved, but the first vertex of a triangle may change. This is only
+ * significant when the first vertex is the provoking vertex for flat shading.
+ *
+ * For triangle strips there's a 4-bit code for each index, starting with the lower 4 bits of each
+ * byte. Codes 0-13 and 15 are vertex codes as above, limited to the first 13 entries of the vertex
+ * FIFO, while 14 is the primitive restart value. Triangle strips are decoded exactly.
+ *
+ * Explicit vertices are stored as the zigzag-encoded difference from the previous explicit vertex
+ * as a variable-length integer with 7 bits per byte, starting with the least significant bits.
+ * Only new and explicit vertices are added to the vertex FIFO. All values are little-endian.
+ * Decoding is fully validated, so corrupt or malicious data fails rather than reading or writing
+ * out of bounds.
+ */
+
+namespace vfc
+{
+
+/**
+ * @brief The magic number at the start of encoded index data.
+ */
+constexpr char encodedIndicesMagic[4] = {'V', 'F', 'C', 'T'};
+
+/**
+ * @brief The current version of the encoded index data format.
+ */
+constexpr std::uint8_t encodedIndicesVersion = 1;
+
+/**
+ * @brief The header at the start of encoded index data.
+ */
+struct EncodedIndicesHeader
+{
+	/**
+	 * @brief The magic number, which is always encodedIndicesMagic.
+	 */
+	char magic[4];
+
+	/**
+	 * @brief The version of the encoded index data format.
+	 */
+	std::uint8_t version;
+
+	/**
+	 * @brief The primitive type, which is either TriangleList or TriangleStrip.
+	 */
+	PrimitiveType primitiveType;
+
+	/**
+	 * @brief The type of the indices.
+	 */
+	IndexType indexType;
+
+	/**
+	 * @brief Reserved for future use. This is always 0.
+	 */
+	std::uint8_t reserved;
+
+	/**
+	 * @brief The number of indices.
+	 */
+	std::uint32_t indexCount;
+
+	/**
+	 * @brief The size of the data stream in bytes, which follows the code stream.
+	 */
+	std::uint32_t dataSize;
+};
+
+static_assert(sizeof(EncodedIndicesHeader) == 16, "Unexpected EncodedIndicesHeader size.");
+
+/**
+ * @brief Encodes triangle index data.
+ * @param[out] outData The encoded data.
+ * @param indexData The index data to encode. The base vertex isn't encoded, since it's separate
+ *     from the data for the indices.
+ * @param primitiveType The primitive type. This must be TriangleList or TriangleStrip.
+ * @return False if the parameters are invalid, such as a triangle list index count that isn't a
+ *     multiple of 3.
+ */
+VFC_EXPORT bool encodeIndices(std::vector<std::uint8_t>& outData, const IndexData& indexData,
+	PrimitiveType primitiveType);
+
+/**
+ * @brief Reads the header for encoded index data.
+ *
+ * This may be used to find the size to decode to, which is the index count multiplied by the
+ * size of the index type.
+ *
+ * @param[out] outHeader The header.
+ * @param data The encoded data.
+ * @param size The size of the encoded data in bytes.
+ * @return False if the data doesn't start with a valid header.
+ */
+VFC_EXPORT bool readEncodedIndicesHeader(EncodedIndicesHeader& outHeader, const void* data,
+	std::size_t size);
+
+/**
+ * @brief Decodes triangle index data.
+ * @param[out] outIndices The indices to decode to.
+ * @param outSize The size of outIndices in bytes. This must match the index count multiplied by
+ *     the size of the index type from the header.
+ * @param data The encoded data.
+ * @param size The size of the encoded data in bytes.
+ * @return False if the data is invalid or the size doesn't match.
+ */
+VFC_EXPORT bool decodeIndices(void* outIndices, std::size_t outSize, const void* data,
+	std::size_t size);
+
+} // namespace vfc
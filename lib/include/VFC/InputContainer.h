@@ -0,0 +1,489 @@
+/*
+ * Copyright 2026 Aaron Barany
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <VFC/Config.h>
+#include <VFC/Converter.h>
+#include <VFC/Export.h>
+#include <VFC/IndexData.h>
+#include <VFC/VertexFormat.h>
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+/**
+ * @file
+ * @brief Types and classes for the binary container that holds the input for a conversion.
+ *
+ * The input container is a single file that holds everything needed to set up a Converter: the
+ * vertex format to convert to, the index and primitive types, the element transforms, and the
+ * vertex format and data for each input vertex stream. It's the binary equivalent of the JSON
+ * config for the vfc tool, without the need to parse JSON, decode base64, or open a file for each
+ * vertex stream. All values are little-endian. The file is laid out as follows:
+ * - InputContainerHeader
+ * - InputContainerFormat for each vertex stream to convert to.
+ * - InputContainerVertexStream for each input vertex stream.
+ * - InputContainerElement for each vertex element across all vertex formats.
+ * - InputContainerTransform for each element transform.
+ * - The string table with the null-terminated names of the vertex elements and transforms.
+ * - Padding to the section alignment, then the vertex and index data for each input vertex
+ *   stream, each starting at a multiple of the section alignment.
+ *
+ * Each struct has a fixed size and is aligned to 8 bytes, so the tables may be accessed in place
+ * when the container is memory-mapped.
+ */
+
+namespace vfc
+{
+
+/**
+ * @brief The magic number at the start of an input container.
+ */
+constexpr char inputContainerMagic[4] = {'V', 'F', 'C', 'I'};
+
+/**
+ * @brief The current version of the input container format.
+ */
+constexpr std::uint32_t inputContainerVersion = 1;
+
+/**
+ * @brief The default alignment for data sections within the input container.
+ *
+ * This is large enough for any vertex element or index type.
+ */
+constexpr std::uint32_t defaultInputContainerAlignment = 16;
+
+/**
+ * @brief The header at the start of the input container.
+ */
+struct InputContainerHeader
+{
+	/**
+	 * @brief The magic number, which is always inputContainerMagic.
+	 */
+	char magic[4];
+
+	/**
+	 * @brief The version of the input container format.
+	 */
+	std::uint32_t version;
+
+	/**
+	 * @brief The size of the full container in bytes.
+	 */
+	std::uint64_t fileSize;
+
+	/**
+	 * @brief The size in bytes of the header, tables, and string table, including padding.
+	 *
+	 * This is the offset to the first data section.
+	 */
+	std::uint32_t headerSize;
+
+	/**
+	 * @brief The alignment in bytes of each data section. This is a power of two.
+	 */
+	std::uint32_t sectionAlignment;
+
+	/**
+	 * @brief The number of vertex formats to convert to.
+	 */
+	std::uint32_t vertexFormatCount;
+
+	/**
+	 * @brief The number of input vertex streams.
+	 */
+	std::uint32_t vertexStreamCount;
+
+	/**
+	 * @brief The number of vertex elements across all vertex formats.
+	 */
+	std::uint32_t elementCount;
+
+	/**
+	 * @brief The number of element transforms.
+	 */
+	std::uint32_t transformCount;
+
+	/**
+	 * @brief The size of the string table in bytes.
+	 */
+	std::uint32_t stringTableSize;
+
+	/**
+	 * @brief The type of the indices to convert to.
+	 */
+	IndexType indexType;
+
+	/**
+	 * @brief The type of the primitive.
+	 */
+	PrimitiveType primitiveType;
+
+	/**
+	 * @brief The number of patch points when primitiveType is PatchList.
+	 */
+	std::uint16_t patchPoints;
+};
+
+static_assert(sizeof(InputContainerHeader) == 48, "Unexpected InputContainerHeader size.");
+
+/**
+ * @brief A vertex format to convert to within the input container.
+ */
+struct InputContainerFormat
+{
+	/**
+	 * @brief The index of the first element in the element table.
+	 */
+	std::uint32_t firstElement;
+
+	/**
+	 * @brief The number of elements in the vertex format.
+	 */
+	std::uint32_t elementCount;
+};
+
+static_assert(sizeof(InputContainerFormat) == 8, "Unexpected InputContainerFormat size.");
+
+/**
+ * @brief An input vertex stream within the input container.
+ */
+struct InputContainerVertexStream
+{
+	/**
+	 * @brief The offset in bytes from the start of the container to the vertex data.
+	 */
+	std::uint64_t vertexDataOffset;
+
+	/**
+	 * @brief The size of the vertex data in bytes.
+	 */
+	std::uint64_t vertexDataSize;
+
+	/**
+	 * @brief The offset in bytes from the start of the container to the index data.
+	 */
+	std::uint64_t indexDataOffset;
+
+	/**
+	 * @brief The size of the index data in bytes.
+	 */
+	std::uint64_t indexDataSize;
+
+	/**
+	 * @brief The index of the first element in the element table.
+	 */
+	std::uint32_t firstElement;
+
+	/**
+	 * @brief The number of elements in the vertex format.
+	 */
+	std::uint32_t elementCount;
+
+	/**
+	 * @brief The type of the index data, or NoIndices if the vertex stream isn't indexed.
+	 */
+	IndexType indexType;
+
+	/**
+	 * @brief Reserved for future use. This is always 0.
+	 */
+	std::uint8_t reserved[7];
+};
+
+static_assert(sizeof(InputContainerVertexStream) == 48,
+	"Unexpected InputContainerVertexStream size.");
+
+/**
+ * @brief A vertex element within the input container.
+ *
+ * The offset of each element is implied by the order of the elements within the vertex format.
+ */
+struct InputContainerElement
+{
+	/**
+	 * @brief The offset of the null-terminated name within the string table.
+	 */
+	std::uint32_t nameOffset;
+
+	/**
+	 * @brief The length of the name, not including the null terminator.
+	 */
+	std::uint32_t nameLength;
+
+	/**
+	 * @brief The layout of the element.
+	 */
+	ElementLayout layout;
+
+	/**
+	 * @brief The type of the element.
+	 */
+	ElementType type;
+
+	/**
+	 * @brief Reserved for future use. This is always 0.
+	 */
+	std::uint8_t reserved[6];
+};
+
+static_assert(sizeof(InputContainerElement) == 16, "Unexpected InputContainerElement size.");
+
+/**
+ * @brief An element transform within the input container.
+ */
+struct InputContainerTransform
+{
+	/**
+	 * @brief The offset of the null-terminated element name within the string table.
+	 */
+	std::uint32_t nameOffset;
+
+	/**
+	 * @brief The length of the name, not including the null terminator.
+	 */
+	std::uint32_t nameLength;
+
+	/**
+	 * @brief The transform to apply, as the value of Converter::Transform.
+	 */
+	std::uint32_t transform;
+
+	/**
+	 * @brief Reserved for future use. This is always 0.
+	 */
+	std::uint32_t reserved;
+};
+
+static_assert(sizeof(InputContainerTransform) == 16, "Unexpected InputContainerTransform size.");
+
+/**
+ * @brief Struct describing an input vertex stream.
+ *
+ * This mirrors the parameters to Converter::addVertexStream().
+ */
+struct InputVertexStream
+{
+	/**
+	 * @brief The vertex format of the vertex data.
+	 */
+	VertexFormat vertexFormat;
+
+	/**
+	 * @brief The vertex data.
+	 */
+	const void* vertexData;
+
+	/**
+	 * @brief The number of vertices.
+	 */
+	std::uint32_t vertexCount;
+
+	/**
+	 * @brief The type of the index data.
+	 */
+	IndexType indexType;
+
+	/**
+	 * @brief The index data, or nullptr if the vertex stream isn't indexed.
+	 */
+	const void* indexData;
+
+	/**
+	 * @brief The number of indices.
+	 */
+	std::uint32_t indexCount;
+};
+
+/**
+ * @brief Class to write the input for a conversion to an input container.
+ *
+ * The vertex and index data is referenced by pointer, and must remain valid until the container
+ * is written.
+ */
+class VFC_EXPORT InputContainerWriter
+{
+public:
+	/**
+	 * @brief Constructs the input container writer.
+	 * @param vertexFormat The vertex format to convert to.
+	 * @param indexType The type of the indices to convert to.
+	 * @param primitiveType The type of the primitive.
+	 * @param patchPoints The number of patch points when primitiveType is PatchList.
+	 * @param sectionAlignment The alignment of each data section. This must be a power of two.
+	 */
+	InputContainerWriter(std::vector<VertexFormat> vertexFormat, IndexType indexType,
+		PrimitiveType primitiveType = PrimitiveType::TriangleList, unsigned int patchPoints = 0,
+		std::uint32_t sectionAlignment = defaultInputContainerAlignment);
+
+	/**
+	 * @brief Adds an input vertex stream.
+	 * @param vertexFormat The vertex format of the vertex data.
+	 * @param vertexData The vertex data.
+	 * @param vertexCount The number of vertices.
+	 * @param indexType The type of the index data.
+	 * @param indexData The index data, or nullptr if the vertex stream isn't indexed.
+	 * @param indexCount The number of indices.
+	 */
+	void addVertexStream(VertexFormat vertexFormat, const void* vertexData,
+		std::uint32_t vertexCount, IndexType indexType = IndexType::NoIndices,
+		const void* indexData = nullptr, std::uint32_t indexCount = 0);
+
+	/**
+	 * @brief Sets the transform for a vertex element.
+	 * @param name The name of the vertex element.
+	 * @param transform The transform to apply.
+	 */
+	void setElementTransform(std::string name, Converter::Transform transform);
+
+	/**
+	 * @brief Gets the size of the input container.
+	 * @return The size in bytes.
+	 */
+	std::size_t getSize() const;
+
+	/**
+	 * @brief Writes the input container.
+	 * @param[out] outData The data to write to. This must be at least getSize() bytes.
+	 * @param size The size of outData in bytes.
+	 * @return False if the size is too small or the data is invalid.
+	 */
+	bool write(void* outData, std::size_t size) const;
+
+private:
+	std::uint64_t getHeaderSize() const;
+	std::uint64_t alignSize(std::uint64_t size) const;
+
+	std::vector<VertexFormat> m_vertexFormat;
+	IndexType m_indexType;
+	PrimitiveType m_primitiveType;
+	unsigned int m_patchPoints;
+	std::uint32_t m_sectionAlignment;
+	std::vector<InputVertexStream> m_vertexStreams;
+	std::vector<std::pair<std::string, Converter::Transform>> m_transforms;
+};
+
+/**
+ * @brief Class to read an input container.
+ *
+ * The container is validated when opened. The vertex and index data for each vertex stream
+ * references the container data, which may be passed directly to the Converter.
+ */
+class VFC_EXPORT InputContainerReader
+{
+public:
+	/**
+	 * @brief Checks whether data starts with the magic number for an input container.
+	 * @param data The data to check.
+	 * @param size The size of the data in bytes.
+	 * @return True if the data is likely an input container.
+	 */
+	static bool isInputContainer(const void* data, std::size_t size);
+
+	/**
+	 * @brief Opens an input container.
+	 * @param data The container data. This must remain valid while the reader or the vertex
+	 *     stream data is used.
+	 * @param size The size of the data in bytes.
+	 * @return False if the data isn't a valid input container.
+	 */
+	bool open(const void* data, std::size_t size);
+
+	/**
+	 * @brief Gets the vertex format to convert to.
+	 * @return The vertex format.
+	 */
+	const std::vector<VertexFormat>& getVertexFormat() const
+	{
+		return m_vertexFormat;
+	}
+
+	/**
+	 * @brief Gets the type of the indices to convert to.
+	 * @return The index type.
+	 */
+	IndexType getIndexType() const
+	{
+		return m_indexType;
+	}
+
+	/**
+	 * @brief Gets the type of the primitive.
+	 * @return The primitive type.
+	 */
+	PrimitiveType getPrimitiveType() const
+	{
+		return m_primitiveType;
+	}
+
+	/**
+	 * @brief Gets the number of patch points.
+	 * @return The patch points.
+	 */
+	unsigned int getPatchPoints() const
+	{
+		return m_patchPoints;
+	}
+
+	/**
+	 * @brief Gets the input vertex streams.
+	 * @return The vertex streams.
+	 */
+	const std::vector<InputVertexStream>& getVertexStreams() const
+	{
+		return m_vertexStreams;
+	}
+
+	/**
+	 * @brief Gets the element transforms.
+	 * @return The element name and transform for each transform.
+	 */
+	const std::vector<std::pair<std::string, Converter::Transform>>& getTransforms() const
+	{
+		return m_transforms;
+	}
+
+	/**
+	 * @brief Adds the vertex streams and transforms to a converter.
+	 *
+	 * The converter should have been created with the vertex format, index type, primitive type,
+	 * and patch points from this container.
+	 *
+	 * @param converter The converter to add the vertex streams to.
+	 * @return False if the converter rejected a vertex stream or transform.
+	 */
+	bool setupConverter(Converter& converter) const;
+
+private:
+	bool readVertexFormat(VertexFormat& outVertexFormat, std::uint32_t firstElement,
+		std::uint32_t elementCount) const;
+	bool readString(std::string& outString, std::uint32_t offset, std::uint32_t length) const;
+	bool validate(std::size_t size);
+
+	const std::uint8_t* m_data = nullptr;
+	const InputContainerHeader* m_header = nullptr;
+	std::vector<VertexFormat> m_vertexFormat;
+	IndexType m_indexType = IndexType::NoIndices;
+	PrimitiveType m_primitiveType = PrimitiveType::TriangleList;
+	unsigned int m_patchPoints = 0;
+	std::vector<InputVertexStream> m_vertexStreams;
+	std::vector<std::pair<std::string, Converter::Transform>> m_transforms;
+};
+
+} // namespace vfc
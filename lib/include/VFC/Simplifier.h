@@ -0,0 +1,170 @@
+/*
+ * Copyright 2026 Aaron Barany
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <VFC/Config.h>
+#include <VFC/Converter.h>
+#include <VFC/Export.h>
+#include <VFC/IndexData.h>
+#include <VFC/VertexFormat.h>
+#include <VFC/VertexValue.h>
+#include <cstdint>
+#include <vector>
+
+namespace vfc
+{
+
+/**
+ * @brief Class to generate levels of detail for converted triangle lists.
+ *
+ * This takes the de-duplicated vertices and indices output by Converter and creates a chain of
+ * simplified index buffers that share the same vertices. Each level of detail is simplified from
+ * the previous one by collapsing edges onto one of their existing vertices, picking the
+ * collapses with the smallest quadric error for the position element first. Since vertices are
+ * never moved or created, the vertex buffer is used as-is.
+ *
+ * Vertices along the border of the mesh or an attribute seam, where neighboring triangles use
+ * different vertices at the same position, are never removed, though other vertices may be
+ * collapsed onto them. This keeps the attribute seams intact. Each index buffer is simplified
+ * independently, so the index values stay within the range of the original buffer and the base
+ * vertex stays the same. The vertices at the edges of each buffer are also kept.
+ */
+class VFC_EXPORT Simplifier
+{
+public:
+	/**
+	 * @brief Type for a function to handle errors.
+	 */
+	using ErrorFunction = Converter::ErrorFunction;
+
+	/**
+	 * @brief Constructs the simplifier.
+	 * @param errorFunction Function to report error messages.
+	 */
+	explicit Simplifier(ErrorFunction errorFunction = &Converter::stderrErrorFunction);
+
+	Simplifier(const Simplifier& other) = delete;
+	Simplifier& operator=(const Simplifier& other) = delete;
+
+	/**
+	 * @brief Move constructor.
+	 * @param other The other instance to move.
+	 */
+	Simplifier(Simplifier&& other) = default;
+
+	/**
+	 * @brief Move assignment.
+	 * @param other The other instance to move.
+	 * @return A reference to this.
+	 */
+	Simplifier& operator=(Simplifier&& other) = default;
+
+	/**
+	 * @brief Sets the transform that was applied to the position element during conversion.
+	 *
+	 * The transform is reversed when reading the positions so the errors are measured in the
+	 * original space. This is important for Converter::Transform::Bounds, where each axis may have
+	 * a different scale. Defaults to Converter::Transform::Identity.
+	 *
+	 * @param transform The transform for the position element.
+	 * @param boundsMin The minimum bounds for the position element from the converter.
+	 * @param boundsMax The maximum bounds for the position element from the converter.
+	 */
+	void setPositionTransform(Converter::Transform transform, const VertexValue& boundsMin,
+		const VertexValue& boundsMax)
+	{
+		m_positionTransform = transform;
+		m_positionMin = boundsMin;
+		m_positionMax = boundsMax;
+	}
+
+	/**
+	 * @brief Generates the levels of detail.
+	 * @param vertexFormat The vertex format of the vertex data with the position element.
+	 * @param vertexData The vertex data.
+	 * @param vertexCount The number of vertices.
+	 * @param positionName The name of the position element.
+	 * @param indices The index buffers to simplify.
+	 * @param primitiveType The primitive type. This must be PrimitiveType::TriangleList.
+	 * @param ratios The target ratio of triangles to keep for each level of detail. Each ratio
+	 *     must be in the range (0, 1] and no larger than the ratio before it. Fewer triangles may
+	 *     be kept than requested, and more when the mesh can't be simplified further.
+	 * @return False if the parameters are invalid.
+	 */
+	bool simplify(const VertexFormat& vertexFormat, const void* vertexData,
+		std::uint32_t vertexCount, const char* positionName, const std::vector<IndexData>& indices,
+		PrimitiveType primitiveType, const std::vector<double>& ratios);
+
+	/**
+	 * @brief Generates the levels of detail for the result of a converter.
+	 *
+	 * This uses the vertices and transform for the position element from the converter. An output
+	 * buffer function must not have been used for the conversion.
+	 *
+	 * @param converter The converter to use the converted vertices and indices from.
+	 * @param positionName The name of the position element.
+	 * @param ratios The target ratio of triangles to keep for each level of detail. Each ratio
+	 *     must be in the range (0, 1] and no larger than the ratio before it.
+	 * @return False if the parameters are invalid.
+	 */
+	bool simplify(const Converter& converter, const char* positionName,
+		const std::vector<double>& ratios);
+
+	/**
+	 * @brief Gets the number of levels of detail that were generated.
+	 * @return The number of levels of detail.
+	 */
+	std::size_t getLodCount() const
+	{
+		return m_lodIndices.size();
+	}
+
+	/**
+	 * @brief Gets the index buffers for a level of detail.
+	 * @param lod The index of the level of detail.
+	 * @return The index data, with an index buffer for each original index buffer.
+	 */
+	const std::vector<IndexData>& getLodIndices(std::size_t lod) const
+	{
+		return m_lodIndices[lod];
+	}
+
+	/**
+	 * @brief Gets the error for a level of detail.
+	 * @param lod The index of the level of detail.
+	 * @return The approximate distance from the original surface in the units of the position
+	 *     element.
+	 */
+	double getLodError(std::size_t lod) const
+	{
+		return m_lodErrors[lod];
+	}
+
+private:
+	void logError(const char* message) const;
+
+	ErrorFunction m_errorFunction;
+	Converter::Transform m_positionTransform;
+	VertexValue m_positionMin;
+	VertexValue m_positionMax;
+
+	std::vector<std::vector<std::uint8_t>> m_indices;
+	std::vector<std::vector<IndexData>> m_lodIndices;
+	std::vector<double> m_lodErrors;
+};
+
+} // namespace vfc
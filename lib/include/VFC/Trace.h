@@ -0,0 +1,192 @@
+/*
+ * Copyright 2026 Aaron Barany
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <VFC/Config.h>
+#include <VFC/Export.h>
+#include <chrono>
+#include <ostream>
+#include <string>
+
+/**
+ * @file
+ * @brief Functions and macros for recording a trace of the time spent in each stage.
+ *
+ * Trace spans are added with the VFC_TRACE_* macros, which are compiled out unless
+ * VFC_ENABLE_TRACING is set to 1. This is set when building with the VFC_ENABLE_TRACING CMake
+ * option. Even when compiled in, spans are only recorded between Trace::start() and Trace::stop().
+ */
+
+/**
+ * @brief Define for whether or not trace spans are compiled in.
+ */
+#ifndef VFC_ENABLE_TRACING
+#define VFC_ENABLE_TRACING 0
+#endif
+
+namespace vfc
+{
+
+/**
+ * @brief Class for recording trace events.
+ *
+ * Events are recorded from any thread and may be written out in the Chrome trace event JSON
+ * format, which can be viewed with chrome://tracing or Perfetto.
+ */
+class VFC_EXPORT Trace
+{
+public:
+	/**
+	 * @brief The clock used for trace events.
+	 */
+	using Clock = std::chrono::steady_clock;
+
+	/**
+	 * @brief Starts recording trace events.
+	 *
+	 * This clears any previously recorded events and resets the start time.
+	 */
+	static void start();
+
+	/**
+	 * @brief Stops recording trace events.
+	 *
+	 * Events that have been recorded will be kept until the next call to start().
+	 */
+	static void stop();
+
+	/**
+	 * @brief Returns whether or not trace events are being recorded.
+	 * @return True if events are recorded.
+	 */
+	static bool isEnabled();
+
+	/**
+	 * @brief Adds a complete trace event for the current thread.
+	 *
+	 * This does nothing if events aren't being recorded.
+	 *
+	 * @param name The name of the event. This must remain valid until the events are written, such
+	 *     as a string literal.
+	 * @param detail Extra detail for the event, such as a file name. This may be empty.
+	 * @param startTime The start time of the event.
+	 * @param endTime The end time of the event.
+	 */
+	static void addEvent(const char* name, std::string detail, Clock::time_point startTime,
+		Clock::time_point endTime);
+
+	/**
+	 * @brief Returns the number of recorded events.
+	 * @return The number of events.
+	 */
+	static std::size_t getEventCount();
+
+	/**
+	 * @brief Writes the recorded events in the Chrome trace event JSON format.
+	 * @param stream The stream to write to.
+	 * @return False if the events couldn't be written.
+	 */
+	static bool writeChromeTrace(std::ostream& stream);
+};
+
+/**
+ * @brief Class that records a trace event for the lifetime of the object.
+ *
+ * This is typically used through the VFC_TRACE_* macros so it may be compiled out.
+ */
+class VFC_EXPORT ScopedTrace
+{
+public:
+	/**
+	 * @brief Starts the trace event.
+	 * @param name The name of the event. This must remain valid until the events are written, such
+	 *     as a string literal.
+	 * @param detail Extra detail for the event, such as a file name.
+	 */
+	explicit ScopedTrace(const char* name, std::string detail = std::string());
+
+	ScopedTrace(const ScopedTrace&) = delete;
+	ScopedTrace& operator=(const ScopedTrace&) = delete;
+
+	/**
+	 * @brief Ends the trace event.
+	 */
+	~ScopedTrace();
+
+	/**
+	 * @brief Ends the current trace event and starts a new one.
+	 *
+	 * This is convenient for sequential phases within the same scope.
+	 *
+	 * @param name The name of the new event.
+	 * @param detail Extra detail for the new event.
+	 */
+	void next(const char* name, std::string detail = std::string());
+
+private:
+	void end();
+
+	const char* m_name;
+	std::string m_detail;
+	Trace::Clock::time_point m_startTime;
+	bool m_enabled;
+};
+
+} // namespace vfc
+
+#define VFC_TRACE_CONCAT_IMPL(x, y) x ## y
+#define VFC_TRACE_CONCAT(x, y) VFC_TRACE_CONCAT_IMPL(x, y)
+
+#if VFC_ENABLE_TRACING
+
+/**
+ * @brief Records a trace event until the end of the current scope.
+ * @param name The name of the event as a string literal.
+ */
+#define VFC_TRACE_SCOPE(name) \
+	vfc::ScopedTrace VFC_TRACE_CONCAT(vfcScopedTrace, __LINE__)(name)
+
+/**
+ * @brief Records a trace event with extra detail until the end of the current scope.
+ * @param name The name of the event as a string literal.
+ * @param detail The detail for the event as a std::string.
+ */
+#define VFC_TRACE_SCOPE_DETAIL(name, detail) \
+	vfc::ScopedTrace VFC_TRACE_CONCAT(vfcScopedTrace, __LINE__)(name, detail)
+
+/**
+ * @brief Starts a named trace event for sequential phases within the current scope.
+ * @param var The name of the variable for the phases.
+ * @param name The name of the first event as a string literal.
+ */
+#define VFC_TRACE_PHASE_BEGIN(var, name) vfc::ScopedTrace var(name)
+
+/**
+ * @brief Ends the current phase started with VFC_TRACE_PHASE_BEGIN() and starts the next.
+ * @param var The name of the variable for the phases.
+ * @param name The name of the next event as a string literal.
+ */
+#define VFC_TRACE_PHASE_NEXT(var, name) var.next(name)
+
+#else
+
+#define VFC_TRACE_SCOPE(name) static_cast<void>(0)
+#define VFC_TRACE_SCOPE_DETAIL(name, detail) static_cast<void>(0)
+#define VFC_TRACE_PHASE_BEGIN(var, name) static_cast<void>(0)
+#define VFC_TRACE_PHASE_NEXT(var, name) static_cast<void>(0)
+
+#endif
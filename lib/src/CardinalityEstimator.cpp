@@ -0,0 +1,76 @@
+/*
+ * Copyright 2026 Aaron Barany
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "CardinalityEstimator.h"
+
+#include <climits>
+#include <cmath>
+#include <cstring>
+
+namespace vfc
+{
+
+namespace
+{
+
+constexpr unsigned int hashBits = sizeof(std::size_t)*CHAR_BIT;
+
+} // namespace
+
+constexpr unsigned int CardinalityEstimator::registerBits;
+constexpr std::size_t CardinalityEstimator::registerCount;
+
+CardinalityEstimator::CardinalityEstimator()
+{
+	std::memset(m_registers, 0, sizeof(m_registers));
+}
+
+void CardinalityEstimator::add(std::size_t hash)
+{
+	// The top bits select the register, and the rank is the position of the first set bit for the
+	// remaining bits.
+	std::size_t index = hash >> (hashBits - registerBits);
+	std::size_t remaining = hash << registerBits;
+	std::uint8_t rank = 1;
+	const std::uint8_t maxRank = hashBits - registerBits + 1;
+	for (; rank < maxRank && !(remaining >> (hashBits - 1)); remaining <<= 1)
+		++rank;
+
+	if (rank > m_registers[index])
+		m_registers[index] = rank;
+}
+
+double CardinalityEstimator::estimate() const
+{
+	const double count = static_cast<double>(registerCount);
+	const double alpha = 0.7213/(1.0 + 1.079/count);
+
+	double sum = 0;
+	unsigned int zeroCount = 0;
+	for (std::uint8_t value : m_registers)
+	{
+		sum += std::ldexp(1.0, -value);
+		zeroCount += value == 0;
+	}
+
+	double estimate = alpha*count*count/sum;
+	// Use linear counting for small cardinalities, where the raw estimate is biased.
+	if (estimate <= 2.5*count && zeroCount > 0)
+		estimate = count*std::log(count/zeroCount);
+	return estimate;
+}
+
+} // namespace vfc
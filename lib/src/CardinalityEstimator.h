@@ -0,0 +1,45 @@
+/*
+ * Copyright 2026 Aaron Barany
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <VFC/Config.h>
+
+#include <cstddef>
+#include <cstdint>
+
+namespace vfc
+{
+
+// HyperLogLog sketch to estimate the number of unique values from their hashes with a fixed amount
+// of memory. With 2^12 registers the standard error is about 1.6%.
+// http://algo.inria.fr/flajolet/Publications/FlFuGaMe07.pdf
+class CardinalityEstimator
+{
+public:
+	static constexpr unsigned int registerBits = 12;
+	static constexpr std::size_t registerCount = std::size_t(1) << registerBits;
+
+	CardinalityEstimator();
+
+	void add(std::size_t hash);
+	double estimate() const;
+
+private:
+	std::uint8_t m_registers[registerCount];
+};
+
+} // namespace vfc
@@ -0,0 +1,833 @@
+/*
+ * Copyright 2026 Aaron Barany
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <VFC/Compression.h>
+#include <VFC/Trace.h>
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+#include <limits>
+
+namespace vfc
+{
+
+namespace
+{
+
+const unsigned int symbolCount = 256;
+const unsigned int maxCodeLength = 11;
+const std::uint32_t decodeTableSize = 1U << maxCodeLength;
+// Code lengths are stored as a nibble for each symbol.
+const std::size_t codeLengthsSize = symbolCount/2;
+// Huffman planes are split into independent bit streams that are decoded in parallel.
+const unsigned int huffmanStreamCount = 4;
+
+const std::uint8_t planeCodingMask = 0x3;
+const std::uint8_t planeDeltaFlag = 0x4;
+
+enum PlaneCoding : std::uint8_t
+{
+	ConstantPlane,
+	HuffmanPlane,
+	StoredPlane
+};
+
+void write32(std::uint8_t* data, std::uint32_t value)
+{
+	for (unsigned int i = 0; i < 4; ++i)
+		data[i] = static_cast<std::uint8_t>(value >> (i*8));
+}
+
+void append32(std::vector<std::uint8_t>& data, std::uint32_t value)
+{
+	std::size_t offset = data.size();
+	data.resize(offset + sizeof(std::uint32_t));
+	write32(data.data() + offset, value);
+}
+
+inline std::uint32_t read32(const std::uint8_t* data)
+{
+	std::uint32_t value = 0;
+	for (int i = 3; i >= 0; --i)
+		value = (value << 8) | data[i];
+	return value;
+}
+
+// Written so compilers merge it into a single load on little-endian platforms.
+inline std::uint64_t read64(const std::uint8_t* data)
+{
+	return static_cast<std::uint64_t>(data[0]) | static_cast<std::uint64_t>(data[1]) << 8 |
+		static_cast<std::uint64_t>(data[2]) << 16 | static_cast<std::uint64_t>(data[3]) << 24 |
+		static_cast<std::uint64_t>(data[4]) << 32 | static_cast<std::uint64_t>(data[5]) << 40 |
+		static_cast<std::uint64_t>(data[6]) << 48 | static_cast<std::uint64_t>(data[7]) << 56;
+}
+
+std::uint32_t getBlockCount(std::uint32_t count)
+{
+	return count/compressedBlockSize + (count % compressedBlockSize != 0);
+}
+
+// Huffman tree built with the two-queue method, retrying with flattened counts until the code
+// lengths fit within maxCodeLength. At least two symbols must be used.
+void buildCodeLengths(std::uint8_t* outLengths, const std::uint32_t* counts)
+{
+	std::uint16_t symbols[symbolCount];
+	std::uint32_t curCounts[symbolCount];
+	unsigned int used = 0;
+	for (unsigned int i = 0; i < symbolCount; ++i)
+	{
+		curCounts[i] = counts[i];
+		if (counts[i] > 0)
+			symbols[used++] = static_cast<std::uint16_t>(i);
+	}
+	assert(used >= 2);
+
+	std::memset(outLengths, 0, symbolCount);
+	std::uint64_t weights[symbolCount*2];
+	std::uint16_t parents[symbolCount*2];
+	std::uint8_t depths[symbolCount*2];
+	for (;;)
+	{
+		std::sort(symbols, symbols + used,
+			[&curCounts](std::uint16_t left, std::uint16_t right)
+			{
+				return curCounts[left] < curCounts[right] ||
+					(curCounts[left] == curCounts[right] && left < right);
+			});
+
+		// Leaves are the first nodes in sorted order, followed by the internal nodes in the order
+		// they were created, which is also sorted by weight.
+		for (unsigned int i = 0; i < used; ++i)
+			weights[i] = curCounts[symbols[i]];
+
+		unsigned int nextLeaf = 0;
+		unsigned int nextInternal = used;
+		unsigned int nodeCount = used;
+		auto takeMin = [&]()
+		{
+			if (nextLeaf < used &&
+				(nextInternal == nodeCount || weights[nextLeaf] <= weights[nextInternal]))
+			{
+				return nextLeaf++;
+			}
+			return nextInternal++;
+		};
+
+		while (nodeCount < used*2 - 1)
+		{
+			unsigned int first = takeMin();
+			unsigned int second = takeMin();
+			weights[nodeCount] = weights[first] + weights[second];
+			parents[first] = parents[second] = static_cast<std::uint16_t>(nodeCount);
+			++nodeCount;
+		}
+
+		// Parents are always after their children.
+		depths[nodeCount - 1] = 0;
+		unsigned int maxDepth = 0;
+		for (unsigned int i = nodeCount - 1; i-- > 0;)
+		{
+			depths[i] = static_cast<std::uint8_t>(depths[parents[i]] + 1);
+			maxDepth = std::max(maxDepth, static_cast<unsigned int>(depths[i]));
+		}
+
+		if (maxDepth <= maxCodeLength)
+		{
+			for (unsigned int i = 0; i < used; ++i)
+				outLengths[symbols[i]] = depths[i];
+			return;
+		}
+
+		for (unsigned int i = 0; i < used; ++i)
+			curCounts[symbols[i]] = (curCounts[symbols[i]] + 1)/2;
+	}
+}
+
+// Canonical codes, with the bits reversed since the bit stream is read from the least
+// significant bit. Returns false if the lengths don't form a complete code.
+bool buildCodes(std::uint16_t* outCodes, const std::uint8_t* lengths)
+{
+	std::uint32_t lengthCounts[maxCodeLength + 1] = {};
+	std::uint32_t kraftSum = 0;
+	for (unsigned int i = 0; i < symbolCount; ++i)
+	{
+		std::uint8_t length = lengths[i];
+		if (length == 0)
+			continue;
+
+		if (length > maxCodeLength)
+			return false;
+
+		++lengthCounts[length];
+		kraftSum += decodeTableSize >> length;
+	}
+
+	if (kraftSum != decodeTableSize)
+		return false;
+
+	std::uint32_t nextCodes[maxCodeLength + 1];
+	std::uint32_t code = 0;
+	nextCodes[0] = 0;
+	for (unsigned int i = 1; i <= maxCodeLength; ++i)
+	{
+		code = (code + lengthCounts[i - 1]) << 1;
+		nextCodes[i] = code;
+	}
+
+	for (unsigned int i = 0; i < symbolCount; ++i)
+	{
+		std::uint8_t length = lengths[i];
+		if (length == 0)
+			continue;
+
+		std::uint32_t curCode = nextCodes[length]++;
+		std::uint32_t reversed = 0;
+		for (unsigned int j = 0; j < length; ++j)
+			reversed |= ((curCode >> j) & 1) << (length - 1 - j);
+		outCodes[i] = static_cast<std::uint16_t>(reversed);
+	}
+
+	return true;
+}
+
+// Each entry holds the symbol in the lower 8 bits and the code length in the upper bits.
+bool buildDecodeTable(std::uint16_t* outTable, const std::uint8_t* lengths)
+{
+	std::uint16_t codes[symbolCount];
+	if (!buildCodes(codes, lengths))
+		return false;
+
+	for (unsigned int i = 0; i < symbolCount; ++i)
+	{
+		unsigned int length = lengths[i];
+		if (length == 0)
+			continue;
+
+		auto entry = static_cast<std::uint16_t>(i | (length << 8));
+		for (std::uint32_t j = codes[i]; j < decodeTableSize; j += 1U << length)
+			outTable[j] = entry;
+	}
+
+	return true;
+}
+
+class BitWriter
+{
+public:
+	explicit BitWriter(std::vector<std::uint8_t>& data)
+		: m_data(data)
+	{
+	}
+
+	void write(std::uint32_t code, unsigned int length)
+	{
+		m_bits |= static_cast<std::uint64_t>(code) << m_bitCount;
+		m_bitCount += length;
+		if (m_bitCount >= 32)
+		{
+			append32(m_data, static_cast<std::uint32_t>(m_bits));
+			m_bits >>= 32;
+			m_bitCount -= 32;
+		}
+	}
+
+	void flush()
+	{
+		for (; m_bitCount > 0; m_bitCount -= std::min(m_bitCount, 8U))
+		{
+			m_data.push_back(static_cast<std::uint8_t>(m_bits));
+			m_bits >>= 8;
+		}
+	}
+
+private:
+	std::vector<std::uint8_t>& m_data;
+	std::uint64_t m_bits = 0;
+	unsigned int m_bitCount = 0;
+};
+
+// Symbols are split evenly between the streams, with the last stream taking what's left.
+std::size_t getStreamSymbolCount(std::size_t count)
+{
+	return (count + huffmanStreamCount - 1)/huffmanStreamCount;
+}
+
+struct PlaneEncoding
+{
+	PlaneCoding coding;
+	std::uint8_t lengths[symbolCount];
+	std::size_t size;
+};
+
+void choosePlaneEncoding(PlaneEncoding& outEncoding, const std::uint8_t* plane, std::size_t count)
+{
+	std::uint32_t counts[symbolCount] = {};
+	for (std::size_t i = 0; i < count; ++i)
+		++counts[plane[i]];
+
+	unsigned int used = 0;
+	for (unsigned int i = 0; i < symbolCount; ++i)
+		used += counts[i] > 0;
+
+	if (used == 1)
+	{
+		outEncoding.coding = ConstantPlane;
+		outEncoding.size = 1;
+		return;
+	}
+
+	buildCodeLengths(outEncoding.lengths, counts);
+	std::uint64_t bitCount = 0;
+	for (unsigned int i = 0; i < symbolCount; ++i)
+		bitCount += static_cast<std::uint64_t>(counts[i])*outEncoding.lengths[i];
+
+	// Approximate the padding for each stream.
+	std::size_t huffmanSize = codeLengthsSize + huffmanStreamCount*sizeof(std::uint32_t) +
+		static_cast<std::size_t>(bitCount/8) + huffmanStreamCount;
+	if (huffmanSize < count)
+	{
+		outEncoding.coding = HuffmanPlane;
+		outEncoding.size = huffmanSize;
+	}
+	else
+	{
+		outEncoding.coding = StoredPlane;
+		outEncoding.size = count;
+	}
+}
+
+void writePlane(std::vector<std::uint8_t>& outData, const PlaneEncoding& encoding,
+	const std::uint8_t* plane, std::size_t count, bool delta)
+{
+	outData.push_back(static_cast<std::uint8_t>(encoding.coding | (delta ? planeDeltaFlag : 0)));
+	switch (encoding.coding)
+	{
+		case ConstantPlane:
+			outData.push_back(plane[0]);
+			break;
+		case StoredPlane:
+			outData.insert(outData.end(), plane, plane + count);
+			break;
+		case HuffmanPlane:
+		{
+			const std::uint8_t* lengths = encoding.lengths;
+			for (unsigned int i = 0; i < symbolCount; i += 2)
+				outData.push_back(static_cast<std::uint8_t>(lengths[i] | (lengths[i + 1] << 4)));
+
+			std::uint16_t codes[symbolCount];
+			bool validCodes = buildCodes(codes, encoding.lengths);
+			assert(validCodes);
+			(void)validCodes;
+
+			std::size_t sizesOffset = outData.size();
+			outData.resize(sizesOffset + huffmanStreamCount*sizeof(std::uint32_t));
+			std::size_t streamSymbols = getStreamSymbolCount(count);
+			for (unsigned int i = 0; i < huffmanStreamCount; ++i)
+			{
+				std::size_t streamOffset = outData.size();
+				std::size_t begin = std::min(count, streamSymbols*i);
+				std::size_t end = std::min(count, begin + streamSymbols);
+				BitWriter writer(outData);
+				for (std::size_t j = begin; j < end; ++j)
+					writer.write(codes[plane[j]], encoding.lengths[plane[j]]);
+				writer.flush();
+				write32(outData.data() + sizesOffset + i*sizeof(std::uint32_t),
+					static_cast<std::uint32_t>(outData.size() - streamOffset));
+			}
+			break;
+		}
+	}
+}
+
+// The delta plane is only used when it's smaller than the original plane.
+void encodePlane(std::vector<std::uint8_t>& outData, const std::uint8_t* plane,
+	const std::uint8_t* deltaPlane, std::size_t count)
+{
+	PlaneEncoding encoding;
+	choosePlaneEncoding(encoding, plane, count);
+	if (deltaPlane && encoding.coding != ConstantPlane)
+	{
+		PlaneEncoding deltaEncoding;
+		choosePlaneEncoding(deltaEncoding, deltaPlane, count);
+		if (deltaEncoding.size < encoding.size)
+		{
+			writePlane(outData, deltaEncoding, deltaPlane, count, true);
+			return;
+		}
+	}
+
+	writePlane(outData, encoding, plane, count, false);
+}
+
+void startCompressedData(std::vector<std::uint8_t>& outData, CompressedDataType type,
+	std::uint32_t elementSize, std::uint32_t count)
+{
+	std::uint8_t header[sizeof(CompressedHeader)];
+	std::memcpy(header, compressedMagic, sizeof(compressedMagic));
+	header[4] = compressedVersion;
+	header[5] = static_cast<std::uint8_t>(type);
+	header[6] = static_cast<std::uint8_t>(elementSize);
+	header[7] = static_cast<std::uint8_t>(elementSize >> 8);
+	write32(header + 8, count);
+	write32(header + 12, getBlockCount(count));
+	outData.assign(header, header + sizeof(header));
+}
+
+template <typename T>
+inline T zigzagEncode(T value)
+{
+	const unsigned int signShift = sizeof(T)*8 - 1;
+	return static_cast<T>(static_cast<T>(value << 1) ^ static_cast<T>(0 - (value >> signShift)));
+}
+
+template <typename T>
+inline T zigzagDecode(T value)
+{
+	return static_cast<T>((value >> 1) ^ static_cast<T>(0 - (value & 1)));
+}
+
+template <typename T>
+void compressIndicesImpl(std::vector<std::uint8_t>& outData, const T* indices,
+	std::uint32_t indexCount)
+{
+	std::vector<T> values(std::min(indexCount, compressedBlockSize));
+	std::vector<std::uint8_t> plane(values.size());
+	for (std::uint32_t start = 0; start < indexCount; start += compressedBlockSize)
+	{
+		std::uint32_t count = std::min(indexCount - start, compressedBlockSize);
+		const T* curIndices = indices + start;
+		T prevIndex = 0;
+		for (std::uint32_t i = 0; i < count; ++i)
+		{
+			values[i] = zigzagEncode(static_cast<T>(curIndices[i] - prevIndex));
+			prevIndex = curIndices[i];
+		}
+
+		std::size_t sizeOffset = outData.size();
+		append32(outData, 0);
+		for (unsigned int byte = 0; byte < sizeof(T); ++byte)
+		{
+			for (std::uint32_t i = 0; i < count; ++i)
+				plane[i] = static_cast<std::uint8_t>(values[i] >> (byte*8));
+			encodePlane(outData, plane.data(), nullptr, count);
+		}
+
+		write32(outData.data() + sizeOffset,
+			static_cast<std::uint32_t>(outData.size() - sizeOffset - sizeof(std::uint32_t)));
+	}
+}
+
+// Bits are read 8 bytes at a time, only advancing by the whole bytes that were consumed. Near the
+// end of the data bytes are read one at a time, reading zeros past the end. The overrun is checked
+// once decoding is done.
+class BitReader
+{
+public:
+	BitReader(const std::uint8_t* data, std::size_t size)
+		: m_data(data)
+		, m_size(size)
+	{
+	}
+
+	bool canRefillFast() const
+	{
+		return m_offset + sizeof(std::uint64_t) <= m_size;
+	}
+
+	void refillFast()
+	{
+		assert(canRefillFast());
+		m_bits |= read64(m_data + m_offset) << m_bitCount;
+		m_offset += (63 - m_bitCount) >> 3;
+		m_bitCount |= 56;
+	}
+
+	void refill()
+	{
+		if (canRefillFast())
+		{
+			refillFast();
+			return;
+		}
+
+		for (; m_bitCount <= 56; m_bitCount += 8, ++m_offset)
+		{
+			if (m_offset < m_size)
+				m_bits |= static_cast<std::uint64_t>(m_data[m_offset]) << m_bitCount;
+		}
+	}
+
+	std::uint8_t decode(const std::uint16_t* table)
+	{
+		std::uint16_t entry = table[m_bits & (decodeTableSize - 1)];
+		unsigned int length = entry >> 8;
+		m_bits >>= length;
+		m_bitCount -= length;
+		return static_cast<std::uint8_t>(entry);
+	}
+
+	bool isValid() const
+	{
+		return m_offset*8 - m_bitCount <= static_cast<std::uint64_t>(m_size)*8;
+	}
+
+private:
+	const std::uint8_t* m_data;
+	std::size_t m_size;
+	std::size_t m_offset = 0;
+	std::uint64_t m_bits = 0;
+	unsigned int m_bitCount = 0;
+};
+
+// Takes the reader by value so the readers in decodeHuffman() can stay in registers.
+bool decodeHuffmanTail(std::uint8_t* outPlane, BitReader reader, std::size_t begin,
+	std::size_t end, const std::uint16_t* table)
+{
+	for (std::size_t i = begin; i < end; ++i)
+	{
+		reader.refill();
+		outPlane[i] = reader.decode(table);
+	}
+
+	return reader.isValid();
+}
+
+bool decodeHuffman(std::uint8_t* outPlane, std::size_t count, const std::uint8_t* data,
+	const std::uint32_t* streamSizes, const std::uint16_t* table)
+{
+	static_assert(huffmanStreamCount == 4, "Unexpected Huffman stream count.");
+
+	// Separate readers rather than an array so they stay in registers.
+	const std::uint8_t* streamData = data;
+	BitReader reader0(streamData, streamSizes[0]);
+	streamData += streamSizes[0];
+	BitReader reader1(streamData, streamSizes[1]);
+	streamData += streamSizes[1];
+	BitReader reader2(streamData, streamSizes[2]);
+	streamData += streamSizes[2];
+	BitReader reader3(streamData, streamSizes[3]);
+
+	std::size_t streamSymbols = getStreamSymbolCount(count);
+	std::size_t lastStreamSymbols = count - std::min(count, streamSymbols*3);
+	std::uint8_t* outPlane0 = outPlane;
+	std::uint8_t* outPlane1 = outPlane + std::min(count, streamSymbols);
+	std::uint8_t* outPlane2 = outPlane + std::min(count, streamSymbols*2);
+	std::uint8_t* outPlane3 = outPlane + std::min(count, streamSymbols*3);
+
+	// Decode the streams together while they all have symbols and data left. Each refill provides
+	// at least 56 bits, enough for 4 symbols.
+	std::size_t i = 0;
+	for (; i + 4 <= lastStreamSymbols && reader0.canRefillFast() && reader1.canRefillFast() &&
+		reader2.canRefillFast() && reader3.canRefillFast(); i += 4)
+	{
+		reader0.refillFast();
+		reader1.refillFast();
+		reader2.refillFast();
+		reader3.refillFast();
+		for (std::size_t j = i; j < i + 4; ++j)
+		{
+			outPlane0[j] = reader0.decode(table);
+			outPlane1[j] = reader1.decode(table);
+			outPlane2[j] = reader2.decode(table);
+			outPlane3[j] = reader3.decode(table);
+		}
+	}
+
+	return decodeHuffmanTail(outPlane0, reader0, i, std::min(count, streamSymbols), table) &&
+		decodeHuffmanTail(outPlane1, reader1, i, outPlane2 - outPlane1, table) &&
+		decodeHuffmanTail(outPlane2, reader2, i, outPlane3 - outPlane2, table) &&
+		decodeHuffmanTail(outPlane3, reader3, i, lastStreamSymbols, table);
+}
+
+// Decodes a plane, advancing the data pointer.
+bool decodePlane(std::uint8_t* outPlane, bool& outDelta, std::size_t count,
+	const std::uint8_t*& data, const std::uint8_t* end)
+{
+	if (data == end)
+		return false;
+
+	std::uint8_t mode = *data++;
+	if ((mode & ~(planeCodingMask | planeDeltaFlag)) != 0)
+		return false;
+
+	outDelta = (mode & planeDeltaFlag) != 0;
+	switch (mode & planeCodingMask)
+	{
+		case ConstantPlane:
+			if (data == end)
+				return false;
+			std::memset(outPlane, *data++, count);
+			return true;
+		case StoredPlane:
+			if (static_cast<std::size_t>(end - data) < count)
+				return false;
+			std::memcpy(outPlane, data, count);
+			data += count;
+			return true;
+		case HuffmanPlane:
+		{
+			if (static_cast<std::size_t>(end - data) <
+					codeLengthsSize + huffmanStreamCount*sizeof(std::uint32_t))
+			{
+				return false;
+			}
+
+			std::uint8_t lengths[symbolCount];
+			for (unsigned int i = 0; i < symbolCount; i += 2)
+			{
+				lengths[i] = static_cast<std::uint8_t>(data[i/2] & 0xF);
+				lengths[i + 1] = static_cast<std::uint8_t>(data[i/2] >> 4);
+			}
+			data += codeLengthsSize;
+
+			std::uint32_t streamSizes[huffmanStreamCount];
+			std::uint64_t totalSize = 0;
+			for (std::uint32_t& streamSize : streamSizes)
+			{
+				streamSize = read32(data);
+				data += sizeof(std::uint32_t);
+				totalSize += streamSize;
+			}
+
+			std::uint16_t table[decodeTableSize];
+			if (static_cast<std::uint64_t>(end - data) < totalSize ||
+				!buildDecodeTable(table, lengths) ||
+				!decodeHuffman(outPlane, count, data, streamSizes, table))
+			{
+				return false;
+			}
+
+			data += totalSize;
+			return true;
+		}
+		default:
+			return false;
+	}
+}
+
+bool decompressVertices(std::uint8_t* outVertices, const CompressedHeader& header,
+	const std::uint8_t* data, const std::uint8_t* end)
+{
+	std::size_t stride = header.elementSize;
+	std::vector<std::uint8_t> plane(std::min(header.count, compressedBlockSize));
+	for (std::uint32_t start = 0; start < header.count; start += compressedBlockSize)
+	{
+		std::uint32_t count = std::min(header.count - start, compressedBlockSize);
+		if (end - data < 4)
+			return false;
+
+		std::uint32_t blockSize = read32(data);
+		data += sizeof(std::uint32_t);
+		if (static_cast<std::size_t>(end - data) < blockSize)
+			return false;
+
+		const std::uint8_t* blockEnd = data + blockSize;
+		for (std::size_t byte = 0; byte < stride; ++byte)
+		{
+			bool delta;
+			if (!decodePlane(plane.data(), delta, count, data, blockEnd))
+				return false;
+
+			std::uint8_t* vertexByte = outVertices + start*stride + byte;
+			if (delta)
+			{
+				std::uint8_t value = 0;
+				for (std::uint32_t i = 0; i < count; ++i, vertexByte += stride)
+				{
+					value = static_cast<std::uint8_t>(value + plane[i]);
+					*vertexByte = value;
+				}
+			}
+			else
+			{
+				for (std::uint32_t i = 0; i < count; ++i, vertexByte += stride)
+					*vertexByte = plane[i];
+			}
+		}
+
+		if (data != blockEnd)
+			return false;
+	}
+
+	return data == end;
+}
+
+template <typename T>
+bool decompressIndices(std::uint8_t* outIndices, const CompressedHeader& header,
+	const std::uint8_t* data, const std::uint8_t* end)
+{
+	std::vector<T> values(std::min(header.count, compressedBlockSize));
+	std::vector<std::uint8_t> plane(values.size());
+	for (std::uint32_t start = 0; start < header.count; start += compressedBlockSize)
+	{
+		std::uint32_t count = std::min(header.count - start, compressedBlockSize);
+		if (end - data < 4)
+			return false;
+
+		std::uint32_t blockSize = read32(data);
+		data += sizeof(std::uint32_t);
+		if (static_cast<std::size_t>(end - data) < blockSize)
+			return false;
+
+		const std::uint8_t* blockEnd = data + blockSize;
+		std::fill(values.begin(), values.end(), T(0));
+		for (unsigned int byte = 0; byte < sizeof(T); ++byte)
+		{
+			bool delta;
+			if (!decodePlane(plane.data(), delta, count, data, blockEnd) || delta)
+				return false;
+
+			for (std::uint32_t i = 0; i < count; ++i)
+				values[i] = static_cast<T>(values[i] | (static_cast<T>(plane[i]) << (byte*8)));
+		}
+
+		if (data != blockEnd)
+			return false;
+
+		T index = 0;
+		for (std::uint32_t i = 0; i < count; ++i)
+		{
+			index = static_cast<T>(index + zigzagDecode(values[i]));
+			values[i] = index;
+		}
+		std::memcpy(outIndices + start*sizeof(T), values.data(), count*sizeof(T));
+	}
+
+	return data == end;
+}
+
+} // namespace
+
+bool compressVertices(std::vector<std::uint8_t>& outData, const void* vertices,
+	std::uint32_t vertexCount, std::uint32_t vertexStride)
+{
+	VFC_TRACE_SCOPE("compressVertices");
+	if ((!vertices && vertexCount > 0) || vertexStride == 0 ||
+		vertexStride > std::numeric_limits<std::uint16_t>::max())
+	{
+		return false;
+	}
+
+	startCompressedData(outData, CompressedDataType::Vertices, vertexStride, vertexCount);
+	auto vertexBytes = reinterpret_cast<const std::uint8_t*>(vertices);
+	std::vector<std::uint8_t> plane(std::min(vertexCount, compressedBlockSize));
+	std::vector<std::uint8_t> deltaPlane(plane.size());
+	for (std::uint32_t start = 0; start < vertexCount; start += compressedBlockSize)
+	{
+		std::uint32_t count = std::min(vertexCount - start, compressedBlockSize);
+		std::size_t sizeOffset = outData.size();
+		append32(outData, 0);
+		for (std::uint32_t byte = 0; byte < vertexStride; ++byte)
+		{
+			const std::uint8_t* vertexByte =
+				vertexBytes + static_cast<std::size_t>(start)*vertexStride + byte;
+			std::uint8_t prevValue = 0;
+			for (std::uint32_t i = 0; i < count; ++i, vertexByte += vertexStride)
+			{
+				plane[i] = *vertexByte;
+				deltaPlane[i] = static_cast<std::uint8_t>(*vertexByte - prevValue);
+				prevValue = *vertexByte;
+			}
+			encodePlane(outData, plane.data(), deltaPlane.data(), count);
+		}
+
+		write32(outData.data() + sizeOffset,
+			static_cast<std::uint32_t>(outData.size() - sizeOffset - sizeof(std::uint32_t)));
+	}
+
+	return true;
+}
+
+bool compressIndices(std::vector<std::uint8_t>& outData, const void* indices,
+	std::uint32_t indexCount, IndexType indexType)
+{
+	VFC_TRACE_SCOPE("compressIndices");
+	if (!indices && indexCount > 0)
+		return false;
+
+	switch (indexType)
+	{
+		case IndexType::UInt16:
+			startCompressedData(outData, CompressedDataType::Indices, sizeof(std::uint16_t),
+				indexCount);
+			compressIndicesImpl(outData, reinterpret_cast<const std::uint16_t*>(indices),
+				indexCount);
+			return true;
+		case IndexType::UInt32:
+			startCompressedData(outData, CompressedDataType::Indices, sizeof(std::uint32_t),
+				indexCount);
+			compressIndicesImpl(outData, reinterpret_cast<const std::uint32_t*>(indices),
+				indexCount);
+			return true;
+		default:
+			return false;
+	}
+}
+
+bool readCompressedHeader(CompressedHeader& outHeader, const void* data, std::size_t size)
+{
+	if (!data || size < sizeof(CompressedHeader))
+		return false;
+
+	auto bytes = reinterpret_cast<const std::uint8_t*>(data);
+	std::memcpy(outHeader.magic, bytes, sizeof(outHeader.magic));
+	outHeader.version = bytes[4];
+	outHeader.type = static_cast<CompressedDataType>(bytes[5]);
+	outHeader.elementSize = static_cast<std::uint16_t>(bytes[6] | (bytes[7] << 8));
+	outHeader.count = read32(bytes + 8);
+	outHeader.blockCount = read32(bytes + 12);
+
+	if (std::memcmp(outHeader.magic, compressedMagic, sizeof(compressedMagic)) != 0 ||
+		outHeader.version != compressedVersion || outHeader.elementSize == 0 ||
+		outHeader.blockCount != getBlockCount(outHeader.count))
+	{
+		return false;
+	}
+
+	switch (outHeader.type)
+	{
+		case CompressedDataType::Vertices:
+			return true;
+		case CompressedDataType::Indices:
+			return outHeader.elementSize == sizeof(std::uint16_t) ||
+				outHeader.elementSize == sizeof(std::uint32_t);
+		default:
+			return false;
+	}
+}
+
+bool decompress(void* outData, std::size_t outSize, const void* data, std::size_t size)
+{
+	VFC_TRACE_SCOPE("decompress");
+	CompressedHeader header;
+	if (!readCompressedHeader(header, data, size) ||
+		static_cast<std::uint64_t>(header.count)*header.elementSize != outSize ||
+		(!outData && outSize > 0))
+	{
+		return false;
+	}
+
+	auto outBytes = reinterpret_cast<std::uint8_t*>(outData);
+	auto begin = reinterpret_cast<const std::uint8_t*>(data) + sizeof(CompressedHeader);
+	auto end = reinterpret_cast<const std::uint8_t*>(data) + size;
+	if (header.type == CompressedDataType::Vertices)
+		return decompressVertices(outBytes, header, begin, end);
+	else if (header.elementSize == sizeof(std::uint16_t))
+		return decompressIndices<std::uint16_t>(outBytes, header, begin, end);
+	return decompressIndices<std::uint32_t>(outBytes, header, begin, end);
+}
+
+} // namespace vfc
@@ -0,0 +1,356 @@
+/*
+ * Copyright 2026 Aaron Barany
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <VFC/Container.h>
+#include <VFC/Trace.h>
+#include <cstring>
+#include <limits>
+
+namespace vfc
+{
+
+namespace
+{
+
+std::uint64_t getTablesSize(std::uint64_t vertexStreamCount, std::uint64_t elementCount,
+	std::uint64_t indexBufferCount, std::uint64_t stringTableSize)
+{
+	return sizeof(ContainerHeader) + vertexStreamCount*sizeof(ContainerVertexStream) +
+		elementCount*sizeof(ContainerElement) + indexBufferCount*sizeof(ContainerIndexBuffer) +
+		stringTableSize;
+}
+
+bool isSectionValid(std::uint64_t offset, std::uint64_t size, std::uint64_t headerSize,
+	std::uint64_t fileSize, std::uint32_t alignment)
+{
+	return offset >= headerSize && offset <= fileSize && size <= fileSize - offset &&
+		offset % alignment == 0;
+}
+
+} // namespace
+
+ContainerWriter::ContainerWriter(std::uint32_t vertexCount, IndexType indexType,
+	PrimitiveType primitiveType, unsigned int patchPoints, std::uint32_t sectionAlignment)
+	: m_vertexCount(vertexCount)
+	, m_indexType(indexType)
+	, m_primitiveType(primitiveType)
+	, m_patchPoints(patchPoints)
+	, m_sectionAlignment(sectionAlignment)
+{
+}
+
+void ContainerWriter::addVertexStream(const VertexFormat& vertexFormat,
+	const VertexValue* minValues, const VertexValue* maxValues, const void* data,
+	std::size_t size)
+{
+	m_vertexStreams.push_back(VertexStream{&vertexFormat, minValues, maxValues, data, size});
+}
+
+void ContainerWriter::addIndexBuffer(const IndexData& indexData)
+{
+	m_indexBuffers.push_back(indexData);
+}
+
+std::size_t ContainerWriter::getSize() const
+{
+	std::uint64_t size = getHeaderSize();
+	for (const VertexStream& vertexStream : m_vertexStreams)
+		size += alignSize(vertexStream.size);
+	for (const IndexData& indexData : m_indexBuffers)
+		size += alignSize(static_cast<std::uint64_t>(indexData.count)*indexSize(indexData.type));
+
+	if (size > std::numeric_limits<std::size_t>::max())
+		return 0;
+	return static_cast<std::size_t>(size);
+}
+
+bool ContainerWriter::write(void* outData, std::size_t size) const
+{
+	VFC_TRACE_SCOPE("ContainerWriter::write");
+	if (m_sectionAlignment < sizeof(std::uint64_t) ||
+		(m_sectionAlignment & (m_sectionAlignment - 1)) != 0 ||
+		m_patchPoints > std::numeric_limits<std::uint16_t>::max())
+	{
+		return false;
+	}
+
+	std::size_t fileSize = getSize();
+	std::uint64_t headerSize = getHeaderSize();
+	if (!outData || fileSize == 0 || size < fileSize ||
+		headerSize > std::numeric_limits<std::uint32_t>::max())
+	{
+		return false;
+	}
+
+	std::uint32_t elementCount = 0;
+	for (const VertexStream& vertexStream : m_vertexStreams)
+	{
+		if (vertexStream.size !=
+			static_cast<std::uint64_t>(m_vertexCount)*vertexStream.vertexFormat->stride())
+		{
+			return false;
+		}
+		elementCount += static_cast<std::uint32_t>(vertexStream.vertexFormat->size());
+	}
+
+	for (const IndexData& indexData : m_indexBuffers)
+	{
+		if (m_indexType == IndexType::NoIndices || indexData.type != m_indexType ||
+			(indexData.count > 0 && !indexData.data))
+		{
+			return false;
+		}
+	}
+
+	auto data = reinterpret_cast<std::uint8_t*>(outData);
+	// Zero the header so padding and reserved values are consistent.
+	std::memset(data, 0, static_cast<std::size_t>(headerSize));
+
+	auto header = reinterpret_cast<ContainerHeader*>(data);
+	std::memcpy(header->magic, containerMagic, sizeof(containerMagic));
+	header->version = containerVersion;
+	header->fileSize = fileSize;
+	header->headerSize = static_cast<std::uint32_t>(headerSize);
+	header->sectionAlignment = m_sectionAlignment;
+	header->vertexCount = m_vertexCount;
+	header->vertexStreamCount = static_cast<std::uint32_t>(m_vertexStreams.size());
+	header->elementCount = elementCount;
+	header->indexBufferCount = static_cast<std::uint32_t>(m_indexBuffers.size());
+	header->indexType = m_indexType;
+	header->primitiveType = m_primitiveType;
+	header->patchPoints = static_cast<std::uint16_t>(m_patchPoints);
+
+	auto vertexStreams = reinterpret_cast<ContainerVertexStream*>(header + 1);
+	auto elements = reinterpret_cast<ContainerElement*>(vertexStreams + m_vertexStreams.size());
+	auto indexBuffers = reinterpret_cast<ContainerIndexBuffer*>(elements + elementCount);
+	auto stringTable = reinterpret_cast<char*>(indexBuffers + m_indexBuffers.size());
+
+	std::uint64_t dataOffset = headerSize;
+	std::uint32_t stringTableSize = 0;
+	ContainerElement* curElement = elements;
+	for (std::size_t i = 0; i < m_vertexStreams.size(); ++i)
+	{
+		const VertexStream& vertexStream = m_vertexStreams[i];
+		const VertexFormat& vertexFormat = *vertexStream.vertexFormat;
+		ContainerVertexStream& curStream = vertexStreams[i];
+		curStream.dataOffset = dataOffset;
+		curStream.dataSize = vertexStream.size;
+		curStream.stride = vertexFormat.stride();
+		curStream.firstElement = static_cast<std::uint32_t>(curElement - elements);
+		curStream.elementCount = static_cast<std::uint32_t>(vertexFormat.size());
+
+		for (std::size_t j = 0; j < vertexFormat.size(); ++j, ++curElement)
+		{
+			const VertexElement& element = vertexFormat[j];
+			curElement->nameOffset = stringTableSize;
+			curElement->nameLength = static_cast<std::uint32_t>(element.name.size());
+			curElement->offset = element.offset;
+			curElement->layout = element.layout;
+			curElement->type = element.type;
+			for (unsigned int k = 0; k < VertexValue::count; ++k)
+			{
+				curElement->minValue[k] = vertexStream.minValues[j][k];
+				curElement->maxValue[k] = vertexStream.maxValues[j][k];
+			}
+
+			std::memcpy(stringTable + stringTableSize, element.name.c_str(),
+				element.name.size() + 1);
+			stringTableSize += static_cast<std::uint32_t>(element.name.size() + 1);
+		}
+
+		dataOffset = writeSection(data, dataOffset, vertexStream.data, vertexStream.size);
+	}
+	header->stringTableSize = stringTableSize;
+
+	for (std::size_t i = 0; i < m_indexBuffers.size(); ++i)
+	{
+		const IndexData& indexData = m_indexBuffers[i];
+		std::uint64_t dataSize = static_cast<std::uint64_t>(indexData.count)*indexSize(m_indexType);
+		ContainerIndexBuffer& curBuffer = indexBuffers[i];
+		curBuffer.dataOffset = dataOffset;
+		curBuffer.dataSize = dataSize;
+		curBuffer.count = indexData.count;
+		curBuffer.baseVertex = indexData.baseVertex;
+
+		dataOffset = writeSection(data, dataOffset, indexData.data, dataSize);
+	}
+
+	return true;
+}
+
+std::uint64_t ContainerWriter::getHeaderSize() const
+{
+	std::uint64_t elementCount = 0;
+	std::uint64_t stringTableSize = 0;
+	for (const VertexStream& vertexStream : m_vertexStreams)
+	{
+		elementCount += vertexStream.vertexFormat->size();
+		for (const VertexElement& element : *vertexStream.vertexFormat)
+			stringTableSize += element.name.size() + 1;
+	}
+
+	return alignSize(getTablesSize(m_vertexStreams.size(), elementCount, m_indexBuffers.size(),
+		stringTableSize));
+}
+
+std::uint64_t ContainerWriter::alignSize(std::uint64_t size) const
+{
+	return (size + m_sectionAlignment - 1) & ~static_cast<std::uint64_t>(m_sectionAlignment - 1);
+}
+
+std::uint64_t ContainerWriter::writeSection(std::uint8_t* data, std::uint64_t offset,
+	const void* sectionData, std::uint64_t size) const
+{
+	// Zero the padding so the contents are consistent.
+	auto sectionSize = static_cast<std::size_t>(size);
+	auto alignedSize = static_cast<std::size_t>(alignSize(size));
+	if (sectionSize > 0)
+		std::memcpy(data + offset, sectionData, sectionSize);
+	std::memset(data + offset + sectionSize, 0, alignedSize - sectionSize);
+	return offset + alignedSize;
+}
+
+bool ContainerReader::open(const void* data, std::size_t size)
+{
+	VFC_TRACE_SCOPE("ContainerReader::open");
+	m_data = reinterpret_cast<const std::uint8_t*>(data);
+	m_vertexFormat.clear();
+	m_indexData.clear();
+	if (!m_data || !validate(size))
+	{
+		m_data = nullptr;
+		m_header = nullptr;
+		m_vertexStreams = nullptr;
+		m_elements = nullptr;
+		m_vertexFormat.clear();
+		m_indexData.clear();
+		return false;
+	}
+
+	return true;
+}
+
+void ContainerReader::getVertexElementBounds(VertexValue& outMin, VertexValue& outMax,
+	std::size_t stream, std::size_t element) const
+{
+	assert(stream < m_vertexFormat.size());
+	assert(element < m_vertexFormat[stream].size());
+	const ContainerElement& curElement =
+		m_elements[m_vertexStreams[stream].firstElement + element];
+	for (unsigned int i = 0; i < VertexValue::count; ++i)
+	{
+		outMin[i] = curElement.minValue[i];
+		outMax[i] = curElement.maxValue[i];
+	}
+}
+
+const void* ContainerReader::getVertexData(std::size_t stream) const
+{
+	assert(stream < m_vertexFormat.size());
+	return m_data + m_vertexStreams[stream].dataOffset;
+}
+
+std::size_t ContainerReader::getVertexDataSize(std::size_t stream) const
+{
+	assert(stream < m_vertexFormat.size());
+	return static_cast<std::size_t>(m_vertexStreams[stream].dataSize);
+}
+
+bool ContainerReader::validate(std::size_t size)
+{
+	if (size < sizeof(ContainerHeader))
+		return false;
+
+	auto header = reinterpret_cast<const ContainerHeader*>(m_data);
+	std::uint32_t alignment = header->sectionAlignment;
+	if (std::memcmp(header->magic, containerMagic, sizeof(containerMagic)) != 0 ||
+		header->version != containerVersion || header->fileSize > size ||
+		alignment < sizeof(std::uint64_t) || (alignment & (alignment - 1)) != 0 ||
+		header->headerSize > header->fileSize ||
+		getTablesSize(header->vertexStreamCount, header->elementCount, header->indexBufferCount,
+			header->stringTableSize) > header->headerSize ||
+		header->indexType > IndexType::UInt32 ||
+		header->primitiveType < PrimitiveType::PointList ||
+		header->primitiveType > PrimitiveType::PatchList ||
+		(header->indexType == IndexType::NoIndices && header->indexBufferCount > 0))
+	{
+		return false;
+	}
+
+	auto vertexStreams = reinterpret_cast<const ContainerVertexStream*>(header + 1);
+	auto elements =
+		reinterpret_cast<const ContainerElement*>(vertexStreams + header->vertexStreamCount);
+	auto indexBuffers =
+		reinterpret_cast<const ContainerIndexBuffer*>(elements + header->elementCount);
+	auto stringTable = reinterpret_cast<const char*>(indexBuffers + header->indexBufferCount);
+
+	m_vertexFormat.resize(header->vertexStreamCount);
+	for (std::uint32_t i = 0; i < header->vertexStreamCount; ++i)
+	{
+		const ContainerVertexStream& curStream = vertexStreams[i];
+		if (curStream.firstElement > header->elementCount ||
+			curStream.elementCount > header->elementCount - curStream.firstElement ||
+			!isSectionValid(curStream.dataOffset, curStream.dataSize, header->headerSize,
+				header->fileSize, alignment) ||
+			curStream.dataSize != static_cast<std::uint64_t>(header->vertexCount)*curStream.stride)
+		{
+			return false;
+		}
+
+		// Re-construct the vertex format, which also validates the elements.
+		VertexFormat& vertexFormat = m_vertexFormat[i];
+		for (std::uint32_t j = 0; j < curStream.elementCount; ++j)
+		{
+			const ContainerElement& element = elements[curStream.firstElement + j];
+			if (element.nameOffset >= header->stringTableSize ||
+				element.nameLength >= header->stringTableSize - element.nameOffset ||
+				stringTable[element.nameOffset + element.nameLength] != 0 ||
+				element.offset != vertexFormat.stride() ||
+				vertexFormat.appendElement(std::string(stringTable + element.nameOffset,
+						element.nameLength), element.layout, element.type) !=
+					VertexFormat::AddResult::Succeeded)
+			{
+				return false;
+			}
+		}
+
+		if (vertexFormat.stride() != curStream.stride)
+			return false;
+	}
+
+	m_indexData.resize(header->indexBufferCount);
+	std::uint32_t curIndexSize = indexSize(header->indexType);
+	for (std::uint32_t i = 0; i < header->indexBufferCount; ++i)
+	{
+		const ContainerIndexBuffer& curBuffer = indexBuffers[i];
+		if (!isSectionValid(curBuffer.dataOffset, curBuffer.dataSize, header->headerSize,
+				header->fileSize, alignment) ||
+			curBuffer.dataSize != static_cast<std::uint64_t>(curBuffer.count)*curIndexSize)
+		{
+			return false;
+		}
+
+		m_indexData[i] = IndexData{m_data + curBuffer.dataOffset, header->indexType,
+			curBuffer.count, curBuffer.baseVertex};
+	}
+
+	m_header = header;
+	m_vertexStreams = vertexStreams;
+	m_elements = elements;
+	return true;
+}
+
+} // namespace vfc
@@ -1,5 +1,5 @@
 /*
- * Copyright 2020-2021 Aaron Barany
+ * Copyright 2020-2026 Aaron Barany
  *
  * Licensed under the Apache License, Version 2.0 (the "License");
  * you may not use this file except in compliance with the License.
@@ -15,12 +15,21 @@
  */
 
 #include <VFC/Converter.h>
+#include <VFC/Trace.h>
 #include <VFC/VertexValue.h>
+
+#include "CardinalityEstimator.h"
+#include "Hash.h"
+#include "VertexWelder.h"
+
 #include <algorithm>
 #include <cassert>
+#include <chrono>
 #include <cstring>
+#include <future>
 #include <iostream>
 #include <limits>
+#include <memory>
 #include <unordered_set>
 
 namespace vfc
@@ -29,159 +38,108 @@ namespace vfc
 namespace
 {
 
-constexpr std::uint32_t hashSeed = 0xc70f6907U;
-
-// MurmurHash2, with some adjustments for code clarity and alignment guarantees.
-// https://github.com/aappleby/smhasher/blob/master/src/MurmurHash2.cpp
-#if VFC_64BIT
-std::size_t murmurHash2(const std::uint8_t* data, std::uint32_t size)
+struct VertexRef
 {
-	const std::uint64_t m = 0xc6a4a7935bd1e995ULL;
-	const int r = 47;
-
-	std::uint64_t h = hashSeed ^ (size * m);
-
-	while (size >= 8)
+	VertexRef(const std::vector<std::uint8_t>& _data, std::uint32_t _stride, std::uint32_t _index)
+		: data(&_data), stride(_stride), index(_index)
 	{
-		std::uint64_t k;
-		std::memcpy(&k, data, sizeof(std::uint64_t));
-
-		k *= m;
-		k ^= k >> r;
-		k *= m;
+	}
 
-		h ^= k;
-		h *= m;
+	const std::vector<std::uint8_t>* data;
+	std::uint32_t stride;
+	std::uint32_t index;
 
-		data += 8;
-		size -= 8;
+	const std::uint8_t* vertex() const
+	{
+		return data->data() + static_cast<std::size_t>(index)*stride;
 	}
 
-	switch (size)
+	bool operator==(const VertexRef& other) const
 	{
-		case 7: h ^= std::uint64_t(data[6]) << 48;
-		case 6: h ^= std::uint64_t(data[5]) << 40;
-		case 5: h ^= std::uint64_t(data[4]) << 32;
-		case 4: h ^= std::uint64_t(data[3]) << 24;
-		case 3: h ^= std::uint64_t(data[2]) << 16;
-		case 2: h ^= std::uint64_t(data[1]) << 8;
-		case 1: h ^= std::uint64_t(data[0]);
-		h *= m;
-	};
-
-	h ^= h >> r;
-	h *= m;
-	h ^= h >> r;
+		assert(data == other.data);
+		assert(stride == other.stride);
+		return std::memcmp(vertex(), other.vertex(), stride) == 0;
+	}
 
-	return h;
-}
-#else
-inline void mmix(std::uint32_t& h, std::uint32_t k, std::uint32_t m)
-{
-	const int r = 24;
-	k *= m;
-	k ^= k >> r;
-	k *= m;
-	h *= m;
-	h ^= k;
-}
+	bool operator!=(const VertexRef& other) const
+	{
+		return !(*this == other);
+	}
+};
 
-std::size_t murmurHash2(const std::uint8_t* data, std::uint32_t size)
+struct VertexHash
 {
-	const std::uint32_t m = 0x5bd1e995;
-	std::uint32_t l = size;
-	std::uint32_t h = hashSeed;
-
-	while (size >= 4)
+	explicit VertexHash(HashFunction _function = &fixedHashAny)
+		: function(_function)
 	{
-		std::uint32_t k;
-		std::memcpy(&k, data, sizeof(std::uint32_t));
+	}
 
-		mmix(h, k, m);
+	HashFunction function;
 
-		data += 4;
-		size -= 4;
+	std::size_t operator()(const VertexRef& vertex) const
+	{
+		return function(vertex.vertex(), vertex.stride);
 	}
+};
 
-	std::uint32_t t = 0;
-	switch (size)
+// Counts the full vertex comparisons made by the hash table for the statistics.
+struct VertexEqual
+{
+	explicit VertexEqual(std::uint64_t* _compareCount = nullptr)
+		: compareCount(_compareCount)
 	{
-		case 3: t ^= data[2] << 16;
-		case 2: t ^= data[1] << 8;
-		case 1: t ^= data[0];
 	}
 
-	mmix(h, t, m);
-	mmix(h, l, m);
+	std::uint64_t* compareCount;
 
-	h ^= h >> 13;
-	h *= m;
-	h ^= h >> 15;
+	bool operator()(const VertexRef& left, const VertexRef& right) const
+	{
+		if (compareCount)
+			++*compareCount;
+		return left == right;
+	}
+};
 
-	return h;
-}
-#endif
+using VertexSet = std::unordered_set<VertexRef, VertexHash, VertexEqual>;
 
-std::size_t hashCombine(std::size_t seed, std::size_t value)
+// Accumulates the time between laps into the duration for each phase when enabled.
+class PhaseTimer
 {
-	return seed ^ (value + 0x9e3779b9 + (seed << 6) + (seed >> 2));
-}
+public:
+	using Clock = std::chrono::steady_clock;
 
-struct VertexRef
-{
-	VertexRef(const std::vector<std::vector<std::uint8_t>>& _data,
-		const std::vector<VertexFormat>& _format, std::uint32_t _index)
-		: data(&_data), format(&_format), index(_index)
+	explicit PhaseTimer(bool enabled)
+		: m_enabled(enabled)
 	{
-		assert(data->size() == format->size());
+		if (m_enabled)
+			m_start = m_last = Clock::now();
 	}
 
-	const std::vector<std::vector<std::uint8_t>>* data;
-	const std::vector<VertexFormat>* format;
-	std::uint32_t index;
-
-	bool operator==(const VertexRef& other) const
+	void lap(Clock::duration& phaseTime)
 	{
-		assert(data == other.data);
-		assert(format == other.format);
-		for (std::size_t i = 0; i < data->size(); ++i)
-		{
-			std::size_t stride = (*format)[i].stride();
-			std::size_t thisOffset = index*stride;
-			std::size_t otherOffset = other.index*stride;
-			if (std::memcmp((*data)[i].data() + thisOffset,
-					(*other.data)[i].data() + otherOffset, stride) != 0)
-			{
-				return false;
-			}
-		}
+		if (!m_enabled)
+			return;
 
-		return true;
+		Clock::time_point now = Clock::now();
+		phaseTime += now - m_last;
+		m_last = now;
 	}
 
-	bool operator!=(const VertexRef& other) const
+	Clock::duration total() const
 	{
-		return !(*this == other);
+		return m_last - m_start;
 	}
-};
-
-struct VertexHash
-{
-	std::size_t operator()(const VertexRef& vertex) const
-	{
-		std::size_t hash = 0;
-		for (std::size_t i = 0; i < vertex.data->size(); ++i)
-		{
-			std::uint32_t stride = (*vertex.format)[i].stride();
-			std::size_t offset = vertex.index*size_t(stride);
-			hash = hashCombine(hash, murmurHash2((*vertex.data)[i].data() + offset, stride));
-		}
 
-		return hash;
-	}
+private:
+	bool m_enabled;
+	Clock::time_point m_start;
+	Clock::time_point m_last;
 };
 
-using VertexSet = std::unordered_set<VertexRef, VertexHash>;
+double toSeconds(PhaseTimer::Clock::duration duration)
+{
+	return std::chrono::duration<double>(duration).count();
+}
 
 inline std::vector<VertexFormat> singleVertexFormat(VertexFormat&& baseFormat)
 {
@@ -190,60 +148,49 @@ inline std::vector<VertexFormat> singleVertexFormat(VertexFormat&& baseFormat)
 	return formatVec;
 }
 
-std::uint32_t addVertex(std::vector<std::vector<std::uint8_t>>& vertices,
-	const std::vector<VertexFormat>& vertexFormat,
-	const std::vector<std::vector<std::uint8_t>>& newVertex, VertexSet& vertexSet)
+// Vertices are staged with the data for all vertex streams contiguous for each vertex. This allows
+// the full vertex to be hashed and compared as a single key during de-duplication. The data is
+// split into the separate vertex streams once conversion is complete.
+std::uint32_t addVertex(std::vector<std::uint8_t>& vertices, std::uint32_t stride,
+	const std::vector<std::uint8_t>& newVertex, VertexSet& vertexSet)
 {
-	assert(!vertices.empty());
-#if VFC_DEBUG
-	for (std::size_t i = 0; i < vertices.size(); ++i)
-		assert(vertices[i].size() % vertexFormat[i].stride() == 0);
-#endif
+	assert(vertices.size() % stride == 0);
+	assert(newVertex.size() == stride);
 
 	// Expected that almost always adding a new vertex, so optimize for that.
-	auto index = static_cast<std::uint32_t>(vertices[0].size()/vertexFormat[0].stride());
-	for (std::size_t i = 0; i < vertices.size(); ++i)
-		vertices[i].insert(vertices[i].end(), newVertex[i].begin(), newVertex[i].end());
-	VertexRef ref(vertices, vertexFormat, index);
+	auto index = static_cast<std::uint32_t>(vertices.size()/stride);
+	vertices.insert(vertices.end(), newVertex.begin(), newVertex.end());
+	VertexRef ref(vertices, stride, index);
 	auto insertPair = vertexSet.insert(ref);
 	if (!insertPair.second)
 	{
 		assert(insertPair.first->index < ref.index);
 		// Remove the added vertex data.
-		for (std::size_t i = 0; i < vertices.size(); ++i)
-			vertices[i].resize(vertices[i].size() - vertexFormat[i].stride());
+		vertices.resize(vertices.size() - stride);
 		return insertPair.first->index;
 	}
 
 	return index;
 }
 
-std::uint32_t addVertex(std::vector<std::vector<std::uint8_t>>& vertices,
-	const std::vector<VertexFormat>& vertexFormat, std::uint32_t index, VertexSet& vertexSet)
+std::uint32_t addVertex(std::vector<std::uint8_t>& vertices, std::uint32_t stride,
+	std::uint32_t index, VertexSet& vertexSet)
 {
-	assert(!vertices.empty());
-#if VFC_DEBUG
-	for (std::size_t i = 0; i < vertices.size(); ++i)
-		assert(vertices[i].size() % vertexFormat[i].stride() == 0);
-#endif
-
-	// Expected that almost always adding a new vertex, so optimize for that.
-	auto newIndex = static_cast<std::uint32_t>(vertices[0].size()/vertexFormat[0].stride());
-	for (std::size_t i = 0; i < vertices.size(); ++i)
-	{
-		std::size_t stride = vertexFormat[i].stride();
-		std::size_t offset = index*stride;
-		vertices[i].insert(vertices[i].end(), vertices[i].begin() + offset,
-			vertices[i].begin() + offset + stride);
-	}
-	VertexRef ref(vertices, vertexFormat, newIndex);
+	assert(vertices.size() % stride == 0);
+
+	// Expected that almost always adding a new vertex, so optimize for that. The vector may be
+	// re-allocated on resize, so copy based on the offsets afterward.
+	auto newIndex = static_cast<std::uint32_t>(vertices.size()/stride);
+	vertices.resize(vertices.size() + stride);
+	std::memcpy(vertices.data() + static_cast<std::size_t>(newIndex)*stride,
+		vertices.data() + static_cast<std::size_t>(index)*stride, stride);
+	VertexRef ref(vertices, stride, newIndex);
 	auto insertPair = vertexSet.insert(ref);
 	if (!insertPair.second)
 	{
 		assert(insertPair.first->index < ref.index);
 		// Remove the added vertex data.
-		for (std::size_t i = 0; i < vertices.size(); ++i)
-			vertices.resize(vertices[i].size() - vertexFormat[i].stride());
+		vertices.resize(vertices.size() - stride);
 		return insertPair.first->index;
 	}
 
@@ -316,26 +263,32 @@ unsigned int primitiveIndexStride(PrimitiveType type, unsigned int patchPoints)
 	return 0;
 }
 
-void copyVertex(std::vector<std::vector<std::uint8_t>>& vertices,
-	const std::vector<VertexFormat>& vertexFormat, VertexSet& vertexSet,
-	std::vector<std::uint8_t>& indices, IndexType indexType, unsigned int sizeofIndex,
-	std::uint32_t baseVertex, std::uint32_t indexIndex, std::int32_t prevBaseVertex)
+template <typename T>
+void reserveAdditional(std::vector<T>& values, std::size_t count)
 {
-	std::uint32_t prevIndex = getIndexValue(indexType, indices.data(), indexIndex) + prevBaseVertex;
-	std::uint32_t newIndex = addVertex(vertices, vertexFormat, prevIndex, vertexSet);
-	addIndex(indices, indexType, sizeofIndex, newIndex - baseVertex);
+	// Keep geometric growth rather than reserving the exact size, which would cause a
+	// re-allocation for the next value added.
+	std::size_t requiredSize = values.size() + count;
+	if (values.capacity() < requiredSize)
+		values.reserve(std::max(requiredSize, values.capacity()*2));
 }
 
-void copyConnectedVertices(std::vector<std::vector<std::uint8_t>>& vertices,
-	const std::vector<VertexFormat>& vertexFormat, VertexSet& vertexSet,
+// Copies the vertices for the partial primitive at the end of the previous index buffer to the
+// start of the next one. The vertices to copy are gathered first, then the vertex and index data
+// grown once for all of them, so the copies themselves never re-allocate.
+void copyConnectedVertices(std::vector<std::uint8_t>& vertices, std::uint32_t stride,
+	VertexSet& vertexSet,
 	std::vector<std::uint8_t>& indices, IndexType indexType, unsigned int sizeofIndex,
 	std::int32_t baseVertex, PrimitiveType primitiveType, std::uint32_t lastRestartIndex,
 	std::uint32_t& prevIndexCount, std::int32_t prevBaseVertex, std::uint32_t& curIndexCount)
 {
-#if VFC_DEBUG
-	for (std::size_t i = 0; i < vertices.size(); ++i)
-		assert(static_cast<std::size_t>(baseVertex) == vertices[i].size()/vertexFormat[i].stride());
-#endif
+	assert(static_cast<std::size_t>(baseVertex) == vertices.size()/stride);
+
+	const unsigned int maxCopyCount = 3;
+	std::uint32_t copyIndices[maxCopyCount];
+	unsigned int copyCount = 0;
+	// Number of indices at the end of the previous index buffer that are copied.
+	unsigned int sourceCount = 0;
 
 	auto indexCount = static_cast<std::uint32_t>(indices.size()/sizeofIndex);
 	switch (primitiveType)
@@ -343,43 +296,31 @@ void copyConnectedVertices(std::vector<std::vector<std::uint8_t>>& vertices,
 		case PrimitiveType::LineStrip:
 			if (lastRestartIndex != indexCount - 1)
 			{
-				copyVertex(vertices, vertexFormat, vertexSet, indices, indexType, sizeofIndex,
-					baseVertex, indexCount - 1, prevBaseVertex);
-				++curIndexCount;
+				copyIndices[copyCount++] = indexCount - 1;
+				sourceCount = 1;
 			}
 			break;
 		case PrimitiveType::TriangleStrip:
 		{
 			std::uint32_t firstIndex = lastRestartIndex + 1;
-			std::uint32_t stripIndexCount = indexCount - firstIndex + 1;
-			if (stripIndexCount <= 2)
+			std::uint32_t stripIndexCount = indexCount - firstIndex;
+			if (stripIndexCount < 2)
 			{
 				for (std::uint32_t k = firstIndex; k < indexCount; ++k)
-				{
-					copyVertex(vertices, vertexFormat, vertexSet, indices, indexType, sizeofIndex,
-						baseVertex, k, prevBaseVertex);
-					++curIndexCount;
-				}
+					copyIndices[copyCount++] = k;
+				sourceCount = copyCount;
 			}
 			else
 			{
-				// Reverse every other primitive.
+				// Every other primitive is reversed, so the next primitive is reversed after an odd
+				// number of primitives. The copied vertices start a new strip, so start with a
+				// degenerate primitive to keep the winding order for the rest of the strip.
 				std::uint32_t primitiveCount = stripIndexCount - 2;
 				if (primitiveCount & 1)
-				{
-					copyVertex(vertices, vertexFormat, vertexSet, indices, indexType, sizeofIndex,
-						baseVertex, indexCount - 1, prevBaseVertex);
-					copyVertex(vertices, vertexFormat, vertexSet, indices, indexType, sizeofIndex,
-						baseVertex, indexCount - 2, prevBaseVertex);
-				}
-				else
-				{
-					copyVertex(vertices, vertexFormat, vertexSet, indices, indexType, sizeofIndex,
-						baseVertex, indexCount - 2, prevBaseVertex);
-					copyVertex(vertices, vertexFormat, vertexSet, indices, indexType, sizeofIndex,
-						baseVertex, indexCount - 1, prevBaseVertex);
-				}
-				curIndexCount += 2;
+					copyIndices[copyCount++] = indexCount - 2;
+				copyIndices[copyCount++] = indexCount - 2;
+				copyIndices[copyCount++] = indexCount - 1;
+				sourceCount = 2;
 			}
 			break;
 		}
@@ -387,31 +328,44 @@ void copyConnectedVertices(std::vector<std::vector<std::uint8_t>>& vertices,
 			if (lastRestartIndex != indexCount - 1)
 			{
 				// First vertex in the fan.
-				copyVertex(vertices, vertexFormat, vertexSet, indices, indexType, sizeofIndex,
-					baseVertex, lastRestartIndex + 1, prevBaseVertex);
-				++curIndexCount;
+				copyIndices[copyCount++] = lastRestartIndex + 1;
+				// Last point to continue for the triangle.
 				if (lastRestartIndex != indexCount - 2)
-				{
-					// Last point to continue for the triangle.
-					copyVertex(vertices, vertexFormat, vertexSet, indices, indexType, sizeofIndex,
-						baseVertex, indexCount - 1, prevBaseVertex);
-					++curIndexCount;
-				}
+					copyIndices[copyCount++] = indexCount - 1;
+				sourceCount = copyCount;
 			}
 			break;
 		default:
 			break;
 	}
 
+	assert(copyCount <= maxCopyCount);
+	if (copyCount == 0)
+		return;
+
+	// Read the source vertices before any indices are added.
+	for (unsigned int i = 0; i < copyCount; ++i)
+		copyIndices[i] = getIndexValue(indexType, indices.data(), copyIndices[i]) + prevBaseVertex;
+
+	reserveAdditional(vertices, copyCount*stride);
+	reserveAdditional(indices, copyCount*sizeofIndex);
+	for (unsigned int i = 0; i < copyCount; ++i)
+	{
+		std::uint32_t newIndex = addVertex(vertices, stride, copyIndices[i], vertexSet);
+		addIndex(indices, indexType, sizeofIndex, newIndex - baseVertex);
+	}
+	curIndexCount += copyCount;
+
 	// If we had to copy all of the vertices since the last restart, there wasn't a full primitive
 	// and the number of indices for the last index buffer must be reduced.
-	auto addedIndices = static_cast<std::uint32_t>(indices.size()/sizeofIndex) - indexCount;
-	if (lastRestartIndex + 1 == indexCount - addedIndices)
-		prevIndexCount -= addedIndices;
+	if (lastRestartIndex + 1 == indexCount - sourceCount)
+		prevIndexCount -= sourceCount;
 }
 
 } // namespace
 
+constexpr std::size_t Converter::noWeldElement;
+
 void Converter::stderrErrorFunction(const char* message)
 {
 	std::cerr << message << std::endl;
@@ -447,7 +401,56 @@ Converter::Converter(std::vector<VertexFormat> vertexFormat, IndexType indexType
 	, m_patchPoints(patchPoints)
 	, m_maxIndexValue(maxIndexValue)
 	, m_errorFunction(std::move(errorFunction))
+	, m_reservePolicy(ReservePolicy::Estimate)
+	, m_backgroundValidation(false)
+	, m_weldStream(noWeldElement)
+	, m_weldElement(noWeldElement)
 	, m_indexCount(0)
+	, m_vertexCount(0)
+	, m_weldedVertexCount(0)
+{
+	initialize();
+}
+
+void Converter::reset(std::vector<VertexFormat> vertexFormat, IndexType indexType,
+	PrimitiveType primitiveType, unsigned int patchPoints)
+{
+	reset(std::move(vertexFormat), indexType, primitiveType, patchPoints,
+		maxIndexValue(indexType));
+}
+
+void Converter::reset(std::vector<VertexFormat> vertexFormat, IndexType indexType,
+	PrimitiveType primitiveType, unsigned int patchPoints, std::uint32_t maxIndexValue)
+{
+	m_vertexFormat = std::move(vertexFormat);
+	m_indexType = indexType;
+	m_primitiveType = primitiveType;
+	m_patchPoints = patchPoints;
+	m_maxIndexValue = maxIndexValue;
+	m_weldStream = noWeldElement;
+	m_weldElement = noWeldElement;
+
+	// Keep the largest vertex buffer from the previous conversion to stage the next vertices. The
+	// index memory is kept as-is.
+	for (std::vector<std::uint8_t>& curVertices : m_vertices)
+	{
+		if (curVertices.capacity() > m_stagingVertices.capacity())
+			m_stagingVertices.swap(curVertices);
+	}
+	m_stagingVertices.clear();
+
+	m_vertexStreams.clear();
+	m_elementMapping.clear();
+	m_vertices.clear();
+	m_indices.clear();
+	m_indexData.clear();
+	m_indexCount = 0;
+	m_vertexCount = 0;
+	m_weldedVertexCount = 0;
+	initialize();
+}
+
+void Converter::initialize()
 {
 	bool error = false;
 	if (m_vertexFormat.empty())
@@ -477,14 +480,14 @@ Converter::Converter(std::vector<VertexFormat> vertexFormat, IndexType indexType
 		error = true;
 	}
 
-	if (indexType != IndexType::NoIndices)
+	if (m_indexType != IndexType::NoIndices)
 	{
-		if (m_maxIndexValue < primitiveMinIndexCount(primitiveType, patchPoints) - 1)
+		if (m_maxIndexValue < primitiveMinIndexCount(m_primitiveType, m_patchPoints) - 1)
 		{
 			logError("Max index value is too small to hold any primitives.");
 			error = true;
 		}
-		else if (m_maxIndexValue > primitiveRestartIndexValue(indexType))
+		else if (m_maxIndexValue > primitiveRestartIndexValue(m_indexType))
 		{
 			logError("Max index value is higher than the maximum for the type.");
 			error = true;
@@ -499,7 +502,8 @@ Converter::Converter(std::vector<VertexFormat> vertexFormat, IndexType indexType
 		for (std::size_t i = 0; i < m_vertexFormat.size(); ++i)
 		{
 			m_elementMapping.emplace_back(m_vertexFormat[i].size(), VertexElementRef{0, nullptr,
-				Transform::Identity, VertexValue::initialBoundsMin, VertexValue::initialBoundsMax});
+				Transform::Identity, VertexValue::initialBoundsMin, VertexValue::initialBoundsMax,
+				0.0});
 		}
 	}
 }
@@ -508,6 +512,7 @@ bool Converter::addVertexStream(VertexFormat vertexFormat, const void* vertexDat
 	std::uint32_t vertexCount, IndexType indexType, const void* indexData,
 	std::uint32_t indexCount)
 {
+	VFC_TRACE_SCOPE("Converter::addVertexStream");
 	bool hasIndices = indexType != IndexType::NoIndices;
 	if (!vertexData || (hasIndices && !indexData))
 	{
@@ -565,6 +570,7 @@ bool Converter::addVertexStream(VertexFormat vertexFormat, const void* vertexDat
 		return true;
 
 	auto streamIndex = static_cast<std::uint32_t>(m_vertexStreams.size());
+	std::vector<std::size_t> elements;
 	for (std::size_t i = 0; i < m_vertexFormat.size(); ++i)
 	{
 		const VertexFormat& curFormat = m_vertexFormat[i];
@@ -577,14 +583,88 @@ bool Converter::addVertexStream(VertexFormat vertexFormat, const void* vertexDat
 
 			curElementMapping[j].streamIndex = streamIndex;
 			curElementMapping[j].element = &*it;
+			elements.push_back(static_cast<std::size_t>(it - vertexFormat.begin()));
 		}
 	}
 
-	m_vertexStreams.push_back(VertexStream{reinterpret_cast<const std::uint8_t*>(vertexData),
-		indexData, std::move(vertexFormat), vertexCount, indexType});
+	// Only the elements that are used are read for the bounds. The arguments are copied for the
+	// background task so they stay valid as more vertex streams are added.
+	auto vertices = reinterpret_cast<const std::uint8_t*>(vertexData);
+	bool allowPrimitiveRestart = m_indexType != IndexType::NoIndices;
+	StreamBounds bounds = {{}, {}, StreamError::None};
+	std::future<StreamBounds> pendingBounds;
+	if (m_backgroundValidation)
+	{
+		pendingBounds = std::async(std::launch::async | std::launch::deferred,
+			&Converter::gatherStreamBounds, vertices, indexData, vertexFormat, vertexCount,
+			indexType, finalIndexCount, std::move(elements), m_primitiveType,
+			allowPrimitiveRestart);
+	}
+	else
+	{
+		bounds = gatherStreamBounds(vertices, indexData, vertexFormat, vertexCount, indexType,
+			finalIndexCount, elements, m_primitiveType, allowPrimitiveRestart);
+	}
+
+	m_vertexStreams.push_back(VertexStream{vertices, indexData, std::move(vertexFormat),
+		vertexCount, indexType, std::move(bounds), std::move(pendingBounds)});
 	return true;
 }
 
+void Converter::waitForValidation()
+{
+	for (VertexStream& stream : m_vertexStreams)
+	{
+		if (stream.pendingBounds.valid())
+			stream.bounds = stream.pendingBounds.get();
+	}
+}
+
+Converter::StreamBounds Converter::gatherStreamBounds(const std::uint8_t* vertexData,
+	const void* indexData, const VertexFormat& vertexFormat, std::uint32_t vertexCount,
+	IndexType indexType, std::uint32_t indexCount, const std::vector<std::size_t>& elements,
+	PrimitiveType primitiveType, bool allowPrimitiveRestart)
+{
+	VFC_TRACE_SCOPE("Converter::gatherStreamBounds");
+	StreamBounds bounds = {std::vector<VertexValue>(vertexFormat.size(),
+		VertexValue::initialBoundsMin), std::vector<VertexValue>(vertexFormat.size(),
+		VertexValue::initialBoundsMax), StreamError::None};
+
+	// Read each index once for all of the elements.
+	std::size_t stride = vertexFormat.stride();
+	std::uint32_t primitiveRestart = primitiveRestartIndexValue(indexType);
+	for (std::uint32_t i = 0; i < indexCount; ++i)
+	{
+		std::uint32_t indexValue = getIndexValue(indexType, indexData, i, i);
+		if (isPrimitiveRestart(indexValue, primitiveRestart, primitiveType))
+		{
+			if (!allowPrimitiveRestart)
+			{
+				bounds.error = StreamError::PrimitiveRestart;
+				break;
+			}
+			continue;
+		}
+
+		if (indexValue >= vertexCount)
+		{
+			bounds.error = StreamError::OutOfRange;
+			break;
+		}
+
+		const std::uint8_t* vertex = vertexData + static_cast<std::size_t>(indexValue)*stride;
+		for (std::size_t element : elements)
+		{
+			const VertexElement& curElement = vertexFormat[element];
+			VertexValue value;
+			value.fromData(vertex + curElement.offset, curElement.layout, curElement.type);
+			value.expandBounds(bounds.minVals[element], bounds.maxVals[element]);
+		}
+	}
+
+	return bounds;
+}
+
 Converter::Transform Converter::getElementTransform(const char* name) const
 {
 	for (std::size_t i = 0; i < m_vertexFormat.size(); ++i)
@@ -614,13 +694,120 @@ bool Converter::setElementTransform(const char* name, Transform transform)
 	return false;
 }
 
+double Converter::getElementWeldTolerance(const char* name) const
+{
+	for (std::size_t i = 0; i < m_vertexFormat.size(); ++i)
+	{
+		const VertexFormat& curFormat = m_vertexFormat[i];
+		auto foundElement = curFormat.find(name);
+		if (foundElement != curFormat.end())
+			return m_elementMapping[i][foundElement - curFormat.begin()].weldTolerance;
+	}
+
+	return 0.0;
+}
+
+bool Converter::setElementWeldTolerance(const char* name, double tolerance)
+{
+	for (std::size_t i = 0; i < m_vertexFormat.size(); ++i)
+	{
+		const VertexFormat& curFormat = m_vertexFormat[i];
+		auto foundElement = curFormat.find(name);
+		if (foundElement == curFormat.end())
+			continue;
+
+		m_elementMapping[i][foundElement - curFormat.begin()].weldTolerance = tolerance;
+		return true;
+	}
+
+	return false;
+}
+
+bool Converter::setWeldPositionElement(const char* name)
+{
+	for (std::size_t i = 0; i < m_vertexFormat.size(); ++i)
+	{
+		const VertexFormat& curFormat = m_vertexFormat[i];
+		auto foundElement = curFormat.find(name);
+		if (foundElement == curFormat.end())
+			continue;
+
+		m_weldStream = i;
+		m_weldElement = foundElement - curFormat.begin();
+		return true;
+	}
+
+	return false;
+}
+
 void Converter::logError(const char* message) const
 {
 	if (m_errorFunction)
 		m_errorFunction(message);
 }
 
-bool Converter::convert()
+std::size_t Converter::estimateVertexCount() const
+{
+	if (m_indexType == IndexType::NoIndices)
+		return m_indexCount;
+
+	switch (m_reservePolicy)
+	{
+		case ReservePolicy::None:
+			return 0;
+		case ReservePolicy::InputVertexCount:
+		{
+			std::size_t vertexCount = 0;
+			for (const VertexStream& stream : m_vertexStreams)
+				vertexCount = std::max(vertexCount, static_cast<std::size_t>(stream.vertexCount));
+			return std::min(vertexCount, static_cast<std::size_t>(m_indexCount));
+		}
+		case ReservePolicy::Estimate:
+			break;
+	}
+
+	// Every index is unique if any stream doesn't have indices.
+	for (const VertexStream& stream : m_vertexStreams)
+	{
+		if (stream.indexType == IndexType::NoIndices)
+			return m_indexCount;
+	}
+
+	// Estimate the number of unique combinations of indices across the vertex streams. Vertices
+	// that differ in index may still be identical after conversion, so this is an upper bound for
+	// typical input.
+	std::vector<std::uint32_t> indexTuple(m_vertexStreams.size());
+	auto tupleSize = static_cast<std::uint32_t>(indexTuple.size()*sizeof(std::uint32_t));
+	HashFunction hashFunction = fixedHashFunction(tupleSize);
+	CardinalityEstimator estimator;
+	for (std::uint32_t i = 0; i < m_indexCount; ++i)
+	{
+		bool restart = false;
+		for (std::size_t j = 0; j < m_vertexStreams.size(); ++j)
+		{
+			const VertexStream& stream = m_vertexStreams[j];
+			indexTuple[j] = getIndexValue(stream.indexType, stream.indexData, i);
+			if (isPrimitiveRestart(indexTuple[j], primitiveRestartIndexValue(stream.indexType),
+					m_primitiveType))
+			{
+				restart = true;
+				break;
+			}
+		}
+
+		if (!restart)
+		{
+			estimator.add(hashFunction(reinterpret_cast<const std::uint8_t*>(indexTuple.data()),
+				tupleSize));
+		}
+	}
+
+	// Add some headroom for the estimate error and vertices copied between index buffers.
+	auto estimate = static_cast<std::size_t>(estimator.estimate()*1.05);
+	return std::min(estimate, static_cast<std::size_t>(m_indexCount));
+}
+
+bool Converter::convert(Stats* outStats)
 {
 	if (!isValid())
 	{
@@ -634,6 +821,20 @@ bool Converter::convert()
 		return false;
 	}
 
+	PhaseTimer timer(outStats != nullptr);
+	PhaseTimer::Clock::duration validateTime{}, boundsTime{}, reserveTime{}, encodeTime{},
+		dedupTime{}, carryOverTime{}, splitStreamsTime{};
+	std::uint64_t hashProbes = 0, dedupHits = 0, carriedOverVertices = 0;
+	VFC_TRACE_SCOPE("Converter::convert");
+	VFC_TRACE_PHASE_BEGIN(tracePhase, "bounds");
+
+	// The bounds were gathered when adding the vertex streams, so only need to wait for any
+	// background tasks. This is done first so the input data is no longer referenced when
+	// returning early.
+	waitForValidation();
+	timer.lap(boundsTime);
+	VFC_TRACE_PHASE_NEXT(tracePhase, "validate");
+
 	bool hasAllElements = true;
 	std::string message;
 	for (std::size_t i = 0; i < m_vertexFormat.size(); ++i)
@@ -656,51 +857,85 @@ bool Converter::convert()
 	if (!hasAllElements)
 		return false;
 
-	// First need to gather the bounds. Loop over the streams first for better cache efficiency.
+	// Errors for the index values are reported in the order of the elements.
 	for (std::vector<VertexElementRef>& curElementMapping : m_elementMapping)
 	{
 		for (VertexElementRef& elementRef : curElementMapping)
 		{
 			const VertexStream& stream = m_vertexStreams[elementRef.streamIndex];
 			assert(elementRef.element);
-			const VertexElement& element = *elementRef.element;
-			std::uint32_t primitiveRestart = primitiveRestartIndexValue(stream.indexType);
-			for (std::uint32_t i = 0; i < m_indexCount; ++i)
+			switch (stream.bounds.error)
 			{
-				std::uint32_t indexValue = getIndexValue(stream.indexType, stream.indexData, i, i);
-				if (isPrimitiveRestart(indexValue, primitiveRestart, m_primitiveType))
-				{
-					if (m_indexType == IndexType::NoIndices)
-					{
-						logError("Indices must be output if a primitive restart is used.");
-						return false;
-					}
-					continue;
-				}
-
-				if (indexValue >= stream.vertexCount)
-				{
+				case StreamError::None:
+					break;
+				case StreamError::OutOfRange:
 					message = "Index value for vertex element '";
-					message += element.name;
+					message += elementRef.element->name;
 					message += "' is out of range.";
 					logError(message.c_str());
 					return false;
-				}
-
-				VertexValue value;
-				auto offset = static_cast<std::size_t>(indexValue)*stream.vertexFormat.stride();
-				value.fromData(stream.vertexData + offset, element.layout, element.type);
-				value.expandBounds(elementRef.minVal, elementRef.maxVal);
+				case StreamError::PrimitiveRestart:
+					logError("Indices must be output if a primitive restart is used.");
+					return false;
 			}
+
+			auto element = static_cast<std::size_t>(elementRef.element - &stream.vertexFormat[0]);
+			elementRef.minVal = stream.bounds.minVals[element];
+			elementRef.maxVal = stream.bounds.maxVals[element];
+		}
+	}
+
+	// Welding is only performed when outputting indices, since otherwise no vertices are merged.
+	std::unique_ptr<VertexWelder> welder;
+	std::vector<VertexValue> weldValues;
+	if (isWeldingEnabled() && m_indexType != IndexType::NoIndices)
+	{
+		if (!(m_elementMapping[m_weldStream][m_weldElement].weldTolerance > 0))
+		{
+			logError("Weld position element must have a weld tolerance greater than 0.");
+			return false;
 		}
+
+		std::vector<double> tolerances;
+		std::size_t positionElement = 0;
+		for (std::size_t i = 0; i < m_elementMapping.size(); ++i)
+		{
+			if (i == m_weldStream)
+				positionElement = tolerances.size() + m_weldElement;
+			for (const VertexElementRef& elementRef : m_elementMapping[i])
+				tolerances.push_back(elementRef.weldTolerance);
+		}
+
+		weldValues.resize(tolerances.size());
+		welder.reset(new VertexWelder(std::move(tolerances), positionElement));
 	}
+	timer.lap(validateTime);
+	VFC_TRACE_PHASE_NEXT(tracePhase, "reserve");
 
-	// Create the combined vertex stream.
-	std::vector<std::vector<std::uint8_t>> vertexData(m_vertexFormat.size());
-	VertexSet vertexSet;
+	// Create the combined vertex stream. All output streams are staged together, with the data for
+	// each vertex contiguous, then split into the separate streams at the end.
+	std::vector<std::uint32_t> streamOffsets(m_vertexFormat.size());
+	std::uint32_t combinedStride = 0;
 	for (std::size_t i = 0; i < m_vertexFormat.size(); ++i)
-		vertexData[i].resize(m_vertexFormat[i].stride());
-	m_vertices.resize(m_vertexFormat.size());
+	{
+		streamOffsets[i] = combinedStride;
+		combinedStride += m_vertexFormat[i].stride();
+	}
+
+	std::vector<std::uint8_t> vertexData(combinedStride);
+	// Re-use the staging memory from a previous conversion before reset().
+	std::vector<std::uint8_t> combinedVertices;
+	combinedVertices.swap(m_stagingVertices);
+	VertexSet vertexSet(0, VertexHash(fixedHashFunction(combinedStride)),
+		VertexEqual(outStats ? &hashProbes : nullptr));
+
+	// Reserve the memory up front to avoid re-allocating as vertices and indices are added.
+	std::size_t reserveVertexCount = estimateVertexCount();
+	combinedVertices.reserve(reserveVertexCount*combinedStride);
+	// The vertex set is cleared for each index buffer, which is proportional to the bucket count,
+	// so only reserve the vertices for a single index buffer.
+	vertexSet.reserve(std::min(reserveVertexCount, static_cast<std::size_t>(m_maxIndexValue) + 1));
+	m_indices.reserve(static_cast<std::size_t>(m_indexCount)*indexSize(m_indexType));
 
 	assert(m_indexData.empty());
 	std::uint32_t lastRestartIndex = std::numeric_limits<std::uint32_t>::max();
@@ -712,36 +947,45 @@ bool Converter::convert()
 		indexData = &m_indexData.back();
 	}
 
+	timer.lap(reserveTime);
+	VFC_TRACE_PHASE_NEXT(tracePhase, "vertices");
+
 	unsigned int indexStride = primitiveIndexStride(m_primitiveType, m_patchPoints);
 	for (std::uint32_t i = 0; i < m_indexCount; i += indexStride)
 	{
 		// Check if there's room for a new primitive.
-		auto vertexCount =
-			static_cast<std::uint32_t>(m_vertices[0].size()/m_vertexFormat[0].stride());
+		auto vertexCount = static_cast<std::uint32_t>(combinedVertices.size()/combinedStride);
 		if (m_indexType != IndexType::NoIndices &&
 			vertexCount + indexStride - 1 - indexData->baseVertex > m_maxIndexValue)
 		{
+			timer.lap(dedupTime);
+			VFC_TRACE_SCOPE("carryOver");
 			std::int32_t baseVertex = vertexCount;
 			m_indexData.push_back(IndexData{reinterpret_cast<void*>(m_indices.size()),
 				m_indexType, 0, baseVertex});
 			indexData = &m_indexData.back();
 			vertexSet.clear();
+			if (welder)
+				welder->clear();
 
 			// Copy any vertices that are needed.
 			assert(m_indexData.size() >= 2);
 			IndexData& lastIndexData = m_indexData[m_indexData.size() - 2];
 			auto indexCount = static_cast<std::uint32_t>(m_indices.size()/sizeofIndex);
-			copyConnectedVertices(m_vertices, m_vertexFormat, vertexSet, m_indices,
+			copyConnectedVertices(combinedVertices, combinedStride, vertexSet, m_indices,
 				m_indexType, sizeofIndex, baseVertex, m_primitiveType, lastRestartIndex,
 				lastIndexData.count, lastIndexData.baseVertex, indexData->count);
 			// Count this as a the first index after a primitive restart.
 			lastRestartIndex = indexCount - 1;
+			carriedOverVertices += combinedVertices.size()/combinedStride - vertexCount;
+			timer.lap(carryOverTime);
 		}
 
 		for (std::uint32_t j = 0; j < indexStride; ++j)
 		{
 			std::uint32_t index = i + j;
 			bool restart = false;
+			VertexValue* weldValue = weldValues.data();
 			for (std::size_t k = 0; k < m_elementMapping.size(); ++k)
 			{
 				const VertexFormat& curFormat = m_vertexFormat[k];
@@ -771,9 +1015,12 @@ bool Converter::convert()
 					auto offset = static_cast<std::size_t>(indexValue)*stream.vertexFormat.stride() +
 						element.offset;
 					value.fromData(stream.vertexData + offset, element.layout, element.type);
+					if (welder)
+						*weldValue++ = value;
 
 					// Then write it into the combined vertex.
-					std::uint8_t* elementPtr = vertexData[k].data() + dstElement.offset;
+					std::uint8_t* elementPtr =
+						vertexData.data() + streamOffsets[k] + dstElement.offset;
 					switch (elementRef.transform)
 					{
 						case Transform::Identity:
@@ -800,6 +1047,7 @@ bool Converter::convert()
 				}
 			}
 
+			timer.lap(encodeTime);
 			if (restart)
 			{
 				assert(indexStride == 1);
@@ -808,34 +1056,159 @@ bool Converter::convert()
 				addIndex(m_indices, m_indexType, sizeofIndex,
 					primitiveRestartIndexValue(m_indexType));
 				++indexData->count;
+				timer.lap(dedupTime);
 				break; // Continues outer loop.
 			}
 
 			// Add the vertex and index once all the data has been added.
 			if (m_indexType == IndexType::NoIndices)
-			{
-				for (std::size_t i = 0; i < m_vertices.size(); ++i)
-				{
-					m_vertices[i].insert(m_vertices[i].end(), vertexData[i].begin(),
-						vertexData[i].end());
-				}
-			}
+				combinedVertices.insert(combinedVertices.end(), vertexData.begin(), vertexData.end());
 			else
 			{
 				assert(indexData);
-				std::uint32_t vertexIndex =
-					addVertex(m_vertices, m_vertexFormat, vertexData, vertexSet);
+				std::uint32_t vertexIndex = VertexWelder::notFound;
+				if (welder)
+				{
+					vertexIndex = welder->find(weldValues.data());
+					if (vertexIndex != VertexWelder::notFound)
+						++dedupHits;
+					if (vertexIndex != VertexWelder::notFound &&
+						std::memcmp(combinedVertices.data() +
+								static_cast<std::size_t>(vertexIndex)*combinedStride,
+							vertexData.data(), combinedStride) != 0)
+					{
+						++m_weldedVertexCount;
+					}
+				}
+
+				if (vertexIndex == VertexWelder::notFound)
+				{
+					auto prevVertexCount = static_cast<std::uint32_t>(
+						combinedVertices.size()/combinedStride);
+					vertexIndex = addVertex(combinedVertices, combinedStride, vertexData, vertexSet);
+					if (vertexIndex != prevVertexCount)
+						++dedupHits;
+					else if (welder)
+						welder->add(weldValues.data(), vertexIndex);
+				}
 				std::uint32_t indexValue = vertexIndex - indexData->baseVertex;
 				assert(indexValue <= m_maxIndexValue);
 				addIndex(m_indices, m_indexType, sizeofIndex, indexValue);
 				++indexData->count;
 			}
+			timer.lap(dedupTime);
+		}
+	}
+
+	// Split the combined vertices into the separate vertex streams.
+	VFC_TRACE_PHASE_NEXT(tracePhase, "splitStreams");
+	std::size_t vertexCount = combinedVertices.size()/combinedStride;
+	m_vertexCount = static_cast<std::uint32_t>(vertexCount);
+	m_vertices.resize(m_vertexFormat.size());
+	std::size_t peakVertexBytes = combinedVertices.capacity();
+
+	// The staged vertices are already in the final layout with a single stream, so they're moved
+	// to the output even with an output buffer function to avoid holding a second copy.
+	if (m_vertices.size() == 1)
+		m_vertices[0] = std::move(combinedVertices);
+	else
+	{
+		for (std::size_t i = 0; i < m_vertices.size(); ++i)
+		{
+			std::uint32_t stride = m_vertexFormat[i].stride();
+			std::size_t size = vertexCount*stride;
+			std::uint8_t* dstVertex;
+			if (m_outputBufferFunction)
+			{
+				dstVertex = reinterpret_cast<std::uint8_t*>(
+					m_outputBufferFunction(OutputBufferType::Vertices, i, size));
+				if (!dstVertex && size > 0)
+				{
+					logError("Couldn't get output buffer for converted vertices.");
+					return false;
+				}
+			}
+			else
+			{
+				std::vector<std::uint8_t>& curVertices = m_vertices[i];
+				curVertices.resize(size);
+				dstVertex = curVertices.data();
+				peakVertexBytes += curVertices.capacity();
+			}
+
+			if (stride == combinedStride)
+			{
+				if (size > 0)
+					std::memcpy(dstVertex, combinedVertices.data(), size);
+				continue;
+			}
+
+			const std::uint8_t* srcVertex = combinedVertices.data() + streamOffsets[i];
+			for (std::size_t j = 0; j < vertexCount;
+				++j, srcVertex += combinedStride, dstVertex += stride)
+			{
+				std::memcpy(dstVertex, srcVertex, stride);
+			}
 		}
 	}
 
 	// Set the pointers for the index data.
-	for (IndexData& indexData : m_indexData)
-		indexData.data = m_indices.data() + reinterpret_cast<std::size_t>(indexData.data);
+	std::size_t peakIndexBytes = m_indices.capacity();
+	if (m_outputBufferFunction)
+	{
+		// Free the staged vertices before allocating the index buffers to lower the peak memory.
+		std::vector<std::uint8_t>().swap(combinedVertices);
+		for (std::size_t i = 0; i < m_indexData.size(); ++i)
+		{
+			IndexData& indexData = m_indexData[i];
+			std::size_t size = static_cast<std::size_t>(indexData.count)*sizeofIndex;
+			void* buffer = m_outputBufferFunction(OutputBufferType::Indices, i, size);
+			if (!buffer && size > 0)
+			{
+				logError("Couldn't get output buffer for converted indices.");
+				return false;
+			}
+
+			if (size > 0)
+			{
+				std::memcpy(buffer,
+					m_indices.data() + reinterpret_cast<std::size_t>(indexData.data), size);
+			}
+			indexData.data = buffer;
+		}
+
+		// Indices were copied to the output buffers, so they're no longer needed.
+		std::vector<std::uint8_t>().swap(m_indices);
+	}
+	else
+	{
+		for (IndexData& indexData : m_indexData)
+			indexData.data = m_indices.data() + reinterpret_cast<std::size_t>(indexData.data);
+	}
+	timer.lap(splitStreamsTime);
+
+	if (outStats)
+	{
+		outStats->validateTime = toSeconds(validateTime);
+		outStats->boundsTime = toSeconds(boundsTime);
+		outStats->reserveTime = toSeconds(reserveTime);
+		outStats->encodeTime = toSeconds(encodeTime);
+		outStats->dedupTime = toSeconds(dedupTime);
+		outStats->carryOverTime = toSeconds(carryOverTime);
+		outStats->splitStreamsTime = toSeconds(splitStreamsTime);
+		outStats->totalTime = toSeconds(timer.total());
+		outStats->hashProbes = hashProbes;
+		outStats->dedupHits = dedupHits;
+		outStats->carriedOverVertices = carriedOverVertices;
+		outStats->uniqueVertices = getVertexCount() - carriedOverVertices;
+		outStats->indexBuffers = m_indexData.size();
+		outStats->peakVertexBytes = peakVertexBytes;
+		outStats->peakIndexBytes = peakIndexBytes;
+	}
+
+	// Keep the staging memory to re-use after reset().
+	combinedVertices.clear();
+	m_stagingVertices.swap(combinedVertices);
 
 	return true;
 }
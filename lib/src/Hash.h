@@ -0,0 +1,284 @@
+/*
+ * Copyright 2020-2026 Aaron Barany
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <VFC/Config.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#if VFC_MSC && (VFC_X86_64 || VFC_ARM_64)
+#include <intrin.h>
+#endif
+
+namespace vfc
+{
+
+/**
+ * @brief Type for a function to hash a block of memory.
+ * @param data The data to hash.
+ * @param size The size of the data in bytes.
+ * @return The hash value.
+ */
+using HashFunction = std::size_t (*)(const std::uint8_t* data, std::uint32_t size);
+
+constexpr std::uint32_t hashSeed = 0xc70f6907U;
+
+// MurmurHash2, with some adjustments for code clarity and alignment guarantees.
+// https://github.com/aappleby/smhasher/blob/master/src/MurmurHash2.cpp
+#if VFC_64BIT
+inline std::size_t murmurHash2(const std::uint8_t* data, std::uint32_t size)
+{
+	const std::uint64_t m = 0xc6a4a7935bd1e995ULL;
+	const int r = 47;
+
+	std::uint64_t h = hashSeed ^ (size * m);
+
+	while (size >= 8)
+	{
+		std::uint64_t k;
+		std::memcpy(&k, data, sizeof(std::uint64_t));
+
+		k *= m;
+		k ^= k >> r;
+		k *= m;
+
+		h ^= k;
+		h *= m;
+
+		data += 8;
+		size -= 8;
+	}
+
+	switch (size)
+	{
+		case 7: h ^= std::uint64_t(data[6]) << 48;
+		case 6: h ^= std::uint64_t(data[5]) << 40;
+		case 5: h ^= std::uint64_t(data[4]) << 32;
+		case 4: h ^= std::uint64_t(data[3]) << 24;
+		case 3: h ^= std::uint64_t(data[2]) << 16;
+		case 2: h ^= std::uint64_t(data[1]) << 8;
+		case 1: h ^= std::uint64_t(data[0]);
+		h *= m;
+	};
+
+	h ^= h >> r;
+	h *= m;
+	h ^= h >> r;
+
+	return h;
+}
+#else
+inline void mmix(std::uint32_t& h, std::uint32_t k, std::uint32_t m)
+{
+	const int r = 24;
+	k *= m;
+	k ^= k >> r;
+	k *= m;
+	h *= m;
+	h ^= k;
+}
+
+inline std::size_t murmurHash2(const std::uint8_t* data, std::uint32_t size)
+{
+	const std::uint32_t m = 0x5bd1e995;
+	std::uint32_t l = size;
+	std::uint32_t h = hashSeed;
+
+	while (size >= 4)
+	{
+		std::uint32_t k;
+		std::memcpy(&k, data, sizeof(std::uint32_t));
+
+		mmix(h, k, m);
+
+		data += 4;
+		size -= 4;
+	}
+
+	std::uint32_t t = 0;
+	switch (size)
+	{
+		case 3: t ^= data[2] << 16;
+		case 2: t ^= data[1] << 8;
+		case 1: t ^= data[0];
+	}
+
+	mmix(h, t, m);
+	mmix(h, l, m);
+
+	h ^= h >> 13;
+	h *= m;
+	h ^= h >> 15;
+
+	return h;
+}
+#endif
+
+// Hash for small fixed-size keys based on wyhash, which mixes 16 bytes at a time with a 64 x 64 ->
+// 128-bit multiply. Keys up to 48 bytes are read with overlapping loads rather than looping over
+// individual bytes, and the variant is selected up front based on the size so the branches
+// within the hash are constant for the duration of a conversion.
+// https://github.com/wangyi-fudan/wyhash
+namespace detail
+{
+
+constexpr std::uint64_t hashSecret0 = 0xa0761d6478bd642fULL;
+constexpr std::uint64_t hashSecret1 = 0xe7037ed1a0b428dbULL;
+
+inline std::uint64_t hashMix(std::uint64_t a, std::uint64_t b)
+{
+#if defined(__SIZEOF_INT128__)
+	unsigned __int128 result = static_cast<unsigned __int128>(a)*b;
+	return static_cast<std::uint64_t>(result) ^ static_cast<std::uint64_t>(result >> 64);
+#elif VFC_MSC && VFC_X86_64
+	std::uint64_t high;
+	std::uint64_t low = _umul128(a, b, &high);
+	return low ^ high;
+#elif VFC_MSC && VFC_ARM_64
+	return a*b ^ __umulh(a, b);
+#else
+	std::uint64_t aHigh = a >> 32, aLow = static_cast<std::uint32_t>(a);
+	std::uint64_t bHigh = b >> 32, bLow = static_cast<std::uint32_t>(b);
+	std::uint64_t highHigh = aHigh*bHigh, highLow = aHigh*bLow;
+	std::uint64_t lowHigh = aLow*bHigh, lowLow = aLow*bLow;
+	std::uint64_t middle = highLow + (lowLow >> 32) + static_cast<std::uint32_t>(lowHigh);
+	std::uint64_t high = highHigh + (middle >> 32) + (lowHigh >> 32);
+	std::uint64_t low = (middle << 32) | static_cast<std::uint32_t>(lowLow);
+	return low ^ high;
+#endif
+}
+
+inline std::uint64_t hashRead64(const std::uint8_t* data)
+{
+	std::uint64_t value;
+	std::memcpy(&value, data, sizeof(std::uint64_t));
+	return value;
+}
+
+inline std::uint64_t hashRead32(const std::uint8_t* data)
+{
+	std::uint32_t value;
+	std::memcpy(&value, data, sizeof(std::uint32_t));
+	return value;
+}
+
+inline std::size_t hashFinish(std::uint64_t a, std::uint64_t b, std::uint64_t seed,
+	std::uint32_t size)
+{
+	return static_cast<std::size_t>(hashMix(hashSecret1 ^ size,
+		hashMix(a ^ hashSecret1, b ^ seed)));
+}
+
+inline std::size_t hashTail16(const std::uint8_t* data, std::uint32_t size, std::uint64_t seed,
+	std::uint32_t totalSize)
+{
+	// Last 16 bytes of a key > 16 bytes, which may overlap with previously hashed bytes.
+	return hashFinish(hashRead64(data + size - 16), hashRead64(data + size - 8), seed, totalSize);
+}
+
+} // namespace detail
+
+/**
+ * @brief Hashes a key up to 16 bytes.
+ */
+inline std::size_t fixedHash16(const std::uint8_t* data, std::uint32_t size)
+{
+	std::uint64_t a, b;
+	if (size >= 4)
+	{
+		std::uint32_t middle = (size >> 3) << 2;
+		a = (detail::hashRead32(data) << 32) | detail::hashRead32(data + middle);
+		b = (detail::hashRead32(data + size - 4) << 32) |
+			detail::hashRead32(data + size - 4 - middle);
+	}
+	else if (size > 0)
+	{
+		a = (std::uint64_t(data[0]) << 16) | (std::uint64_t(data[size >> 1]) << 8) |
+			data[size - 1];
+		b = 0;
+	}
+	else
+		a = b = 0;
+
+	return detail::hashFinish(a, b, hashSeed ^ detail::hashSecret0, size);
+}
+
+/**
+ * @brief Hashes a key between 17 and 32 bytes.
+ */
+inline std::size_t fixedHash32(const std::uint8_t* data, std::uint32_t size)
+{
+	std::uint64_t seed = hashSeed ^ detail::hashSecret0;
+	seed = detail::hashMix(detail::hashRead64(data) ^ detail::hashSecret1,
+		detail::hashRead64(data + 8) ^ seed);
+	return detail::hashTail16(data, size, seed, size);
+}
+
+/**
+ * @brief Hashes a key between 33 and 48 bytes.
+ */
+inline std::size_t fixedHash48(const std::uint8_t* data, std::uint32_t size)
+{
+	std::uint64_t seed = hashSeed ^ detail::hashSecret0;
+	seed = detail::hashMix(detail::hashRead64(data) ^ detail::hashSecret1,
+		detail::hashRead64(data + 8) ^ seed);
+	seed = detail::hashMix(detail::hashRead64(data + 16) ^ detail::hashSecret1,
+		detail::hashRead64(data + 24) ^ seed);
+	return detail::hashTail16(data, size, seed, size);
+}
+
+/**
+ * @brief Hashes a key of any size.
+ */
+inline std::size_t fixedHashAny(const std::uint8_t* data, std::uint32_t size)
+{
+	if (size <= 16)
+		return fixedHash16(data, size);
+
+	std::uint64_t seed = hashSeed ^ detail::hashSecret0;
+	const std::uint8_t* curData = data;
+	std::uint32_t remaining = size;
+	for (; remaining > 16; curData += 16, remaining -= 16)
+	{
+		seed = detail::hashMix(detail::hashRead64(curData) ^ detail::hashSecret1,
+			detail::hashRead64(curData + 8) ^ seed);
+	}
+	return detail::hashTail16(data, size, seed, size);
+}
+
+/**
+ * @brief Gets the hash function to use for keys of a fixed size.
+ *
+ * All functions returned for a size will give the same result as fixedHashAny() for that size.
+ *
+ * @param size The size of each key in bytes.
+ * @return The hash function.
+ */
+inline HashFunction fixedHashFunction(std::uint32_t size)
+{
+	if (size <= 16)
+		return &fixedHash16;
+	else if (size <= 32)
+		return &fixedHash32;
+	else if (size <= 48)
+		return &fixedHash48;
+	return &fixedHashAny;
+}
+
+} // namespace vfc
@@ -0,0 +1,476 @@
+/*
+ * Copyright 2026 Aaron Barany
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <VFC/IndexCodec.h>
+#include <VFC/Trace.h>
+#include <cstring>
+#include <limits>
+
+namespace vfc
+{
+
+namespace
+{
+
+const unsigned int fifoSize = 16;
+const unsigned int fifoMask = fifoSize - 1;
+
+const unsigned int nextVertexCode = 0;
+const unsigned int explicitVertexCode = 15;
+const unsigned int restartCode = 14;
+const unsigned int noEdgeCode = 15;
+
+// The number of vertex FIFO entries that may be referenced with codes.
+const unsigned int listFifoCodeCount = 14;
+const unsigned int stripFifoCodeCount = 13;
+// The last edge code is reserved for triangles that don't share an edge.
+const unsigned int edgeFifoCodeCount = 15;
+
+void write32(std::uint8_t* data, std::uint32_t value)
+{
+	for (unsigned int i = 0; i < 4; ++i)
+		data[i] = static_cast<std::uint8_t>(value >> (i*8));
+}
+
+std::uint32_t read32(const std::uint8_t* data)
+{
+	std::uint32_t value = 0;
+	for (int i = 3; i >= 0; --i)
+		value = (value << 8) | data[i];
+	return value;
+}
+
+std::size_t getCodeSize(PrimitiveType primitiveType, std::uint32_t indexCount)
+{
+	if (primitiveType == PrimitiveType::TriangleList)
+		return indexCount/3;
+	return indexCount/2 + (indexCount & 1);
+}
+
+std::uint32_t getRestartValue(IndexType indexType)
+{
+	return indexType == IndexType::UInt16 ? std::numeric_limits<std::uint16_t>::max() :
+		std::numeric_limits<std::uint32_t>::max();
+}
+
+// The FIFO storage is separate from the offsets so the offsets may be kept in registers when
+// decoding.
+struct VertexFifo
+{
+	std::uint32_t* vertices;
+	unsigned int offset;
+	std::uint32_t nextVertex;
+	std::uint32_t lastExplicit;
+
+	void push(std::uint32_t vertex)
+	{
+		vertices[offset++ & fifoMask] = vertex;
+	}
+
+	std::uint32_t get(unsigned int index) const
+	{
+		return vertices[(offset - 1 - index) & fifoMask];
+	}
+};
+
+struct EdgeFifo
+{
+	std::uint32_t (*edges)[2];
+	unsigned int offset;
+
+	void push(std::uint32_t first, std::uint32_t second)
+	{
+		std::uint32_t* edge = edges[offset++ & fifoMask];
+		edge[0] = first;
+		edge[1] = second;
+	}
+
+	const std::uint32_t* get(unsigned int index) const
+	{
+		return edges[(offset - 1 - index) & fifoMask];
+	}
+};
+
+void writeVarint(std::vector<std::uint8_t>& outData, std::uint32_t value)
+{
+	while (value >= 0x80)
+	{
+		outData.push_back(static_cast<std::uint8_t>(value | 0x80));
+		value >>= 7;
+	}
+	outData.push_back(static_cast<std::uint8_t>(value));
+}
+
+inline bool readVarint(std::uint32_t& outValue, const std::uint8_t*& data, const std::uint8_t* end)
+{
+	std::uint32_t value = 0;
+	for (unsigned int shift = 0; shift < 35; shift += 7)
+	{
+		if (data == end)
+			return false;
+
+		std::uint8_t byte = *data++;
+		value |= static_cast<std::uint32_t>(byte & 0x7F) << shift;
+		if (!(byte & 0x80))
+		{
+			outValue = value;
+			return true;
+		}
+	}
+
+	return false;
+}
+
+unsigned int encodeVertex(std::vector<std::uint8_t>& outData, VertexFifo& fifo,
+	std::uint32_t vertex, unsigned int fifoCodeCount)
+{
+	if (vertex == fifo.nextVertex)
+	{
+		++fifo.nextVertex;
+		fifo.push(vertex);
+		return nextVertexCode;
+	}
+
+	for (unsigned int i = 0; i < fifoCodeCount; ++i)
+	{
+		if (fifo.get(i) == vertex)
+			return i + 1;
+	}
+
+	std::uint32_t delta = vertex - fifo.lastExplicit;
+	writeVarint(outData, (delta << 1) ^ (0 - (delta >> 31)));
+	fifo.lastExplicit = vertex;
+	fifo.push(vertex);
+	return explicitVertexCode;
+}
+
+inline bool decodeVertex(std::uint32_t& outVertex, VertexFifo& fifo, unsigned int code,
+	const std::uint8_t*& data, const std::uint8_t* end)
+{
+	if (code == nextVertexCode)
+	{
+		outVertex = fifo.nextVertex++;
+		fifo.push(outVertex);
+		return true;
+	}
+	else if (code != explicitVertexCode)
+	{
+		outVertex = fifo.get(code - 1);
+		return true;
+	}
+
+	std::uint32_t value;
+	if (!readVarint(value, data, end))
+		return false;
+
+	outVertex = fifo.lastExplicit + ((value >> 1) ^ (0 - (value & 1)));
+	fifo.lastExplicit = outVertex;
+	fifo.push(outVertex);
+	return true;
+}
+
+template <typename T>
+void encodeTriangleList(std::vector<std::uint8_t>& outCodes, std::vector<std::uint8_t>& outData,
+	const T* indices, std::uint32_t indexCount)
+{
+	std::uint32_t vertices[fifoSize] = {};
+	std::uint32_t edges[fifoSize][2] = {};
+	VertexFifo vertexFifo = {vertices, 0, 0, 0};
+	EdgeFifo edgeFifo = {edges, 0};
+	for (std::uint32_t i = 0; i < indexCount; i += 3)
+	{
+		std::uint32_t triangle[3] = {indices[i], indices[i + 1], indices[i + 2]};
+
+		// Find a recent edge, rotating the triangle to start with it.
+		unsigned int edgeIndex = noEdgeCode;
+		unsigned int rotation = 0;
+		for (unsigned int j = 0; j < edgeFifoCodeCount && edgeIndex == noEdgeCode; ++j)
+		{
+			const std::uint32_t* edge = edgeFifo.get(j);
+			for (unsigned int k = 0; k < 3; ++k)
+			{
+				if (edge[0] == triangle[k] && edge[1] == triangle[(k + 1) % 3])
+				{
+					edgeIndex = j;
+					rotation = k;
+					break;
+				}
+			}
+		}
+
+		std::uint32_t a = triangle[rotation];
+		std::uint32_t b = triangle[(rotation + 1) % 3];
+		std::uint32_t c = triangle[(rotation + 2) % 3];
+		if (edgeIndex == noEdgeCode)
+		{
+			unsigned int codeA = encodeVertex(outData, vertexFifo, a, listFifoCodeCount);
+			std::size_t codeOffset = outData.size();
+			outData.push_back(0);
+			unsigned int codeB = encodeVertex(outData, vertexFifo, b, listFifoCodeCount);
+			unsigned int codeC = encodeVertex(outData, vertexFifo, c, listFifoCodeCount);
+			outCodes.push_back(static_cast<std::uint8_t>((noEdgeCode << 4) | codeA));
+			outData[codeOffset] = static_cast<std::uint8_t>((codeB << 4) | codeC);
+			edgeFifo.push(b, a);
+		}
+		else
+		{
+			unsigned int codeC = encodeVertex(outData, vertexFifo, c, listFifoCodeCount);
+			outCodes.push_back(static_cast<std::uint8_t>((edgeIndex << 4) | codeC));
+		}
+
+		edgeFifo.push(c, b);
+		edgeFifo.push(a, c);
+	}
+}
+
+template <typename T>
+void encodeTriangleStrip(std::vector<std::uint8_t>& outCodes, std::vector<std::uint8_t>& outData,
+	const T* indices, std::uint32_t indexCount, std::uint32_t restartValue)
+{
+	std::uint32_t vertices[fifoSize] = {};
+	VertexFifo vertexFifo = {vertices, 0, 0, 0};
+	for (std::uint32_t i = 0; i < indexCount; ++i)
+	{
+		unsigned int code;
+		if (indices[i] == restartValue)
+			code = restartCode;
+		else
+			code = encodeVertex(outData, vertexFifo, indices[i], stripFifoCodeCount);
+
+		if (i & 1)
+			outCodes.back() = static_cast<std::uint8_t>(outCodes.back() | (code << 4));
+		else
+			outCodes.push_back(static_cast<std::uint8_t>(code));
+	}
+}
+
+template <typename T>
+bool decodeTriangleList(T* outIndices, std::uint32_t indexCount, const std::uint8_t* codes,
+	const std::uint8_t* data, const std::uint8_t* dataEnd)
+{
+	std::uint32_t vertices[fifoSize] = {};
+	std::uint32_t edges[fifoSize][2] = {};
+	VertexFifo vertexFifo = {vertices, 0, 0, 0};
+	EdgeFifo edgeFifo = {edges, 0};
+	for (std::uint32_t i = 0; i < indexCount; i += 3, ++codes)
+	{
+		unsigned int edgeCode = *codes >> 4;
+		unsigned int vertexCode = *codes & 0xF;
+		std::uint32_t a, b, c;
+		if (edgeCode == noEdgeCode)
+		{
+			if (!decodeVertex(a, vertexFifo, vertexCode, data, dataEnd) || data == dataEnd)
+				return false;
+
+			unsigned int otherCodes = *data++;
+			if (!decodeVertex(b, vertexFifo, otherCodes >> 4, data, dataEnd) ||
+				!decodeVertex(c, vertexFifo, otherCodes & 0xF, data, dataEnd))
+			{
+				return false;
+			}
+
+			edgeFifo.push(b, a);
+		}
+		else
+		{
+			const std::uint32_t* edge = edgeFifo.get(edgeCode);
+			a = edge[0];
+			b = edge[1];
+			if (!decodeVertex(c, vertexFifo, vertexCode, data, dataEnd))
+				return false;
+		}
+
+		edgeFifo.push(c, b);
+		edgeFifo.push(a, c);
+		outIndices[i] = static_cast<T>(a);
+		outIndices[i + 1] = static_cast<T>(b);
+		outIndices[i + 2] = static_cast<T>(c);
+	}
+
+	return data == dataEnd;
+}
+
+template <typename T>
+inline bool decodeStripIndex(T& outIndex, VertexFifo& fifo, unsigned int code,
+	const std::uint8_t*& data, const std::uint8_t* end)
+{
+	if (code == restartCode)
+	{
+		outIndex = std::numeric_limits<T>::max();
+		return true;
+	}
+
+	std::uint32_t vertex;
+	if (!decodeVertex(vertex, fifo, code, data, end))
+		return false;
+
+	outIndex = static_cast<T>(vertex);
+	return true;
+}
+
+template <typename T>
+bool decodeTriangleStrip(T* outIndices, std::uint32_t indexCount, const std::uint8_t* codes,
+	const std::uint8_t* data, const std::uint8_t* dataEnd)
+{
+	std::uint32_t vertices[fifoSize] = {};
+	VertexFifo vertexFifo = {vertices, 0, 0, 0};
+	std::uint32_t pairCount = indexCount/2;
+	for (std::uint32_t i = 0; i < pairCount; ++i)
+	{
+		unsigned int codePair = codes[i];
+		if (!decodeStripIndex(outIndices[i*2], vertexFifo, codePair & 0xF, data, dataEnd) ||
+			!decodeStripIndex(outIndices[i*2 + 1], vertexFifo, codePair >> 4, data, dataEnd))
+		{
+			return false;
+		}
+	}
+
+	if (indexCount & 1)
+	{
+		// The unused upper bits for an odd number of indices must be 0.
+		unsigned int codePair = codes[pairCount];
+		if ((codePair >> 4) != 0 ||
+			!decodeStripIndex(outIndices[indexCount - 1], vertexFifo, codePair, data, dataEnd))
+		{
+			return false;
+		}
+	}
+
+	return data == dataEnd;
+}
+
+template <typename T>
+void encodeIndicesImpl(std::vector<std::uint8_t>& outCodes, std::vector<std::uint8_t>& outData,
+	const T* indices, std::uint32_t indexCount, PrimitiveType primitiveType,
+	std::uint32_t restartValue)
+{
+	if (primitiveType == PrimitiveType::TriangleList)
+		encodeTriangleList(outCodes, outData, indices, indexCount);
+	else
+		encodeTriangleStrip(outCodes, outData, indices, indexCount, restartValue);
+}
+
+template <typename T>
+bool decodeIndicesImpl(void* outIndices, const EncodedIndicesHeader& header,
+	const std::uint8_t* codes, const std::uint8_t* data, const std::uint8_t* dataEnd)
+{
+	auto indices = reinterpret_cast<T*>(outIndices);
+	if (header.primitiveType == PrimitiveType::TriangleList)
+		return decodeTriangleList(indices, header.indexCount, codes, data, dataEnd);
+	return decodeTriangleStrip(indices, header.indexCount, codes, data, dataEnd);
+}
+
+} // namespace
+
+bool encodeIndices(std::vector<std::uint8_t>& outData, const IndexData& indexData,
+	PrimitiveType primitiveType)
+{
+	VFC_TRACE_SCOPE("encodeIndices");
+	if ((!indexData.data && indexData.count > 0) ||
+		(indexData.type != IndexType::UInt16 && indexData.type != IndexType::UInt32) ||
+		(primitiveType != PrimitiveType::TriangleList &&
+			primitiveType != PrimitiveType::TriangleStrip) ||
+		(primitiveType == PrimitiveType::TriangleList && indexData.count % 3 != 0))
+	{
+		return false;
+	}
+
+	std::vector<std::uint8_t> codes;
+	std::vector<std::uint8_t> data;
+	codes.reserve(getCodeSize(primitiveType, indexData.count));
+	std::uint32_t restartValue = getRestartValue(indexData.type);
+	if (indexData.type == IndexType::UInt16)
+	{
+		encodeIndicesImpl(codes, data, reinterpret_cast<const std::uint16_t*>(indexData.data),
+			indexData.count, primitiveType, restartValue);
+	}
+	else
+	{
+		encodeIndicesImpl(codes, data, reinterpret_cast<const std::uint32_t*>(indexData.data),
+			indexData.count, primitiveType, restartValue);
+	}
+
+	if (data.size() > std::numeric_limits<std::uint32_t>::max())
+		return false;
+
+	std::uint8_t header[sizeof(EncodedIndicesHeader)];
+	std::memcpy(header, encodedIndicesMagic, sizeof(encodedIndicesMagic));
+	header[4] = encodedIndicesVersion;
+	header[5] = static_cast<std::uint8_t>(primitiveType);
+	header[6] = static_cast<std::uint8_t>(indexData.type);
+	header[7] = 0;
+	write32(header + 8, indexData.count);
+	write32(header + 12, static_cast<std::uint32_t>(data.size()));
+
+	outData.assign(header, header + sizeof(header));
+	outData.insert(outData.end(), codes.begin(), codes.end());
+	outData.insert(outData.end(), data.begin(), data.end());
+	return true;
+}
+
+bool readEncodedIndicesHeader(EncodedIndicesHeader& outHeader, const void* data,
+	std::size_t size)
+{
+	if (!data || size < sizeof(EncodedIndicesHeader))
+		return false;
+
+	auto bytes = reinterpret_cast<const std::uint8_t*>(data);
+	std::memcpy(outHeader.magic, bytes, sizeof(outHeader.magic));
+	outHeader.version = bytes[4];
+	outHeader.primitiveType = static_cast<PrimitiveType>(bytes[5]);
+	outHeader.indexType = static_cast<IndexType>(bytes[6]);
+	outHeader.reserved = bytes[7];
+	outHeader.indexCount = read32(bytes + 8);
+	outHeader.dataSize = read32(bytes + 12);
+
+	return std::memcmp(outHeader.magic, encodedIndicesMagic, sizeof(encodedIndicesMagic)) == 0 &&
+		outHeader.version == encodedIndicesVersion && outHeader.reserved == 0 &&
+		(outHeader.indexType == IndexType::UInt16 || outHeader.indexType == IndexType::UInt32) &&
+		(outHeader.primitiveType == PrimitiveType::TriangleStrip ||
+			(outHeader.primitiveType == PrimitiveType::TriangleList &&
+				outHeader.indexCount % 3 == 0));
+}
+
+bool decodeIndices(void* outIndices, std::size_t outSize, const void* data, std::size_t size)
+{
+	VFC_TRACE_SCOPE("decodeIndices");
+	EncodedIndicesHeader header;
+	if (!readEncodedIndicesHeader(header, data, size) ||
+		static_cast<std::uint64_t>(header.indexCount)*indexSize(header.indexType) != outSize ||
+		(!outIndices && outSize > 0))
+	{
+		return false;
+	}
+
+	std::size_t codeSize = getCodeSize(header.primitiveType, header.indexCount);
+	if (static_cast<std::uint64_t>(sizeof(EncodedIndicesHeader)) + codeSize + header.dataSize !=
+		size)
+	{
+		return false;
+	}
+
+	auto codes = reinterpret_cast<const std::uint8_t*>(data) + sizeof(EncodedIndicesHeader);
+	const std::uint8_t* indexData = codes + codeSize;
+	const std::uint8_t* indexDataEnd = indexData + header.dataSize;
+	if (header.indexType == IndexType::UInt16)
+	{
+		return decodeIndicesImpl<std::uint16_t>(outIndices, header, codes, indexData,
+			indexDataEnd);
+	}
+	return decodeIndicesImpl<std::uint32_t>(outIndices, header, codes, indexData, indexDataEnd);
+}
+
+} // namespace vfc
@@ -0,0 +1,464 @@
+/*
+ * Copyright 2026 Aaron Barany
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <VFC/InputContainer.h>
+#include <VFC/Trace.h>
+#include <cstring>
+#include <limits>
+
+namespace vfc
+{
+
+namespace
+{
+
+std::uint64_t getTablesSize(std::uint64_t vertexFormatCount, std::uint64_t vertexStreamCount,
+	std::uint64_t elementCount, std::uint64_t transformCount, std::uint64_t stringTableSize)
+{
+	return sizeof(InputContainerHeader) + vertexFormatCount*sizeof(InputContainerFormat) +
+		vertexStreamCount*sizeof(InputContainerVertexStream) +
+		elementCount*sizeof(InputContainerElement) +
+		transformCount*sizeof(InputContainerTransform) + stringTableSize;
+}
+
+bool isSectionValid(std::uint64_t offset, std::uint64_t size, std::uint64_t headerSize,
+	std::uint64_t fileSize, std::uint32_t alignment)
+{
+	return offset >= headerSize && offset <= fileSize && size <= fileSize - offset &&
+		offset % alignment == 0;
+}
+
+std::uint64_t getVertexDataSize(const InputVertexStream& vertexStream)
+{
+	return static_cast<std::uint64_t>(vertexStream.vertexCount)*vertexStream.vertexFormat.stride();
+}
+
+std::uint64_t getIndexDataSize(const InputVertexStream& vertexStream)
+{
+	if (vertexStream.indexType == IndexType::NoIndices)
+		return 0;
+	return static_cast<std::uint64_t>(vertexStream.indexCount)*indexSize(vertexStream.indexType);
+}
+
+std::uint32_t addString(char* stringTable, std::uint32_t& stringTableSize, const std::string& str)
+{
+	std::uint32_t offset = stringTableSize;
+	std::memcpy(stringTable + offset, str.c_str(), str.size() + 1);
+	stringTableSize += static_cast<std::uint32_t>(str.size() + 1);
+	return offset;
+}
+
+InputContainerElement* writeElements(InputContainerElement* elements, char* stringTable,
+	std::uint32_t& stringTableSize, const VertexFormat& vertexFormat)
+{
+	for (const VertexElement& element : vertexFormat)
+	{
+		elements->nameOffset = addString(stringTable, stringTableSize, element.name);
+		elements->nameLength = static_cast<std::uint32_t>(element.name.size());
+		elements->layout = element.layout;
+		elements->type = element.type;
+		++elements;
+	}
+	return elements;
+}
+
+} // namespace
+
+InputContainerWriter::InputContainerWriter(std::vector<VertexFormat> vertexFormat,
+	IndexType indexType, PrimitiveType primitiveType, unsigned int patchPoints,
+	std::uint32_t sectionAlignment)
+	: m_vertexFormat(std::move(vertexFormat))
+	, m_indexType(indexType)
+	, m_primitiveType(primitiveType)
+	, m_patchPoints(patchPoints)
+	, m_sectionAlignment(sectionAlignment)
+{
+}
+
+void InputContainerWriter::addVertexStream(VertexFormat vertexFormat, const void* vertexData,
+	std::uint32_t vertexCount, IndexType indexType, const void* indexData,
+	std::uint32_t indexCount)
+{
+	m_vertexStreams.push_back(InputVertexStream{std::move(vertexFormat), vertexData, vertexCount,
+		indexType, indexData, indexCount});
+}
+
+void InputContainerWriter::setElementTransform(std::string name, Converter::Transform transform)
+{
+	for (auto& curTransform : m_transforms)
+	{
+		if (curTransform.first == name)
+		{
+			curTransform.second = transform;
+			return;
+		}
+	}
+
+	m_transforms.emplace_back(std::move(name), transform);
+}
+
+std::size_t InputContainerWriter::getSize() const
+{
+	std::uint64_t size = getHeaderSize();
+	for (const InputVertexStream& vertexStream : m_vertexStreams)
+	{
+		size += alignSize(getVertexDataSize(vertexStream));
+		if (vertexStream.indexType != IndexType::NoIndices)
+			size += alignSize(getIndexDataSize(vertexStream));
+	}
+
+	if (size > std::numeric_limits<std::size_t>::max())
+		return 0;
+	return static_cast<std::size_t>(size);
+}
+
+bool InputContainerWriter::write(void* outData, std::size_t size) const
+{
+	VFC_TRACE_SCOPE("InputContainerWriter::write");
+	if (m_sectionAlignment < sizeof(std::uint64_t) ||
+		(m_sectionAlignment & (m_sectionAlignment - 1)) != 0 ||
+		m_patchPoints > std::numeric_limits<std::uint16_t>::max())
+	{
+		return false;
+	}
+
+	std::size_t fileSize = getSize();
+	std::uint64_t headerSize = getHeaderSize();
+	if (!outData || fileSize == 0 || size < fileSize ||
+		headerSize > std::numeric_limits<std::uint32_t>::max())
+	{
+		return false;
+	}
+
+	std::uint32_t elementCount = 0;
+	for (const VertexFormat& vertexFormat : m_vertexFormat)
+		elementCount += static_cast<std::uint32_t>(vertexFormat.size());
+	for (const InputVertexStream& vertexStream : m_vertexStreams)
+	{
+		if ((vertexStream.vertexCount > 0 && !vertexStream.vertexData) ||
+			(vertexStream.indexType != IndexType::NoIndices && vertexStream.indexCount > 0 &&
+				!vertexStream.indexData))
+		{
+			return false;
+		}
+		elementCount += static_cast<std::uint32_t>(vertexStream.vertexFormat.size());
+	}
+
+	auto data = reinterpret_cast<std::uint8_t*>(outData);
+	// Zero everything so padding and reserved values are consistent.
+	std::memset(data, 0, fileSize);
+
+	auto header = reinterpret_cast<InputContainerHeader*>(data);
+	std::memcpy(header->magic, inputContainerMagic, sizeof(inputContainerMagic));
+	header->version = inputContainerVersion;
+	header->fileSize = fileSize;
+	header->headerSize = static_cast<std::uint32_t>(headerSize);
+	header->sectionAlignment = m_sectionAlignment;
+	header->vertexFormatCount = static_cast<std::uint32_t>(m_vertexFormat.size());
+	header->vertexStreamCount = static_cast<std::uint32_t>(m_vertexStreams.size());
+	header->elementCount = elementCount;
+	header->transformCount = static_cast<std::uint32_t>(m_transforms.size());
+	header->indexType = m_indexType;
+	header->primitiveType = m_primitiveType;
+	header->patchPoints = static_cast<std::uint16_t>(m_patchPoints);
+
+	auto formats = reinterpret_cast<InputContainerFormat*>(header + 1);
+	auto vertexStreams =
+		reinterpret_cast<InputContainerVertexStream*>(formats + m_vertexFormat.size());
+	auto elements =
+		reinterpret_cast<InputContainerElement*>(vertexStreams + m_vertexStreams.size());
+	auto transforms = reinterpret_cast<InputContainerTransform*>(elements + elementCount);
+	auto stringTable = reinterpret_cast<char*>(transforms + m_transforms.size());
+
+	std::uint32_t stringTableSize = 0;
+	InputContainerElement* curElement = elements;
+	for (std::size_t i = 0; i < m_vertexFormat.size(); ++i)
+	{
+		formats[i].firstElement = static_cast<std::uint32_t>(curElement - elements);
+		formats[i].elementCount = static_cast<std::uint32_t>(m_vertexFormat[i].size());
+		curElement = writeElements(curElement, stringTable, stringTableSize, m_vertexFormat[i]);
+	}
+
+	std::uint64_t dataOffset = headerSize;
+	for (std::size_t i = 0; i < m_vertexStreams.size(); ++i)
+	{
+		const InputVertexStream& vertexStream = m_vertexStreams[i];
+		InputContainerVertexStream& curStream = vertexStreams[i];
+		curStream.firstElement = static_cast<std::uint32_t>(curElement - elements);
+		curStream.elementCount = static_cast<std::uint32_t>(vertexStream.vertexFormat.size());
+		curStream.indexType = vertexStream.indexType;
+		curElement = writeElements(curElement, stringTable, stringTableSize,
+			vertexStream.vertexFormat);
+
+		std::uint64_t vertexDataSize = getVertexDataSize(vertexStream);
+		curStream.vertexDataOffset = dataOffset;
+		curStream.vertexDataSize = vertexDataSize;
+		if (vertexDataSize > 0)
+		{
+			std::memcpy(data + dataOffset, vertexStream.vertexData,
+				static_cast<std::size_t>(vertexDataSize));
+		}
+		dataOffset += alignSize(vertexDataSize);
+
+		if (vertexStream.indexType == IndexType::NoIndices)
+			continue;
+
+		std::uint64_t indexDataSize = getIndexDataSize(vertexStream);
+		curStream.indexDataOffset = dataOffset;
+		curStream.indexDataSize = indexDataSize;
+		if (indexDataSize > 0)
+		{
+			std::memcpy(data + dataOffset, vertexStream.indexData,
+				static_cast<std::size_t>(indexDataSize));
+		}
+		dataOffset += alignSize(indexDataSize);
+	}
+
+	for (std::size_t i = 0; i < m_transforms.size(); ++i)
+	{
+		const std::string& name = m_transforms[i].first;
+		transforms[i].nameOffset = addString(stringTable, stringTableSize, name);
+		transforms[i].nameLength = static_cast<std::uint32_t>(name.size());
+		transforms[i].transform = static_cast<std::uint32_t>(m_transforms[i].second);
+	}
+	header->stringTableSize = stringTableSize;
+
+	return true;
+}
+
+std::uint64_t InputContainerWriter::getHeaderSize() const
+{
+	std::uint64_t elementCount = 0;
+	std::uint64_t stringTableSize = 0;
+	for (const VertexFormat& vertexFormat : m_vertexFormat)
+	{
+		elementCount += vertexFormat.size();
+		for (const VertexElement& element : vertexFormat)
+			stringTableSize += element.name.size() + 1;
+	}
+
+	for (const InputVertexStream& vertexStream : m_vertexStreams)
+	{
+		elementCount += vertexStream.vertexFormat.size();
+		for (const VertexElement& element : vertexStream.vertexFormat)
+			stringTableSize += element.name.size() + 1;
+	}
+
+	for (const auto& transform : m_transforms)
+		stringTableSize += transform.first.size() + 1;
+
+	return alignSize(getTablesSize(m_vertexFormat.size(), m_vertexStreams.size(), elementCount,
+		m_transforms.size(), stringTableSize));
+}
+
+std::uint64_t InputContainerWriter::alignSize(std::uint64_t size) const
+{
+	return (size + m_sectionAlignment - 1) & ~static_cast<std::uint64_t>(m_sectionAlignment - 1);
+}
+
+bool InputContainerReader::isInputContainer(const void* data, std::size_t size)
+{
+	return data && size >= sizeof(inputContainerMagic) &&
+		std::memcmp(data, inputContainerMagic, sizeof(inputContainerMagic)) == 0;
+}
+
+bool InputContainerReader::open(const void* data, std::size_t size)
+{
+	VFC_TRACE_SCOPE("InputContainerReader::open");
+	m_data = reinterpret_cast<const std::uint8_t*>(data);
+	m_vertexFormat.clear();
+	m_vertexStreams.clear();
+	m_transforms.clear();
+	if (!m_data || !validate(size))
+	{
+		m_data = nullptr;
+		m_header = nullptr;
+		m_vertexFormat.clear();
+		m_indexType = IndexType::NoIndices;
+		m_primitiveType = PrimitiveType::TriangleList;
+		m_patchPoints = 0;
+		m_vertexStreams.clear();
+		m_transforms.clear();
+		return false;
+	}
+
+	return true;
+}
+
+bool InputContainerReader::setupConverter(Converter& converter) const
+{
+	for (const InputVertexStream& vertexStream : m_vertexStreams)
+	{
+		if (!converter.addVertexStream(vertexStream.vertexFormat, vertexStream.vertexData,
+				vertexStream.vertexCount, vertexStream.indexType, vertexStream.indexData,
+				vertexStream.indexCount))
+		{
+			return false;
+		}
+	}
+
+	for (const auto& transform : m_transforms)
+	{
+		if (!converter.setElementTransform(transform.first, transform.second))
+			return false;
+	}
+
+	return true;
+}
+
+bool InputContainerReader::readVertexFormat(VertexFormat& outVertexFormat,
+	std::uint32_t firstElement, std::uint32_t elementCount) const
+{
+	if (firstElement > m_header->elementCount ||
+		elementCount > m_header->elementCount - firstElement)
+	{
+		return false;
+	}
+
+	// Re-construct the vertex format, which also validates the elements.
+	auto elements = reinterpret_cast<const InputContainerElement*>(
+		reinterpret_cast<const InputContainerVertexStream*>(
+			reinterpret_cast<const InputContainerFormat*>(m_header + 1) +
+			m_header->vertexFormatCount) + m_header->vertexStreamCount);
+	std::string name;
+	for (std::uint32_t i = 0; i < elementCount; ++i)
+	{
+		const InputContainerElement& element = elements[firstElement + i];
+		if (!readString(name, element.nameOffset, element.nameLength) ||
+			outVertexFormat.appendElement(std::move(name), element.layout, element.type) !=
+				VertexFormat::AddResult::Succeeded)
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
+
+bool InputContainerReader::readString(std::string& outString, std::uint32_t offset,
+	std::uint32_t length) const
+{
+	std::uint32_t stringTableSize = m_header->stringTableSize;
+	const char* stringTable = reinterpret_cast<const char*>(m_data) +
+		getTablesSize(m_header->vertexFormatCount, m_header->vertexStreamCount,
+			m_header->elementCount, m_header->transformCount, 0);
+	if (offset >= stringTableSize || length >= stringTableSize - offset ||
+		stringTable[offset + length] != 0)
+	{
+		return false;
+	}
+
+	outString.assign(stringTable + offset, length);
+	return true;
+}
+
+bool InputContainerReader::validate(std::size_t size)
+{
+	if (size < sizeof(InputContainerHeader))
+		return false;
+
+	auto header = reinterpret_cast<const InputContainerHeader*>(m_data);
+	std::uint32_t alignment = header->sectionAlignment;
+	if (std::memcmp(header->magic, inputContainerMagic, sizeof(inputContainerMagic)) != 0 ||
+		header->version != inputContainerVersion || header->fileSize > size ||
+		alignment < sizeof(std::uint64_t) || (alignment & (alignment - 1)) != 0 ||
+		header->headerSize > header->fileSize ||
+		getTablesSize(header->vertexFormatCount, header->vertexStreamCount,
+			header->elementCount, header->transformCount, header->stringTableSize) >
+			header->headerSize ||
+		header->indexType > IndexType::UInt32 ||
+		header->primitiveType < PrimitiveType::PointList ||
+		header->primitiveType > PrimitiveType::PatchList)
+	{
+		return false;
+	}
+
+	m_header = header;
+	auto formats = reinterpret_cast<const InputContainerFormat*>(header + 1);
+	auto vertexStreams =
+		reinterpret_cast<const InputContainerVertexStream*>(formats + header->vertexFormatCount);
+	auto elements =
+		reinterpret_cast<const InputContainerElement*>(vertexStreams + header->vertexStreamCount);
+	auto transforms =
+		reinterpret_cast<const InputContainerTransform*>(elements + header->elementCount);
+
+	m_vertexFormat.resize(header->vertexFormatCount);
+	for (std::uint32_t i = 0; i < header->vertexFormatCount; ++i)
+	{
+		if (!readVertexFormat(m_vertexFormat[i], formats[i].firstElement, formats[i].elementCount))
+			return false;
+	}
+
+	m_vertexStreams.resize(header->vertexStreamCount);
+	for (std::uint32_t i = 0; i < header->vertexStreamCount; ++i)
+	{
+		const InputContainerVertexStream& curStream = vertexStreams[i];
+		InputVertexStream& vertexStream = m_vertexStreams[i];
+		if (!readVertexFormat(vertexStream.vertexFormat, curStream.firstElement,
+				curStream.elementCount) ||
+			vertexStream.vertexFormat.empty() || curStream.indexType > IndexType::UInt32 ||
+			!isSectionValid(curStream.vertexDataOffset, curStream.vertexDataSize,
+				header->headerSize, header->fileSize, alignment) ||
+			curStream.vertexDataSize % vertexStream.vertexFormat.stride() != 0 ||
+			curStream.vertexDataSize/vertexStream.vertexFormat.stride() >
+				std::numeric_limits<std::uint32_t>::max())
+		{
+			return false;
+		}
+
+		vertexStream.vertexData = m_data + curStream.vertexDataOffset;
+		vertexStream.vertexCount = static_cast<std::uint32_t>(
+			curStream.vertexDataSize/vertexStream.vertexFormat.stride());
+		vertexStream.indexType = curStream.indexType;
+		vertexStream.indexData = nullptr;
+		vertexStream.indexCount = 0;
+		if (curStream.indexType == IndexType::NoIndices)
+			continue;
+
+		std::uint32_t curIndexSize = indexSize(curStream.indexType);
+		if (!isSectionValid(curStream.indexDataOffset, curStream.indexDataSize,
+				header->headerSize, header->fileSize, alignment) ||
+			curStream.indexDataSize % curIndexSize != 0 ||
+			curStream.indexDataSize/curIndexSize > std::numeric_limits<std::uint32_t>::max())
+		{
+			return false;
+		}
+
+		vertexStream.indexData = m_data + curStream.indexDataOffset;
+		vertexStream.indexCount = static_cast<std::uint32_t>(curStream.indexDataSize/curIndexSize);
+	}
+
+	m_transforms.resize(header->transformCount);
+	const auto maxTransform = static_cast<std::uint32_t>(Converter::Transform::SNormToUNorm);
+	for (std::uint32_t i = 0; i < header->transformCount; ++i)
+	{
+		const InputContainerTransform& curTransform = transforms[i];
+		if (curTransform.transform > maxTransform ||
+			!readString(m_transforms[i].first, curTransform.nameOffset, curTransform.nameLength))
+		{
+			return false;
+		}
+
+		m_transforms[i].second = static_cast<Converter::Transform>(curTransform.transform);
+	}
+
+	m_indexType = header->indexType;
+	m_primitiveType = header->primitiveType;
+	m_patchPoints = header->patchPoints;
+	return true;
+}
+
+} // namespace vfc
@@ -0,0 +1,617 @@
+/*
+ * Copyright 2026 Aaron Barany
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <VFC/Simplifier.h>
+#include <VFC/Trace.h>
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <string>
+
+namespace vfc
+{
+
+namespace
+{
+
+struct Position
+{
+	double x, y, z;
+};
+
+inline Position operator-(const Position& left, const Position& right)
+{
+	return Position{left.x - right.x, left.y - right.y, left.z - right.z};
+}
+
+inline Position cross(const Position& left, const Position& right)
+{
+	return Position{left.y*right.z - left.z*right.y, left.z*right.x - left.x*right.z,
+		left.x*right.y - left.y*right.x};
+}
+
+inline double dot(const Position& left, const Position& right)
+{
+	return left.x*right.x + left.y*right.y + left.z*right.z;
+}
+
+// Symmetric 4x4 matrix for the sum of squared distances to planes, weighted by area.
+struct Quadric
+{
+	double xx, yy, zz, xy, xz, yz, xw, yw, zw, ww;
+	double weight;
+};
+
+Quadric& operator+=(Quadric& left, const Quadric& right)
+{
+	left.xx += right.xx;
+	left.yy += right.yy;
+	left.zz += right.zz;
+	left.xy += right.xy;
+	left.xz += right.xz;
+	left.yz += right.yz;
+	left.xw += right.xw;
+	left.yw += right.yw;
+	left.zw += right.zw;
+	left.ww += right.ww;
+	left.weight += right.weight;
+	return left;
+}
+
+void addPlane(Quadric& quadric, const Position& normal, double distance, double weight)
+{
+	quadric.xx += normal.x*normal.x*weight;
+	quadric.yy += normal.y*normal.y*weight;
+	quadric.zz += normal.z*normal.z*weight;
+	quadric.xy += normal.x*normal.y*weight;
+	quadric.xz += normal.x*normal.z*weight;
+	quadric.yz += normal.y*normal.z*weight;
+	quadric.xw += normal.x*distance*weight;
+	quadric.yw += normal.y*distance*weight;
+	quadric.zw += normal.z*distance*weight;
+	quadric.ww += distance*distance*weight;
+	quadric.weight += weight;
+}
+
+double evaluate(const Quadric& quadric, const Position& p)
+{
+	double result = quadric.xx*p.x*p.x + quadric.yy*p.y*p.y + quadric.zz*p.z*p.z +
+		2*(quadric.xy*p.x*p.y + quadric.xz*p.x*p.z + quadric.yz*p.y*p.z + quadric.xw*p.x +
+			quadric.yw*p.y + quadric.zw*p.z) + quadric.ww;
+	// Avoid negative values due to round-off.
+	return std::max(result, 0.0);
+}
+
+Position readPosition(const std::uint8_t* data, const VertexElement& element,
+	Converter::Transform transform, const VertexValue& boundsMin, const VertexValue& boundsMax)
+{
+	VertexValue value;
+	value.fromData(data, element.layout, element.type);
+	for (unsigned int i = 0; i < 3; ++i)
+	{
+		switch (transform)
+		{
+			case Converter::Transform::Identity:
+				break;
+			case Converter::Transform::Bounds:
+				if (element.type == ElementType::UNorm)
+					value[i] = boundsMin[i] + value[i]*(boundsMax[i] - boundsMin[i]);
+				else if (element.type == ElementType::SNorm)
+					value[i] = boundsMin[i] + (value[i] + 1)*0.5*(boundsMax[i] - boundsMin[i]);
+				break;
+			case Converter::Transform::UNormToSNorm:
+				value[i] = (value[i] + 1)*0.5;
+				break;
+			case Converter::Transform::SNormToUNorm:
+				value[i] = value[i]*2 - 1;
+				break;
+		}
+	}
+	return Position{value[0], value[1], value[2]};
+}
+
+struct Collapse
+{
+	std::uint32_t source;
+	std::uint32_t target;
+	double cost;
+
+	bool operator<(const Collapse& other) const
+	{
+		return cost < other.cost;
+	}
+};
+
+// Simplifies a single index buffer, keeping the state between levels of detail.
+class BufferSimplifier
+{
+public:
+	BufferSimplifier(std::vector<Position> positions, std::vector<std::uint32_t> triangles);
+
+	double simplify(std::size_t targetTriangleCount);
+
+	const std::vector<std::uint32_t>& getTriangles() const
+	{
+		return m_triangles;
+	}
+
+private:
+	void buildAdjacency();
+	void lockBorders();
+	bool collapsePass(std::size_t targetTriangleCount);
+	bool canCollapse(std::uint32_t source, std::uint32_t target);
+
+	std::vector<Position> m_positions;
+	std::vector<Quadric> m_quadrics;
+	std::vector<std::uint8_t> m_locked;
+	std::vector<std::uint32_t> m_triangles;
+
+	// Triangles for each vertex, where the triangles for vertex i are in the range
+	// [m_adjacencyOffsets[i], m_adjacencyOffsets[i + 1]).
+	std::vector<std::uint32_t> m_adjacencyOffsets;
+	std::vector<std::uint32_t> m_adjacency;
+
+	std::vector<Collapse> m_collapses;
+	std::vector<std::uint8_t> m_collapseLocked;
+	std::vector<std::uint32_t> m_remap;
+	std::vector<std::uint32_t> m_neighborMarks;
+	std::uint32_t m_curMark;
+	double m_maxError;
+};
+
+BufferSimplifier::BufferSimplifier(std::vector<Position> positions,
+	std::vector<std::uint32_t> triangles)
+	: m_positions(std::move(positions))
+	, m_triangles(std::move(triangles))
+	, m_curMark(0)
+	, m_maxError(0)
+{
+	std::size_t vertexCount = m_positions.size();
+	m_quadrics.resize(vertexCount, Quadric{0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0});
+	for (std::size_t i = 0; i < m_triangles.size(); i += 3)
+	{
+		const std::uint32_t* triangle = m_triangles.data() + i;
+		const Position& p0 = m_positions[triangle[0]];
+		Position normal = cross(m_positions[triangle[1]] - p0, m_positions[triangle[2]] - p0);
+		double length = std::sqrt(dot(normal, normal));
+		if (length == 0)
+			continue;
+
+		normal = Position{normal.x/length, normal.y/length, normal.z/length};
+		double area = length*0.5;
+		double distance = -dot(normal, p0);
+		for (unsigned int j = 0; j < 3; ++j)
+			addPlane(m_quadrics[triangle[j]], normal, distance, area);
+	}
+
+	m_locked.resize(vertexCount, false);
+	m_collapseLocked.resize(vertexCount);
+	m_remap.resize(vertexCount);
+	m_neighborMarks.resize(vertexCount, 0);
+	buildAdjacency();
+	lockBorders();
+}
+
+double BufferSimplifier::simplify(std::size_t targetTriangleCount)
+{
+	while (m_triangles.size()/3 > targetTriangleCount && collapsePass(targetTriangleCount))
+		buildAdjacency();
+	return std::sqrt(m_maxError);
+}
+
+void BufferSimplifier::buildAdjacency()
+{
+	m_adjacencyOffsets.assign(m_positions.size() + 1, 0);
+	for (std::uint32_t index : m_triangles)
+		++m_adjacencyOffsets[index + 1];
+	for (std::size_t i = 1; i < m_adjacencyOffsets.size(); ++i)
+		m_adjacencyOffsets[i] += m_adjacencyOffsets[i - 1];
+
+	// Fill using the start offsets, then shift back afterward.
+	m_adjacency.resize(m_triangles.size());
+	for (std::size_t i = 0; i < m_triangles.size(); ++i)
+		m_adjacency[m_adjacencyOffsets[m_triangles[i]]++] = static_cast<std::uint32_t>(i/3);
+	for (std::size_t i = m_adjacencyOffsets.size() - 1; i > 0; --i)
+		m_adjacencyOffsets[i] = m_adjacencyOffsets[i - 1];
+	m_adjacencyOffsets[0] = 0;
+}
+
+void BufferSimplifier::lockBorders()
+{
+	// Each edge of a closed manifold surface is used once in each direction. Edges that don't are
+	// on a border, which includes attribute seams since the vertices on each side of the seam are
+	// different.
+	for (std::size_t i = 0; i < m_triangles.size(); i += 3)
+	{
+		const std::uint32_t* triangle = m_triangles.data() + i;
+		for (unsigned int j = 0; j < 3; ++j)
+		{
+			std::uint32_t first = triangle[j];
+			std::uint32_t second = triangle[(j + 1) % 3];
+			unsigned int forwardCount = 0;
+			unsigned int reverseCount = 0;
+			for (std::uint32_t k = m_adjacencyOffsets[first]; k < m_adjacencyOffsets[first + 1];
+				++k)
+			{
+				const std::uint32_t* other = m_triangles.data() + m_adjacency[k]*3;
+				for (unsigned int m = 0; m < 3; ++m)
+				{
+					if (other[m] != first)
+						continue;
+
+					forwardCount += other[(m + 1) % 3] == second;
+					reverseCount += other[(m + 2) % 3] == second;
+				}
+			}
+
+			if (forwardCount != 1 || reverseCount != 1)
+				m_locked[first] = m_locked[second] = true;
+		}
+	}
+}
+
+bool BufferSimplifier::collapsePass(std::size_t targetTriangleCount)
+{
+	// Each interior edge is listed once in each direction, so only take the edge where the first
+	// index is smaller. Edges with both vertices locked can't be collapsed.
+	m_collapses.clear();
+	for (std::size_t i = 0; i < m_triangles.size(); i += 3)
+	{
+		const std::uint32_t* triangle = m_triangles.data() + i;
+		for (unsigned int j = 0; j < 3; ++j)
+		{
+			std::uint32_t first = triangle[j];
+			std::uint32_t second = triangle[(j + 1) % 3];
+			if (first >= second || (m_locked[first] && m_locked[second]))
+				continue;
+
+			Quadric quadric = m_quadrics[first];
+			quadric += m_quadrics[second];
+			Collapse collapse = {first, second, evaluate(quadric, m_positions[second])};
+			if (!m_locked[second])
+			{
+				double reverseCost = evaluate(quadric, m_positions[first]);
+				if (m_locked[first] || reverseCost < collapse.cost)
+					collapse = Collapse{second, first, reverseCost};
+			}
+			m_collapses.push_back(collapse);
+		}
+	}
+
+	if (m_collapses.empty())
+		return false;
+
+	// Each collapse typically removes two triangles. Limit the cost to avoid collapsing edges that
+	// are much more expensive than needed to reach the target.
+	std::sort(m_collapses.begin(), m_collapses.end());
+	std::size_t triangleCount = m_triangles.size()/3;
+	std::size_t goal = std::min((triangleCount - targetTriangleCount + 1)/2,
+		m_collapses.size() - 1);
+	double costLimit = m_collapses[goal].cost*1.5;
+
+	std::fill(m_collapseLocked.begin(), m_collapseLocked.end(), false);
+	for (std::size_t i = 0; i < m_remap.size(); ++i)
+		m_remap[i] = static_cast<std::uint32_t>(i);
+
+	bool collapsed = false;
+	for (const Collapse& collapse : m_collapses)
+	{
+		if (triangleCount <= targetTriangleCount || collapse.cost > costLimit)
+			break;
+
+		std::uint32_t source = collapse.source;
+		std::uint32_t target = collapse.target;
+		if (m_collapseLocked[source] || m_collapseLocked[target] || !canCollapse(source, target))
+			continue;
+
+		// Lock the neighborhood of the source vertex so the triangles used to check later
+		// collapses in this pass are up to date.
+		for (std::uint32_t j = m_adjacencyOffsets[source]; j < m_adjacencyOffsets[source + 1];
+			++j)
+		{
+			const std::uint32_t* triangle = m_triangles.data() + m_adjacency[j]*3;
+			bool removed = false;
+			for (unsigned int k = 0; k < 3; ++k)
+			{
+				m_collapseLocked[triangle[k]] = true;
+				removed |= triangle[k] == target;
+			}
+			triangleCount -= removed;
+		}
+
+		m_remap[source] = target;
+		m_quadrics[target] += m_quadrics[source];
+		const Quadric& quadric = m_quadrics[target];
+		if (quadric.weight > 0)
+		{
+			m_maxError =
+				std::max(m_maxError, evaluate(quadric, m_positions[target])/quadric.weight);
+		}
+		collapsed = true;
+	}
+
+	if (!collapsed)
+		return false;
+
+	std::size_t writeIndex = 0;
+	for (std::size_t i = 0; i < m_triangles.size(); i += 3)
+	{
+		std::uint32_t v0 = m_remap[m_triangles[i]];
+		std::uint32_t v1 = m_remap[m_triangles[i + 1]];
+		std::uint32_t v2 = m_remap[m_triangles[i + 2]];
+		if (v0 == v1 || v0 == v2 || v1 == v2)
+			continue;
+
+		m_triangles[writeIndex++] = v0;
+		m_triangles[writeIndex++] = v1;
+		m_triangles[writeIndex++] = v2;
+	}
+	m_triangles.resize(writeIndex);
+	return true;
+}
+
+bool BufferSimplifier::canCollapse(std::uint32_t source, std::uint32_t target)
+{
+	// The vertices may only share the two vertices opposite the edge, otherwise the collapse
+	// would fold the surface onto itself.
+	if (++m_curMark == 0)
+	{
+		std::fill(m_neighborMarks.begin(), m_neighborMarks.end(), 0);
+		m_curMark = 1;
+	}
+
+	for (std::uint32_t i = m_adjacencyOffsets[source]; i < m_adjacencyOffsets[source + 1]; ++i)
+	{
+		const std::uint32_t* triangle = m_triangles.data() + m_adjacency[i]*3;
+		for (unsigned int j = 0; j < 3; ++j)
+			m_neighborMarks[triangle[j]] = m_curMark;
+	}
+
+	unsigned int sharedCount = 0;
+	for (std::uint32_t i = m_adjacencyOffsets[target]; i < m_adjacencyOffsets[target + 1]; ++i)
+	{
+		const std::uint32_t* triangle = m_triangles.data() + m_adjacency[i]*3;
+		for (unsigned int j = 0; j < 3; ++j)
+		{
+			std::uint32_t vertex = triangle[j];
+			if (vertex != source && vertex != target && m_neighborMarks[vertex] == m_curMark)
+			{
+				// Count each shared vertex once.
+				m_neighborMarks[vertex] = 0;
+				++sharedCount;
+			}
+		}
+	}
+
+	if (sharedCount > 2)
+		return false;
+
+	// Reject collapses that flip or sharply rotate the remaining triangles.
+	const Position& targetPos = m_positions[target];
+	for (std::uint32_t i = m_adjacencyOffsets[source]; i < m_adjacencyOffsets[source + 1]; ++i)
+	{
+		const std::uint32_t* triangle = m_triangles.data() + m_adjacency[i]*3;
+		unsigned int sourceIndex = 0;
+		bool hasTarget = false;
+		for (unsigned int j = 0; j < 3; ++j)
+		{
+			if (triangle[j] == source)
+				sourceIndex = j;
+			hasTarget |= triangle[j] == target;
+		}
+
+		if (hasTarget)
+			continue;
+
+		const Position& p1 = m_positions[triangle[(sourceIndex + 1) % 3]];
+		const Position& p2 = m_positions[triangle[(sourceIndex + 2) % 3]];
+		Position edge = p2 - p1;
+		Position before = cross(edge, m_positions[source] - p1);
+		Position after = cross(edge, targetPos - p1);
+		double beforeLength2 = dot(before, before);
+		if (beforeLength2 == 0)
+			continue;
+
+		double afterDot = dot(before, after);
+		if (afterDot <= 0 || afterDot*afterDot < 0.25*beforeLength2*dot(after, after))
+			return false;
+	}
+
+	return true;
+}
+
+template <typename T>
+void writeIndices(std::uint8_t* outData, const std::vector<std::uint32_t>& triangles)
+{
+	for (std::uint32_t index : triangles)
+	{
+		auto value = static_cast<T>(index);
+		std::memcpy(outData, &value, sizeof(T));
+		outData += sizeof(T);
+	}
+}
+
+} // namespace
+
+Simplifier::Simplifier(ErrorFunction errorFunction)
+	: m_errorFunction(std::move(errorFunction))
+	, m_positionTransform(Converter::Transform::Identity)
+{
+}
+
+bool Simplifier::simplify(const VertexFormat& vertexFormat, const void* vertexData,
+	std::uint32_t vertexCount, const char* positionName, const std::vector<IndexData>& indices,
+	PrimitiveType primitiveType, const std::vector<double>& ratios)
+{
+	VFC_TRACE_SCOPE("Simplifier::simplify");
+	m_indices.clear();
+	m_lodIndices.clear();
+	m_lodErrors.clear();
+
+	if (primitiveType != PrimitiveType::TriangleList)
+	{
+		logError("Only triangle lists may be simplified.");
+		return false;
+	}
+
+	auto positionElement = vertexFormat.find(positionName);
+	if (positionElement == vertexFormat.end())
+	{
+		std::string message = "No vertex element '";
+		message += positionName;
+		message += "' found for the position.";
+		logError(message.c_str());
+		return false;
+	}
+
+	for (std::size_t i = 0; i < ratios.size(); ++i)
+	{
+		if (!(ratios[i] > 0 && ratios[i] <= 1) || (i > 0 && ratios[i] > ratios[i - 1]))
+		{
+			logError("LOD ratios must be in the range (0, 1] and in decreasing order.");
+			return false;
+		}
+	}
+
+	for (const IndexData& indexData : indices)
+	{
+		if (indexData.type != IndexType::UInt16 && indexData.type != IndexType::UInt32)
+		{
+			logError("Simplifying requires index data.");
+			return false;
+		}
+
+		if (indexData.count % 3 != 0)
+		{
+			logError("Index count must be a multiple of 3 for triangle lists.");
+			return false;
+		}
+	}
+
+	m_indices.resize(ratios.size());
+	m_lodIndices.resize(ratios.size());
+	m_lodErrors.resize(ratios.size(), 0.0);
+
+	auto vertexBytes = reinterpret_cast<const std::uint8_t*>(vertexData);
+	std::size_t stride = vertexFormat.stride();
+	std::vector<std::vector<std::size_t>> indexOffsets(ratios.size());
+	for (const IndexData& indexData : indices)
+	{
+		std::vector<std::uint32_t> triangles(indexData.count);
+		std::uint32_t maxIndex = 0;
+		for (std::uint32_t i = 0; i < indexData.count; ++i)
+		{
+			if (indexData.type == IndexType::UInt16)
+				triangles[i] = reinterpret_cast<const std::uint16_t*>(indexData.data)[i];
+			else
+				triangles[i] = reinterpret_cast<const std::uint32_t*>(indexData.data)[i];
+			maxIndex = std::max(maxIndex, triangles[i]);
+		}
+
+		std::int64_t localVertexCount =
+			triangles.empty() ? 0 : static_cast<std::int64_t>(maxIndex) + 1;
+		if (indexData.baseVertex < 0 || indexData.baseVertex + localVertexCount > vertexCount)
+		{
+			logError("Index value out of range of the vertices.");
+			m_indices.clear();
+			m_lodIndices.clear();
+			m_lodErrors.clear();
+			return false;
+		}
+
+		std::vector<Position> positions(static_cast<std::size_t>(localVertexCount));
+		for (std::size_t i = 0; i < positions.size(); ++i)
+		{
+			std::size_t offset = (static_cast<std::size_t>(indexData.baseVertex) + i)*stride +
+				positionElement->offset;
+			positions[i] = readPosition(vertexBytes + offset, *positionElement,
+				m_positionTransform, m_positionMin, m_positionMax);
+		}
+
+		std::size_t triangleCount = triangles.size()/3;
+		BufferSimplifier simplifier(std::move(positions), std::move(triangles));
+		unsigned int indexSize = vfc::indexSize(indexData.type);
+		for (std::size_t i = 0; i < ratios.size(); ++i)
+		{
+			auto targetTriangleCount = static_cast<std::size_t>(
+				std::floor(static_cast<double>(triangleCount)*ratios[i]));
+			m_lodErrors[i] =
+				std::max(m_lodErrors[i], simplifier.simplify(targetTriangleCount));
+
+			const std::vector<std::uint32_t>& lodTriangles = simplifier.getTriangles();
+			std::vector<std::uint8_t>& lodData = m_indices[i];
+			std::size_t offset = lodData.size();
+			indexOffsets[i].push_back(offset);
+			lodData.resize(offset + lodTriangles.size()*indexSize);
+			if (indexData.type == IndexType::UInt16)
+				writeIndices<std::uint16_t>(lodData.data() + offset, lodTriangles);
+			else
+				writeIndices<std::uint32_t>(lodData.data() + offset, lodTriangles);
+
+			m_lodIndices[i].push_back(IndexData{nullptr, indexData.type,
+				static_cast<std::uint32_t>(lodTriangles.size()), indexData.baseVertex});
+		}
+	}
+
+	// Set the data pointers once each level of detail's data is fully allocated.
+	for (std::size_t i = 0; i < ratios.size(); ++i)
+	{
+		for (std::size_t j = 0; j < m_lodIndices[i].size(); ++j)
+			m_lodIndices[i][j].data = m_indices[i].data() + indexOffsets[i][j];
+	}
+
+	return true;
+}
+
+bool Simplifier::simplify(const Converter& converter, const char* positionName,
+	const std::vector<double>& ratios)
+{
+	const std::vector<VertexFormat>& vertexFormat = converter.getVertexFormat();
+	const std::vector<std::vector<std::uint8_t>>& vertices = converter.getVertices();
+	for (std::size_t i = 0; i < vertexFormat.size(); ++i)
+	{
+		auto positionElement = vertexFormat[i].find(positionName);
+		if (positionElement == vertexFormat[i].end())
+			continue;
+
+		if (converter.getVertexCount() > 0 && vertices[i].empty())
+		{
+			logError("Converted vertices aren't available when using an output buffer function.");
+			return false;
+		}
+
+		VertexValue boundsMin, boundsMax;
+		converter.getVertexElementBounds(boundsMin, boundsMax, i,
+			positionElement - vertexFormat[i].begin());
+		setPositionTransform(converter.getElementTransform(positionName), boundsMin, boundsMax);
+		return simplify(vertexFormat[i], vertices[i].data(), converter.getVertexCount(),
+			positionName, converter.getIndices(), converter.getPrimitiveType(), ratios);
+	}
+
+	std::string message = "No vertex element '";
+	message += positionName;
+	message += "' found for the position.";
+	logError(message.c_str());
+	return false;
+}
+
+void Simplifier::logError(const char* message) const
+{
+	if (m_errorFunction)
+		m_errorFunction(message);
+}
+
+} // namespace vfc
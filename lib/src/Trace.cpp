@@ -0,0 +1,204 @@
+/*
+ * Copyright 2026 Aaron Barany
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <VFC/Trace.h>
+
+#include <atomic>
+#include <cstdio>
+#include <mutex>
+#include <vector>
+
+namespace vfc
+{
+
+namespace
+{
+
+struct TraceEvent
+{
+	const char* name;
+	std::string detail;
+	Trace::Clock::time_point startTime;
+	Trace::Clock::time_point endTime;
+	std::uint32_t threadId;
+};
+
+struct TraceState
+{
+	std::atomic<bool> enabled{false};
+	std::mutex mutex;
+	Trace::Clock::time_point startTime;
+	std::vector<TraceEvent> events;
+	std::uint32_t nextThreadId = 1;
+};
+
+TraceState& getState()
+{
+	static TraceState state;
+	return state;
+}
+
+// Sequential IDs are easier to read in trace viewers than hashes of std::thread::id.
+std::uint32_t getThreadId(TraceState& state)
+{
+	thread_local std::uint32_t threadId = 0;
+	if (threadId == 0)
+		threadId = state.nextThreadId++;
+	return threadId;
+}
+
+long long toMicroseconds(Trace::Clock::duration duration)
+{
+	return static_cast<long long>(
+		std::chrono::duration_cast<std::chrono::microseconds>(duration).count());
+}
+
+void writeString(std::ostream& stream, const char* str)
+{
+	stream << '"';
+	for (const char* c = str; *c; ++c)
+	{
+		switch (*c)
+		{
+			case '"':
+				stream << "\\\"";
+				break;
+			case '\\':
+				stream << "\\\\";
+				break;
+			case '\n':
+				stream << "\\n";
+				break;
+			case '\r':
+				stream << "\\r";
+				break;
+			case '\t':
+				stream << "\\t";
+				break;
+			default:
+				if (static_cast<unsigned char>(*c) < 0x20)
+				{
+					char buffer[7];
+					std::snprintf(buffer, sizeof(buffer), "\\u%04x",
+						static_cast<unsigned int>(*c));
+					stream << buffer;
+				}
+				else
+					stream << *c;
+				break;
+		}
+	}
+	stream << '"';
+}
+
+} // namespace
+
+void Trace::start()
+{
+	TraceState& state = getState();
+	std::lock_guard<std::mutex> lock(state.mutex);
+	state.events.clear();
+	state.startTime = Clock::now();
+	state.enabled = true;
+}
+
+void Trace::stop()
+{
+	getState().enabled = false;
+}
+
+bool Trace::isEnabled()
+{
+	return getState().enabled;
+}
+
+void Trace::addEvent(const char* name, std::string detail, Clock::time_point startTime,
+	Clock::time_point endTime)
+{
+	TraceState& state = getState();
+	if (!state.enabled)
+		return;
+
+	std::lock_guard<std::mutex> lock(state.mutex);
+	state.events.push_back(
+		TraceEvent{name, std::move(detail), startTime, endTime, getThreadId(state)});
+}
+
+std::size_t Trace::getEventCount()
+{
+	TraceState& state = getState();
+	std::lock_guard<std::mutex> lock(state.mutex);
+	return state.events.size();
+}
+
+bool Trace::writeChromeTrace(std::ostream& stream)
+{
+	TraceState& state = getState();
+	std::lock_guard<std::mutex> lock(state.mutex);
+	stream << "{\"traceEvents\": [";
+	for (std::size_t i = 0; i < state.events.size(); ++i)
+	{
+		const TraceEvent& event = state.events[i];
+		stream << (i == 0 ? "\n" : ",\n") << "\t{\"name\": ";
+		writeString(stream, event.name);
+		stream << ", \"cat\": \"vfc\", \"ph\": \"X\", \"ts\": " <<
+			toMicroseconds(event.startTime - state.startTime) << ", \"dur\": " <<
+			toMicroseconds(event.endTime - event.startTime) << ", \"pid\": 1, \"tid\": " <<
+			event.threadId;
+		if (!event.detail.empty())
+		{
+			stream << ", \"args\": {\"detail\": ";
+			writeString(stream, event.detail.c_str());
+			stream << "}";
+		}
+		stream << "}";
+	}
+	stream << "\n], \"displayTimeUnit\": \"ms\"}\n";
+	return stream.good();
+}
+
+ScopedTrace::ScopedTrace(const char* name, std::string detail)
+	: m_name(name)
+	, m_detail(std::move(detail))
+	, m_enabled(Trace::isEnabled())
+{
+	if (m_enabled)
+		m_startTime = Trace::Clock::now();
+}
+
+ScopedTrace::~ScopedTrace()
+{
+	end();
+}
+
+void ScopedTrace::next(const char* name, std::string detail)
+{
+	end();
+	m_name = name;
+	m_detail = std::move(detail);
+	m_enabled = Trace::isEnabled();
+	if (m_enabled)
+		m_startTime = Trace::Clock::now();
+}
+
+void ScopedTrace::end()
+{
+	if (m_enabled)
+		Trace::addEvent(m_name, std::move(m_detail), m_startTime, Trace::Clock::now());
+	m_enabled = false;
+}
+
+} // namespace vfc
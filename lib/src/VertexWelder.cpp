@@ -0,0 +1,148 @@
+/*
+ * Copyright 2026 Aaron Barany
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "VertexWelder.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <utility>
+
+namespace vfc
+{
+
+namespace
+{
+
+// Cells are larger than the tolerance so the range around a position usually only touches one or
+// two cells along each axis.
+constexpr double cellSizeScale = 4.0;
+constexpr unsigned int gridDimensions = 3;
+constexpr double maxCellCoord = static_cast<double>(std::int64_t(1) << 62);
+
+std::uint64_t cellKey(const std::int64_t coords[gridDimensions])
+{
+	std::uint64_t key = 0;
+	for (unsigned int i = 0; i < gridDimensions; ++i)
+		key = (key ^ static_cast<std::uint64_t>(coords[i]))*0x9e3779b97f4a7c15ULL;
+	return key ^ (key >> 29);
+}
+
+bool isPositionFinite(const VertexValue& position)
+{
+	for (unsigned int i = 0; i < gridDimensions; ++i)
+	{
+		if (!std::isfinite(position[i]))
+			return false;
+	}
+
+	return true;
+}
+
+} // namespace
+
+constexpr std::uint32_t VertexWelder::notFound;
+
+VertexWelder::VertexWelder(std::vector<double> tolerances, std::size_t positionElement)
+	: m_tolerances(std::move(tolerances))
+	, m_positionElement(positionElement)
+{
+	assert(m_positionElement < m_tolerances.size());
+	assert(m_tolerances[m_positionElement] > 0);
+	m_invCellSize = 1.0/(m_tolerances[m_positionElement]*cellSizeScale);
+}
+
+std::uint32_t VertexWelder::find(const VertexValue* values) const
+{
+	const VertexValue& position = values[m_positionElement];
+	if (!isPositionFinite(position))
+		return notFound;
+
+	double tolerance = m_tolerances[m_positionElement];
+	std::int64_t minCoords[gridDimensions];
+	std::int64_t maxCoords[gridDimensions];
+	for (unsigned int i = 0; i < gridDimensions; ++i)
+	{
+		minCoords[i] = cellCoord(position[i] - tolerance);
+		maxCoords[i] = cellCoord(position[i] + tolerance);
+	}
+
+	std::size_t elementCount = m_tolerances.size();
+	std::int64_t coords[gridDimensions];
+	for (coords[0] = minCoords[0]; coords[0] <= maxCoords[0]; ++coords[0])
+	{
+		for (coords[1] = minCoords[1]; coords[1] <= maxCoords[1]; ++coords[1])
+		{
+			for (coords[2] = minCoords[2]; coords[2] <= maxCoords[2]; ++coords[2])
+			{
+				auto range = m_grid.equal_range(cellKey(coords));
+				for (auto it = range.first; it != range.second; ++it)
+				{
+					if (matches(values, m_values.data() + it->second*elementCount))
+						return m_vertices[it->second];
+				}
+			}
+		}
+	}
+
+	return notFound;
+}
+
+void VertexWelder::add(const VertexValue* values, std::uint32_t vertexIndex)
+{
+	const VertexValue& position = values[m_positionElement];
+	if (!isPositionFinite(position))
+		return;
+
+	std::int64_t coords[gridDimensions];
+	for (unsigned int i = 0; i < gridDimensions; ++i)
+		coords[i] = cellCoord(position[i]);
+
+	auto candidate = static_cast<std::uint32_t>(m_vertices.size());
+	m_grid.emplace(cellKey(coords), candidate);
+	m_values.insert(m_values.end(), values, values + m_tolerances.size());
+	m_vertices.push_back(vertexIndex);
+}
+
+void VertexWelder::clear()
+{
+	m_grid.clear();
+	m_values.clear();
+	m_vertices.clear();
+}
+
+std::int64_t VertexWelder::cellCoord(double value) const
+{
+	double coord = std::floor(value*m_invCellSize);
+	return static_cast<std::int64_t>(std::min(std::max(coord, -maxCellCoord), maxCellCoord));
+}
+
+bool VertexWelder::matches(const VertexValue* values, const VertexValue* otherValues) const
+{
+	for (std::size_t i = 0; i < m_tolerances.size(); ++i)
+	{
+		double tolerance = m_tolerances[i];
+		for (unsigned int j = 0; j < VertexValue::count; ++j)
+		{
+			if (!(std::abs(values[i][j] - otherValues[i][j]) <= tolerance))
+				return false;
+		}
+	}
+
+	return true;
+}
+
+} // namespace vfc
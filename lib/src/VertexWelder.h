@@ -0,0 +1,60 @@
+/*
+ * Copyright 2026 Aaron Barany
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <VFC/Config.h>
+#include <VFC/VertexValue.h>
+
+#include <cstdint>
+#include <limits>
+#include <unordered_map>
+#include <vector>
+
+namespace vfc
+{
+
+// Finds previously added vertices where every element is within a tolerance of a new vertex. The
+// vertices are placed in a spatial hash grid based on the XYZ values of a position element, so
+// only vertices in the neighboring cells need to be compared.
+class VertexWelder
+{
+public:
+	static constexpr std::uint32_t notFound = std::numeric_limits<std::uint32_t>::max();
+
+	// Values for each vertex have one VertexValue per element, with tolerances for each element.
+	// Elements with a tolerance of 0 must match exactly. The position element must have a
+	// tolerance > 0.
+	VertexWelder(std::vector<double> tolerances, std::size_t positionElement);
+
+	std::uint32_t find(const VertexValue* values) const;
+	void add(const VertexValue* values, std::uint32_t vertexIndex);
+	void clear();
+
+private:
+	std::int64_t cellCoord(double value) const;
+	bool matches(const VertexValue* values, const VertexValue* otherValues) const;
+
+	std::vector<double> m_tolerances;
+	std::size_t m_positionElement;
+	double m_invCellSize;
+
+	std::unordered_multimap<std::uint64_t, std::uint32_t> m_grid;
+	std::vector<VertexValue> m_values;
+	std::vector<std::uint32_t> m_vertices;
+};
+
+} // namespace vfc
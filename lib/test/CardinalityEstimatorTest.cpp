@@ -0,0 +1,53 @@
+/*
+ * Copyright 2026 Aaron Barany
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "CardinalityEstimator.h"
+#include "Hash.h"
+#include <gtest/gtest.h>
+
+namespace
+{
+
+double estimateCount(std::uint32_t uniqueCount, unsigned int repeatCount)
+{
+	vfc::CardinalityEstimator estimator;
+	for (unsigned int i = 0; i < repeatCount; ++i)
+	{
+		for (std::uint32_t j = 0; j < uniqueCount; ++j)
+		{
+			estimator.add(vfc::fixedHash16(reinterpret_cast<const std::uint8_t*>(&j),
+				sizeof(std::uint32_t)));
+		}
+	}
+
+	return estimator.estimate();
+}
+
+} // namespace
+
+TEST(CardinalityEstimatorTest, Empty)
+{
+	vfc::CardinalityEstimator estimator;
+	EXPECT_EQ(0.0, estimator.estimate());
+}
+
+TEST(CardinalityEstimatorTest, Estimate)
+{
+	EXPECT_NEAR(10.0, estimateCount(10, 3), 1.0);
+	EXPECT_NEAR(1000.0, estimateCount(1000, 6), 50.0);
+	EXPECT_NEAR(50000.0, estimateCount(50000, 2), 2500.0);
+	EXPECT_NEAR(1000000.0, estimateCount(1000000, 1), 50000.0);
+}
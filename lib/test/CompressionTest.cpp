@@ -0,0 +1,233 @@
+/*
+ * Copyright 2026 Aaron Barany
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <VFC/Compression.h>
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <random>
+
+namespace
+{
+
+struct Vertex
+{
+	float position[3];
+	std::uint8_t color[4];
+};
+
+std::vector<Vertex> createVertices(std::uint32_t count)
+{
+	std::vector<Vertex> vertices(count);
+	for (std::uint32_t i = 0; i < count; ++i)
+	{
+		float angle = static_cast<float>(i)*0.01f;
+		vertices[i].position[0] = std::cos(angle);
+		vertices[i].position[1] = std::sin(angle);
+		vertices[i].position[2] = static_cast<float>(i % 16);
+		vertices[i].color[0] = static_cast<std::uint8_t>(i);
+		vertices[i].color[1] = 0x80;
+		vertices[i].color[2] = static_cast<std::uint8_t>(i/64);
+		vertices[i].color[3] = 0xFF;
+	}
+	return vertices;
+}
+
+std::vector<std::uint8_t> decompressData(const std::vector<std::uint8_t>& data)
+{
+	vfc::CompressedHeader header;
+	EXPECT_TRUE(vfc::readCompressedHeader(header, data.data(), data.size()));
+	std::vector<std::uint8_t> result(header.count*header.elementSize);
+	EXPECT_TRUE(vfc::decompress(result.data(), result.size(), data.data(), data.size()));
+	return result;
+}
+
+} // namespace
+
+TEST(CompressionTest, Vertices)
+{
+	// Multiple blocks with a partial final block.
+	std::uint32_t vertexCount = vfc::compressedBlockSize*2 + 100;
+	std::vector<Vertex> vertices = createVertices(vertexCount);
+
+	std::vector<std::uint8_t> compressed;
+	ASSERT_TRUE(vfc::compressVertices(compressed, vertices.data(), vertexCount, sizeof(Vertex)));
+	EXPECT_LT(compressed.size(), vertices.size()*sizeof(Vertex)/2);
+
+	vfc::CompressedHeader header;
+	ASSERT_TRUE(vfc::readCompressedHeader(header, compressed.data(), compressed.size()));
+	EXPECT_EQ(vfc::CompressedDataType::Vertices, header.type);
+	EXPECT_EQ(sizeof(Vertex), header.elementSize);
+	EXPECT_EQ(vertexCount, header.count);
+	EXPECT_EQ(3U, header.blockCount);
+
+	std::vector<std::uint8_t> decompressed = decompressData(compressed);
+	ASSERT_EQ(vertices.size()*sizeof(Vertex), decompressed.size());
+	EXPECT_EQ(0, std::memcmp(vertices.data(), decompressed.data(), decompressed.size()));
+}
+
+TEST(CompressionTest, RandomVertices)
+{
+	std::mt19937 random(1234);
+	std::vector<std::uint8_t> vertices(1000*12);
+	for (std::uint8_t& byte : vertices)
+		byte = static_cast<std::uint8_t>(random());
+
+	std::vector<std::uint8_t> compressed;
+	ASSERT_TRUE(vfc::compressVertices(compressed, vertices.data(), 1000, 12));
+	EXPECT_GE(compressed.size(), vertices.size());
+	EXPECT_EQ(vertices, decompressData(compressed));
+
+	// Odd strides are byte-aligned planes.
+	ASSERT_TRUE(vfc::compressVertices(compressed, vertices.data(), 4000, 3));
+	EXPECT_EQ(vertices, decompressData(compressed));
+}
+
+TEST(CompressionTest, SkewedVertices)
+{
+	// Geometric distribution that requires limiting the code lengths.
+	std::vector<std::uint8_t> vertices;
+	for (unsigned int i = 0; i < 20; ++i)
+		vertices.insert(vertices.end(), 1U << i, static_cast<std::uint8_t>(i));
+	std::mt19937 random(5678);
+	std::shuffle(vertices.begin(), vertices.end(), random);
+
+	std::vector<std::uint8_t> compressed;
+	ASSERT_TRUE(vfc::compressVertices(compressed, vertices.data(),
+		static_cast<std::uint32_t>(vertices.size()), 1));
+	EXPECT_EQ(vertices, decompressData(compressed));
+}
+
+TEST(CompressionTest, ConstantVertices)
+{
+	std::vector<std::uint8_t> vertices(5000*8, 0x3F);
+	std::vector<std::uint8_t> compressed;
+	ASSERT_TRUE(vfc::compressVertices(compressed, vertices.data(), 5000, 8));
+	EXPECT_EQ(sizeof(vfc::CompressedHeader) + sizeof(std::uint32_t) + 8*2, compressed.size());
+	EXPECT_EQ(vertices, decompressData(compressed));
+}
+
+TEST(CompressionTest, Empty)
+{
+	std::vector<std::uint8_t> compressed;
+	ASSERT_TRUE(vfc::compressVertices(compressed, nullptr, 0, 16));
+	EXPECT_EQ(sizeof(vfc::CompressedHeader), compressed.size());
+	EXPECT_TRUE(vfc::decompress(nullptr, 0, compressed.data(), compressed.size()));
+
+	ASSERT_TRUE(vfc::compressIndices(compressed, nullptr, 0, vfc::IndexType::UInt16));
+	EXPECT_EQ(sizeof(vfc::CompressedHeader), compressed.size());
+	EXPECT_TRUE(vfc::decompress(nullptr, 0, compressed.data(), compressed.size()));
+}
+
+TEST(CompressionTest, UInt16Indices)
+{
+	std::vector<std::uint16_t> indices;
+	for (std::uint16_t i = 0; i < 20000; ++i)
+	{
+		std::uint16_t base = static_cast<std::uint16_t>(i/2);
+		indices.push_back(base);
+		indices.push_back(static_cast<std::uint16_t>(base + 1));
+		indices.push_back(static_cast<std::uint16_t>(base + 2));
+	}
+	indices.push_back(0xFFFF);
+	indices.push_back(0);
+
+	std::vector<std::uint8_t> compressed;
+	ASSERT_TRUE(vfc::compressIndices(compressed, indices.data(),
+		static_cast<std::uint32_t>(indices.size()), vfc::IndexType::UInt16));
+	EXPECT_LT(compressed.size(), indices.size()*sizeof(std::uint16_t)/4);
+
+	vfc::CompressedHeader header;
+	ASSERT_TRUE(vfc::readCompressedHeader(header, compressed.data(), compressed.size()));
+	EXPECT_EQ(vfc::CompressedDataType::Indices, header.type);
+	EXPECT_EQ(sizeof(std::uint16_t), header.elementSize);
+
+	std::vector<std::uint8_t> decompressed = decompressData(compressed);
+	ASSERT_EQ(indices.size()*sizeof(std::uint16_t), decompressed.size());
+	EXPECT_EQ(0, std::memcmp(indices.data(), decompressed.data(), decompressed.size()));
+}
+
+TEST(CompressionTest, UInt32Indices)
+{
+	std::mt19937 random(42);
+	std::vector<std::uint32_t> indices(50000);
+	for (std::uint32_t& index : indices)
+		index = static_cast<std::uint32_t>(random());
+	indices[0] = 0xFFFFFFFF;
+	indices[1] = 0;
+
+	std::vector<std::uint8_t> compressed;
+	ASSERT_TRUE(vfc::compressIndices(compressed, indices.data(),
+		static_cast<std::uint32_t>(indices.size()), vfc::IndexType::UInt32));
+
+	std::vector<std::uint8_t> decompressed = decompressData(compressed);
+	ASSERT_EQ(indices.size()*sizeof(std::uint32_t), decompressed.size());
+	EXPECT_EQ(0, std::memcmp(indices.data(), decompressed.data(), decompressed.size()));
+}
+
+TEST(CompressionTest, InvalidParameters)
+{
+	std::uint8_t data[4] = {};
+	std::vector<std::uint8_t> compressed;
+	EXPECT_FALSE(vfc::compressVertices(compressed, nullptr, 1, 4));
+	EXPECT_FALSE(vfc::compressVertices(compressed, data, 1, 0));
+	EXPECT_FALSE(vfc::compressVertices(compressed, data, 1, 0x10000));
+	EXPECT_FALSE(vfc::compressIndices(compressed, nullptr, 1, vfc::IndexType::UInt16));
+	EXPECT_FALSE(vfc::compressIndices(compressed, data, 1, vfc::IndexType::NoIndices));
+}
+
+TEST(CompressionTest, InvalidData)
+{
+	std::vector<Vertex> vertices = createVertices(1000);
+	std::vector<std::uint8_t> compressed;
+	ASSERT_TRUE(vfc::compressVertices(compressed, vertices.data(), 1000, sizeof(Vertex)));
+
+	std::vector<std::uint8_t> decompressed(vertices.size()*sizeof(Vertex));
+	EXPECT_FALSE(vfc::decompress(decompressed.data(), decompressed.size() - 1, compressed.data(),
+		compressed.size()));
+	EXPECT_FALSE(vfc::decompress(decompressed.data(), decompressed.size(), compressed.data(),
+		compressed.size() - 1));
+	EXPECT_FALSE(vfc::decompress(decompressed.data(), decompressed.size(), compressed.data(),
+		sizeof(vfc::CompressedHeader) - 1));
+
+	std::vector<std::uint8_t> invalid = compressed;
+	invalid[0] = 'X';
+	EXPECT_FALSE(vfc::decompress(decompressed.data(), decompressed.size(), invalid.data(),
+		invalid.size()));
+
+	invalid = compressed;
+	invalid[4] = vfc::compressedVersion + 1;
+	EXPECT_FALSE(vfc::decompress(decompressed.data(), decompressed.size(), invalid.data(),
+		invalid.size()));
+
+	invalid = compressed;
+	invalid.push_back(0);
+	EXPECT_FALSE(vfc::decompress(decompressed.data(), decompressed.size(), invalid.data(),
+		invalid.size()));
+
+	// Corrupting any byte must never read or write out of bounds. Most corruptions are detected,
+	// though some only change the decoded values.
+	std::mt19937 random(1234);
+	for (unsigned int i = 0; i < 1000; ++i)
+	{
+		invalid = compressed;
+		std::size_t offset = sizeof(vfc::CompressedHeader) + random() %
+			(invalid.size() - sizeof(vfc::CompressedHeader));
+		invalid[offset] = static_cast<std::uint8_t>(invalid[offset] ^ (1 + random() % 255));
+		vfc::decompress(decompressed.data(), decompressed.size(), invalid.data(), invalid.size());
+	}
+}
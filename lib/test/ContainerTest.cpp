@@ -0,0 +1,227 @@
+/*
+ * Copyright 2026 Aaron Barany
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <VFC/Container.h>
+#include <gtest/gtest.h>
+#include <cstring>
+
+namespace
+{
+
+// Storage aligned to 8 bytes so the tables may be accessed in place.
+std::vector<std::uint64_t> writeContainer(const vfc::ContainerWriter& writer)
+{
+	std::size_t size = writer.getSize();
+	std::vector<std::uint64_t> data((size + sizeof(std::uint64_t) - 1)/sizeof(std::uint64_t));
+	EXPECT_TRUE(writer.write(data.data(), size));
+	return data;
+}
+
+} // namespace
+
+TEST(ContainerTest, RoundTrip)
+{
+	std::vector<vfc::VertexFormat> vertexFormat(2);
+	ASSERT_EQ(vfc::VertexFormat::AddResult::Succeeded, vertexFormat[0].appendElement("position",
+		vfc::ElementLayout::X32Y32Z32, vfc::ElementType::Float));
+	ASSERT_EQ(vfc::VertexFormat::AddResult::Succeeded, vertexFormat[1].appendElement("normal",
+		vfc::ElementLayout::X16Y16Z16W16, vfc::ElementType::SNorm));
+	ASSERT_EQ(vfc::VertexFormat::AddResult::Succeeded, vertexFormat[1].appendElement("uv",
+		vfc::ElementLayout::X16Y16, vfc::ElementType::UNorm));
+
+	const std::uint32_t vertexCount = 3;
+	std::vector<std::uint8_t> positions(vertexCount*vertexFormat[0].stride());
+	std::vector<std::uint8_t> normals(vertexCount*vertexFormat[1].stride());
+	for (std::size_t i = 0; i < positions.size(); ++i)
+		positions[i] = static_cast<std::uint8_t>(i);
+	for (std::size_t i = 0; i < normals.size(); ++i)
+		normals[i] = static_cast<std::uint8_t>(255 - i);
+
+	vfc::VertexValue positionMin(-1, -2, -3), positionMax(1, 2, 3);
+	vfc::VertexValue attributeMin[2] = {vfc::VertexValue(-1, -1, -1, 0), vfc::VertexValue(0, 0)};
+	vfc::VertexValue attributeMax[2] = {vfc::VertexValue(1, 1, 1, 0), vfc::VertexValue(1, 1)};
+
+	std::uint16_t indices0[] = {0, 1, 2};
+	std::uint16_t indices1[] = {2, 1, 0, 0, 1};
+
+	vfc::ContainerWriter writer(vertexCount, vfc::IndexType::UInt16,
+		vfc::PrimitiveType::TriangleList, 0, 16);
+	writer.addVertexStream(vertexFormat[0], &positionMin, &positionMax, positions.data(),
+		positions.size());
+	writer.addVertexStream(vertexFormat[1], attributeMin, attributeMax, normals.data(),
+		normals.size());
+	writer.addIndexBuffer(vfc::IndexData{indices0, vfc::IndexType::UInt16, 3, 0});
+	writer.addIndexBuffer(vfc::IndexData{indices1, vfc::IndexType::UInt16, 5, 10});
+
+	std::size_t size = writer.getSize();
+	EXPECT_EQ(0U, size % 16);
+	std::vector<std::uint64_t> data = writeContainer(writer);
+
+	vfc::ContainerReader reader;
+	ASSERT_TRUE(reader.open(data.data(), size));
+	ASSERT_TRUE(reader.getHeader());
+	EXPECT_EQ(size, reader.getHeader()->fileSize);
+	EXPECT_EQ(vertexCount, reader.getVertexCount());
+	EXPECT_EQ(vfc::IndexType::UInt16, reader.getIndexType());
+	EXPECT_EQ(vfc::PrimitiveType::TriangleList, reader.getPrimitiveType());
+	EXPECT_EQ(vertexFormat, reader.getVertexFormat());
+
+	ASSERT_EQ(positions.size(), reader.getVertexDataSize(0));
+	EXPECT_EQ(0, std::memcmp(positions.data(), reader.getVertexData(0), positions.size()));
+	EXPECT_EQ(0U, reinterpret_cast<std::uintptr_t>(reader.getVertexData(0)) % 16);
+	ASSERT_EQ(normals.size(), reader.getVertexDataSize(1));
+	EXPECT_EQ(0, std::memcmp(normals.data(), reader.getVertexData(1), normals.size()));
+	EXPECT_EQ(0U, reinterpret_cast<std::uintptr_t>(reader.getVertexData(1)) % 16);
+
+	vfc::VertexValue minValue, maxValue;
+	reader.getVertexElementBounds(minValue, maxValue, 0, 0);
+	EXPECT_EQ(positionMin, minValue);
+	EXPECT_EQ(positionMax, maxValue);
+	reader.getVertexElementBounds(minValue, maxValue, 1, 1);
+	EXPECT_EQ(attributeMin[1], minValue);
+	EXPECT_EQ(attributeMax[1], maxValue);
+
+	const std::vector<vfc::IndexData>& indexData = reader.getIndices();
+	ASSERT_EQ(2U, indexData.size());
+	EXPECT_EQ(3U, indexData[0].count);
+	EXPECT_EQ(0, indexData[0].baseVertex);
+	EXPECT_EQ(0, std::memcmp(indices0, indexData[0].data, sizeof(indices0)));
+	EXPECT_EQ(5U, indexData[1].count);
+	EXPECT_EQ(10, indexData[1].baseVertex);
+	EXPECT_EQ(0, std::memcmp(indices1, indexData[1].data, sizeof(indices1)));
+}
+
+TEST(ContainerTest, NoIndices)
+{
+	std::vector<vfc::VertexFormat> vertexFormat(1);
+	ASSERT_EQ(vfc::VertexFormat::AddResult::Succeeded, vertexFormat[0].appendElement("position",
+		vfc::ElementLayout::X32Y32, vfc::ElementType::Float));
+
+	float positions[] = {0.0f, 1.0f, 2.0f, 3.0f};
+	vfc::VertexValue minValue(0, 1), maxValue(2, 3);
+	vfc::ContainerWriter writer(2, vfc::IndexType::NoIndices, vfc::PrimitiveType::LineList);
+	writer.addVertexStream(vertexFormat[0], &minValue, &maxValue, positions, sizeof(positions));
+	std::vector<std::uint64_t> data = writeContainer(writer);
+
+	vfc::ContainerReader reader;
+	ASSERT_TRUE(reader.open(data.data(), writer.getSize()));
+	EXPECT_EQ(vfc::defaultContainerAlignment, reader.getHeader()->sectionAlignment);
+	EXPECT_EQ(vfc::IndexType::NoIndices, reader.getIndexType());
+	EXPECT_EQ(vfc::PrimitiveType::LineList, reader.getPrimitiveType());
+	EXPECT_EQ(vertexFormat, reader.getVertexFormat());
+	EXPECT_TRUE(reader.getIndices().empty());
+	EXPECT_EQ(0, std::memcmp(positions, reader.getVertexData(0), sizeof(positions)));
+
+	vfc::ContainerWriter invalidWriter(2, vfc::IndexType::NoIndices,
+		vfc::PrimitiveType::LineList);
+	std::uint16_t indices[] = {0, 1};
+	invalidWriter.addIndexBuffer(vfc::IndexData{indices, vfc::IndexType::NoIndices, 2, 0});
+	EXPECT_FALSE(invalidWriter.write(data.data(), data.size()*sizeof(std::uint64_t)));
+}
+
+TEST(ContainerTest, WriteInvalid)
+{
+	vfc::VertexFormat vertexFormat;
+	ASSERT_EQ(vfc::VertexFormat::AddResult::Succeeded, vertexFormat.appendElement("position",
+		vfc::ElementLayout::X32Y32, vfc::ElementType::Float));
+
+	float positions[] = {0.0f, 1.0f, 2.0f, 3.0f};
+	vfc::VertexValue minValue, maxValue;
+	std::vector<std::uint64_t> data(1024);
+
+	vfc::ContainerWriter sizeMismatch(3, vfc::IndexType::NoIndices,
+		vfc::PrimitiveType::PointList);
+	sizeMismatch.addVertexStream(vertexFormat, &minValue, &maxValue, positions,
+		sizeof(positions));
+	EXPECT_FALSE(sizeMismatch.write(data.data(), data.size()*sizeof(std::uint64_t)));
+
+	vfc::ContainerWriter badAlignment(2, vfc::IndexType::NoIndices,
+		vfc::PrimitiveType::PointList, 0, 24);
+	badAlignment.addVertexStream(vertexFormat, &minValue, &maxValue, positions,
+		sizeof(positions));
+	EXPECT_FALSE(badAlignment.write(data.data(), data.size()*sizeof(std::uint64_t)));
+
+	vfc::ContainerWriter tooSmall(2, vfc::IndexType::NoIndices, vfc::PrimitiveType::PointList);
+	tooSmall.addVertexStream(vertexFormat, &minValue, &maxValue, positions, sizeof(positions));
+	EXPECT_FALSE(tooSmall.write(data.data(), tooSmall.getSize() - 1));
+}
+
+TEST(ContainerTest, ReadInvalid)
+{
+	vfc::VertexFormat vertexFormat;
+	ASSERT_EQ(vfc::VertexFormat::AddResult::Succeeded, vertexFormat.appendElement("position",
+		vfc::ElementLayout::X32Y32, vfc::ElementType::Float));
+
+	float positions[] = {0.0f, 1.0f, 2.0f, 3.0f};
+	std::uint32_t indices[] = {0, 1};
+	vfc::VertexValue minValue, maxValue;
+	vfc::ContainerWriter writer(2, vfc::IndexType::UInt32, vfc::PrimitiveType::PointList);
+	writer.addVertexStream(vertexFormat, &minValue, &maxValue, positions, sizeof(positions));
+	writer.addIndexBuffer(vfc::IndexData{indices, vfc::IndexType::UInt32, 2, 0});
+	std::size_t size = writer.getSize();
+	std::vector<std::uint64_t> data = writeContainer(writer);
+
+	vfc::ContainerReader reader;
+	ASSERT_TRUE(reader.open(data.data(), size));
+	EXPECT_FALSE(reader.open(nullptr, size));
+	EXPECT_FALSE(reader.getHeader());
+	EXPECT_FALSE(reader.open(data.data(), sizeof(vfc::ContainerHeader) - 1));
+	EXPECT_FALSE(reader.open(data.data(), size - 1));
+
+	auto header = reinterpret_cast<vfc::ContainerHeader*>(data.data());
+	auto vertexStream = reinterpret_cast<vfc::ContainerVertexStream*>(header + 1);
+	auto element = reinterpret_cast<vfc::ContainerElement*>(vertexStream + 1);
+	auto indexBuffer = reinterpret_cast<vfc::ContainerIndexBuffer*>(element + 1);
+
+	std::vector<std::uint64_t> original = data;
+	header->magic[0] = 'X';
+	EXPECT_FALSE(reader.open(data.data(), size));
+	data = original;
+
+	header->version = vfc::containerVersion + 1;
+	EXPECT_FALSE(reader.open(data.data(), size));
+	data = original;
+
+	header->elementCount = 1000;
+	EXPECT_FALSE(reader.open(data.data(), size));
+	data = original;
+
+	vertexStream->dataOffset = size;
+	EXPECT_FALSE(reader.open(data.data(), size));
+	data = original;
+
+	vertexStream->elementCount = 2;
+	EXPECT_FALSE(reader.open(data.data(), size));
+	data = original;
+
+	element->nameLength = 100;
+	EXPECT_FALSE(reader.open(data.data(), size));
+	data = original;
+
+	element->type = vfc::ElementType::UNorm;
+	EXPECT_FALSE(reader.open(data.data(), size));
+	data = original;
+
+	indexBuffer->count = 3;
+	EXPECT_FALSE(reader.open(data.data(), size));
+	data = original;
+
+	indexBuffer->dataOffset += 4;
+	EXPECT_FALSE(reader.open(data.data(), size));
+	data = original;
+
+	EXPECT_TRUE(reader.open(data.data(), size));
+}
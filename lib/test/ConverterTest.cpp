@@ -16,6 +16,9 @@
 
 #include <VFC/Converter.h>
 #include <gtest/gtest.h>
+#include <algorithm>
+#include <array>
+#include <cstring>
 #include <utility>
 
 #if VFC_GCC
@@ -30,6 +33,124 @@
 #pragma GCC diagnostic pop
 #endif
 
+namespace
+{
+
+using Triangle = std::array<float, 3>;
+
+void addTriangle(std::vector<Triangle>& triangles, float v0, float v1, float v2)
+{
+	// Skip degenerate triangles, which aren't drawn.
+	if (v0 == v1 || v0 == v2 || v1 == v2)
+		return;
+
+	// Rotate so the smallest value is first to compare triangles with the same winding order.
+	Triangle triangle = {{v0, v1, v2}};
+	std::rotate(triangle.begin(), std::min_element(triangle.begin(), triangle.end()),
+		triangle.end());
+	triangles.push_back(triangle);
+}
+
+// Gets the triangles for strip or fan primitives, where each vertex value is a single float.
+void getTriangles(std::vector<Triangle>& triangles, const float* values, const void* indices,
+	vfc::IndexType indexType, std::uint32_t indexCount, vfc::PrimitiveType primitiveType)
+{
+	std::uint32_t primitiveRestart = vfc::primitiveRestartIndexValue(indexType);
+	std::vector<float> primitiveValues;
+	for (std::uint32_t i = 0; i <= indexCount; ++i)
+	{
+		std::uint32_t index = i < indexCount ? vfc::getIndexValue(indexType, indices, i) :
+			primitiveRestart;
+		if (index != primitiveRestart)
+		{
+			primitiveValues.push_back(values[index]);
+			continue;
+		}
+
+		for (std::size_t j = 2; j < primitiveValues.size(); ++j)
+		{
+			if (primitiveType == vfc::PrimitiveType::TriangleFan)
+			{
+				addTriangle(triangles, primitiveValues[0], primitiveValues[j - 1],
+					primitiveValues[j]);
+			}
+			else if (j & 1)
+			{
+				addTriangle(triangles, primitiveValues[j - 1], primitiveValues[j - 2],
+					primitiveValues[j]);
+			}
+			else
+			{
+				addTriangle(triangles, primitiveValues[j - 2], primitiveValues[j - 1],
+					primitiveValues[j]);
+			}
+		}
+		primitiveValues.clear();
+	}
+}
+
+void testManyIndexBufferSplits(vfc::PrimitiveType primitiveType, std::uint32_t maxIndexValue)
+{
+	// Several primitives separated by primitive restarts, with a unique value for each vertex.
+	const std::uint32_t vertexCount = 200;
+	const std::uint32_t primitiveVertexCount = 23;
+	std::vector<float> values(vertexCount);
+	std::vector<std::uint32_t> inputIndices;
+	for (std::uint32_t i = 0; i < vertexCount; ++i)
+	{
+		values[i] = static_cast<float>(i);
+		if (i > 0 && i % primitiveVertexCount == 0)
+			inputIndices.push_back(0xFFFFFFFF);
+		inputIndices.push_back(i);
+	}
+
+	std::vector<Triangle> expectedTriangles;
+	getTriangles(expectedTriangles, values.data(), inputIndices.data(), vfc::IndexType::UInt32,
+		static_cast<std::uint32_t>(inputIndices.size()), primitiveType);
+
+	vfc::VertexFormat inputFormat;
+	inputFormat.appendElement("value", vfc::ElementLayout::X32, vfc::ElementType::Float);
+	inputFormat.appendElement("unused", vfc::ElementLayout::X32, vfc::ElementType::Float);
+
+	std::vector<vfc::VertexFormat> vertexFormat(2);
+	vertexFormat[0].appendElement("value", vfc::ElementLayout::X32, vfc::ElementType::Float);
+	vertexFormat[1].appendElement("unused", vfc::ElementLayout::X32, vfc::ElementType::Float);
+
+	std::vector<float> inputVertices(vertexCount*2);
+	for (std::uint32_t i = 0; i < vertexCount; ++i)
+		inputVertices[i*2] = inputVertices[i*2 + 1] = values[i];
+
+	vfc::Converter converter(vertexFormat, vfc::IndexType::UInt16, primitiveType, 0,
+		maxIndexValue);
+	ASSERT_TRUE(converter.addVertexStream(inputFormat, inputVertices.data(), vertexCount,
+		vfc::IndexType::UInt32, inputIndices.data(),
+		static_cast<std::uint32_t>(inputIndices.size())));
+	ASSERT_TRUE(converter.convert());
+
+	const std::vector<vfc::IndexData>& indices = converter.getIndices();
+	EXPECT_LT(20U, indices.size());
+	ASSERT_EQ(2U, converter.getVertices().size());
+	auto outputValues = reinterpret_cast<const float*>(converter.getVertices()[0].data());
+	EXPECT_EQ(0, std::memcmp(outputValues, converter.getVertices()[1].data(),
+		converter.getVertices()[0].size()));
+
+	std::vector<Triangle> triangles;
+	for (const vfc::IndexData& indexData : indices)
+	{
+		for (std::uint32_t i = 0; i < indexData.count; ++i)
+		{
+			EXPECT_TRUE(vfc::getIndexValue(indexData.type, indexData.data, i) <= maxIndexValue ||
+				vfc::getIndexValue(indexData.type, indexData.data, i) == 0xFFFF);
+		}
+		getTriangles(triangles, outputValues + indexData.baseVertex, indexData.data,
+			indexData.type, indexData.count, primitiveType);
+	}
+
+	EXPECT_EQ(expectedTriangles, triangles);
+}
+
+} // namespace
+
 TEST(ConverterTest, QuadWithIndices)
 {
 	float positions[] =
@@ -1518,12 +1639,14 @@ TEST(ConverterTest, TrinagleStripWithMaxIndexValue)
 	EXPECT_EQ(5U, vfc::getIndexValue(indices[0].type, indices[0].data, 6));
 	EXPECT_EQ(6U, vfc::getIndexValue(indices[0].type, indices[0].data, 7));
 
-	ASSERT_EQ(3U, indices[1].count);
+	// Starts with a degenerate triangle to keep the winding order of the odd triangle.
+	ASSERT_EQ(4U, indices[1].count);
 	EXPECT_EQ(vfc::IndexType::UInt16, indices[1].type);
 	EXPECT_EQ(7, indices[1].baseVertex);
-	EXPECT_EQ(0U, vfc::getIndexValue(indices[0].type, indices[0].data, 0));
-	EXPECT_EQ(1U, vfc::getIndexValue(indices[0].type, indices[0].data, 1));
-	EXPECT_EQ(2U, vfc::getIndexValue(indices[0].type, indices[0].data, 2));
+	EXPECT_EQ(0U, vfc::getIndexValue(indices[1].type, indices[1].data, 0));
+	EXPECT_EQ(0U, vfc::getIndexValue(indices[1].type, indices[1].data, 1));
+	EXPECT_EQ(1U, vfc::getIndexValue(indices[1].type, indices[1].data, 2));
+	EXPECT_EQ(2U, vfc::getIndexValue(indices[1].type, indices[1].data, 3));
 
 	ASSERT_EQ(1U, converter.getVertices().size());
 	const std::vector<std::uint8_t>& vertices = converter.getVertices()[0];
@@ -2650,3 +2773,645 @@ TEST(ConverterTest, QuadRemapIndicesSplitStreams)
 	EXPECT_EQ(vfc::VertexValue(0.0, 0.0), minBounds);
 	EXPECT_EQ(vfc::VertexValue(1.0, 1.0), maxBounds);
 }
+
+TEST(ConverterTest, TrinagleListWithMaxIndexValueSplitStreams)
+{
+	float positions[] =
+	{
+		-1.0f, -1.0f,
+		 1.0f, -1.0f,
+		-1.0f,  1.0f,
+		 1.0f,  1.0f,
+		 2.0f,  1.0f
+	};
+
+	vfc::VertexFormat positionFormat;
+	positionFormat.appendElement("positions", vfc::ElementLayout::X32Y32, vfc::ElementType::Float);
+
+	struct TexCoordId
+	{
+		float texCoord[2];
+		std::uint32_t id;
+	};
+
+	TexCoordId texCoordIds[] =
+	{
+		{{0.0f, 0.0f}, 1},
+		{{1.0f, 0.0f}, 2},
+		{{0.0f, 1.0f}, 3},
+		{{1.0f, 1.0f}, 4},
+		{{1.0f, 1.0f}, 5}
+	};
+
+	vfc::VertexFormat texCoordIdFormat;
+	texCoordIdFormat.appendElement("texCoords", vfc::ElementLayout::X32Y32,
+		vfc::ElementType::Float);
+	texCoordIdFormat.appendElement("ids", vfc::ElementLayout::X32, vfc::ElementType::UInt);
+	ASSERT_EQ(sizeof(TexCoordId), texCoordIdFormat.stride());
+
+	std::uint16_t inputIndices[] = {0, 1, 2, 2, 1, 3, 0, 3, 4};
+
+	std::vector<vfc::VertexFormat> vertexFormat(3);
+	vertexFormat[0].appendElement("positions", vfc::ElementLayout::X32Y32,
+		vfc::ElementType::Float);
+	vertexFormat[1].appendElement("texCoords", vfc::ElementLayout::X16Y16,
+		vfc::ElementType::UNorm);
+	vertexFormat[2].appendElement("ids", vfc::ElementLayout::X16, vfc::ElementType::UInt);
+
+	vfc::Converter converter(vertexFormat, vfc::IndexType::UInt16,
+		vfc::PrimitiveType::TriangleList, 0, 5);
+	ASSERT_TRUE(converter.addVertexStream(std::move(positionFormat), positions, 5,
+		vfc::IndexType::UInt16, inputIndices, 9));
+	ASSERT_TRUE(converter.addVertexStream(std::move(texCoordIdFormat), texCoordIds, 5,
+		vfc::IndexType::UInt16, inputIndices, 9));
+	ASSERT_TRUE(converter.convert());
+
+	const std::vector<vfc::IndexData>& indices = converter.getIndices();
+	ASSERT_EQ(2U, indices.size());
+	ASSERT_EQ(6U, indices[0].count);
+	EXPECT_EQ(0, indices[0].baseVertex);
+	EXPECT_EQ(0U, vfc::getIndexValue(indices[0].type, indices[0].data, 0));
+	EXPECT_EQ(1U, vfc::getIndexValue(indices[0].type, indices[0].data, 1));
+	EXPECT_EQ(2U, vfc::getIndexValue(indices[0].type, indices[0].data, 2));
+	EXPECT_EQ(2U, vfc::getIndexValue(indices[0].type, indices[0].data, 3));
+	EXPECT_EQ(1U, vfc::getIndexValue(indices[0].type, indices[0].data, 4));
+	EXPECT_EQ(3U, vfc::getIndexValue(indices[0].type, indices[0].data, 5));
+
+	ASSERT_EQ(3U, indices[1].count);
+	EXPECT_EQ(4, indices[1].baseVertex);
+	EXPECT_EQ(0U, vfc::getIndexValue(indices[1].type, indices[1].data, 0));
+	EXPECT_EQ(1U, vfc::getIndexValue(indices[1].type, indices[1].data, 1));
+	EXPECT_EQ(2U, vfc::getIndexValue(indices[1].type, indices[1].data, 2));
+
+	// Vertices from the first buffer are duplicated in the second buffer.
+	const unsigned int expectedVertices[] = {0, 1, 2, 3, 0, 3, 4};
+	ASSERT_EQ(7U, converter.getVertexCount());
+	ASSERT_EQ(3U, converter.getVertices().size());
+	for (std::size_t i = 0; i < converter.getVertices().size(); ++i)
+	{
+		EXPECT_EQ(converter.getVertexCount()*vertexFormat[i].stride(),
+			converter.getVertices()[i].size());
+	}
+
+	auto outPositions = reinterpret_cast<const float*>(converter.getVertices()[0].data());
+	auto outTexCoords = reinterpret_cast<const std::uint16_t*>(converter.getVertices()[1].data());
+	auto outIds = reinterpret_cast<const std::uint16_t*>(converter.getVertices()[2].data());
+	for (unsigned int i = 0; i < converter.getVertexCount(); ++i)
+	{
+		unsigned int expectedVertex = expectedVertices[i];
+		EXPECT_EQ(positions[expectedVertex*2], outPositions[i*2]);
+		EXPECT_EQ(positions[expectedVertex*2 + 1], outPositions[i*2 + 1]);
+		EXPECT_EQ(texCoordIds[expectedVertex].texCoord[0]*0xFFFF, outTexCoords[i*2]);
+		EXPECT_EQ(texCoordIds[expectedVertex].texCoord[1]*0xFFFF, outTexCoords[i*2 + 1]);
+		EXPECT_EQ(texCoordIds[expectedVertex].id, outIds[i]);
+	}
+}
+
+TEST(ConverterTest, WeldVertices)
+{
+	float positions[] =
+	{
+		-1.0f,    -1.0f,    0.0f,
+		 1.0f,    -1.0f,    0.0f,
+		-1.0f,     1.0f,    0.0f,
+		-1.0001f,  1.0f,    0.0f,
+		 1.0f,    -0.9999f, 0.0001f,
+		 1.0f,     1.0f,    0.0f
+	};
+
+	float texCoords[] =
+	{
+		0.0f, 0.0f,
+		1.0f, 0.0f,
+		0.0f, 1.0f,
+		0.0f, 1.0f,
+		1.0f, 0.0f,
+		1.0f, 1.0f
+	};
+
+	vfc::VertexFormat vertexFormat;
+	vertexFormat.appendElement("positions", vfc::ElementLayout::X32Y32Z32,
+		vfc::ElementType::Float);
+	vertexFormat.appendElement("texCoords", vfc::ElementLayout::X32Y32, vfc::ElementType::Float);
+
+	vfc::VertexFormat positionFormat;
+	positionFormat.appendElement("positions", vfc::ElementLayout::X32Y32Z32,
+		vfc::ElementType::Float);
+
+	vfc::VertexFormat texCoordFormat;
+	texCoordFormat.appendElement("texCoords", vfc::ElementLayout::X32Y32, vfc::ElementType::Float);
+
+	vfc::Converter converter(vertexFormat, vfc::IndexType::UInt16,
+		vfc::PrimitiveType::TriangleList);
+	EXPECT_FALSE(converter.isWeldingEnabled());
+	EXPECT_FALSE(converter.setWeldPositionElement("asdf"));
+	ASSERT_TRUE(converter.setWeldPositionElement("positions"));
+	EXPECT_TRUE(converter.isWeldingEnabled());
+	ASSERT_TRUE(converter.setElementWeldTolerance("positions", 0.001));
+	EXPECT_EQ(0.001, converter.getElementWeldTolerance("positions"));
+	EXPECT_EQ(0.0, converter.getElementWeldTolerance("texCoords"));
+
+	ASSERT_TRUE(converter.addVertexStream(std::move(positionFormat), positions, 6));
+	ASSERT_TRUE(converter.addVertexStream(std::move(texCoordFormat), texCoords, 6));
+	ASSERT_TRUE(converter.convert());
+	EXPECT_EQ(2U, converter.getWeldedVertexCount());
+
+	const std::vector<vfc::IndexData>& indices = converter.getIndices();
+	ASSERT_EQ(1U, indices.size());
+	ASSERT_EQ(6U, indices[0].count);
+	EXPECT_EQ(0U, vfc::getIndexValue(indices[0].type, indices[0].data, 0));
+	EXPECT_EQ(1U, vfc::getIndexValue(indices[0].type, indices[0].data, 1));
+	EXPECT_EQ(2U, vfc::getIndexValue(indices[0].type, indices[0].data, 2));
+	EXPECT_EQ(2U, vfc::getIndexValue(indices[0].type, indices[0].data, 3));
+	EXPECT_EQ(1U, vfc::getIndexValue(indices[0].type, indices[0].data, 4));
+	EXPECT_EQ(3U, vfc::getIndexValue(indices[0].type, indices[0].data, 5));
+
+	// Welded vertices use the values from the first vertex.
+	ASSERT_EQ(4U, converter.getVertexCount());
+	auto vertexData = reinterpret_cast<const float*>(converter.getVertices()[0].data());
+	EXPECT_EQ(-1.0f, vertexData[5*2 + 0]);
+	EXPECT_EQ(1.0f, vertexData[5*2 + 1]);
+	EXPECT_EQ(1.0f, vertexData[5 + 0]);
+	EXPECT_EQ(-1.0f, vertexData[5 + 1]);
+	EXPECT_EQ(0.0f, vertexData[5 + 2]);
+}
+
+TEST(ConverterTest, WeldVerticesOutsideTolerance)
+{
+	float vertices[] =
+	{
+		-1.0f,    -1.0f, 0.0f, 0.0f,
+		 1.0f,    -1.0f, 1.0f, 0.0f,
+		-1.0f,     1.0f, 0.0f, 1.0f,
+		-1.0001f,  1.0f, 0.0f, 0.5f,
+		 1.01f,   -1.0f, 1.0f, 0.0f,
+		 1.0f,     1.0f, 1.0f, 1.0f
+	};
+
+	vfc::VertexFormat vertexFormat;
+	vertexFormat.appendElement("positions", vfc::ElementLayout::X32Y32, vfc::ElementType::Float);
+	vertexFormat.appendElement("texCoords", vfc::ElementLayout::X32Y32, vfc::ElementType::Float);
+
+	vfc::Converter converter(vertexFormat, vfc::IndexType::UInt16,
+		vfc::PrimitiveType::TriangleList);
+	converter.setWeldPositionElement(0, 0);
+	converter.setElementWeldTolerance(0, 0, 0.001);
+	EXPECT_EQ(0.001, converter.getElementWeldTolerance(0, 0));
+
+	ASSERT_TRUE(converter.addVertexStream(vertexFormat, vertices, 6));
+	ASSERT_TRUE(converter.convert());
+	EXPECT_EQ(0U, converter.getWeldedVertexCount());
+	EXPECT_EQ(6U, converter.getVertexCount());
+}
+
+TEST(ConverterTest, WeldVerticesWithMaxIndexValue)
+{
+	float positions[] =
+	{
+		0.0f,    0.0f,
+		1.0f,    0.0f,
+		0.0f,    1.0f,
+		0.0001f, 1.0f,
+		1.0f,    0.0001f,
+		1.0f,    1.0f
+	};
+
+	vfc::VertexFormat vertexFormat;
+	vertexFormat.appendElement("positions", vfc::ElementLayout::X32Y32, vfc::ElementType::Float);
+
+	vfc::Converter converter(vertexFormat, vfc::IndexType::UInt16,
+		vfc::PrimitiveType::TriangleList, 0, 2);
+	converter.setWeldPositionElement("positions");
+	converter.setElementWeldTolerance("positions", 0.001);
+
+	ASSERT_TRUE(converter.addVertexStream(vertexFormat, positions, 6));
+	ASSERT_TRUE(converter.convert());
+
+	// Vertices aren't welded across separate index buffers.
+	EXPECT_EQ(0U, converter.getWeldedVertexCount());
+	EXPECT_EQ(6U, converter.getVertexCount());
+	const std::vector<vfc::IndexData>& indices = converter.getIndices();
+	ASSERT_EQ(2U, indices.size());
+	EXPECT_EQ(3U, indices[0].count);
+	EXPECT_EQ(3U, indices[1].count);
+	EXPECT_EQ(3, indices[1].baseVertex);
+}
+
+TEST(ConverterTest, WeldVerticesErrors)
+{
+	float positions[] =
+	{
+		0.0f, 0.0f,
+		1.0f, 0.0f,
+		0.0f, 1.0f
+	};
+
+	vfc::VertexFormat vertexFormat;
+	vertexFormat.appendElement("positions", vfc::ElementLayout::X32Y32, vfc::ElementType::Float);
+
+	vfc::Converter converter(vertexFormat, vfc::IndexType::UInt16,
+		vfc::PrimitiveType::TriangleList);
+	converter.setWeldPositionElement("positions");
+	ASSERT_TRUE(converter.addVertexStream(vertexFormat, positions, 3));
+	EXPECT_FALSE(converter.convert());
+
+	converter.disableWelding();
+	EXPECT_FALSE(converter.isWeldingEnabled());
+	EXPECT_TRUE(converter.convert());
+	EXPECT_EQ(3U, converter.getVertexCount());
+}
+
+TEST(ConverterTest, ReservePolicies)
+{
+	float positions[] =
+	{
+		-1.0f, -1.0f,
+		 1.0f, -1.0f,
+		-1.0f,  1.0f,
+		 1.0f,  1.0f
+	};
+	std::uint16_t positionIndices[] = {0, 1, 2, 2, 1, 3};
+
+	float texCoords[] =
+	{
+		0.0f, 0.0f,
+		1.0f, 0.0f,
+		0.0f, 1.0f,
+		1.0f, 1.0f
+	};
+	std::uint16_t texCoordIndices[] = {0, 1, 2, 2, 1, 3};
+
+	vfc::VertexFormat positionFormat;
+	positionFormat.appendElement("positions", vfc::ElementLayout::X32Y32, vfc::ElementType::Float);
+
+	vfc::VertexFormat texCoordFormat;
+	texCoordFormat.appendElement("texCoords", vfc::ElementLayout::X32Y32, vfc::ElementType::Float);
+
+	vfc::VertexFormat vertexFormat;
+	vertexFormat.appendElement("positions", vfc::ElementLayout::X32Y32, vfc::ElementType::Float);
+	vertexFormat.appendElement("texCoords", vfc::ElementLayout::X32Y32, vfc::ElementType::Float);
+
+	const vfc::Converter::ReservePolicy policies[] =
+	{
+		vfc::Converter::ReservePolicy::None,
+		vfc::Converter::ReservePolicy::InputVertexCount,
+		vfc::Converter::ReservePolicy::Estimate
+	};
+	for (vfc::Converter::ReservePolicy policy : policies)
+	{
+		vfc::Converter converter(vertexFormat, vfc::IndexType::UInt16,
+			vfc::PrimitiveType::TriangleList);
+		EXPECT_EQ(vfc::Converter::ReservePolicy::Estimate, converter.getReservePolicy());
+		converter.setReservePolicy(policy);
+		EXPECT_EQ(policy, converter.getReservePolicy());
+
+		ASSERT_TRUE(converter.addVertexStream(positionFormat, positions, 4,
+			vfc::IndexType::UInt16, positionIndices, 6));
+		ASSERT_TRUE(converter.addVertexStream(texCoordFormat, texCoords, 4,
+			vfc::IndexType::UInt16, texCoordIndices, 6));
+		ASSERT_TRUE(converter.convert());
+
+		const std::vector<vfc::IndexData>& indices = converter.getIndices();
+		ASSERT_EQ(1U, indices.size());
+		ASSERT_EQ(6U, indices[0].count);
+		for (unsigned int i = 0; i < 6; ++i)
+		{
+			EXPECT_EQ(positionIndices[i],
+				vfc::getIndexValue(indices[0].type, indices[0].data, i));
+		}
+
+		ASSERT_EQ(4U, converter.getVertexCount());
+		EXPECT_EQ(0, std::memcmp(positions + 6, converter.getVertices()[0].data() + 3*16, 8));
+	}
+}
+
+TEST(ConverterTest, BackgroundValidation)
+{
+	// Interleaved elements to check the bounds are read for each element.
+	float vertices[] =
+	{
+		-1.0f, -1.0f, 0.0f, 0.0f,
+		 1.0f, -1.0f, 1.0f, 0.0f,
+		-1.0f,  1.0f, 0.0f, 1.0f,
+		 1.0f,  1.0f, 1.0f, 1.0f,
+		 5.0f,  5.0f, 5.0f, 5.0f
+	};
+	std::uint16_t vertexIndices[] = {0, 1, 2, 2, 1, 3};
+
+	float colors[] = {0.25f, 0.5f, 0.75f};
+	std::uint16_t colorIndices[] = {0, 1, 0, 0, 1, 2};
+	std::uint16_t outOfRangeIndices[] = {0, 1, 0, 0, 1, 3};
+
+	vfc::VertexFormat inputFormat;
+	inputFormat.appendElement("positions", vfc::ElementLayout::X32Y32, vfc::ElementType::Float);
+	inputFormat.appendElement("texCoords", vfc::ElementLayout::X32Y32, vfc::ElementType::Float);
+
+	vfc::VertexFormat colorFormat;
+	colorFormat.appendElement("colors", vfc::ElementLayout::X32, vfc::ElementType::Float);
+
+	vfc::VertexFormat vertexFormat;
+	vertexFormat.appendElement("positions", vfc::ElementLayout::X32Y32, vfc::ElementType::Float);
+	vertexFormat.appendElement("texCoords", vfc::ElementLayout::X16Y16, vfc::ElementType::UNorm);
+	vertexFormat.appendElement("colors", vfc::ElementLayout::X32, vfc::ElementType::Float);
+
+	for (bool background : {false, true})
+	{
+		std::vector<std::string> errors;
+		vfc::Converter converter(vertexFormat, vfc::IndexType::UInt16,
+			vfc::PrimitiveType::TriangleList, 0,
+			[&errors](const char* message) {errors.push_back(message);});
+		EXPECT_FALSE(converter.isBackgroundValidationEnabled());
+		converter.setBackgroundValidationEnabled(background);
+		EXPECT_EQ(background, converter.isBackgroundValidationEnabled());
+		ASSERT_TRUE(converter.setElementTransform("texCoords", vfc::Converter::Transform::Bounds));
+
+		ASSERT_TRUE(converter.addVertexStream(inputFormat, vertices, 5, vfc::IndexType::UInt16,
+			vertexIndices, 6));
+		ASSERT_TRUE(converter.addVertexStream(colorFormat, colors, 3, vfc::IndexType::UInt16,
+			colorIndices, 6));
+		ASSERT_TRUE(converter.convert());
+		EXPECT_TRUE(errors.empty());
+
+		// Only vertices that are referenced by the indices are part of the bounds.
+		vfc::VertexValue minBounds, maxBounds;
+		EXPECT_TRUE(converter.getVertexElementBounds(minBounds, maxBounds, "positions"));
+		EXPECT_EQ(vfc::VertexValue(-1.0, -1.0), minBounds);
+		EXPECT_EQ(vfc::VertexValue(1.0, 1.0), maxBounds);
+
+		EXPECT_TRUE(converter.getVertexElementBounds(minBounds, maxBounds, "texCoords"));
+		EXPECT_EQ(vfc::VertexValue(0.0, 0.0), minBounds);
+		EXPECT_EQ(vfc::VertexValue(1.0, 1.0), maxBounds);
+
+		EXPECT_TRUE(converter.getVertexElementBounds(minBounds, maxBounds, "colors"));
+		EXPECT_EQ(vfc::VertexValue(0.25), minBounds);
+		EXPECT_EQ(vfc::VertexValue(0.75), maxBounds);
+
+		ASSERT_EQ(4U, converter.getVertexCount());
+		auto texCoord = reinterpret_cast<const std::uint16_t*>(
+			converter.getVertices()[0].data() + 3*vertexFormat.stride() + vertexFormat[1].offset);
+		EXPECT_EQ(0xFFFF, texCoord[0]);
+		EXPECT_EQ(0xFFFF, texCoord[1]);
+
+		// Errors for the indices are reported on convert.
+		converter.reset({vertexFormat}, vfc::IndexType::UInt16, vfc::PrimitiveType::TriangleList);
+		ASSERT_TRUE(converter.addVertexStream(inputFormat, vertices, 5, vfc::IndexType::UInt16,
+			vertexIndices, 6));
+		ASSERT_TRUE(converter.addVertexStream(colorFormat, colors, 3, vfc::IndexType::UInt16,
+			outOfRangeIndices, 6));
+		converter.waitForValidation();
+		EXPECT_TRUE(errors.empty());
+		EXPECT_FALSE(converter.convert());
+
+		std::vector<std::string> expectedErrors =
+		{
+			"Index value for vertex element 'colors' is out of range."
+		};
+		EXPECT_EQ(expectedErrors, errors);
+
+		// Validation in progress is kept when moving the converter.
+		errors.clear();
+		converter.reset({vertexFormat}, vfc::IndexType::UInt16, vfc::PrimitiveType::TriangleList);
+		ASSERT_TRUE(converter.addVertexStream(inputFormat, vertices, 5, vfc::IndexType::UInt16,
+			vertexIndices, 6));
+		ASSERT_TRUE(converter.addVertexStream(colorFormat, colors, 3, vfc::IndexType::UInt16,
+			colorIndices, 6));
+		vfc::Converter movedConverter(std::move(converter));
+		converter = std::move(movedConverter);
+		EXPECT_TRUE(converter.convert());
+		EXPECT_TRUE(errors.empty());
+		EXPECT_EQ(4U, converter.getVertexCount());
+	}
+}
+
+TEST(ConverterTest, TriangleStripManyIndexBufferSplits)
+{
+	testManyIndexBufferSplits(vfc::PrimitiveType::TriangleStrip, 5);
+	testManyIndexBufferSplits(vfc::PrimitiveType::TriangleStrip, 6);
+}
+
+TEST(ConverterTest, TriangleFanManyIndexBufferSplits)
+{
+	testManyIndexBufferSplits(vfc::PrimitiveType::TriangleFan, 5);
+	testManyIndexBufferSplits(vfc::PrimitiveType::TriangleFan, 6);
+}
+
+TEST(ConverterTest, Stats)
+{
+	// Quad as a triangle list with the shared vertices duplicated.
+	const float vertices[] = {0.0f, 1.0f, 2.0f, 2.0f, 1.0f, 3.0f};
+	vfc::VertexFormat vertexFormat;
+	vertexFormat.appendElement("value", vfc::ElementLayout::X32, vfc::ElementType::Float);
+
+	vfc::Converter converter(vertexFormat, vfc::IndexType::UInt16,
+		vfc::PrimitiveType::TriangleList);
+	ASSERT_TRUE(converter.addVertexStream(vertexFormat, vertices, 6, vfc::IndexType::NoIndices,
+		nullptr, 0));
+
+	vfc::Converter::Stats stats;
+	ASSERT_TRUE(converter.convert(&stats));
+	// Each duplicate is compared, with any further comparisons from hash collisions.
+	EXPECT_EQ(2U, stats.dedupHits);
+	EXPECT_LE(stats.dedupHits, stats.hashProbes);
+	EXPECT_EQ(4U, stats.uniqueVertices);
+	EXPECT_EQ(0U, stats.carriedOverVertices);
+	EXPECT_EQ(1U, stats.indexBuffers);
+	EXPECT_LE(4*sizeof(float), stats.peakVertexBytes);
+	EXPECT_LE(6*sizeof(std::uint16_t), stats.peakIndexBytes);
+	EXPECT_LE(0.0, stats.encodeTime);
+	EXPECT_LE(0.0, stats.dedupTime);
+	EXPECT_GE(stats.totalTime, stats.encodeTime + stats.dedupTime);
+
+	// Triangle strip split into multiple index buffers.
+	const std::uint16_t indices[] = {0, 1, 2, 5};
+	vfc::Converter splitConverter(vertexFormat, vfc::IndexType::UInt16,
+		vfc::PrimitiveType::TriangleStrip, 0, 2);
+	ASSERT_TRUE(splitConverter.addVertexStream(vertexFormat, vertices, 6, vfc::IndexType::UInt16,
+		indices, 4));
+
+	ASSERT_TRUE(splitConverter.convert(&stats));
+	EXPECT_EQ(splitConverter.getIndices().size(), stats.indexBuffers);
+	EXPECT_LT(1U, stats.indexBuffers);
+	EXPECT_LT(0U, stats.carriedOverVertices);
+	EXPECT_EQ(splitConverter.getVertexCount(), stats.uniqueVertices + stats.carriedOverVertices);
+	EXPECT_LE(stats.dedupHits, stats.hashProbes);
+}
+
+TEST(ConverterTest, OutputBufferFunction)
+{
+	struct PositionId
+	{
+		float position;
+		std::uint32_t id;
+	};
+
+	const PositionId vertices[] = {{0.0f, 1}, {1.0f, 2}, {2.0f, 3}, {3.0f, 4}, {4.0f, 5}};
+	const std::uint16_t indices[] = {0, 1, 2, 2, 1, 3, 0, 3, 4};
+
+	vfc::VertexFormat inputFormat;
+	inputFormat.appendElement("position", vfc::ElementLayout::X32, vfc::ElementType::Float);
+	inputFormat.appendElement("id", vfc::ElementLayout::X32, vfc::ElementType::UInt);
+
+	std::vector<vfc::VertexFormat> splitFormat(2);
+	splitFormat[0].appendElement("position", vfc::ElementLayout::X32, vfc::ElementType::Float);
+	splitFormat[1].appendElement("id", vfc::ElementLayout::X16, vfc::ElementType::UInt);
+	std::vector<vfc::VertexFormat> singleFormat(1);
+	singleFormat[0] = inputFormat;
+
+	for (const std::vector<vfc::VertexFormat>& vertexFormat : {singleFormat, splitFormat})
+	{
+		vfc::Converter expectedConverter(vertexFormat, vfc::IndexType::UInt16,
+			vfc::PrimitiveType::TriangleList, 0, 5);
+		ASSERT_TRUE(expectedConverter.addVertexStream(inputFormat, vertices, 5,
+			vfc::IndexType::UInt16, indices, 9));
+		ASSERT_TRUE(expectedConverter.convert());
+
+		std::vector<std::vector<std::uint8_t>> vertexBuffers;
+		std::vector<std::vector<std::uint8_t>> indexBuffers;
+		vfc::Converter converter(vertexFormat, vfc::IndexType::UInt16,
+			vfc::PrimitiveType::TriangleList, 0, 5);
+		converter.setOutputBufferFunction(
+			[&](vfc::Converter::OutputBufferType type, std::size_t index, std::size_t size)
+			{
+				auto& buffers = type == vfc::Converter::OutputBufferType::Vertices ?
+					vertexBuffers : indexBuffers;
+				EXPECT_EQ(buffers.size(), index);
+				buffers.emplace_back(size);
+				return buffers.back().data();
+			});
+		ASSERT_TRUE(converter.addVertexStream(inputFormat, vertices, 5, vfc::IndexType::UInt16,
+			indices, 9));
+		ASSERT_TRUE(converter.convert());
+
+		// A single vertex stream is moved to the converter's vertices rather than copied.
+		EXPECT_EQ(expectedConverter.getVertexCount(), converter.getVertexCount());
+		ASSERT_EQ(vertexFormat.size(), converter.getVertices().size());
+		if (vertexFormat.size() == 1)
+		{
+			EXPECT_TRUE(vertexBuffers.empty());
+			EXPECT_EQ(expectedConverter.getVertices()[0], converter.getVertices()[0]);
+		}
+		else
+		{
+			ASSERT_EQ(vertexFormat.size(), vertexBuffers.size());
+			for (std::size_t i = 0; i < vertexFormat.size(); ++i)
+			{
+				EXPECT_TRUE(converter.getVertices()[i].empty());
+				EXPECT_EQ(expectedConverter.getVertices()[i], vertexBuffers[i]);
+			}
+		}
+
+		const std::vector<vfc::IndexData>& expectedIndices = expectedConverter.getIndices();
+		const std::vector<vfc::IndexData>& outIndices = converter.getIndices();
+		ASSERT_EQ(2U, outIndices.size());
+		ASSERT_EQ(expectedIndices.size(), outIndices.size());
+		ASSERT_EQ(outIndices.size(), indexBuffers.size());
+		for (std::size_t i = 0; i < outIndices.size(); ++i)
+		{
+			EXPECT_EQ(indexBuffers[i].data(), outIndices[i].data);
+			EXPECT_EQ(expectedIndices[i].baseVertex, outIndices[i].baseVertex);
+			ASSERT_EQ(expectedIndices[i].count, outIndices[i].count);
+			EXPECT_EQ(0, std::memcmp(expectedIndices[i].data, outIndices[i].data,
+				outIndices[i].count*sizeof(std::uint16_t)));
+		}
+	}
+}
+
+TEST(ConverterTest, OutputBufferFunctionError)
+{
+	const float vertices[] = {0.0f, 1.0f, 2.0f, 3.0f, 4.0f, 5.0f};
+	vfc::VertexFormat inputFormat;
+	inputFormat.appendElement("position", vfc::ElementLayout::X32, vfc::ElementType::Float);
+	inputFormat.appendElement("value", vfc::ElementLayout::X32, vfc::ElementType::Float);
+
+	// Vertices are only written to output buffers with multiple streams.
+	std::vector<vfc::VertexFormat> vertexFormat(2);
+	vertexFormat[0].appendElement("position", vfc::ElementLayout::X32, vfc::ElementType::Float);
+	vertexFormat[1].appendElement("value", vfc::ElementLayout::X32, vfc::ElementType::Float);
+
+	std::string errorMessage;
+	vfc::Converter converter(vertexFormat, vfc::IndexType::UInt16,
+		vfc::PrimitiveType::TriangleList, 0,
+		[&errorMessage](const char* message)
+		{
+			errorMessage = message;
+		});
+	converter.setOutputBufferFunction(
+		[](vfc::Converter::OutputBufferType, std::size_t, std::size_t) -> void*
+		{
+			return nullptr;
+		});
+	ASSERT_TRUE(converter.addVertexStream(inputFormat, vertices, 3, vfc::IndexType::NoIndices,
+		nullptr, 0));
+	EXPECT_FALSE(converter.convert());
+	EXPECT_EQ("Couldn't get output buffer for converted vertices.", errorMessage);
+}
+
+TEST(ConverterTest, Reset)
+{
+	struct PositionId
+	{
+		float position;
+		std::uint32_t id;
+	};
+
+	const PositionId vertices[] = {{0.0f, 1}, {1.0f, 2}, {2.0f, 3}, {3.0f, 4}, {4.0f, 5}};
+	const std::uint16_t indices[] = {0, 1, 2, 2, 1, 3, 0, 3, 4};
+
+	vfc::VertexFormat inputFormat;
+	inputFormat.appendElement("position", vfc::ElementLayout::X32, vfc::ElementType::Float);
+	inputFormat.appendElement("id", vfc::ElementLayout::X32, vfc::ElementType::UInt);
+
+	std::vector<vfc::VertexFormat> splitFormat(2);
+	splitFormat[0].appendElement("position", vfc::ElementLayout::X32, vfc::ElementType::Float);
+	splitFormat[1].appendElement("id", vfc::ElementLayout::X16, vfc::ElementType::UInt);
+	std::vector<vfc::VertexFormat> singleFormat(1);
+	singleFormat[0] = inputFormat;
+
+	vfc::Converter converter(singleFormat, vfc::IndexType::UInt32,
+		vfc::PrimitiveType::TriangleList);
+	ASSERT_TRUE(converter.addVertexStream(inputFormat, vertices, 5, vfc::IndexType::UInt16,
+		indices, 9));
+	ASSERT_TRUE(converter.convert());
+
+	for (const std::vector<vfc::VertexFormat>& vertexFormat :
+		{splitFormat, singleFormat, splitFormat})
+	{
+		vfc::Converter expectedConverter(vertexFormat, vfc::IndexType::UInt16,
+			vfc::PrimitiveType::TriangleList, 0, 5);
+		ASSERT_TRUE(expectedConverter.addVertexStream(inputFormat, vertices, 5,
+			vfc::IndexType::UInt16, indices, 9));
+		ASSERT_TRUE(expectedConverter.convert());
+
+		converter.reset(vertexFormat, vfc::IndexType::UInt16, vfc::PrimitiveType::TriangleList, 0,
+			5);
+		ASSERT_TRUE(converter.isValid());
+		EXPECT_EQ(vertexFormat, converter.getVertexFormat());
+		EXPECT_EQ(vfc::IndexType::UInt16, converter.getIndexType());
+		EXPECT_EQ(5U, converter.getMaxIndexValue());
+		EXPECT_TRUE(converter.getVertices().empty());
+		EXPECT_TRUE(converter.getIndices().empty());
+		EXPECT_EQ(0U, converter.getVertexCount());
+
+		ASSERT_TRUE(converter.addVertexStream(inputFormat, vertices, 5, vfc::IndexType::UInt16,
+			indices, 9));
+		ASSERT_TRUE(converter.convert());
+
+		EXPECT_EQ(expectedConverter.getVertexCount(), converter.getVertexCount());
+		EXPECT_EQ(expectedConverter.getVertices(), converter.getVertices());
+
+		const std::vector<vfc::IndexData>& expectedIndices = expectedConverter.getIndices();
+		const std::vector<vfc::IndexData>& outIndices = converter.getIndices();
+		ASSERT_EQ(expectedIndices.size(), outIndices.size());
+		for (std::size_t i = 0; i < outIndices.size(); ++i)
+		{
+			EXPECT_EQ(expectedIndices[i].baseVertex, outIndices[i].baseVertex);
+			ASSERT_EQ(expectedIndices[i].count, outIndices[i].count);
+			EXPECT_EQ(0, std::memcmp(expectedIndices[i].data, outIndices[i].data,
+				outIndices[i].count*sizeof(std::uint16_t)));
+		}
+	}
+
+	converter.reset(std::vector<vfc::VertexFormat>(), vfc::IndexType::UInt16,
+		vfc::PrimitiveType::TriangleList);
+	EXPECT_FALSE(converter.isValid());
+}
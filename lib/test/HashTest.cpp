@@ -0,0 +1,63 @@
+/*
+ * Copyright 2026 Aaron Barany
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "Hash.h"
+#include <gtest/gtest.h>
+#include <unordered_set>
+#include <vector>
+
+TEST(HashTest, FixedHashFunctionMatchesAny)
+{
+	std::vector<std::uint8_t> data(64);
+	for (std::size_t i = 0; i < data.size(); ++i)
+		data[i] = static_cast<std::uint8_t>(i*37 + 11);
+
+	for (std::uint32_t size = 0; size <= data.size(); ++size)
+	{
+		vfc::HashFunction function = vfc::fixedHashFunction(size);
+		EXPECT_EQ(vfc::fixedHashAny(data.data(), size), function(data.data(), size)) << size;
+	}
+}
+
+TEST(HashTest, FixedHashUsesAllBytes)
+{
+	// Each single bit flip must change the hash for every key size, including the bytes only
+	// covered by overlapping reads.
+	std::vector<std::uint8_t> data(64);
+	for (std::uint32_t size = 1; size <= data.size(); ++size)
+	{
+		std::fill(data.begin(), data.end(), 0);
+		vfc::HashFunction function = vfc::fixedHashFunction(size);
+		std::unordered_set<std::size_t> hashes;
+		hashes.insert(function(data.data(), size));
+		for (std::uint32_t i = 0; i < size*8; ++i)
+		{
+			data[i/8] ^= static_cast<std::uint8_t>(1 << (i % 8));
+			hashes.insert(function(data.data(), size));
+			data[i/8] ^= static_cast<std::uint8_t>(1 << (i % 8));
+		}
+		EXPECT_EQ(size*8 + 1, hashes.size()) << size;
+	}
+}
+
+TEST(HashTest, FixedHashDependsOnSize)
+{
+	std::vector<std::uint8_t> data(64, 0);
+	std::unordered_set<std::size_t> hashes;
+	for (std::uint32_t size = 0; size <= data.size(); ++size)
+		hashes.insert(vfc::fixedHashAny(data.data(), size));
+	EXPECT_EQ(data.size() + 1, hashes.size());
+}
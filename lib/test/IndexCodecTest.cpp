@@ -0,0 +1,235 @@
+/*
+ * Copyright 2026 Aaron Barany
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <VFC/IndexCodec.h>
+#include <gtest/gtest.h>
+#include <random>
+
+namespace
+{
+
+// Grid of triangles with the vertices ordered by first use, similar to the output of Converter.
+template <typename T>
+std::vector<T> createGridTriangles(std::uint32_t width, std::uint32_t height)
+{
+	std::vector<T> indices;
+	for (std::uint32_t y = 0; y < height; ++y)
+	{
+		for (std::uint32_t x = 0; x < width; ++x)
+		{
+			auto v0 = static_cast<T>(y*(width + 1) + x);
+			auto v1 = static_cast<T>(v0 + 1);
+			auto v2 = static_cast<T>(v0 + width + 1);
+			auto v3 = static_cast<T>(v2 + 1);
+			indices.insert(indices.end(), {v0, v1, v2, v2, v1, v3});
+		}
+	}
+
+	std::vector<std::uint32_t> remap((width + 1)*(height + 1), 0xFFFFFFFF);
+	std::uint32_t nextVertex = 0;
+	for (T& index : indices)
+	{
+		if (remap[index] == 0xFFFFFFFF)
+			remap[index] = nextVertex++;
+		index = static_cast<T>(remap[index]);
+	}
+	return indices;
+}
+
+template <typename T>
+std::vector<T> decodeData(const std::vector<std::uint8_t>& data)
+{
+	vfc::EncodedIndicesHeader header;
+	EXPECT_TRUE(vfc::readEncodedIndicesHeader(header, data.data(), data.size()));
+	std::vector<T> result(header.indexCount);
+	EXPECT_TRUE(vfc::decodeIndices(result.data(), result.size()*sizeof(T), data.data(),
+		data.size()));
+	return result;
+}
+
+template <typename T>
+void expectSameTriangles(const std::vector<T>& expected, const std::vector<T>& actual)
+{
+	ASSERT_EQ(expected.size(), actual.size());
+	for (std::size_t i = 0; i < expected.size(); i += 3)
+	{
+		// Triangles may be rotated, but must have the same winding order.
+		const T* triangle = expected.data() + i;
+		unsigned int rotation = 0;
+		while (rotation < 3 && (triangle[rotation] != actual[i] ||
+			triangle[(rotation + 1) % 3] != actual[i + 1] ||
+			triangle[(rotation + 2) % 3] != actual[i + 2]))
+		{
+			++rotation;
+		}
+		EXPECT_LT(rotation, 3U) << "triangle " << i/3;
+	}
+}
+
+} // namespace
+
+TEST(IndexCodecTest, TriangleList)
+{
+	std::vector<std::uint16_t> indices = createGridTriangles<std::uint16_t>(100, 100);
+	vfc::IndexData indexData = {indices.data(), vfc::IndexType::UInt16,
+		static_cast<std::uint32_t>(indices.size()), 0};
+
+	std::vector<std::uint8_t> encoded;
+	ASSERT_TRUE(vfc::encodeIndices(encoded, indexData, vfc::PrimitiveType::TriangleList));
+	// A code byte per triangle, with an explicit vertex from the previous row for each quad.
+	EXPECT_LT(encoded.size(), indices.size()*sizeof(std::uint16_t)/3);
+
+	vfc::EncodedIndicesHeader header;
+	ASSERT_TRUE(vfc::readEncodedIndicesHeader(header, encoded.data(), encoded.size()));
+	EXPECT_EQ(vfc::PrimitiveType::TriangleList, header.primitiveType);
+	EXPECT_EQ(vfc::IndexType::UInt16, header.indexType);
+	EXPECT_EQ(indices.size(), header.indexCount);
+
+	expectSameTriangles(indices, decodeData<std::uint16_t>(encoded));
+}
+
+TEST(IndexCodecTest, RandomTriangleList)
+{
+	std::mt19937 random(42);
+	std::vector<std::uint32_t> indices(30000);
+	for (std::uint32_t& index : indices)
+		index = static_cast<std::uint32_t>(random());
+	indices[0] = 0xFFFFFFFF;
+	indices[1] = 0;
+	// Repeated vertices within a triangle.
+	indices[3] = indices[4] = indices[5] = 7;
+	indices[6] = indices[7] = 7;
+
+	vfc::IndexData indexData = {indices.data(), vfc::IndexType::UInt32,
+		static_cast<std::uint32_t>(indices.size()), 0};
+	std::vector<std::uint8_t> encoded;
+	ASSERT_TRUE(vfc::encodeIndices(encoded, indexData, vfc::PrimitiveType::TriangleList));
+	expectSameTriangles(indices, decodeData<std::uint32_t>(encoded));
+}
+
+TEST(IndexCodecTest, TriangleStrip)
+{
+	// Strips for each grid row separated by primitive restart.
+	const std::uint32_t width = 100, height = 50;
+	std::vector<std::uint16_t> indices;
+	for (std::uint32_t y = 0; y < height; ++y)
+	{
+		if (y > 0)
+			indices.push_back(0xFFFF);
+		for (std::uint32_t x = 0; x <= width; ++x)
+		{
+			indices.push_back(static_cast<std::uint16_t>(y*(width + 1) + x));
+			indices.push_back(static_cast<std::uint16_t>((y + 1)*(width + 1) + x));
+		}
+	}
+	indices.push_back(3);
+
+	vfc::IndexData indexData = {indices.data(), vfc::IndexType::UInt16,
+		static_cast<std::uint32_t>(indices.size()), 0};
+	std::vector<std::uint8_t> encoded;
+	ASSERT_TRUE(vfc::encodeIndices(encoded, indexData, vfc::PrimitiveType::TriangleStrip));
+	EXPECT_LT(encoded.size(), indices.size());
+	EXPECT_EQ(indices, decodeData<std::uint16_t>(encoded));
+}
+
+TEST(IndexCodecTest, RandomTriangleStrip)
+{
+	std::mt19937 random(1234);
+	std::vector<std::uint32_t> indices(10001);
+	for (std::uint32_t& index : indices)
+		index = static_cast<std::uint32_t>(random() % 64);
+	indices[10] = 0xFFFFFFFF;
+	indices[11] = 0xFFFFFFFE;
+
+	vfc::IndexData indexData = {indices.data(), vfc::IndexType::UInt32,
+		static_cast<std::uint32_t>(indices.size()), 0};
+	std::vector<std::uint8_t> encoded;
+	ASSERT_TRUE(vfc::encodeIndices(encoded, indexData, vfc::PrimitiveType::TriangleStrip));
+	EXPECT_EQ(indices, decodeData<std::uint32_t>(encoded));
+}
+
+TEST(IndexCodecTest, Empty)
+{
+	vfc::IndexData indexData = {nullptr, vfc::IndexType::UInt32, 0, 0};
+	std::vector<std::uint8_t> encoded;
+	ASSERT_TRUE(vfc::encodeIndices(encoded, indexData, vfc::PrimitiveType::TriangleList));
+	EXPECT_EQ(sizeof(vfc::EncodedIndicesHeader), encoded.size());
+	EXPECT_TRUE(vfc::decodeIndices(nullptr, 0, encoded.data(), encoded.size()));
+}
+
+TEST(IndexCodecTest, InvalidParameters)
+{
+	std::uint16_t indices[4] = {0, 1, 2, 3};
+	std::vector<std::uint8_t> encoded;
+	vfc::IndexData indexData = {indices, vfc::IndexType::UInt16, 4, 0};
+	EXPECT_FALSE(vfc::encodeIndices(encoded, indexData, vfc::PrimitiveType::TriangleList));
+	EXPECT_FALSE(vfc::encodeIndices(encoded, indexData, vfc::PrimitiveType::TriangleFan));
+	EXPECT_FALSE(vfc::encodeIndices(encoded, indexData, vfc::PrimitiveType::LineList));
+
+	indexData.count = 3;
+	indexData.type = vfc::IndexType::NoIndices;
+	EXPECT_FALSE(vfc::encodeIndices(encoded, indexData, vfc::PrimitiveType::TriangleList));
+
+	indexData.type = vfc::IndexType::UInt16;
+	indexData.data = nullptr;
+	EXPECT_FALSE(vfc::encodeIndices(encoded, indexData, vfc::PrimitiveType::TriangleList));
+}
+
+TEST(IndexCodecTest, InvalidData)
+{
+	std::vector<std::uint32_t> indices = createGridTriangles<std::uint32_t>(20, 20);
+	vfc::IndexData indexData = {indices.data(), vfc::IndexType::UInt32,
+		static_cast<std::uint32_t>(indices.size()), 0};
+	std::vector<std::uint8_t> encoded;
+	ASSERT_TRUE(vfc::encodeIndices(encoded, indexData, vfc::PrimitiveType::TriangleList));
+
+	std::vector<std::uint32_t> decoded(indices.size());
+	std::size_t decodedSize = decoded.size()*sizeof(std::uint32_t);
+	EXPECT_FALSE(vfc::decodeIndices(decoded.data(), decodedSize - 1, encoded.data(),
+		encoded.size()));
+	EXPECT_FALSE(vfc::decodeIndices(decoded.data(), decodedSize, encoded.data(),
+		encoded.size() - 1));
+	EXPECT_FALSE(vfc::decodeIndices(decoded.data(), decodedSize, encoded.data(),
+		sizeof(vfc::EncodedIndicesHeader) - 1));
+
+	std::vector<std::uint8_t> invalid = encoded;
+	invalid[0] = 'X';
+	EXPECT_FALSE(vfc::decodeIndices(decoded.data(), decodedSize, invalid.data(), invalid.size()));
+
+	invalid = encoded;
+	invalid[4] = vfc::encodedIndicesVersion + 1;
+	EXPECT_FALSE(vfc::decodeIndices(decoded.data(), decodedSize, invalid.data(), invalid.size()));
+
+	invalid = encoded;
+	invalid[5] = static_cast<std::uint8_t>(vfc::PrimitiveType::TriangleFan);
+	EXPECT_FALSE(vfc::decodeIndices(decoded.data(), decodedSize, invalid.data(), invalid.size()));
+
+	invalid = encoded;
+	invalid.push_back(0);
+	EXPECT_FALSE(vfc::decodeIndices(decoded.data(), decodedSize, invalid.data(), invalid.size()));
+
+	// Corrupting any byte must never read or write out of bounds. Most corruptions are detected,
+	// though some only change the decoded values.
+	std::mt19937 random(1234);
+	for (unsigned int i = 0; i < 1000; ++i)
+	{
+		invalid = encoded;
+		std::size_t offset = sizeof(vfc::EncodedIndicesHeader) + random() %
+			(invalid.size() - sizeof(vfc::EncodedIndicesHeader));
+		invalid[offset] = static_cast<std::uint8_t>(invalid[offset] ^ (1 + random() % 255));
+		vfc::decodeIndices(decoded.data(), decodedSize, invalid.data(), invalid.size());
+	}
+}
@@ -0,0 +1,249 @@
+/*
+ * Copyright 2026 Aaron Barany
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <VFC/InputContainer.h>
+#include <gtest/gtest.h>
+#include <cstring>
+
+namespace
+{
+
+// Storage aligned to 8 bytes so the tables may be accessed in place.
+std::vector<std::uint64_t> writeContainer(const vfc::InputContainerWriter& writer)
+{
+	std::size_t size = writer.getSize();
+	std::vector<std::uint64_t> data((size + sizeof(std::uint64_t) - 1)/sizeof(std::uint64_t));
+	EXPECT_TRUE(writer.write(data.data(), size));
+	return data;
+}
+
+} // namespace
+
+TEST(InputContainerTest, RoundTrip)
+{
+	std::vector<vfc::VertexFormat> vertexFormat(2);
+	ASSERT_EQ(vfc::VertexFormat::AddResult::Succeeded, vertexFormat[0].appendElement("position",
+		vfc::ElementLayout::X32Y32Z32, vfc::ElementType::Float));
+	ASSERT_EQ(vfc::VertexFormat::AddResult::Succeeded, vertexFormat[1].appendElement("color",
+		vfc::ElementLayout::X8Y8Z8W8, vfc::ElementType::UNorm));
+
+	vfc::VertexFormat positionFormat;
+	ASSERT_EQ(vfc::VertexFormat::AddResult::Succeeded, positionFormat.appendElement("position",
+		vfc::ElementLayout::X32Y32Z32, vfc::ElementType::Float));
+	vfc::VertexFormat colorFormat;
+	ASSERT_EQ(vfc::VertexFormat::AddResult::Succeeded, colorFormat.appendElement("color",
+		vfc::ElementLayout::X32Y32Z32W32, vfc::ElementType::Float));
+
+	float positions[] = {0.0f, 1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f, 7.0f, 8.0f};
+	float colors[] = {0.0f, 0.5f, 1.0f, 1.0f, 1.0f, 0.5f, 0.0f, 1.0f};
+	std::uint16_t positionIndices[] = {0, 1, 2};
+	std::uint32_t colorIndices[] = {0, 1, 0};
+
+	vfc::InputContainerWriter writer(vertexFormat, vfc::IndexType::UInt16,
+		vfc::PrimitiveType::TriangleList, 0, 64);
+	writer.addVertexStream(positionFormat, positions, 3, vfc::IndexType::UInt16, positionIndices,
+		3);
+	writer.addVertexStream(colorFormat, colors, 2, vfc::IndexType::UInt32, colorIndices, 3);
+	writer.setElementTransform("color", vfc::Converter::Transform::UNormToSNorm);
+	writer.setElementTransform("position", vfc::Converter::Transform::Bounds);
+	writer.setElementTransform("color", vfc::Converter::Transform::SNormToUNorm);
+
+	std::size_t size = writer.getSize();
+	EXPECT_EQ(0U, size % 64);
+	std::vector<std::uint64_t> data = writeContainer(writer);
+	EXPECT_TRUE(vfc::InputContainerReader::isInputContainer(data.data(), size));
+
+	vfc::InputContainerReader reader;
+	ASSERT_TRUE(reader.open(data.data(), size));
+	EXPECT_EQ(vertexFormat, reader.getVertexFormat());
+	EXPECT_EQ(vfc::IndexType::UInt16, reader.getIndexType());
+	EXPECT_EQ(vfc::PrimitiveType::TriangleList, reader.getPrimitiveType());
+	EXPECT_EQ(0U, reader.getPatchPoints());
+
+	const std::vector<vfc::InputVertexStream>& vertexStreams = reader.getVertexStreams();
+	ASSERT_EQ(2U, vertexStreams.size());
+	EXPECT_EQ(positionFormat, vertexStreams[0].vertexFormat);
+	EXPECT_EQ(3U, vertexStreams[0].vertexCount);
+	EXPECT_EQ(0, std::memcmp(positions, vertexStreams[0].vertexData, sizeof(positions)));
+	auto base = reinterpret_cast<const std::uint8_t*>(data.data());
+	EXPECT_EQ(0,
+		(reinterpret_cast<const std::uint8_t*>(vertexStreams[0].vertexData) - base) % 64);
+	EXPECT_EQ(vfc::IndexType::UInt16, vertexStreams[0].indexType);
+	EXPECT_EQ(3U, vertexStreams[0].indexCount);
+	EXPECT_EQ(0, std::memcmp(positionIndices, vertexStreams[0].indexData,
+		sizeof(positionIndices)));
+	EXPECT_EQ(0, (reinterpret_cast<const std::uint8_t*>(vertexStreams[0].indexData) - base) % 64);
+
+	EXPECT_EQ(colorFormat, vertexStreams[1].vertexFormat);
+	EXPECT_EQ(2U, vertexStreams[1].vertexCount);
+	EXPECT_EQ(0, std::memcmp(colors, vertexStreams[1].vertexData, sizeof(colors)));
+	EXPECT_EQ(vfc::IndexType::UInt32, vertexStreams[1].indexType);
+	EXPECT_EQ(3U, vertexStreams[1].indexCount);
+	EXPECT_EQ(0, std::memcmp(colorIndices, vertexStreams[1].indexData, sizeof(colorIndices)));
+
+	const auto& transforms = reader.getTransforms();
+	ASSERT_EQ(2U, transforms.size());
+	EXPECT_EQ("color", transforms[0].first);
+	EXPECT_EQ(vfc::Converter::Transform::SNormToUNorm, transforms[0].second);
+	EXPECT_EQ("position", transforms[1].first);
+	EXPECT_EQ(vfc::Converter::Transform::Bounds, transforms[1].second);
+
+	vfc::Converter converter(reader.getVertexFormat(), reader.getIndexType(),
+		reader.getPrimitiveType(), reader.getPatchPoints());
+	ASSERT_TRUE(reader.setupConverter(converter));
+	EXPECT_EQ(vfc::Converter::Transform::Bounds, converter.getElementTransform("position"));
+	EXPECT_EQ(vfc::Converter::Transform::SNormToUNorm, converter.getElementTransform("color"));
+	ASSERT_TRUE(converter.convert());
+	EXPECT_EQ(3U, converter.getVertexCount());
+}
+
+TEST(InputContainerTest, NoIndices)
+{
+	std::vector<vfc::VertexFormat> vertexFormat(1);
+	ASSERT_EQ(vfc::VertexFormat::AddResult::Succeeded, vertexFormat[0].appendElement("position",
+		vfc::ElementLayout::X16Y16, vfc::ElementType::Float));
+
+	float positions[] = {0.0f, 1.0f, 2.0f, 3.0f};
+	vfc::VertexFormat positionFormat;
+	ASSERT_EQ(vfc::VertexFormat::AddResult::Succeeded, positionFormat.appendElement("position",
+		vfc::ElementLayout::X32Y32, vfc::ElementType::Float));
+
+	vfc::InputContainerWriter writer(vertexFormat, vfc::IndexType::NoIndices,
+		vfc::PrimitiveType::LineList);
+	writer.addVertexStream(positionFormat, positions, 2);
+	std::vector<std::uint64_t> data = writeContainer(writer);
+
+	vfc::InputContainerReader reader;
+	ASSERT_TRUE(reader.open(data.data(), writer.getSize()));
+	EXPECT_EQ(vfc::IndexType::NoIndices, reader.getIndexType());
+	EXPECT_EQ(vfc::PrimitiveType::LineList, reader.getPrimitiveType());
+	EXPECT_TRUE(reader.getTransforms().empty());
+
+	const std::vector<vfc::InputVertexStream>& vertexStreams = reader.getVertexStreams();
+	ASSERT_EQ(1U, vertexStreams.size());
+	EXPECT_EQ(2U, vertexStreams[0].vertexCount);
+	EXPECT_EQ(0, std::memcmp(positions, vertexStreams[0].vertexData, sizeof(positions)));
+	EXPECT_EQ(vfc::IndexType::NoIndices, vertexStreams[0].indexType);
+	EXPECT_FALSE(vertexStreams[0].indexData);
+	EXPECT_EQ(0U, vertexStreams[0].indexCount);
+}
+
+TEST(InputContainerTest, WriteInvalid)
+{
+	std::vector<vfc::VertexFormat> vertexFormat(1);
+	ASSERT_EQ(vfc::VertexFormat::AddResult::Succeeded, vertexFormat[0].appendElement("position",
+		vfc::ElementLayout::X32Y32, vfc::ElementType::Float));
+
+	float positions[] = {0.0f, 1.0f, 2.0f, 3.0f};
+	std::vector<std::uint64_t> data(1024);
+
+	vfc::InputContainerWriter missingData(vertexFormat, vfc::IndexType::UInt16,
+		vfc::PrimitiveType::PointList);
+	missingData.addVertexStream(vertexFormat[0], positions, 2, vfc::IndexType::UInt16, nullptr,
+		2);
+	EXPECT_FALSE(missingData.write(data.data(), data.size()*sizeof(std::uint64_t)));
+
+	vfc::InputContainerWriter badAlignment(vertexFormat, vfc::IndexType::NoIndices,
+		vfc::PrimitiveType::PointList, 0, 24);
+	badAlignment.addVertexStream(vertexFormat[0], positions, 2);
+	EXPECT_FALSE(badAlignment.write(data.data(), data.size()*sizeof(std::uint64_t)));
+
+	vfc::InputContainerWriter tooSmall(vertexFormat, vfc::IndexType::NoIndices,
+		vfc::PrimitiveType::PointList);
+	tooSmall.addVertexStream(vertexFormat[0], positions, 2);
+	EXPECT_FALSE(tooSmall.write(data.data(), tooSmall.getSize() - 1));
+}
+
+TEST(InputContainerTest, ReadInvalid)
+{
+	std::vector<vfc::VertexFormat> vertexFormat(1);
+	ASSERT_EQ(vfc::VertexFormat::AddResult::Succeeded, vertexFormat[0].appendElement("position",
+		vfc::ElementLayout::X32Y32, vfc::ElementType::Float));
+
+	float positions[] = {0.0f, 1.0f, 2.0f, 3.0f};
+	std::uint32_t indices[] = {0, 1};
+	vfc::InputContainerWriter writer(vertexFormat, vfc::IndexType::UInt32,
+		vfc::PrimitiveType::PointList);
+	writer.addVertexStream(vertexFormat[0], positions, 2, vfc::IndexType::UInt32, indices, 2);
+	writer.setElementTransform("position", vfc::Converter::Transform::Bounds);
+	std::size_t size = writer.getSize();
+	std::vector<std::uint64_t> data = writeContainer(writer);
+
+	vfc::InputContainerReader reader;
+	ASSERT_TRUE(reader.open(data.data(), size));
+	EXPECT_FALSE(reader.open(nullptr, size));
+	EXPECT_TRUE(reader.getVertexStreams().empty());
+	EXPECT_FALSE(reader.open(data.data(), sizeof(vfc::InputContainerHeader) - 1));
+	EXPECT_FALSE(reader.open(data.data(), size - 1));
+	EXPECT_FALSE(vfc::InputContainerReader::isInputContainer(data.data(), 3));
+
+	auto header = reinterpret_cast<vfc::InputContainerHeader*>(data.data());
+	auto format = reinterpret_cast<vfc::InputContainerFormat*>(header + 1);
+	auto vertexStream = reinterpret_cast<vfc::InputContainerVertexStream*>(format + 1);
+	auto element = reinterpret_cast<vfc::InputContainerElement*>(vertexStream + 1);
+	auto transform = reinterpret_cast<vfc::InputContainerTransform*>(element + 2);
+
+	std::vector<std::uint64_t> original = data;
+	header->magic[3] = 'B';
+	EXPECT_FALSE(reader.open(data.data(), size));
+	data = original;
+
+	header->version = vfc::inputContainerVersion + 1;
+	EXPECT_FALSE(reader.open(data.data(), size));
+	data = original;
+
+	header->transformCount = 1000;
+	EXPECT_FALSE(reader.open(data.data(), size));
+	data = original;
+
+	format->elementCount = 3;
+	EXPECT_FALSE(reader.open(data.data(), size));
+	data = original;
+
+	vertexStream->elementCount = 0;
+	EXPECT_FALSE(reader.open(data.data(), size));
+	data = original;
+
+	vertexStream->vertexDataOffset = size;
+	EXPECT_FALSE(reader.open(data.data(), size));
+	data = original;
+
+	vertexStream->vertexDataSize -= 4;
+	EXPECT_FALSE(reader.open(data.data(), size));
+	data = original;
+
+	vertexStream->indexDataOffset += 4;
+	EXPECT_FALSE(reader.open(data.data(), size));
+	data = original;
+
+	vertexStream->indexDataSize = 6;
+	EXPECT_FALSE(reader.open(data.data(), size));
+	data = original;
+
+	element->nameLength = 100;
+	EXPECT_FALSE(reader.open(data.data(), size));
+	data = original;
+
+	element->type = vfc::ElementType::UNorm;
+	EXPECT_FALSE(reader.open(data.data(), size));
+	data = original;
+
+	transform->transform = 100;
+	EXPECT_FALSE(reader.open(data.data(), size));
+	data = original;
+
+	EXPECT_TRUE(reader.open(data.data(), size));
+}
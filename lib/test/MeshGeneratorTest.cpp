@@ -0,0 +1,190 @@
+/*
+ * Copyright 2026 Aaron Barany
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "MeshGenerator.h"
+#include <VFC/Converter.h>
+#include <gtest/gtest.h>
+
+namespace
+{
+
+vfc::VertexFormat createOutputFormat()
+{
+	vfc::VertexFormat vertexFormat;
+	vertexFormat.appendElement("position", vfc::ElementLayout::X32Y32Z32,
+		vfc::ElementType::Float);
+	vertexFormat.appendElement("normal", vfc::ElementLayout::W2X10Y10Z10,
+		vfc::ElementType::SNorm);
+	vertexFormat.appendElement("texCoord", vfc::ElementLayout::X16Y16, vfc::ElementType::UNorm);
+	return vertexFormat;
+}
+
+std::uint32_t convertedVertexCount(const vfc::MeshOptions& options, vfc::IndexType indexType)
+{
+	vfc::GeneratedMesh mesh;
+	std::string error;
+	EXPECT_TRUE(vfc::generateMesh(mesh, options, error)) << error;
+
+	vfc::Converter converter(createOutputFormat(), indexType, options.primitiveType, 0,
+		[](const char* message)
+		{
+			ADD_FAILURE() << message;
+		});
+	EXPECT_TRUE(vfc::addVertexStreams(converter, mesh));
+	EXPECT_TRUE(converter.convert());
+	return converter.getVertexCount();
+}
+
+} // namespace
+
+TEST(MeshGeneratorTest, Deterministic)
+{
+	vfc::MeshOptions options;
+	options.shape = vfc::MeshShape::Noise;
+	options.primitiveType = vfc::PrimitiveType::TriangleStrip;
+	options.duplicateRatio = 0.3;
+	options.restartDensity = 0.2;
+	options.seed = 3;
+
+	vfc::GeneratedMesh first, second;
+	std::string error;
+	ASSERT_TRUE(vfc::generateMesh(first, options, error));
+	ASSERT_TRUE(vfc::generateMesh(second, options, error));
+	ASSERT_EQ(1U, first.streams.size());
+	ASSERT_EQ(1U, second.streams.size());
+	EXPECT_EQ(first.indexCount, second.indexCount);
+	EXPECT_EQ(first.streams[0].vertices, second.streams[0].vertices);
+	EXPECT_EQ(first.streams[0].indices, second.streams[0].indices);
+
+	options.seed = 4;
+	ASSERT_TRUE(vfc::generateMesh(second, options, error));
+	EXPECT_NE(first.streams[0].indices, second.streams[0].indices);
+}
+
+TEST(MeshGeneratorTest, IndexCount)
+{
+	const vfc::PrimitiveType primitiveTypes[] =
+	{
+		vfc::PrimitiveType::PointList, vfc::PrimitiveType::LineList,
+		vfc::PrimitiveType::LineStrip, vfc::PrimitiveType::TriangleList,
+		vfc::PrimitiveType::TriangleStrip, vfc::PrimitiveType::TriangleFan
+	};
+
+	for (vfc::PrimitiveType primitiveType : primitiveTypes)
+	{
+		vfc::MeshOptions options;
+		options.primitiveType = primitiveType;
+		options.indexCount = 100000;
+
+		vfc::GeneratedMesh mesh;
+		std::string error;
+		ASSERT_TRUE(vfc::generateMesh(mesh, options, error));
+		EXPECT_LE(90000U, mesh.indexCount) << vfc::primitiveTypeName(primitiveType);
+		EXPECT_GE(120000U, mesh.indexCount) << vfc::primitiveTypeName(primitiveType);
+	}
+}
+
+TEST(MeshGeneratorTest, ConvertAll)
+{
+	const vfc::MeshShape shapes[] = {vfc::MeshShape::Grid, vfc::MeshShape::Sphere,
+		vfc::MeshShape::Noise};
+	const vfc::PrimitiveType primitiveTypes[] =
+	{
+		vfc::PrimitiveType::PointList, vfc::PrimitiveType::LineList,
+		vfc::PrimitiveType::LineStrip, vfc::PrimitiveType::TriangleList,
+		vfc::PrimitiveType::TriangleStrip, vfc::PrimitiveType::TriangleFan
+	};
+	const vfc::IndexType indexTypes[] = {vfc::IndexType::NoIndices, vfc::IndexType::UInt16,
+		vfc::IndexType::UInt32};
+
+	for (vfc::MeshShape shape : shapes)
+	{
+		for (vfc::PrimitiveType primitiveType : primitiveTypes)
+		{
+			for (vfc::IndexType indexType : indexTypes)
+			{
+				// Strips and fans always have primitive restarts, which require output indices.
+				bool hasRestarts = primitiveType == vfc::PrimitiveType::LineStrip ||
+					primitiveType == vfc::PrimitiveType::TriangleStrip ||
+					primitiveType == vfc::PrimitiveType::TriangleFan;
+				if (hasRestarts && indexType == vfc::IndexType::NoIndices)
+					continue;
+
+				for (unsigned int i = 0; i < 4; ++i)
+				{
+					vfc::MeshOptions options;
+					options.shape = shape;
+					options.primitiveType = primitiveType;
+					options.indexCount = 3000;
+					options.splitIndices = (i & 1) != 0;
+					options.duplicateRatio = (i & 2) ? 0.25 : 0.0;
+					options.restartDensity = 0.1;
+					options.indexType = vfc::IndexType::UInt16;
+					EXPECT_LT(0U, convertedVertexCount(options, indexType));
+				}
+			}
+		}
+	}
+}
+
+TEST(MeshGeneratorTest, DuplicatesRemoved)
+{
+	vfc::MeshOptions options;
+	options.shape = vfc::MeshShape::Sphere;
+	options.indexCount = 10000;
+	std::uint32_t vertexCount = convertedVertexCount(options, vfc::IndexType::UInt32);
+
+	options.splitIndices = true;
+	EXPECT_EQ(vertexCount, convertedVertexCount(options, vfc::IndexType::UInt32));
+
+	options.duplicateRatio = 0.5;
+	EXPECT_EQ(vertexCount, convertedVertexCount(options, vfc::IndexType::UInt32));
+
+	options.splitIndices = false;
+	EXPECT_EQ(vertexCount, convertedVertexCount(options, vfc::IndexType::UInt32));
+}
+
+TEST(MeshGeneratorTest, Errors)
+{
+	vfc::GeneratedMesh mesh;
+	std::string error;
+
+	vfc::MeshOptions options;
+	options.primitiveType = vfc::PrimitiveType::PatchList;
+	EXPECT_FALSE(vfc::generateMesh(mesh, options, error));
+	EXPECT_EQ("Unsupported primitive type for generated mesh.", error);
+
+	options = vfc::MeshOptions();
+	options.indexType = vfc::IndexType::NoIndices;
+	EXPECT_FALSE(vfc::generateMesh(mesh, options, error));
+	EXPECT_EQ("Generated meshes must have indices.", error);
+
+	options = vfc::MeshOptions();
+	options.duplicateRatio = 1.5;
+	EXPECT_FALSE(vfc::generateMesh(mesh, options, error));
+	EXPECT_EQ("Duplicate ratio and restart density must be in the range [0, 1].", error);
+
+	options = vfc::MeshOptions();
+	options.indexCount = 0xFFFFFFFFULL;
+	EXPECT_FALSE(vfc::generateMesh(mesh, options, error));
+	EXPECT_EQ("Too many indices for generated mesh.", error);
+
+	options = vfc::MeshOptions();
+	options.indexType = vfc::IndexType::UInt16;
+	options.indexCount = 1000000;
+	EXPECT_FALSE(vfc::generateMesh(mesh, options, error));
+	EXPECT_EQ("Too many vertices for the index type of the generated mesh.", error);
+}
@@ -0,0 +1,300 @@
+/*
+ * Copyright 2026 Aaron Barany
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "MeshGenerator.h"
+#include <VFC/Simplifier.h>
+#include <gtest/gtest.h>
+#include <set>
+#include <string>
+
+namespace
+{
+
+struct Vertex
+{
+	float position[3];
+	float texCoord[2];
+};
+
+vfc::VertexFormat createVertexFormat()
+{
+	vfc::VertexFormat vertexFormat;
+	vertexFormat.appendElement("position", vfc::ElementLayout::X32Y32Z32, vfc::ElementType::Float);
+	vertexFormat.appendElement("texCoord", vfc::ElementLayout::X32Y32, vfc::ElementType::Float);
+	return vertexFormat;
+}
+
+// Flat grid in the XY plane facing +Z. When seamColumn is set, the vertices in that column are
+// duplicated with different texture coordinates for the quads to the right.
+void createGrid(std::vector<Vertex>& outVertices, std::vector<std::uint32_t>& outIndices,
+	std::uint32_t size, std::uint32_t seamColumn = 0)
+{
+	outVertices.clear();
+	outIndices.clear();
+	for (std::uint32_t y = 0; y <= size; ++y)
+	{
+		for (std::uint32_t x = 0; x <= size; ++x)
+		{
+			auto fx = static_cast<float>(x), fy = static_cast<float>(y);
+			outVertices.push_back(Vertex{{fx, fy, 0.0f}, {fx, fy}});
+		}
+	}
+
+	auto seamStart = static_cast<std::uint32_t>(outVertices.size());
+	if (seamColumn > 0)
+	{
+		for (std::uint32_t y = 0; y <= size; ++y)
+		{
+			auto fx = static_cast<float>(seamColumn), fy = static_cast<float>(y);
+			outVertices.push_back(Vertex{{fx, fy, 0.0f}, {fx + 100.0f, fy}});
+		}
+	}
+
+	for (std::uint32_t y = 0; y < size; ++y)
+	{
+		for (std::uint32_t x = 0; x < size; ++x)
+		{
+			std::uint32_t v0 = y*(size + 1) + x;
+			std::uint32_t v1 = v0 + 1;
+			std::uint32_t v2 = v0 + size + 1;
+			std::uint32_t v3 = v2 + 1;
+			if (seamColumn > 0 && x == seamColumn)
+			{
+				v0 = seamStart + y;
+				v2 = seamStart + y + 1;
+			}
+			outIndices.insert(outIndices.end(), {v0, v1, v2, v2, v1, v3});
+		}
+	}
+}
+
+std::set<std::uint32_t> usedVertices(const vfc::IndexData& indexData)
+{
+	auto indices = reinterpret_cast<const std::uint32_t*>(indexData.data);
+	return std::set<std::uint32_t>(indices, indices + indexData.count);
+}
+
+bool hasFlippedTriangles(const std::vector<Vertex>& vertices, const vfc::IndexData& indexData)
+{
+	auto indices = reinterpret_cast<const std::uint32_t*>(indexData.data);
+	for (std::uint32_t i = 0; i < indexData.count; i += 3)
+	{
+		const float* p0 = vertices[indices[i]].position;
+		const float* p1 = vertices[indices[i + 1]].position;
+		const float* p2 = vertices[indices[i + 2]].position;
+		float normalZ = (p1[0] - p0[0])*(p2[1] - p0[1]) - (p1[1] - p0[1])*(p2[0] - p0[0]);
+		if (normalZ <= 0)
+			return true;
+	}
+	return false;
+}
+
+} // namespace
+
+TEST(SimplifierTest, Grid)
+{
+	const std::uint32_t size = 20;
+	std::vector<Vertex> vertices;
+	std::vector<std::uint32_t> indices;
+	createGrid(vertices, indices, size);
+
+	vfc::Simplifier simplifier;
+	std::vector<vfc::IndexData> indexData = {{indices.data(), vfc::IndexType::UInt32,
+		static_cast<std::uint32_t>(indices.size()), 0}};
+	ASSERT_TRUE(simplifier.simplify(createVertexFormat(), vertices.data(),
+		static_cast<std::uint32_t>(vertices.size()), "position", indexData,
+		vfc::PrimitiveType::TriangleList, {0.5, 0.2}));
+	ASSERT_EQ(2U, simplifier.getLodCount());
+
+	std::size_t triangleCount = indices.size()/3;
+	const std::size_t targets[] = {triangleCount/2, triangleCount/5};
+	for (std::size_t i = 0; i < simplifier.getLodCount(); ++i)
+	{
+		const std::vector<vfc::IndexData>& lodIndices = simplifier.getLodIndices(i);
+		ASSERT_EQ(1U, lodIndices.size());
+		EXPECT_EQ(vfc::IndexType::UInt32, lodIndices[0].type);
+		EXPECT_EQ(0, lodIndices[0].baseVertex);
+		EXPECT_EQ(0U, lodIndices[0].count % 3);
+		EXPECT_LE(lodIndices[0].count/3, targets[i]);
+		// Collapsing a vertex removes at most two triangles, though the border can't be removed.
+		EXPECT_GE(lodIndices[0].count/3 + 2, targets[i]);
+		EXPECT_FALSE(hasFlippedTriangles(vertices, lodIndices[0]));
+		// Flat, so there's no error.
+		EXPECT_DOUBLE_EQ(0.0, simplifier.getLodError(i));
+
+		// The border vertices are kept.
+		std::set<std::uint32_t> used = usedVertices(lodIndices[0]);
+		for (std::uint32_t j = 0; j <= size; ++j)
+		{
+			EXPECT_EQ(1U, used.count(j));
+			EXPECT_EQ(1U, used.count(size*(size + 1) + j));
+			EXPECT_EQ(1U, used.count(j*(size + 1)));
+			EXPECT_EQ(1U, used.count(j*(size + 1) + size));
+		}
+	}
+}
+
+TEST(SimplifierTest, AttributeSeam)
+{
+	const std::uint32_t size = 20, seamColumn = 10;
+	std::vector<Vertex> vertices;
+	std::vector<std::uint32_t> indices;
+	createGrid(vertices, indices, size, seamColumn);
+
+	vfc::Simplifier simplifier;
+	std::vector<vfc::IndexData> indexData = {{indices.data(), vfc::IndexType::UInt32,
+		static_cast<std::uint32_t>(indices.size()), 0}};
+	ASSERT_TRUE(simplifier.simplify(createVertexFormat(), vertices.data(),
+		static_cast<std::uint32_t>(vertices.size()), "position", indexData,
+		vfc::PrimitiveType::TriangleList, {0.25}));
+
+	const vfc::IndexData& lodIndices = simplifier.getLodIndices(0)[0];
+	EXPECT_LT(lodIndices.count, indices.size()/2);
+	EXPECT_FALSE(hasFlippedTriangles(vertices, lodIndices));
+
+	// Both sides of the seam are kept, and triangles don't cross it.
+	std::set<std::uint32_t> used = usedVertices(lodIndices);
+	auto seamStart = static_cast<std::uint32_t>((size + 1)*(size + 1));
+	auto lod = reinterpret_cast<const std::uint32_t*>(lodIndices.data);
+	for (std::uint32_t y = 0; y <= size; ++y)
+	{
+		EXPECT_EQ(1U, used.count(y*(size + 1) + seamColumn));
+		EXPECT_EQ(1U, used.count(seamStart + y));
+	}
+
+	for (std::uint32_t i = 0; i < lodIndices.count; i += 3)
+	{
+		bool left = false, right = false;
+		for (unsigned int j = 0; j < 3; ++j)
+		{
+			const Vertex& vertex = vertices[lod[i + j]];
+			if (vertex.texCoord[0] >= 100.0f ||
+				(vertex.texCoord[0] > static_cast<float>(seamColumn)))
+			{
+				right = true;
+			}
+			else if (vertex.texCoord[0] < static_cast<float>(seamColumn))
+				left = true;
+		}
+		EXPECT_FALSE(left && right);
+	}
+}
+
+TEST(SimplifierTest, Sphere)
+{
+	vfc::MeshOptions options;
+	options.shape = vfc::MeshShape::Sphere;
+	options.indexCount = 60000;
+	vfc::GeneratedMesh mesh;
+	std::string error;
+	ASSERT_TRUE(vfc::generateMesh(mesh, options, error));
+
+	vfc::VertexFormat vertexFormat;
+	vertexFormat.appendElement("position", vfc::ElementLayout::X16Y16Z16, vfc::ElementType::UNorm);
+	vertexFormat.appendElement("normal", vfc::ElementLayout::W2X10Y10Z10,
+		vfc::ElementType::SNorm);
+	vertexFormat.appendElement("texCoord", vfc::ElementLayout::X16Y16, vfc::ElementType::UNorm);
+
+	vfc::Converter converter(vertexFormat, vfc::IndexType::UInt32, mesh.primitiveType);
+	ASSERT_TRUE(vfc::addVertexStreams(converter, mesh));
+	converter.setElementTransform("position", vfc::Converter::Transform::Bounds);
+	ASSERT_TRUE(converter.convert());
+
+	vfc::VertexValue boundsMin, boundsMax;
+	ASSERT_TRUE(converter.getVertexElementBounds(boundsMin, boundsMax, "position"));
+	double radius = (boundsMax[0] - boundsMin[0])/2;
+
+	vfc::Simplifier simplifier;
+	ASSERT_TRUE(simplifier.simplify(converter, "position", {0.5, 0.1}));
+	ASSERT_EQ(2U, simplifier.getLodCount());
+
+	std::uint32_t indexCount = converter.getIndices()[0].count;
+	const vfc::IndexData& lod0 = simplifier.getLodIndices(0)[0];
+	const vfc::IndexData& lod1 = simplifier.getLodIndices(1)[0];
+	EXPECT_LE(lod0.count, indexCount/2);
+	EXPECT_GT(lod0.count, indexCount/3);
+	EXPECT_LE(lod1.count, indexCount/10);
+	EXPECT_GT(lod1.count, indexCount/20);
+
+	// The error is in the original units, and increases for each level of detail.
+	EXPECT_GT(simplifier.getLodError(0), 0.0);
+	EXPECT_LT(simplifier.getLodError(0), simplifier.getLodError(1));
+	EXPECT_LT(simplifier.getLodError(1), radius*0.1);
+
+	for (const vfc::IndexData* lod : {&lod0, &lod1})
+	{
+		for (std::uint32_t index : usedVertices(*lod))
+			EXPECT_LT(index, converter.getVertexCount());
+	}
+}
+
+TEST(SimplifierTest, SplitIndexBuffers)
+{
+	vfc::MeshOptions options;
+	options.indexCount = 60000;
+	vfc::GeneratedMesh mesh;
+	std::string error;
+	ASSERT_TRUE(vfc::generateMesh(mesh, options, error));
+
+	vfc::VertexFormat vertexFormat;
+	vertexFormat.appendElement("position", vfc::ElementLayout::X32Y32Z32, vfc::ElementType::Float);
+	vfc::Converter converter(vertexFormat, vfc::IndexType::UInt16, mesh.primitiveType, 0, 2000);
+	ASSERT_TRUE(vfc::addVertexStreams(converter, mesh));
+	ASSERT_TRUE(converter.convert());
+	const std::vector<vfc::IndexData>& indices = converter.getIndices();
+	ASSERT_LT(1U, indices.size());
+
+	vfc::Simplifier simplifier;
+	ASSERT_TRUE(simplifier.simplify(converter, "position", {0.5}));
+	const std::vector<vfc::IndexData>& lodIndices = simplifier.getLodIndices(0);
+	ASSERT_EQ(indices.size(), lodIndices.size());
+	for (std::size_t i = 0; i < indices.size(); ++i)
+	{
+		EXPECT_EQ(vfc::IndexType::UInt16, lodIndices[i].type);
+		EXPECT_EQ(indices[i].baseVertex, lodIndices[i].baseVertex);
+		EXPECT_LT(lodIndices[i].count, indices[i].count);
+
+		auto lod = reinterpret_cast<const std::uint16_t*>(lodIndices[i].data);
+		for (std::uint32_t j = 0; j < lodIndices[i].count; ++j)
+			EXPECT_LE(lod[j], 2000U);
+	}
+}
+
+TEST(SimplifierTest, InvalidParameters)
+{
+	std::vector<Vertex> vertices;
+	std::vector<std::uint32_t> indices;
+	createGrid(vertices, indices, 4);
+	auto vertexCount = static_cast<std::uint32_t>(vertices.size());
+	std::vector<vfc::IndexData> indexData = {{indices.data(), vfc::IndexType::UInt32,
+		static_cast<std::uint32_t>(indices.size()), 0}};
+
+	std::vector<std::string> errors;
+	vfc::Simplifier simplifier([&errors](const char* message) {errors.push_back(message);});
+	vfc::VertexFormat vertexFormat = createVertexFormat();
+	EXPECT_FALSE(simplifier.simplify(vertexFormat, vertices.data(), vertexCount, "position",
+		indexData, vfc::PrimitiveType::TriangleStrip, {0.5}));
+	EXPECT_FALSE(simplifier.simplify(vertexFormat, vertices.data(), vertexCount, "normal",
+		indexData, vfc::PrimitiveType::TriangleList, {0.5}));
+	EXPECT_FALSE(simplifier.simplify(vertexFormat, vertices.data(), vertexCount, "position",
+		indexData, vfc::PrimitiveType::TriangleList, {0.0}));
+	EXPECT_FALSE(simplifier.simplify(vertexFormat, vertices.data(), vertexCount, "position",
+		indexData, vfc::PrimitiveType::TriangleList, {0.25, 0.5}));
+	EXPECT_FALSE(simplifier.simplify(vertexFormat, vertices.data(), vertexCount - 1, "position",
+		indexData, vfc::PrimitiveType::TriangleList, {0.5}));
+	EXPECT_EQ(5U, errors.size());
+	EXPECT_EQ(0U, simplifier.getLodCount());
+}
@@ -0,0 +1,77 @@
+/*
+ * Copyright 2026 Aaron Barany
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <VFC/Trace.h>
+#include <gtest/gtest.h>
+#include <sstream>
+
+TEST(TraceTest, Disabled)
+{
+	vfc::Trace::start();
+	vfc::Trace::stop();
+	EXPECT_FALSE(vfc::Trace::isEnabled());
+	{
+		vfc::ScopedTrace trace("test");
+	}
+	EXPECT_EQ(0U, vfc::Trace::getEventCount());
+}
+
+TEST(TraceTest, ScopedTrace)
+{
+	vfc::Trace::start();
+	EXPECT_TRUE(vfc::Trace::isEnabled());
+	{
+		vfc::ScopedTrace outer("outer");
+		vfc::ScopedTrace phase("first");
+		phase.next("second", "detail");
+	}
+	vfc::Trace::stop();
+	EXPECT_EQ(3U, vfc::Trace::getEventCount());
+
+	std::stringstream stream;
+	ASSERT_TRUE(vfc::Trace::writeChromeTrace(stream));
+	std::string trace = stream.str();
+	EXPECT_EQ(0U, trace.find("{\"traceEvents\": [\n"));
+	std::size_t first = trace.find("\"name\": \"first\"");
+	std::size_t second = trace.find("\"name\": \"second\"");
+	std::size_t outer = trace.find("\"name\": \"outer\"");
+	ASSERT_NE(std::string::npos, first);
+	ASSERT_NE(std::string::npos, second);
+	ASSERT_NE(std::string::npos, outer);
+	EXPECT_LT(first, second);
+	EXPECT_LT(second, outer);
+	EXPECT_NE(std::string::npos, trace.find("\"ph\": \"X\""));
+	EXPECT_NE(std::string::npos, trace.find("\"args\": {\"detail\": \"detail\"}"));
+
+	// Starting again clears the previous events.
+	vfc::Trace::start();
+	vfc::Trace::stop();
+	EXPECT_EQ(0U, vfc::Trace::getEventCount());
+}
+
+TEST(TraceTest, EscapeDetail)
+{
+	vfc::Trace::start();
+	{
+		vfc::ScopedTrace trace("escape", "C:\\dir\\\"file\"\n");
+	}
+	vfc::Trace::stop();
+
+	std::stringstream stream;
+	ASSERT_TRUE(vfc::Trace::writeChromeTrace(stream));
+	EXPECT_NE(std::string::npos,
+		stream.str().find("\"detail\": \"C:\\\\dir\\\\\\\"file\\\"\\n\""));
+}
@@ -1,5 +1,5 @@
 /*
- * Copyright 2020 Aaron Barany
+ * Copyright 2020-2026 Aaron Barany
  *
  * Licensed under the Apache License, Version 2.0 (the "License");
  * you may not use this file except in compliance with the License.
@@ -15,11 +15,49 @@
  */
 
 #include "Base64.h"
+#include <VFC/Config.h>
+#include <VFC/Trace.h>
+#include <cstring>
+
+#if VFC_X86_32 || VFC_X86_64
+#include <immintrin.h>
+#define VFC_BASE64_SSSE3 1
+#define VFC_BASE64_NEON 0
+#elif VFC_ARM_64
+#include <arm_neon.h>
+#define VFC_BASE64_SSSE3 0
+#define VFC_BASE64_NEON 1
+#else
+#define VFC_BASE64_SSSE3 0
+#define VFC_BASE64_NEON 0
+#endif
+
+#if VFC_BASE64_SSSE3
+#if VFC_WINDOWS
+#include <intrin.h>
+#else
+#include <cpuid.h>
+#endif
+#endif
+
+#if VFC_BASE64_SSSE3 && VFC_CLANG
+#define VFC_START_SSSE3() \
+	_Pragma("clang attribute push(__attribute__((target(\"sse,sse2,ssse3\"))), apply_to = function)")
+#define VFC_END_SSSE3() _Pragma("clang attribute pop")
+#elif VFC_BASE64_SSSE3 && VFC_GCC
+#define VFC_START_SSSE3() \
+	_Pragma("GCC push_options") \
+	_Pragma("GCC target(\"sse,sse2,ssse3\")")
+#define VFC_END_SSSE3() _Pragma("GCC pop_options")
+#else
+#define VFC_START_SSSE3()
+#define VFC_END_SSSE3()
+#endif
 
 namespace base64
 {
 
-static char bytesToChar[] =
+static const char bytesToChar[] =
 {
 	'A', 'B', 'C', 'D', 'E', 'F', 'G', 'H', 'I', 'J', 'K', 'L', 'M', 'N', 'O', 'P', 'Q', 'R', 'S',
 	'T', 'U', 'V', 'W', 'X', 'Y', 'Z',
@@ -32,20 +70,245 @@ static char bytesToChar[] =
 
 static_assert(sizeof(bytesToChar) == 64, "Invalid bytes to char mapping.");
 
-std::string encode(const void* data, std::size_t size)
+static const std::uint8_t invalidChar = 0xFF;
+
+struct CharToBytes
+{
+	CharToBytes()
+	{
+		std::memset(values, invalidChar, sizeof(values));
+		for (unsigned int i = 0; i < sizeof(bytesToChar); ++i)
+			values[static_cast<std::uint8_t>(bytesToChar[i])] = static_cast<std::uint8_t>(i);
+	}
+
+	std::uint8_t values[256];
+};
+
+static const CharToBytes charToBytes;
+
+#if VFC_BASE64_SSSE3
+
+#if VFC_WINDOWS
+static void __get_cpuid(unsigned int level, unsigned int* eax, unsigned int* ebx, unsigned int* ecx,
+	unsigned int* edx)
+{
+	int cpuInfo[4];
+	__cpuid(cpuInfo, level);
+	*eax = cpuInfo[0];
+	*ebx = cpuInfo[1];
+	*ecx = cpuInfo[2];
+	*edx = cpuInfo[3];
+}
+#endif
+
+static bool checkHasSimd()
+{
+	const unsigned int ssse3Bit = 1 << 9;
+
+	unsigned int eax = 0, ebx = 0, ecx = 0, edx = 0;
+	__get_cpuid(1, &eax, &ebx, &ecx, &edx);
+	return (ecx & ssse3Bit) != 0;
+}
+
+VFC_START_SSSE3()
+
+// Based on the lookup and shuffle algorithms by Wojciech Muła and Alfred Klomp. Each iteration
+// encodes 12 bytes into 16 characters, reading 16 bytes.
+static std::size_t encodeSimd(char* dst, const std::uint8_t* src, std::size_t size)
+{
+	const __m128i shuffle = _mm_set_epi8(10, 11, 9, 10, 7, 8, 6, 7, 4, 5, 3, 4, 1, 2, 0, 1);
+	const __m128i shiftLut = _mm_setr_epi8('a' - 26, '0' - 52, '0' - 52, '0' - 52, '0' - 52,
+		'0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '+' - 62, '/' - 63, 'A', 0, 0);
+
+	std::size_t offset = 0;
+	for (; size - offset >= 16; offset += 12, dst += 16)
+	{
+		__m128i in = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + offset));
+		in = _mm_shuffle_epi8(in, shuffle);
+
+		// Split each 24-bit group into four 6-bit indices, one per byte.
+		__m128i t0 = _mm_and_si128(in, _mm_set1_epi32(0x0FC0FC00));
+		__m128i t1 = _mm_mulhi_epu16(t0, _mm_set1_epi32(0x04000040));
+		__m128i t2 = _mm_and_si128(in, _mm_set1_epi32(0x003F03F0));
+		__m128i t3 = _mm_mullo_epi16(t2, _mm_set1_epi32(0x01000010));
+		__m128i indices = _mm_or_si128(t1, t3);
+
+		// Offset from the index to the character for each range of indices.
+		__m128i range = _mm_subs_epu8(indices, _mm_set1_epi8(51));
+		__m128i upper = _mm_cmpgt_epi8(_mm_set1_epi8(26), indices);
+		range = _mm_or_si128(range, _mm_and_si128(upper, _mm_set1_epi8(13)));
+		__m128i result = _mm_add_epi8(_mm_shuffle_epi8(shiftLut, range), indices);
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(dst), result);
+	}
+
+	return offset;
+}
+
+// Each iteration decodes 16 characters into 12 bytes, writing 16 bytes. Stops at the first block
+// with any invalid characters or padding, leaving it for the scalar implementation.
+static std::size_t decodeSimd(std::uint8_t* dst, const char* src, std::size_t length)
+{
+	const __m128i lutLo = _mm_setr_epi8(0x15, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11,
+		0x11, 0x13, 0x1A, 0x1B, 0x1B, 0x1B, 0x1A);
+	const __m128i lutHi = _mm_setr_epi8(0x10, 0x10, 0x01, 0x02, 0x04, 0x08, 0x04, 0x08, 0x10,
+		0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10);
+	const __m128i lutRoll = _mm_setr_epi8(0, 16, 19, 4, -65, -65, -71, -71, 0, 0, 0, 0, 0, 0, 0,
+		0);
+	const __m128i nibbleMask = _mm_set1_epi8(0x0F);
+	const __m128i shuffle = _mm_setr_epi8(2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1);
+
+	// Keep at least 8 characters after the block so the 16 byte store stays in range.
+	std::size_t offset = 0;
+	for (; length - offset >= 24; offset += 16, dst += 12)
+	{
+		__m128i in = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + offset));
+		__m128i hiNibbles = _mm_and_si128(_mm_srli_epi32(in, 4), nibbleMask);
+		__m128i loNibbles = _mm_and_si128(in, nibbleMask);
+		__m128i lo = _mm_shuffle_epi8(lutLo, loNibbles);
+		__m128i hi = _mm_shuffle_epi8(lutHi, hiNibbles);
+		if (_mm_movemask_epi8(_mm_cmpgt_epi8(_mm_and_si128(lo, hi), _mm_setzero_si128())) != 0)
+			break;
+
+		__m128i isSlash = _mm_cmpeq_epi8(in, _mm_set1_epi8('/'));
+		__m128i roll = _mm_shuffle_epi8(lutRoll, _mm_add_epi8(isSlash, hiNibbles));
+		__m128i values = _mm_add_epi8(in, roll);
+
+		// Merge the 6-bit values into 24-bit groups, then pack the bytes together.
+		__m128i merged = _mm_maddubs_epi16(values, _mm_set1_epi32(0x01400140));
+		merged = _mm_madd_epi16(merged, _mm_set1_epi32(0x00011000));
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(dst), _mm_shuffle_epi8(merged, shuffle));
+	}
+
+	return offset;
+}
+
+VFC_END_SSSE3()
+
+#elif VFC_BASE64_NEON
+
+static bool checkHasSimd()
+{
+	return true;
+}
+
+static uint8x16x4_t loadTable(const std::uint8_t* table)
+{
+	uint8x16x4_t result;
+	result.val[0] = vld1q_u8(table);
+	result.val[1] = vld1q_u8(table + 16);
+	result.val[2] = vld1q_u8(table + 32);
+	result.val[3] = vld1q_u8(table + 48);
+	return result;
+}
+
+// Each iteration encodes 48 bytes into 64 characters.
+static std::size_t encodeSimd(char* dst, const std::uint8_t* src, std::size_t size)
+{
+	const uint8x16x4_t table = loadTable(reinterpret_cast<const std::uint8_t*>(bytesToChar));
+	const uint8x16_t mask = vdupq_n_u8(0x3F);
+
+	std::size_t offset = 0;
+	for (; size - offset >= 48; offset += 48, dst += 64)
+	{
+		uint8x16x3_t in = vld3q_u8(src + offset);
+		uint8x16x4_t indices;
+		indices.val[0] = vshrq_n_u8(in.val[0], 2);
+		indices.val[1] = vandq_u8(vorrq_u8(vshrq_n_u8(in.val[1], 4), vshlq_n_u8(in.val[0], 4)),
+			mask);
+		indices.val[2] = vandq_u8(vorrq_u8(vshrq_n_u8(in.val[2], 6), vshlq_n_u8(in.val[1], 2)),
+			mask);
+		indices.val[3] = vandq_u8(in.val[2], mask);
+
+		uint8x16x4_t result;
+		for (int i = 0; i < 4; ++i)
+			result.val[i] = vqtbl4q_u8(table, indices.val[i]);
+		vst4q_u8(reinterpret_cast<std::uint8_t*>(dst), result);
+	}
+
+	return offset;
+}
+
+// Each iteration decodes 64 characters into 48 bytes. Stops at the first block with any invalid
+// characters or padding, leaving it for the scalar implementation.
+static std::size_t decodeSimd(std::uint8_t* dst, const char* src, std::size_t length)
+{
+	const uint8x16x4_t tableLo = loadTable(charToBytes.values);
+	const uint8x16x4_t tableHi = loadTable(charToBytes.values + 64);
+	const uint8x16_t offsetHi = vdupq_n_u8(64);
+	const uint8x16_t maxValue = vdupq_n_u8(63);
+
+	std::size_t offset = 0;
+	for (; length - offset >= 64; offset += 64, dst += 48)
+	{
+		uint8x16x4_t in = vld4q_u8(reinterpret_cast<const std::uint8_t*>(src + offset));
+		uint8x16x4_t values;
+		uint8x16_t invalid = vdupq_n_u8(0);
+		for (int i = 0; i < 4; ++i)
+		{
+			// Out of range indices return 0, so characters >= 128 must be checked separately.
+			values.val[i] = vorrq_u8(vqtbl4q_u8(tableLo, in.val[i]),
+				vqtbl4q_u8(tableHi, vsubq_u8(in.val[i], offsetHi)));
+			invalid = vorrq_u8(invalid, vcgtq_u8(values.val[i], maxValue));
+			invalid = vorrq_u8(invalid, vcgtq_u8(in.val[i], vdupq_n_u8(127)));
+		}
+		if (vmaxvq_u8(invalid) != 0)
+			break;
+
+		uint8x16x3_t result;
+		result.val[0] = vorrq_u8(vshlq_n_u8(values.val[0], 2), vshrq_n_u8(values.val[1], 4));
+		result.val[1] = vorrq_u8(vshlq_n_u8(values.val[1], 4), vshrq_n_u8(values.val[2], 2));
+		result.val[2] = vorrq_u8(vshlq_n_u8(values.val[2], 6), values.val[3]);
+		vst3q_u8(dst, result);
+	}
+
+	return offset;
+}
+
+#else
+
+static bool checkHasSimd()
+{
+	return false;
+}
+
+static std::size_t encodeSimd(char*, const std::uint8_t*, std::size_t)
+{
+	return 0;
+}
+
+static std::size_t decodeSimd(std::uint8_t*, const char*, std::size_t)
+{
+	return 0;
+}
+
+#endif
+
+static const bool simdSupported = checkHasSimd();
+
+static std::string encodeImpl(const void* data, std::size_t size, bool useSimd)
 {
 	std::string result;
 	if (!data || size == 0)
 		return result;
 
+	result.resize((size + 2)/3*4);
 	auto bytes = reinterpret_cast<const std::uint8_t*>(data);
-	for (; size >= 3; bytes += 3, size -= 3)
+	char* dst = &result[0];
+	if (useSimd)
+	{
+		std::size_t offset = encodeSimd(dst, bytes, size);
+		bytes += offset;
+		size -= offset;
+		dst += offset/3*4;
+	}
+
+	for (; size >= 3; bytes += 3, size -= 3, dst += 4)
 	{
 		std::uint32_t triplet = (bytes[0] << 16) | (bytes[1] << 8) | (bytes[2]);
-		result.push_back(bytesToChar[triplet >> 18]);
-		result.push_back(bytesToChar[(triplet >> 12) & 0x3F]);
-		result.push_back(bytesToChar[(triplet >> 6) & 0x3F]);
-		result.push_back(bytesToChar[triplet & 0x3F]);
+		dst[0] = bytesToChar[triplet >> 18];
+		dst[1] = bytesToChar[(triplet >> 12) & 0x3F];
+		dst[2] = bytesToChar[(triplet >> 6) & 0x3F];
+		dst[3] = bytesToChar[triplet & 0x3F];
 	}
 
 	switch (size)
@@ -53,19 +316,19 @@ std::string encode(const void* data, std::size_t size)
 		case 2:
 		{
 			std::uint32_t duo = (bytes[0] << 8) | bytes[1];
-			result.push_back(bytesToChar[duo >> 10]);
-			result.push_back(bytesToChar[(duo >> 4) & 0x3F]);
-			result.push_back(bytesToChar[(duo << 2) & 0x3F]);
-			result.push_back('=');
+			dst[0] = bytesToChar[duo >> 10];
+			dst[1] = bytesToChar[(duo >> 4) & 0x3F];
+			dst[2] = bytesToChar[(duo << 2) & 0x3F];
+			dst[3] = '=';
 			break;
 		}
 		case 1:
 		{
 			std::uint32_t single = *bytes;
-			result.push_back(bytesToChar[single >> 2]);
-			result.push_back(bytesToChar[(single << 4) & 0x3F]);
-			result.push_back('=');
-			result.push_back('=');
+			dst[0] = bytesToChar[single >> 2];
+			dst[1] = bytesToChar[(single << 4) & 0x3F];
+			dst[2] = '=';
+			dst[3] = '=';
 			break;
 		}
 	}
@@ -73,52 +336,91 @@ std::string encode(const void* data, std::size_t size)
 	return result;
 }
 
-bool decode(std::vector<std::uint8_t>& outData, const char* encoded)
+static bool decodeImpl(std::vector<std::uint8_t>& outData, const char* encoded, bool useSimd)
 {
 	if (!encoded)
 		return false;
 
-	while (*encoded)
+	std::size_t length = std::strlen(encoded);
+	if (length % 4 != 0)
+		return false;
+
+	std::size_t prevSize = outData.size();
+	outData.resize(prevSize + length/4*3);
+	std::uint8_t* dst = outData.data() + prevSize;
+	if (useSimd)
+	{
+		std::size_t offset = decodeSimd(dst, encoded, length);
+		encoded += offset;
+		length -= offset;
+		dst += offset/4*3;
+	}
+
+	const std::uint8_t* values = charToBytes.values;
+	for (; length > 0; encoded += 4, length -= 4, dst += 3)
 	{
-		std::uint32_t triplet = 0;
-		unsigned int byteCount = 3;
-		for (int i = 0; i < 4; ++i, ++encoded)
+		std::uint8_t c0 = values[static_cast<std::uint8_t>(encoded[0])];
+		std::uint8_t c1 = values[static_cast<std::uint8_t>(encoded[1])];
+		std::uint8_t c2 = values[static_cast<std::uint8_t>(encoded[2])];
+		std::uint8_t c3 = values[static_cast<std::uint8_t>(encoded[3])];
+		if ((c0 | c1 | c2 | c3) == invalidChar)
 		{
-			char c = *encoded;
-			std::uint32_t index;
-			if (c >= 'A' && c <= 'Z')
-				index = c - 'A';
-			else if (c >= 'a' && c <= 'z')
-				index = c - 'a' + 26;
-			else if (c >= '0' && c <= '9')
-				index = c - '0' + 52;
-			else if (c == '+')
-				index = 62;
-			else if (c == '/')
-				index = 63;
-			else if (c == '=')
+			// Either ends with one or two =, otherwise not valid.
+			if (length != 4 || c0 == invalidChar || c1 == invalidChar || encoded[3] != '=' ||
+				(c2 == invalidChar && encoded[2] != '='))
 			{
-				// Either ends with one or two =, otherwise not valid.
-				if (i < 2 || (i == 2 && encoded[1] != '='))
-					return false;
-				--byteCount;
-				continue;
-			}
-			else
+				outData.resize(prevSize);
 				return false;
+			}
 
-			triplet |= index << ((3 - i)*6);
-		}
+			std::uint32_t triplet = (c0 << 18) | (c1 << 12);
+			dst[0] = static_cast<std::uint8_t>(triplet >> 16);
+			if (c2 == invalidChar)
+			{
+				outData.resize(outData.size() - 2);
+				break;
+			}
 
-		// Only allow = at end.
-		if (byteCount != 3 && *encoded)
-			return false;
+			triplet |= c2 << 6;
+			dst[1] = static_cast<std::uint8_t>((triplet >> 8) & 0xFF);
+			outData.resize(outData.size() - 1);
+			break;
+		}
 
-		for (unsigned int i = 0; i < byteCount; ++i)
-			outData.push_back(static_cast<std::uint8_t>((triplet >> ((2 - i)*8)) & 0xFF));
+		std::uint32_t triplet = (c0 << 18) | (c1 << 12) | (c2 << 6) | c3;
+		dst[0] = static_cast<std::uint8_t>(triplet >> 16);
+		dst[1] = static_cast<std::uint8_t>((triplet >> 8) & 0xFF);
+		dst[2] = static_cast<std::uint8_t>(triplet & 0xFF);
 	}
 
 	return true;
 }
 
+bool hasSimd()
+{
+	return simdSupported;
+}
+
+std::string encode(const void* data, std::size_t size)
+{
+	VFC_TRACE_SCOPE("base64::encode");
+	return encodeImpl(data, size, simdSupported);
+}
+
+bool decode(std::vector<std::uint8_t>& outData, const char* encoded)
+{
+	VFC_TRACE_SCOPE("base64::decode");
+	return decodeImpl(outData, encoded, simdSupported);
+}
+
+std::string encodeScalar(const void* data, std::size_t size)
+{
+	return encodeImpl(data, size, false);
+}
+
+bool decodeScalar(std::vector<std::uint8_t>& outData, const char* encoded)
+{
+	return decodeImpl(outData, encoded, false);
+}
+
 } // base64
@@ -1,5 +1,5 @@
 /*
- * Copyright 2020 Aaron Barany
+ * Copyright 2020-2026 Aaron Barany
  *
  * Licensed under the Apache License, Version 2.0 (the "License");
  * you may not use this file except in compliance with the License.
@@ -26,4 +26,9 @@ namespace base64
 std::string encode(const void* data, std::size_t size);
 bool decode(std::vector<std::uint8_t>& outData, const char* encoded);
 
+// Scalar implementations and whether SIMD is used, exposed for testing.
+bool hasSimd();
+std::string encodeScalar(const void* data, std::size_t size);
+bool decodeScalar(std::vector<std::uint8_t>& outData, const char* encoded);
+
 } // namespace base64
@@ -1,5 +1,5 @@
 /*
- * Copyright 2020-2021 Aaron Barany
+ * Copyright 2020-2026 Aaron Barany
  *
  * Licensed under the Apache License, Version 2.0 (the "License");
  * you may not use this file except in compliance with the License.
@@ -15,14 +15,20 @@
  */
 
 #include "ConfigFile.h"
-#include <rapidjson/document.h>
+#include "Base64.h"
+#include <VFC/InputContainer.h>
+#include <rapidjson/reader.h>
+#include <algorithm>
 #include <cassert>
+#include <climits>
 #include <fstream>
+#include <iterator>
 
 #include <string.h>
 
 #if VFC_WINDOWS
 #define strcasecmp(x, y) _stricmp(x, y)
+#define strncasecmp(x, y, n) _strnicmp(x, y, n)
 #else
 #include <strings.h>
 #endif
@@ -72,27 +78,9 @@ static const char* getErrorString(rapidjson::ParseErrorCode error)
 	return "Unknown error";
 }
 
-static std::pair<unsigned int, unsigned int> getLineColumn(const char* json, std::size_t offset)
+static std::string errorMessageStart(const std::pair<unsigned int, unsigned int>& lineColumn,
+	const char* fileName)
 {
-	std::pair<unsigned int, unsigned int> lineColumn(1, 1);
-	for (std::size_t i = 0; i < offset && json[i]; ++i)
-	{
-		if (json[i] == '\n')
-		{
-			++lineColumn.first;
-			lineColumn.second = 1;
-		}
-		else
-			++lineColumn.second;
-	}
-
-	return lineColumn;
-}
-
-static std::string errorMessageStart(const char* json, const char* fileName,
-	std::size_t errorOffset)
-{
-	std::pair<unsigned int, unsigned int> lineColumn = getLineColumn(json, errorOffset);
 	std::string message = fileName;
 #if VFC_WINDOWS
 	message += '(';
@@ -112,405 +100,712 @@ static std::string errorMessageStart(const char* json, const char* fileName,
 	return message;
 }
 
-static vfc::VertexFormat readVertexFormat(const rapidjson::Value& value, const char* fileName,
-	const vfc::Converter::ErrorFunction& errorFunction, bool inner = false)
+namespace
 {
-	vfc::VertexFormat vertexFormat;
-	if (!value.IsArray())
+
+const std::size_t jsonBufferSize = 64*1024;
+
+// Input stream for the JSON reader that reads in chunks rather than loading the full JSON. The
+// start of each line is recorded to find the line and column for parse errors.
+class JsonInputStream
+{
+public:
+	typedef char Ch;
+
+	JsonInputStream(const char* json, std::size_t size)
+		: m_begin(json)
+		, m_cur(json)
+		, m_end(json + size)
 	{
-		std::string message = fileName;
-		if (inner)
-			message += ": error: Vertex format must be an array of arrays.";
-		else
-			message += ": error: Vertex format must be an array.";
-		errorFunction(message.c_str());
-		return vertexFormat;
+		m_lineStarts.push_back(0);
 	}
 
-	for (auto it = value.Begin(); it != value.End(); ++it)
+	explicit JsonInputStream(std::istream& stream)
+		: m_stream(&stream)
+		, m_buffer(jsonBufferSize)
 	{
-		if (!it->IsObject())
-		{
-			std::string message = fileName;
-			message += ": error: Vertex format element must be an object.";
-			errorFunction(message.c_str());
-			vertexFormat.clear();
-			return vertexFormat;
-		}
+		m_lineStarts.push_back(0);
+		refill();
+	}
 
-		auto nameIt = it->FindMember("name");
-		if (nameIt == it->MemberEnd() || !nameIt->value.IsString())
-		{
-			std::string message = fileName;
-			message += ": error: Vertex format element must contain 'name' string member.";
-			errorFunction(message.c_str());
-			vertexFormat.clear();
-			return vertexFormat;
-		}
+	Ch Peek() const
+	{
+		return m_cur == m_end ? '\0' : *m_cur;
+	}
 
-		auto layoutIt = it->FindMember("layout");
-		if (layoutIt == it->MemberEnd() || !layoutIt->value.IsString())
-		{
-			std::string message = fileName;
-			message += ": error: Vertex format element must contain 'layout' string member.";
-			errorFunction(message.c_str());
-			vertexFormat.clear();
-			return vertexFormat;
-		}
+	Ch Take()
+	{
+		if (m_cur == m_end)
+			return '\0';
+
+		Ch c = *m_cur++;
+		if (c == '\n')
+			m_lineStarts.push_back(Tell());
+		if (m_cur == m_end)
+			refill();
+		return c;
+	}
 
-		vfc::ElementLayout layout = vfc::elementLayoutFromName(layoutIt->value.GetString());
-		if (layout == vfc::ElementLayout::Invalid)
-		{
-			std::string message = fileName;
-			message += ": error: Vertex format element layout '";
-			message += layoutIt->value.GetString();
-			message += "' is invalid.";
-			errorFunction(message.c_str());
-			vertexFormat.clear();
-			return vertexFormat;
-		}
+	std::size_t Tell() const
+	{
+		return m_bufferOffset + static_cast<std::size_t>(m_cur - m_begin);
+	}
 
-		auto typeIt = it->FindMember("type");
-		if (typeIt == it->MemberEnd() || !typeIt->value.IsString())
-		{
-			std::string message = fileName;
-			message += ": error: Vertex format element must contain 'type' string member.";
-			errorFunction(message.c_str());
-			vertexFormat.clear();
-			return vertexFormat;
-		}
+	// Only used when parsing in place.
+	Ch* PutBegin()
+	{
+		assert(false);
+		return nullptr;
+	}
 
-		vfc::ElementType type = vfc::elementTypeFromName(typeIt->value.GetString());
-		if (type == vfc::ElementType::Invalid)
-		{
-			std::string message = fileName;
-			message += ": error: Vertex format element type '";
-			message += typeIt->value.GetString();
-			message += "' is invalid.";
-			errorFunction(message.c_str());
-			vertexFormat.clear();
-			return vertexFormat;
-		}
+	void Put(Ch)
+	{
+		assert(false);
+	}
 
-		vfc::VertexFormat::AddResult result =
-			vertexFormat.appendElement(nameIt->value.GetString(), layout, type);
-		if (result != vfc::VertexFormat::AddResult::Succeeded)
-		{
-			std::string message = fileName;
-			message += ": error: ";
-			if (result == vfc::VertexFormat::AddResult::NameNotUnique)
-			{
-				message += "Vertex format element name '";
-				message += nameIt->value.GetString();
-				message += "' isn't unique.";
-			}
-			else
-			{
-				assert(result == vfc::VertexFormat::AddResult::ElementInvalid);
-				message += "Vertex format element layout '";
-				message += layoutIt->value.GetString();
-				message += "' can't be used with type '";
-				message += typeIt->value.GetString();
-				message += "'.";
-			}
+	void Flush()
+	{
+		assert(false);
+	}
 
-			errorFunction(message.c_str());
-			vertexFormat.clear();
-			return vertexFormat;
-		}
+	std::size_t PutEnd(Ch*)
+	{
+		assert(false);
+		return 0;
 	}
 
-	if (vertexFormat.empty())
+	std::pair<unsigned int, unsigned int> getLineColumn(std::size_t offset) const
 	{
-		std::string message = fileName;
-		if (inner)
-			message += ": error: Inner vertex format is empty.";
-		else
-			message += ": error: Vertex format is empty.";
-		errorFunction(message.c_str());
+		auto lineIt = std::upper_bound(m_lineStarts.begin(), m_lineStarts.end(), offset) - 1;
+		return std::make_pair(static_cast<unsigned int>(lineIt - m_lineStarts.begin() + 1),
+			static_cast<unsigned int>(offset - *lineIt + 1));
 	}
 
-	return vertexFormat;
-}
+private:
+	void refill()
+	{
+		if (!m_stream)
+			return;
+
+		m_bufferOffset += static_cast<std::size_t>(m_end - m_begin);
+		m_stream->read(m_buffer.data(), static_cast<std::streamsize>(m_buffer.size()));
+		m_begin = m_cur = m_buffer.data();
+		m_end = m_begin + m_stream->gcount();
+	}
 
-static std::vector<vfc::VertexFormat> readVertexFormatArray(const rapidjson::Value& value,
-	const char* fileName, const vfc::Converter::ErrorFunction& errorFunction)
+	std::istream* m_stream = nullptr;
+	std::vector<Ch> m_buffer;
+	const Ch* m_begin = nullptr;
+	const Ch* m_cur = nullptr;
+	const Ch* m_end = nullptr;
+	std::size_t m_bufferOffset = 0;
+	std::vector<std::size_t> m_lineStarts;
+};
+
+enum class ValueType
 {
-	std::vector<vfc::VertexFormat> vertexFormat;
-	if (!value.IsArray())
+	Missing,
+	Null,
+	String,
+	Int,
+	Other
+};
+
+struct MemberValue
+{
+	ValueType type = ValueType::Missing;
+	std::string string;
+	int intValue = 0;
+};
+
+// Handler for the JSON reader that validates the config while parsing. The members of each object
+// are checked when the object ends to report errors in a consistent order. Base64 data is decoded
+// when it's read so the encoded strings don't need to be kept.
+class ConfigFileHandler
+{
+public:
+	ConfigFileHandler(const char* fileName, const vfc::Converter::ErrorFunction& errorFunction)
+		: m_fileName(fileName)
+		, m_errorFunction(errorFunction)
 	{
-		std::string message = fileName;
-		message += ": error: Vertex format must be an array of arrays.";
-		errorFunction(message.c_str());
-		return vertexFormat;
 	}
 
-	vertexFormat.reserve(value.Size());
-	for (auto it = value.Begin(); it != value.End(); ++it)
+	bool hasError() const
 	{
-		vertexFormat.push_back(readVertexFormat(*it, fileName, errorFunction, true));
-		const vfc::VertexFormat& curFormat = vertexFormat.back();
-		if (curFormat.empty())
-		{
-			vertexFormat.clear();
-			return vertexFormat;
-		}
+		return m_hasError;
+	}
 
-		for (const vfc::VertexElement& element : curFormat)
-		{
-			for (std::size_t i = 0; i < vertexFormat.size() - 1; ++i)
-			{
-				if (vertexFormat[i].find(element.name.c_str()) == vertexFormat[i].end())
-					continue;
-
-				std::string message = fileName;
-				message += ": error: Vertex format element name '";
-				message += element.name;
-				message += "' isn't unique.";
-				errorFunction(message.c_str());
-				vertexFormat.clear();
-				return vertexFormat;
-			}
-		}
+	bool Null()
+	{
+		return scalarValue(ValueType::Null);
 	}
 
-	if (vertexFormat.empty())
+	bool Bool(bool)
 	{
-		std::string message = fileName;
-		message += ": error: Vertex format is empty.";
-		errorFunction(message.c_str());
+		return scalarValue(ValueType::Other);
 	}
 
-	return vertexFormat;
-}
+	bool Int(int i)
+	{
+		return scalarValue(ValueType::Int, i);
+	}
 
-static bool readIndexType(vfc::IndexType& outIndexType, const rapidjson::Value& rootValue,
-	const char* fileName, const vfc::Converter::ErrorFunction& errorFunction)
-{
-	auto indexTypeIt = rootValue.FindMember("indexType");
-	if (indexTypeIt == rootValue.MemberEnd() || indexTypeIt->value.IsNull())
+	bool Uint(unsigned int u)
 	{
-		outIndexType = vfc::IndexType::NoIndices;
-		return true;
+		if (u > INT_MAX)
+			return scalarValue(ValueType::Other);
+		return scalarValue(ValueType::Int, static_cast<int>(u));
 	}
 
-	if (!indexTypeIt->value.IsString())
+	bool Int64(std::int64_t)
 	{
-		std::string message = fileName;
-		message += ": error: Index type must be a string.";
-		errorFunction(message.c_str());
-		return false;
+		return scalarValue(ValueType::Other);
 	}
 
-	const char* indexTypeStr = indexTypeIt->value.GetString();
-	if (strcasecmp(indexTypeStr, "uint16") == 0)
+	bool Uint64(std::uint64_t)
 	{
-		outIndexType = vfc::IndexType::UInt16;
-		return true;
+		return scalarValue(ValueType::Other);
 	}
-	else if (strcasecmp(indexTypeStr, "uint32") == 0)
+
+	bool Double(double)
 	{
-		outIndexType = vfc::IndexType::UInt32;
-		return true;
+		return scalarValue(ValueType::Other);
 	}
-	else
+
+	bool RawNumber(const char*, rapidjson::SizeType, bool)
 	{
-		std::string message = fileName;
-		message += ": error: Index type '";
-		message += indexTypeStr;
-		message += "' is invalid.";
-		errorFunction(message.c_str());
-		return false;
+		return scalarValue(ValueType::Other);
 	}
-}
 
-static bool readPrimitiveType(vfc::PrimitiveType& outPrimitiveType, std::uint32_t& outPatchPoints,
-	const rapidjson::Value& rootValue, const char* fileName,
-	const vfc::Converter::ErrorFunction& errorFunction)
-{
-	auto primitiveTypeIt = rootValue.FindMember("primitiveType");
-	if (primitiveTypeIt == rootValue.MemberEnd() || primitiveTypeIt->value.IsNull())
+	bool String(const char* str, rapidjson::SizeType length, bool)
 	{
-		outPrimitiveType = vfc::PrimitiveType::TriangleList;
-		outPatchPoints = 0;
-		return true;
+		if (!m_contexts.empty() && m_contexts.back() == Context::VertexStream &&
+			(m_member == Member::VertexData || m_member == Member::IndexData))
+		{
+			dataString(str, length);
+			return true;
+		}
+
+		m_value.string.assign(str, length);
+		return scalarValue(ValueType::String);
 	}
 
-	if (!primitiveTypeIt->value.IsString())
+	bool Key(const char* str, rapidjson::SizeType, bool)
 	{
-		std::string message = fileName;
-		message += ": error: Primitive type must be a string.";
-		errorFunction(message.c_str());
-		return false;
+		assert(!m_contexts.empty());
+		m_member = findMember(m_contexts.back(), str);
+		return true;
 	}
 
-	const char* primitiveTypeStr = primitiveTypeIt->value.GetString();
-	outPrimitiveType = vfc::primitiveTypeFromName(primitiveTypeStr);
-	if (outPrimitiveType == vfc::PrimitiveType::Invalid)
+	bool StartObject()
 	{
-		std::string message = fileName;
-		message += ": error: Primitive type '";
-		message += primitiveTypeStr;
-		message += "' is invalid.";
-		errorFunction(message.c_str());
-		return false;
+		Context context;
+		if (!beginValue(ValueKind::Object, context))
+			return false;
+
+		m_contexts.push_back(context);
+		return true;
 	}
 
-	if (outPrimitiveType == vfc::PrimitiveType::PatchList)
+	bool EndObject(rapidjson::SizeType)
 	{
-		auto patchPointsIt = rootValue.FindMember("patchPoints");
-		if (patchPointsIt == rootValue.MemberEnd() || !patchPointsIt->value.IsInt())
+		Context context = m_contexts.back();
+		m_contexts.pop_back();
+		switch (context)
 		{
-			std::string message = fileName;
-			message += ": error: Root must contain 'patchPoints' int member.";
-			errorFunction(message.c_str());
-			return false;
+			case Context::Root:
+				return endRoot();
+			case Context::VertexElement:
+				return endVertexElement();
+			case Context::VertexStream:
+				return endVertexStream();
+			case Context::VertexTransform:
+				return endVertexTransform();
+			default:
+				return true;
 		}
+	}
 
-		int patchPoints = patchPointsIt->value.GetInt();
-		if (patchPoints <= 0)
-		{
-			std::string message = fileName;
-			message += ": error: Patch points must have a value > 0.";
-			errorFunction(message.c_str());
+	bool StartArray()
+	{
+		Context context;
+		if (!beginValue(ValueKind::Array, context))
 			return false;
-		}
 
-		outPatchPoints = patchPoints;
+		m_contexts.push_back(context);
+		return true;
 	}
 
-	return true;
-}
+	bool EndArray(rapidjson::SizeType)
+	{
+		Context context = m_contexts.back();
+		m_contexts.pop_back();
+		switch (context)
+		{
+			case Context::VertexFormatArray:
+				if (vertexFormat.empty())
+					return error("Vertex format is empty.");
+				return true;
+			case Context::VertexFormat:
+				return endVertexFormat();
+			case Context::VertexStreams:
+				if (vertexStreams.empty())
+					return error("Vertex streams are empty.");
+				return true;
+			default:
+				return true;
+		}
+	}
 
-static std::vector<ConfigFile::VertexStream> readVertexStreams(const rapidjson::Value& value,
-	const char* fileName, const vfc::Converter::ErrorFunction& errorFunction)
-{
+	std::vector<vfc::VertexFormat> vertexFormat;
+	vfc::IndexType indexType = vfc::IndexType::NoIndices;
+	vfc::PrimitiveType primitiveType = vfc::PrimitiveType::TriangleList;
+	std::uint32_t patchPoints = 0;
 	std::vector<ConfigFile::VertexStream> vertexStreams;
-	if (!value.IsArray())
+	std::vector<std::pair<std::string, vfc::Converter::Transform>> transforms;
+
+private:
+	enum class ValueKind
 	{
-		std::string message = fileName;
-		message += ": error: Vertex streams must be an array.";
-		errorFunction(message.c_str());
-		return vertexStreams;
+		Scalar,
+		Object,
+		Array
+	};
+
+	enum class Context
+	{
+		Root,
+		VertexFormatArray,
+		VertexFormat,
+		VertexElement,
+		VertexStreams,
+		VertexStream,
+		VertexTransforms,
+		VertexTransform,
+		Ignore
+	};
+
+	enum class Member
+	{
+		Unknown,
+		VertexFormat,
+		IndexType,
+		PrimitiveType,
+		PatchPoints,
+		VertexStreams,
+		VertexTransforms,
+		Name,
+		Layout,
+		Type,
+		VertexData,
+		IndexData,
+		Transform
+	};
+
+	static Member findMember(Context context, const char* name)
+	{
+		switch (context)
+		{
+			case Context::Root:
+				if (std::strcmp(name, "vertexFormat") == 0)
+					return Member::VertexFormat;
+				else if (std::strcmp(name, "indexType") == 0)
+					return Member::IndexType;
+				else if (std::strcmp(name, "primitiveType") == 0)
+					return Member::PrimitiveType;
+				else if (std::strcmp(name, "patchPoints") == 0)
+					return Member::PatchPoints;
+				else if (std::strcmp(name, "vertexStreams") == 0)
+					return Member::VertexStreams;
+				else if (std::strcmp(name, "vertexTransforms") == 0)
+					return Member::VertexTransforms;
+				return Member::Unknown;
+			case Context::VertexElement:
+				if (std::strcmp(name, "name") == 0)
+					return Member::Name;
+				else if (std::strcmp(name, "layout") == 0)
+					return Member::Layout;
+				else if (std::strcmp(name, "type") == 0)
+					return Member::Type;
+				return Member::Unknown;
+			case Context::VertexStream:
+				if (std::strcmp(name, "vertexFormat") == 0)
+					return Member::VertexFormat;
+				else if (std::strcmp(name, "vertexData") == 0)
+					return Member::VertexData;
+				else if (std::strcmp(name, "indexType") == 0)
+					return Member::IndexType;
+				else if (std::strcmp(name, "indexData") == 0)
+					return Member::IndexData;
+				return Member::Unknown;
+			case Context::VertexTransform:
+				if (std::strcmp(name, "name") == 0)
+					return Member::Name;
+				else if (std::strcmp(name, "transform") == 0)
+					return Member::Transform;
+				return Member::Unknown;
+			default:
+				return Member::Unknown;
+		}
+	}
+
+	bool error(const std::string& message)
+	{
+		std::string fullMessage = m_fileName;
+		fullMessage += ": error: ";
+		fullMessage += message;
+		m_errorFunction(fullMessage.c_str());
+		m_hasError = true;
+		return false;
 	}
 
-	for (auto it = value.Begin(); it != value.End(); ++it)
+	bool scalarValue(ValueType type, int intValue = 0)
 	{
-		if (!it->IsObject())
+		m_value.type = type;
+		m_value.intValue = intValue;
+		Context context;
+		return beginValue(ValueKind::Scalar, context);
+	}
+
+	bool setMember(MemberValue& member, ValueKind kind)
+	{
+		if (kind == ValueKind::Scalar)
+			member = std::move(m_value);
+		else
 		{
-			std::string message = fileName;
-			message += ": error: Vertex stream element must be an object.";
-			errorFunction(message.c_str());
-			vertexStreams.clear();
-			return vertexStreams;
+			member.type = ValueType::Other;
+			member.string.clear();
 		}
+		return true;
+	}
 
-		vertexStreams.emplace_back();
+	void dataString(const char* str, rapidjson::SizeType length)
+	{
 		ConfigFile::VertexStream& stream = vertexStreams.back();
+		bool vertexData = m_member == Member::VertexData;
+		MemberValue& member = vertexData ? m_vertexData : m_indexData;
+		std::vector<std::uint8_t>& decodedData =
+			vertexData ? stream.decodedVertexData : stream.decodedIndexData;
+		bool& decodeSucceeded = vertexData ? m_vertexDataDecoded : m_indexDataDecoded;
+
+		member.type = ValueType::String;
+		const char* prefix = "base64:";
+		const std::size_t prefixLen = 7;
+		if (strncasecmp(str, prefix, prefixLen) == 0)
+		{
+			member.string.clear();
+			decodeSucceeded = base64::decode(decodedData, str + prefixLen);
+		}
+		else
+		{
+			member.string.assign(str, length);
+			decodedData = std::vector<std::uint8_t>();
+			decodeSucceeded = true;
+		}
+	}
 
-		auto formatIt = it->FindMember("vertexFormat");
-		if (formatIt == it->MemberEnd())
+	bool beginValue(ValueKind kind, Context& outContext)
+	{
+		outContext = Context::Ignore;
+		if (m_contexts.empty())
 		{
-			std::string message = fileName;
-			message += ": error: Vertex stream element must contain 'vertexFormat' member.";
-			errorFunction(message.c_str());
-			vertexStreams.clear();
-			return vertexStreams;
+			if (kind != ValueKind::Object)
+				return error("Root element must be an object.");
+
+			outContext = Context::Root;
+			return true;
 		}
 
-		stream.vertexFormat = readVertexFormat(formatIt->value, fileName, errorFunction);
-		if (stream.vertexFormat.empty())
+		switch (m_contexts.back())
 		{
-			vertexStreams.clear();
-			return vertexStreams;
+			case Context::Root:
+				switch (m_member)
+				{
+					case Member::VertexFormat:
+						if (kind != ValueKind::Array)
+							return error("Vertex format must be an array of arrays.");
+
+						m_hasVertexFormat = true;
+						vertexFormat.clear();
+						outContext = Context::VertexFormatArray;
+						return true;
+					case Member::IndexType:
+						return setMember(m_rootIndexType, kind);
+					case Member::PrimitiveType:
+						return setMember(m_primitiveType, kind);
+					case Member::PatchPoints:
+						return setMember(m_patchPoints, kind);
+					case Member::VertexStreams:
+						if (kind != ValueKind::Array)
+							return error("Vertex streams must be an array.");
+
+						m_hasVertexStreams = true;
+						vertexStreams.clear();
+						outContext = Context::VertexStreams;
+						return true;
+					case Member::VertexTransforms:
+						if (kind != ValueKind::Array)
+							return error("Vertex transforms must be an array.");
+
+						transforms.clear();
+						outContext = Context::VertexTransforms;
+						return true;
+					default:
+						return true;
+				}
+			case Context::VertexFormatArray:
+				if (kind != ValueKind::Array)
+					return error("Vertex format must be an array of arrays.");
+
+				m_innerFormat = true;
+				m_curFormat.clear();
+				outContext = Context::VertexFormat;
+				return true;
+			case Context::VertexFormat:
+				if (kind != ValueKind::Object)
+					return error("Vertex format element must be an object.");
+
+				m_name = MemberValue();
+				m_layout = MemberValue();
+				m_type = MemberValue();
+				outContext = Context::VertexElement;
+				return true;
+			case Context::VertexElement:
+				if (m_member == Member::Name)
+					return setMember(m_name, kind);
+				else if (m_member == Member::Layout)
+					return setMember(m_layout, kind);
+				else if (m_member == Member::Type)
+					return setMember(m_type, kind);
+				return true;
+			case Context::VertexStreams:
+				if (kind != ValueKind::Object)
+					return error("Vertex stream element must be an object.");
+
+				vertexStreams.emplace_back();
+				m_hasStreamFormat = false;
+				m_vertexData = MemberValue();
+				m_streamIndexType = MemberValue();
+				m_indexData = MemberValue();
+				m_vertexDataDecoded = true;
+				m_indexDataDecoded = true;
+				outContext = Context::VertexStream;
+				return true;
+			case Context::VertexStream:
+				switch (m_member)
+				{
+					case Member::VertexFormat:
+						if (kind != ValueKind::Array)
+							return error("Vertex format must be an array.");
+
+						m_hasStreamFormat = true;
+						m_innerFormat = false;
+						m_curFormat.clear();
+						outContext = Context::VertexFormat;
+						return true;
+					case Member::VertexData:
+						return setMember(m_vertexData, kind);
+					case Member::IndexType:
+						return setMember(m_streamIndexType, kind);
+					case Member::IndexData:
+						return setMember(m_indexData, kind);
+					default:
+						return true;
+				}
+			case Context::VertexTransforms:
+				if (kind != ValueKind::Object)
+					return error("Vertex transform element must be an object.");
+
+				m_name = MemberValue();
+				m_transform = MemberValue();
+				outContext = Context::VertexTransform;
+				return true;
+			case Context::VertexTransform:
+				if (m_member == Member::Name)
+					return setMember(m_name, kind);
+				else if (m_member == Member::Transform)
+					return setMember(m_transform, kind);
+				return true;
+			case Context::Ignore:
+				return true;
 		}
 
-		auto vertexDataIt = it->FindMember("vertexData");
-		if (vertexDataIt == it->MemberEnd() || !vertexDataIt->value.IsString())
+		assert(false);
+		return true;
+	}
+
+	bool readIndexType(vfc::IndexType& outIndexType, const MemberValue& value)
+	{
+		if (value.type == ValueType::Missing || value.type == ValueType::Null)
 		{
-			std::string message = fileName;
-			message += ": error: Vertex stream element must contain 'vertexData' string member.";
-			errorFunction(message.c_str());
-			vertexStreams.clear();
-			return vertexStreams;
+			outIndexType = vfc::IndexType::NoIndices;
+			return true;
 		}
 
-		stream.vertexData = vertexDataIt->value.GetString();
+		if (value.type != ValueType::String)
+			return error("Index type must be a string.");
 
-		if (!readIndexType(stream.indexType, *it, fileName, errorFunction))
+		const char* indexTypeStr = value.string.c_str();
+		if (strcasecmp(indexTypeStr, "uint16") == 0)
+		{
+			outIndexType = vfc::IndexType::UInt16;
+			return true;
+		}
+		else if (strcasecmp(indexTypeStr, "uint32") == 0)
 		{
-			vertexStreams.clear();
-			return vertexStreams;
+			outIndexType = vfc::IndexType::UInt32;
+			return true;
 		}
+		else
+			return error("Index type '" + value.string + "' is invalid.");
+	}
 
-		if (stream.indexType != vfc::IndexType::NoIndices)
+	bool readPrimitiveType()
+	{
+		if (m_primitiveType.type == ValueType::Missing || m_primitiveType.type == ValueType::Null)
 		{
-			auto indexDataIt = it->FindMember("indexData");
-			if (indexDataIt == it->MemberEnd() || !indexDataIt->value.IsString())
-			{
-				std::string message = fileName;
-				message += ": error: Vertex stream element must contain 'indexData' string member.";
-				errorFunction(message.c_str());
-				vertexStreams.clear();
-				return vertexStreams;
-			}
+			primitiveType = vfc::PrimitiveType::TriangleList;
+			patchPoints = 0;
+			return true;
+		}
+
+		if (m_primitiveType.type != ValueType::String)
+			return error("Primitive type must be a string.");
+
+		primitiveType = vfc::primitiveTypeFromName(m_primitiveType.string.c_str());
+		if (primitiveType == vfc::PrimitiveType::Invalid)
+			return error("Primitive type '" + m_primitiveType.string + "' is invalid.");
+
+		if (primitiveType == vfc::PrimitiveType::PatchList)
+		{
+			if (m_patchPoints.type != ValueType::Int)
+				return error("Root must contain 'patchPoints' int member.");
+
+			if (m_patchPoints.intValue <= 0)
+				return error("Patch points must have a value > 0.");
 
-			stream.indexData = indexDataIt->value.GetString();
+			patchPoints = static_cast<std::uint32_t>(m_patchPoints.intValue);
 		}
+
+		return true;
 	}
 
-	if (vertexStreams.empty())
+	bool endRoot()
 	{
-		std::string message = fileName;
-		message += ": error: Vertex streams are empty.";
-		errorFunction(message.c_str());
-	}
+		if (!m_hasVertexFormat)
+			return error("Root must contain 'vertexFormat' member.");
 
-	return vertexStreams;
-}
+		if (!readIndexType(indexType, m_rootIndexType) || !readPrimitiveType())
+			return false;
 
-static bool readVertexTransforms(
-	std::vector<std::pair<std::string, vfc::Converter::Transform>>& outTransforms,
-	const rapidjson::Value& value, const char* fileName,
-	const vfc::Converter::ErrorFunction& errorFunction)
-{
-	if (!value.IsArray())
+		if (!m_hasVertexStreams)
+			return error("Root must contain 'vertexStreams' member.");
+
+		return true;
+	}
+
+	bool endVertexElement()
 	{
-		std::string message = fileName;
-		message += ": error: Vertex transforms must be an array.";
-		errorFunction(message.c_str());
-		return false;
+		if (m_name.type != ValueType::String)
+			return error("Vertex format element must contain 'name' string member.");
+
+		if (m_layout.type != ValueType::String)
+			return error("Vertex format element must contain 'layout' string member.");
+
+		vfc::ElementLayout layout = vfc::elementLayoutFromName(m_layout.string.c_str());
+		if (layout == vfc::ElementLayout::Invalid)
+			return error("Vertex format element layout '" + m_layout.string + "' is invalid.");
+
+		if (m_type.type != ValueType::String)
+			return error("Vertex format element must contain 'type' string member.");
+
+		vfc::ElementType type = vfc::elementTypeFromName(m_type.string.c_str());
+		if (type == vfc::ElementType::Invalid)
+			return error("Vertex format element type '" + m_type.string + "' is invalid.");
+
+		vfc::VertexFormat::AddResult result =
+			m_curFormat.appendElement(m_name.string.c_str(), layout, type);
+		if (result == vfc::VertexFormat::AddResult::NameNotUnique)
+			return error("Vertex format element name '" + m_name.string + "' isn't unique.");
+		else if (result != vfc::VertexFormat::AddResult::Succeeded)
+		{
+			assert(result == vfc::VertexFormat::AddResult::ElementInvalid);
+			return error("Vertex format element layout '" + m_layout.string +
+				"' can't be used with type '" + m_type.string + "'.");
+		}
+
+		return true;
 	}
 
-	for (auto it = value.Begin(); it != value.End(); ++it)
+	bool endVertexFormat()
 	{
-		if (!it->IsObject())
+		if (m_curFormat.empty())
 		{
-			std::string message = fileName;
-			message += ": error: Vertex transform element must be an object.";
-			errorFunction(message.c_str());
-			return false;
+			if (m_innerFormat)
+				return error("Inner vertex format is empty.");
+			return error("Vertex format is empty.");
 		}
 
-		auto nameIt = it->FindMember("name");
-		if (nameIt == it->MemberEnd() || !nameIt->value.IsString())
+		if (!m_innerFormat)
 		{
-			std::string message = fileName;
-			message += ": error: Vertex transform element must contain 'name' string member.";
-			errorFunction(message.c_str());
-			return false;
+			vertexStreams.back().vertexFormat = std::move(m_curFormat);
+			return true;
 		}
 
-		auto transformIt = it->FindMember("transform");
-		if (transformIt == it->MemberEnd() || !transformIt->value.IsString())
+		for (const vfc::VertexElement& element : m_curFormat)
 		{
-			std::string message = fileName;
-			message += ": error: Vertex transform element must contain 'transform' string member.";
-			errorFunction(message.c_str());
+			for (const vfc::VertexFormat& otherFormat : vertexFormat)
+			{
+				if (otherFormat.find(element.name.c_str()) != otherFormat.end())
+					return error("Vertex format element name '" + element.name + "' isn't unique.");
+			}
+		}
+
+		vertexFormat.push_back(std::move(m_curFormat));
+		return true;
+	}
+
+	bool endVertexStream()
+	{
+		ConfigFile::VertexStream& stream = vertexStreams.back();
+		if (!m_hasStreamFormat)
+			return error("Vertex stream element must contain 'vertexFormat' member.");
+
+		if (m_vertexData.type != ValueType::String)
+			return error("Vertex stream element must contain 'vertexData' string member.");
+
+		stream.vertexData = std::move(m_vertexData.string);
+		if (!readIndexType(stream.indexType, m_streamIndexType))
 			return false;
+
+		if (stream.indexType == vfc::IndexType::NoIndices)
+			stream.decodedIndexData = std::vector<std::uint8_t>();
+		else
+		{
+			if (m_indexData.type != ValueType::String)
+				return error("Vertex stream element must contain 'indexData' string member.");
+
+			stream.indexData = std::move(m_indexData.string);
 		}
 
-		const char* transformStr = transformIt->value.GetString();
+		if (!m_vertexDataDecoded)
+			return error("Invalid base64 encoding for vertex data.");
+
+		if (stream.indexType != vfc::IndexType::NoIndices && !m_indexDataDecoded)
+			return error("Invalid base64 encoding for index data.");
+
+		return true;
+	}
+
+	bool endVertexTransform()
+	{
+		if (m_name.type != ValueType::String)
+			return error("Vertex transform element must contain 'name' string member.");
+
+		if (m_transform.type != ValueType::String)
+			return error("Vertex transform element must contain 'transform' string member.");
+
+		const char* transformStr = m_transform.string.c_str();
 		vfc::Converter::Transform transform;
 		if (strcasecmp(transformStr, "identity") == 0)
 			transform = vfc::Converter::Transform::Identity;
@@ -521,103 +816,182 @@ static bool readVertexTransforms(
 		else if (strcasecmp(transformStr, "snormtounorm") == 0)
 			transform = vfc::Converter::Transform::SNormToUNorm;
 		else
-		{
-			std::string message = fileName;
-			message += ": error: Vertex transform '";
-			message += transformStr;
-			message += "' is invalid.";
-			errorFunction(message.c_str());
-			return false;
-		}
+			return error("Vertex transform '" + m_transform.string + "' is invalid.");
 
-		outTransforms.emplace_back(nameIt->value.GetString(), transform);
+		transforms.emplace_back(std::move(m_name.string), transform);
+		return true;
 	}
 
-	return true;
-}
-
-bool ConfigFile::load(const char* fileName, const vfc::Converter::ErrorFunction& errorFunction)
+	const char* m_fileName;
+	const vfc::Converter::ErrorFunction& m_errorFunction;
+	bool m_hasError = false;
+
+	std::vector<Context> m_contexts;
+	Member m_member = Member::Unknown;
+	MemberValue m_value;
+
+	bool m_hasVertexFormat = false;
+	bool m_hasVertexStreams = false;
+	MemberValue m_rootIndexType;
+	MemberValue m_primitiveType;
+	MemberValue m_patchPoints;
+
+	vfc::VertexFormat m_curFormat;
+	bool m_innerFormat = false;
+	MemberValue m_name;
+	MemberValue m_layout;
+	MemberValue m_type;
+	MemberValue m_transform;
+
+	bool m_hasStreamFormat = false;
+	MemberValue m_vertexData;
+	MemberValue m_streamIndexType;
+	MemberValue m_indexData;
+	bool m_vertexDataDecoded = true;
+	bool m_indexDataDecoded = true;
+};
+
+} // namespace
+
+template <typename StreamT>
+bool ConfigFile::parse(StreamT& stream, const char* fileName,
+	const vfc::Converter::ErrorFunction& errorFunction)
 {
 	assert(errorFunction);
-	std::ifstream stream(fileName);
-	if (!stream.is_open())
+	ConfigFileHandler handler(fileName, errorFunction);
+	rapidjson::Reader reader;
+	reader.Parse(stream, handler);
+
+	// Parsing is also stopped by the handler after reporting an invalid config.
+	bool succeeded = !reader.HasParseError();
+	if (!succeeded && !handler.hasError())
 	{
-		std::string message = "error: Couldn't open config file '";
-		message += fileName;
-		message += "'.";
+		std::string message =
+			errorMessageStart(stream.getLineColumn(reader.GetErrorOffset()), fileName);
+		message += getErrorString(reader.GetParseErrorCode());
 		errorFunction(message.c_str());
-		return false;
 	}
 
-	return load(stream, fileName, errorFunction);
-}
-
-bool ConfigFile::load(std::istream& stream, const char* fileName,
-	const vfc::Converter::ErrorFunction& errorFunction)
-{
-	std::string json(std::istreambuf_iterator<char>(stream), {});
-	return load(json.c_str(), fileName, errorFunction);
+	m_vertexFormat = std::move(handler.vertexFormat);
+	m_indexType = handler.indexType;
+	m_primitiveType = handler.primitiveType;
+	m_patchPoints = handler.patchPoints;
+	m_vertexStreams = std::move(handler.vertexStreams);
+	m_transforms = std::move(handler.transforms);
+	m_containerData.reset();
+	return succeeded;
 }
 
-bool ConfigFile::load(const char* json, const char* fileName,
+bool ConfigFile::loadContainer(const char* fileName,
 	const vfc::Converter::ErrorFunction& errorFunction)
 {
-	assert(errorFunction);
-	rapidjson::Document document;
-	if (document.Parse(json).HasParseError())
+	vfc::InputContainerReader reader;
+	if (!reader.open(m_containerData.data(), m_containerData.size()))
 	{
-		std::string message = errorMessageStart(json, fileName, document.GetErrorOffset());
-		message += getErrorString(document.GetParseError());
+		m_containerData.reset();
+		std::string message = fileName;
+		message += ": error: Invalid input container.";
 		errorFunction(message.c_str());
 		return false;
 	}
 
-	if (!document.IsObject())
+	m_vertexFormat = reader.getVertexFormat();
+	m_indexType = reader.getIndexType();
+	m_primitiveType = reader.getPrimitiveType();
+	m_patchPoints = reader.getPatchPoints();
+	m_transforms = reader.getTransforms();
+	m_vertexStreams.clear();
+	m_vertexStreams.reserve(reader.getVertexStreams().size());
+	for (const vfc::InputVertexStream& containerStream : reader.getVertexStreams())
 	{
-		std::string message = fileName;
-		message += ": error: Root element must be an object.";
-		errorFunction(message.c_str());
-		return false;
+		m_vertexStreams.emplace_back();
+		VertexStream& stream = m_vertexStreams.back();
+		stream.vertexFormat = containerStream.vertexFormat;
+		stream.indexType = containerStream.indexType;
+		stream.containerVertexData =
+			reinterpret_cast<const std::uint8_t*>(containerStream.vertexData);
+		stream.containerVertexDataSize = static_cast<std::size_t>(containerStream.vertexCount)*
+			containerStream.vertexFormat.stride();
+		if (containerStream.indexType != vfc::IndexType::NoIndices)
+		{
+			stream.containerIndexData =
+				reinterpret_cast<const std::uint8_t*>(containerStream.indexData);
+			stream.containerIndexDataSize =
+				static_cast<std::size_t>(containerStream.indexCount)*
+				vfc::indexSize(containerStream.indexType);
+		}
 	}
 
-	auto vertexFormatIt = document.FindMember("vertexFormat");
-	if (vertexFormatIt == document.MemberEnd())
+	return true;
+}
+
+bool ConfigFile::load(const char* fileName, const vfc::Converter::ErrorFunction& errorFunction)
+{
+	assert(errorFunction);
+	std::ifstream stream(fileName, std::ios_base::in | std::ios_base::binary);
+	if (!stream.is_open())
 	{
-		std::string message = fileName;
-		message += ": error: Root must contain 'vertexFormat' member.";
+		std::string message = "error: Couldn't open config file '";
+		message += fileName;
+		message += "'.";
 		errorFunction(message.c_str());
 		return false;
 	}
 
-	m_vertexFormat = readVertexFormatArray(vertexFormatIt->value, fileName, errorFunction);
-	if (m_vertexFormat.empty())
-		return false;
+	// JSON can't start with the first character of the magic number. Input containers are
+	// memory-mapped so the vertex data is used in place.
+	if (stream.peek() == vfc::inputContainerMagic[0])
+	{
+		stream.close();
+		if (!m_containerData.loadFile(fileName))
+		{
+			std::string message = "error: Couldn't read config file '";
+			message += fileName;
+			message += "'.";
+			errorFunction(message.c_str());
+			return false;
+		}
 
-	if (!readIndexType(m_indexType, document, fileName, errorFunction))
-		return false;
+		return loadContainer(fileName, errorFunction);
+	}
 
-	if (!readPrimitiveType(m_primitiveType, m_patchPoints, document, fileName, errorFunction))
-		return false;
+	JsonInputStream jsonStream(stream);
+	return parse(jsonStream, fileName, errorFunction);
+}
 
-	auto vertexStreamsIt = document.FindMember("vertexStreams");
-	if (vertexStreamsIt == document.MemberEnd())
+bool ConfigFile::load(std::istream& stream, const char* fileName,
+	const vfc::Converter::ErrorFunction& errorFunction)
+{
+	assert(errorFunction);
+	if (stream.peek() == vfc::inputContainerMagic[0])
 	{
-		std::string message = fileName;
-		message += ": error: Root must contain 'vertexStreams' member.";
-		errorFunction(message.c_str());
-		return false;
+		std::vector<std::uint8_t> data((std::istreambuf_iterator<char>(stream)),
+			std::istreambuf_iterator<char>());
+		m_containerData.setData(std::move(data));
+		return loadContainer(fileName, errorFunction);
 	}
 
-	m_vertexStreams = readVertexStreams(vertexStreamsIt->value, fileName, errorFunction);
-	if (m_vertexStreams.empty())
-		return false;
+	JsonInputStream jsonStream(stream);
+	return parse(jsonStream, fileName, errorFunction);
+}
+
+bool ConfigFile::load(const char* json, const char* fileName,
+	const vfc::Converter::ErrorFunction& errorFunction)
+{
+	JsonInputStream jsonStream(json, std::strlen(json));
+	return parse(jsonStream, fileName, errorFunction);
+}
 
-	auto vertexTransformIt = document.FindMember("vertexTransforms");
-	if (vertexTransformIt != document.MemberEnd() &&
-		!readVertexTransforms(m_transforms, vertexTransformIt->value, fileName, errorFunction))
+bool ConfigFile::load(const void* data, std::size_t size, const char* fileName,
+	const vfc::Converter::ErrorFunction& errorFunction)
+{
+	assert(errorFunction);
+	if (vfc::InputContainerReader::isInputContainer(data, size))
 	{
-		return false;
+		m_containerData.setView(data, size);
+		return loadContainer(fileName, errorFunction);
 	}
 
-	return true;
+	JsonInputStream jsonStream(reinterpret_cast<const char*>(data), size);
+	return parse(jsonStream, fileName, errorFunction);
 }
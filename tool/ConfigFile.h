@@ -1,5 +1,5 @@
 /*
- * Copyright 2020-2021 Aaron Barany
+ * Copyright 2020-2026 Aaron Barany
  *
  * Licensed under the Apache License, Version 2.0 (the "License");
  * you may not use this file except in compliance with the License.
@@ -20,6 +20,8 @@
 #include <VFC/Converter.h>
 #include <VFC/VertexFormat.h>
 #include <VFC/IndexData.h>
+#include "InputData.h"
+#include <cstdint>
 #include <istream>
 #include <string>
 #include <vector>
@@ -28,17 +30,31 @@
 class ConfigFile
 {
 public:
+	// Data embedded as base64 is decoded while parsing, leaving the path empty. Data within an
+	// input container is referenced in place, also leaving the path empty.
 	struct VertexStream
 	{
 		vfc::VertexFormat vertexFormat;
 		vfc::IndexType indexType;
 		std::string vertexData;
 		std::string indexData;
+		std::vector<std::uint8_t> decodedVertexData;
+		std::vector<std::uint8_t> decodedIndexData;
+		const std::uint8_t* containerVertexData;
+		std::size_t containerVertexDataSize;
+		const std::uint8_t* containerIndexData;
+		std::size_t containerIndexDataSize;
 
 		bool operator==(const VertexStream& other) const
 		{
 			return vertexFormat == other.vertexFormat && indexType == other.indexType &&
-				vertexData == other.vertexData && indexData == other.indexData;
+				vertexData == other.vertexData && indexData == other.indexData &&
+				decodedVertexData == other.decodedVertexData &&
+				decodedIndexData == other.decodedIndexData &&
+				containerVertexData == other.containerVertexData &&
+				containerVertexDataSize == other.containerVertexDataSize &&
+				containerIndexData == other.containerIndexData &&
+				containerIndexDataSize == other.containerIndexDataSize;
 		}
 
 		bool operator!=(const VertexStream& other) const
@@ -47,6 +63,12 @@ public:
 		}
 	};
 
+	ConfigFile() = default;
+	ConfigFile(const ConfigFile&) = delete;
+	ConfigFile& operator=(const ConfigFile&) = delete;
+	ConfigFile(ConfigFile&&) = default;
+	ConfigFile& operator=(ConfigFile&&) = default;
+
 	bool load(const char* fileName,
 		const vfc::Converter::ErrorFunction& errorFunction = &vfc::Converter::stderrErrorFunction);
 
@@ -56,6 +78,11 @@ public:
 	bool load(const char* json, const char* fileName,
 		const vfc::Converter::ErrorFunction& errorFunction = &vfc::Converter::stderrErrorFunction);
 
+	// Loads either JSON or an input container. An input container is referenced in place, so the
+	// data must remain valid until the vertex streams have been converted.
+	bool load(const void* data, std::size_t size, const char* fileName,
+		const vfc::Converter::ErrorFunction& errorFunction = &vfc::Converter::stderrErrorFunction);
+
 	const std::vector<vfc::VertexFormat>& getVertexFormat() const
 	{
 		return m_vertexFormat;
@@ -81,16 +108,34 @@ public:
 		return m_vertexStreams;
 	}
 
+	std::vector<VertexStream>& getVertexStreams()
+	{
+		return m_vertexStreams;
+	}
+
 	const std::vector<std::pair<std::string, vfc::Converter::Transform>>& getTransforms() const
 	{
 		return m_transforms;
 	}
 
+	// The input container data that vertex streams reference, if loaded from an input container.
+	InputData takeContainerData()
+	{
+		return std::move(m_containerData);
+	}
+
 private:
+	bool loadContainer(const char* fileName, const vfc::Converter::ErrorFunction& errorFunction);
+
+	template <typename StreamT>
+	bool parse(StreamT& stream, const char* fileName,
+		const vfc::Converter::ErrorFunction& errorFunction);
+
 	std::vector<vfc::VertexFormat> m_vertexFormat;
 	vfc::IndexType m_indexType = vfc::IndexType::NoIndices;
 	vfc::PrimitiveType m_primitiveType = vfc::PrimitiveType::TriangleList;
 	std::uint32_t m_patchPoints = 0;
 	std::vector<VertexStream> m_vertexStreams;
 	std::vector<std::pair<std::string, vfc::Converter::Transform>> m_transforms;
+	InputData m_containerData;
 };
@@ -0,0 +1,159 @@
+/*
+ * Copyright 2026 Aaron Barany
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "ContentHash.h"
+#include <algorithm>
+
+namespace
+{
+
+const std::uint64_t prime1 = 0x9E3779B185EBCA87ULL;
+const std::uint64_t prime2 = 0xC2B2AE3D27D4EB4FULL;
+const std::uint64_t prime3 = 0x165667B19E3779F9ULL;
+const std::uint64_t prime4 = 0x85EBCA77C2B2AE63ULL;
+const std::uint64_t prime5 = 0x27D4EB2F165667C5ULL;
+
+inline std::uint64_t rotateLeft(std::uint64_t value, int bits)
+{
+	return (value << bits) | (value >> (64 - bits));
+}
+
+// Data is hashed as little endian.
+inline std::uint64_t read64(const std::uint8_t* data)
+{
+	std::uint64_t value = 0;
+	for (int i = 7; i >= 0; --i)
+		value = (value << 8) | data[i];
+	return value;
+}
+
+inline std::uint64_t read32(const std::uint8_t* data)
+{
+	std::uint64_t value = 0;
+	for (int i = 3; i >= 0; --i)
+		value = (value << 8) | data[i];
+	return value;
+}
+
+inline std::uint64_t accumulate(std::uint64_t accumulator, std::uint64_t lane)
+{
+	accumulator += lane*prime2;
+	accumulator = rotateLeft(accumulator, 31);
+	return accumulator*prime1;
+}
+
+inline std::uint64_t mergeAccumulator(std::uint64_t hash, std::uint64_t accumulator)
+{
+	hash ^= accumulate(0, accumulator);
+	return hash*prime1 + prime4;
+}
+
+inline void processStripe(std::uint64_t* accumulators, const std::uint8_t* data)
+{
+	for (int i = 0; i < 4; ++i)
+		accumulators[i] = accumulate(accumulators[i], read64(data + i*8));
+}
+
+} // namespace
+
+ContentHash::ContentHash(std::uint64_t seed)
+	: m_seed(seed)
+{
+	m_accumulators[0] = seed + prime1 + prime2;
+	m_accumulators[1] = seed + prime2;
+	m_accumulators[2] = seed;
+	m_accumulators[3] = seed - prime1;
+}
+
+void ContentHash::add(const void* data, std::size_t size)
+{
+	auto bytes = reinterpret_cast<const std::uint8_t*>(data);
+	m_totalSize += size;
+	if (m_bufferSize > 0)
+	{
+		std::size_t copySize = std::min(size, sizeof(m_buffer) - m_bufferSize);
+		std::memcpy(m_buffer + m_bufferSize, bytes, copySize);
+		m_bufferSize += copySize;
+		bytes += copySize;
+		size -= copySize;
+		if (m_bufferSize < sizeof(m_buffer))
+			return;
+
+		processStripe(m_accumulators, m_buffer);
+		m_bufferSize = 0;
+	}
+
+	for (; size >= sizeof(m_buffer); bytes += sizeof(m_buffer), size -= sizeof(m_buffer))
+		processStripe(m_accumulators, bytes);
+
+	std::memcpy(m_buffer, bytes, size);
+	m_bufferSize = size;
+}
+
+std::uint64_t ContentHash::finish() const
+{
+	std::uint64_t hash;
+	if (m_totalSize >= sizeof(m_buffer))
+	{
+		hash = rotateLeft(m_accumulators[0], 1) + rotateLeft(m_accumulators[1], 7) +
+			rotateLeft(m_accumulators[2], 12) + rotateLeft(m_accumulators[3], 18);
+		for (std::uint64_t accumulator : m_accumulators)
+			hash = mergeAccumulator(hash, accumulator);
+	}
+	else
+		hash = m_seed + prime5;
+
+	hash += m_totalSize;
+
+	const std::uint8_t* data = m_buffer;
+	std::size_t size = m_bufferSize;
+	for (; size >= 8; data += 8, size -= 8)
+	{
+		hash ^= accumulate(0, read64(data));
+		hash = rotateLeft(hash, 27)*prime1 + prime4;
+	}
+
+	if (size >= 4)
+	{
+		hash ^= read32(data)*prime1;
+		hash = rotateLeft(hash, 23)*prime2 + prime3;
+		data += 4;
+		size -= 4;
+	}
+
+	for (; size > 0; ++data, --size)
+	{
+		hash ^= *data*prime5;
+		hash = rotateLeft(hash, 11)*prime1;
+	}
+
+	hash ^= hash >> 33;
+	hash *= prime2;
+	hash ^= hash >> 29;
+	hash *= prime3;
+	hash ^= hash >> 32;
+	return hash;
+}
+
+std::string ContentHash::finishHex() const
+{
+	const char digits[] = "0123456789abcdef";
+	std::uint64_t hash = finish();
+	std::string hex(16, '0');
+	for (int i = 15; i >= 0; --i, hash >>= 4)
+		hex[static_cast<std::size_t>(i)] = digits[hash & 0xF];
+	return hex;
+}
@@ -0,0 +1,55 @@
+/*
+ * Copyright 2026 Aaron Barany
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <VFC/Config.h>
+#include <cstdint>
+#include <cstring>
+#include <string>
+
+// Streaming 64-bit hash of arbitrary data, using the XXH64 algorithm.
+// https://github.com/Cyan4973/xxHash/blob/dev/doc/xxhash_spec.md
+class ContentHash
+{
+public:
+	explicit ContentHash(std::uint64_t seed = 0);
+
+	void add(const void* data, std::size_t size);
+
+	void add(const std::string& string)
+	{
+		// Include the size so consecutive strings can't be confused.
+		addValue(static_cast<std::uint64_t>(string.size()));
+		add(string.data(), string.size());
+	}
+
+	template <typename T>
+	void addValue(T value)
+	{
+		add(&value, sizeof(T));
+	}
+
+	std::uint64_t finish() const;
+	std::string finishHex() const;
+
+private:
+	std::uint64_t m_accumulators[4];
+	std::uint8_t m_buffer[32];
+	std::size_t m_bufferSize = 0;
+	std::uint64_t m_totalSize = 0;
+	std::uint64_t m_seed;
+};
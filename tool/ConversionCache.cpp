@@ -0,0 +1,390 @@
+/*
+ * Copyright 2026 Aaron Barany
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "ConversionCache.h"
+#include "OutputFile.h"
+#include "Path.h"
+#include <rapidjson/document.h>
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <ctime>
+#include <fstream>
+#include <iterator>
+
+#if VFC_WINDOWS
+#include <process.h>
+#define getpid _getpid
+#else
+#include <unistd.h>
+#endif
+
+namespace
+{
+
+const char* resultFileName = "result.json";
+const char* evictFileName = "last-evict";
+const char* tempPrefix = "tmp-";
+const std::int64_t evictInterval = 60;
+// Temporary directories left behind by processes that exited early.
+const std::int64_t staleTempAge = 60*60;
+
+std::string tempDirectory(const std::string& directory)
+{
+	static std::atomic<unsigned int> counter(0);
+	std::string name = tempPrefix;
+	name += std::to_string(getpid());
+	name += '-';
+	name += std::to_string(counter++);
+	return path::join(directory, name);
+}
+
+void removeDirectoryTree(const std::string& directory)
+{
+	// Entries only contain files.
+	std::vector<std::string> names;
+	if (path::listDirectory(names, directory))
+	{
+		for (const std::string& name : names)
+			path::removeFile(path::join(directory, name));
+	}
+	path::removeDirectory(directory);
+}
+
+bool isEntryName(const std::string& name)
+{
+	if (name.size() != 16)
+		return false;
+
+	for (char c : name)
+	{
+		if (!((c >= '0' && c <= '9') || (c >= 'a' && c <= 'f')))
+			return false;
+	}
+	return true;
+}
+
+std::string dataFileName(const char* prefix, std::size_t index)
+{
+	std::string fileName = prefix;
+	fileName += std::to_string(index);
+	fileName += ".dat";
+	return fileName;
+}
+
+bool writeDataFile(const std::string& fileName, const void* data, std::size_t size)
+{
+	OutputFile file;
+	if (!file.create(fileName, size))
+		return false;
+
+	if (size > 0)
+		std::memcpy(file.data(), data, size);
+	return file.close();
+}
+
+bool readValue(vfc::VertexValue& outValue, const rapidjson::Value& json)
+{
+	if (!json.IsArray() || json.Size() != 4)
+		return false;
+
+	for (unsigned int i = 0; i < 4; ++i)
+	{
+		if (!json[i].IsNumber())
+			return false;
+		outValue[i] = json[i].GetDouble();
+	}
+	return true;
+}
+
+bool readDataFile(std::string& outFile, const rapidjson::Value& json, const char* member,
+	const std::string& entryDir)
+{
+	auto it = json.FindMember(member);
+	if (it == json.MemberEnd() || !it->value.IsString())
+		return false;
+
+	// Only plain file names are written to entries.
+	std::string fileName = it->value.GetString();
+	if (fileName != path::getFileName(fileName))
+		return false;
+
+	outFile = path::join(entryDir, fileName);
+	return true;
+}
+
+bool readEntry(ConversionCache::Entry& outEntry, const std::string& entryDir,
+	const std::string& json)
+{
+	rapidjson::Document document;
+	document.Parse(json.c_str());
+	if (document.HasParseError() || !document.IsObject())
+		return false;
+
+	auto vertices = document.FindMember("vertices");
+	auto vertexCount = document.FindMember("vertexCount");
+	if (vertices == document.MemberEnd() || !vertices->value.IsArray() ||
+		vertexCount == document.MemberEnd() || !vertexCount->value.IsUint())
+	{
+		return false;
+	}
+
+	outEntry.vertexCount = vertexCount->value.GetUint();
+	outEntry.bounds.resize(vertices->value.Size());
+	outEntry.vertexFiles.resize(vertices->value.Size());
+	for (unsigned int i = 0; i < vertices->value.Size(); ++i)
+	{
+		const rapidjson::Value& stream = vertices->value[i];
+		if (!stream.IsObject() ||
+			!readDataFile(outEntry.vertexFiles[i], stream, "vertexData", entryDir))
+		{
+			return false;
+		}
+
+		auto vertexFormat = stream.FindMember("vertexFormat");
+		if (vertexFormat == stream.MemberEnd() || !vertexFormat->value.IsArray())
+			return false;
+
+		std::vector<Bounds>& bounds = outEntry.bounds[i];
+		bounds.resize(vertexFormat->value.Size());
+		for (unsigned int j = 0; j < vertexFormat->value.Size(); ++j)
+		{
+			const rapidjson::Value& element = vertexFormat->value[j];
+			if (!element.IsObject())
+				return false;
+
+			auto minValue = element.FindMember("minValue");
+			auto maxValue = element.FindMember("maxValue");
+			if (minValue == element.MemberEnd() || maxValue == element.MemberEnd() ||
+				!readValue(bounds[j].min, minValue->value) ||
+				!readValue(bounds[j].max, maxValue->value))
+			{
+				return false;
+			}
+		}
+	}
+
+	outEntry.indexBuffers.clear();
+	outEntry.indexFiles.clear();
+	auto indexBuffers = document.FindMember("indexBuffers");
+	if (indexBuffers == document.MemberEnd())
+		return true;
+
+	if (!indexBuffers->value.IsArray())
+		return false;
+
+	outEntry.indexFiles.resize(indexBuffers->value.Size());
+	for (unsigned int i = 0; i < indexBuffers->value.Size(); ++i)
+	{
+		const rapidjson::Value& indexBuffer = indexBuffers->value[i];
+		if (!indexBuffer.IsObject() ||
+			!readDataFile(outEntry.indexFiles[i], indexBuffer, "indexData", entryDir))
+		{
+			return false;
+		}
+
+		auto indexCount = indexBuffer.FindMember("indexCount");
+		auto baseVertex = indexBuffer.FindMember("baseVertex");
+		if (indexCount == indexBuffer.MemberEnd() || !indexCount->value.IsUint() ||
+			baseVertex == indexBuffer.MemberEnd() || !baseVertex->value.IsInt())
+		{
+			return false;
+		}
+
+		outEntry.indexBuffers.push_back(IndexFileData{indexCount->value.GetUint(),
+			baseVertex->value.GetInt(), nullptr, nullptr, 0});
+	}
+
+	return true;
+}
+
+} // namespace
+
+ConversionCache::ConversionCache(std::string directory, std::uint64_t maxSize)
+	: m_directory(std::move(directory))
+	, m_maxSize(maxSize)
+{
+}
+
+bool ConversionCache::initialize()
+{
+	return path::createDirectories(m_directory);
+}
+
+bool ConversionCache::find(Entry& outEntry, const std::string& key) const
+{
+	std::string entryDir = path::join(m_directory, key);
+	std::string resultPath = path::join(entryDir, resultFileName);
+	std::ifstream stream(resultPath);
+	if (!stream.is_open())
+		return false;
+
+	std::string json((std::istreambuf_iterator<char>(stream)), std::istreambuf_iterator<char>());
+	if (!readEntry(outEntry, entryDir, json))
+		return false;
+
+	// Failing to update the time only affects the eviction order.
+	path::touchFile(resultPath);
+	return true;
+}
+
+bool ConversionCache::store(const std::string& key,
+	const std::vector<vfc::VertexFormat>& vertexFormat,
+	const std::vector<std::vector<Bounds>>& bounds, const std::vector<VertexFileData>& vertexData,
+	std::uint32_t vertexCount, vfc::IndexType indexType,
+	const std::vector<IndexFileData>& indexData)
+{
+	std::string entryDir = path::join(m_directory, key);
+	std::string tempDir = tempDirectory(m_directory);
+	if (!path::createDirectories(tempDir))
+		return false;
+
+	// File names are relative to the entry directory.
+	std::vector<std::string> fileNames;
+	fileNames.reserve(vertexData.size() + indexData.size());
+	std::vector<VertexFileData> entryVertexData(vertexData.size());
+	bool success = true;
+	for (std::size_t i = 0; i < vertexData.size() && success; ++i)
+	{
+		fileNames.push_back(dataFileName("vertices.", i));
+		entryVertexData[i] = VertexFileData{fileNames.back().c_str(), nullptr, 0};
+		success = writeDataFile(path::join(tempDir, fileNames.back()), vertexData[i].data,
+			vertexData[i].dataSize);
+	}
+
+	std::vector<IndexFileData> entryIndexData(indexData.size());
+	for (std::size_t i = 0; i < indexData.size() && success; ++i)
+	{
+		const IndexFileData& curIndexData = indexData[i];
+		fileNames.push_back(dataFileName("indices.", i));
+		entryIndexData[i] = IndexFileData{curIndexData.count, curIndexData.baseVertex,
+			fileNames.back().c_str(), nullptr, 0};
+		success = writeDataFile(path::join(tempDir, fileNames.back()), curIndexData.data,
+			curIndexData.dataSize);
+	}
+
+	if (success)
+	{
+		std::string json = resultFile(vertexFormat, bounds, entryVertexData, vertexCount,
+			indexType, entryIndexData, nullptr, true);
+		std::ofstream stream(path::join(tempDir, resultFileName),
+			std::ios_base::out | std::ios_base::trunc | std::ios_base::binary);
+		success = stream.is_open() && stream.write(json.data(), json.size()) && stream.flush();
+	}
+
+	// Renaming fails if the entry already exists, such as from a concurrent conversion.
+	if (success && path::renamePath(tempDir, entryDir))
+		return true;
+
+	removeDirectoryTree(tempDir);
+	std::uint64_t size;
+	std::int64_t time;
+	return success && path::getFileInfo(size, time, path::join(entryDir, resultFileName));
+}
+
+void ConversionCache::evict()
+{
+	struct EntryInfo
+	{
+		std::string name;
+		std::int64_t lastUsed;
+		std::uint64_t size;
+	};
+
+	std::vector<std::string> names;
+	if (!path::listDirectory(names, m_directory))
+		return;
+
+	std::int64_t now = static_cast<std::int64_t>(std::time(nullptr));
+	std::vector<EntryInfo> entries;
+	std::uint64_t totalSize = 0;
+	std::vector<std::string> fileNames;
+	for (const std::string& name : names)
+	{
+		std::string entryDir = path::join(m_directory, name);
+		std::uint64_t size;
+		std::int64_t time;
+		if (name.compare(0, std::strlen(tempPrefix), tempPrefix) == 0)
+		{
+			if (path::getFileInfo(size, time, entryDir) && now - time > staleTempAge)
+				removeDirectoryTree(entryDir);
+			continue;
+		}
+
+		if (!isEntryName(name) ||
+			!path::getFileInfo(size, time, path::join(entryDir, resultFileName)) ||
+			!path::listDirectory(fileNames, entryDir))
+		{
+			continue;
+		}
+
+		EntryInfo info = {name, time, 0};
+		for (const std::string& fileName : fileNames)
+		{
+			if (path::getFileInfo(size, time, path::join(entryDir, fileName)))
+				info.size += size;
+		}
+		totalSize += info.size;
+		entries.push_back(std::move(info));
+	}
+
+	if (totalSize <= m_maxSize)
+		return;
+
+	std::sort(entries.begin(), entries.end(),
+		[](const EntryInfo& left, const EntryInfo& right)
+		{
+			return left.lastUsed < right.lastUsed;
+		});
+	for (const EntryInfo& entry : entries)
+	{
+		if (totalSize <= m_maxSize)
+			break;
+
+		// Move the entry out of place first so it's never seen partially removed.
+		std::string tempDir = tempDirectory(m_directory);
+		if (!path::renamePath(path::join(m_directory, entry.name), tempDir))
+			continue;
+
+		removeDirectoryTree(tempDir);
+		totalSize -= entry.size;
+	}
+}
+
+void ConversionCache::evictIfDue()
+{
+	std::unique_lock<std::mutex> lock(m_evictMutex, std::try_to_lock);
+	if (!lock.owns_lock())
+		return;
+
+	std::string evictPath = path::join(m_directory, evictFileName);
+	std::uint64_t size;
+	std::int64_t time;
+	auto now = static_cast<std::int64_t>(std::time(nullptr));
+	if (path::getFileInfo(size, time, evictPath))
+	{
+		if (now - time < evictInterval)
+			return;
+		path::touchFile(evictPath);
+	}
+	else
+	{
+		// The file's modification time is the time of the last eviction.
+		std::ofstream stream(evictPath);
+	}
+
+	evict();
+}
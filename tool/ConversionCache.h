@@ -0,0 +1,82 @@
+/*
+ * Copyright 2026 Aaron Barany
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "ResultFile.h"
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <vector>
+
+// Cache of conversion results addressed by a hash of the config and input data. Each entry is a
+// directory named by the key with the result JSON and data files. Entries are written to a
+// temporary directory and renamed into place, so multiple processes may share the cache. The least
+// recently used entries are evicted when the cache grows beyond the maximum size.
+class ConversionCache
+{
+public:
+	// Data file names are full paths to the files in the cache.
+	struct Entry
+	{
+		std::vector<std::vector<Bounds>> bounds;
+		std::uint32_t vertexCount = 0;
+		std::vector<std::string> vertexFiles;
+		std::vector<IndexFileData> indexBuffers;
+		std::vector<std::string> indexFiles;
+	};
+
+	// Bump when changes to conversion change the output for the same input.
+	static const std::uint32_t version = 1;
+
+	ConversionCache(std::string directory, std::uint64_t maxSize);
+	ConversionCache(const ConversionCache&) = delete;
+	ConversionCache& operator=(const ConversionCache&) = delete;
+
+	const std::string& getDirectory() const
+	{
+		return m_directory;
+	}
+
+	std::uint64_t getMaxSize() const
+	{
+		return m_maxSize;
+	}
+
+	bool initialize();
+
+	// Finds an entry for the key, marking it as recently used.
+	bool find(Entry& outEntry, const std::string& key) const;
+
+	// Stores the result from in-memory data. Returns true if the entry exists afterward, including
+	// if another process stored it first.
+	bool store(const std::string& key, const std::vector<vfc::VertexFormat>& vertexFormat,
+		const std::vector<std::vector<Bounds>>& bounds,
+		const std::vector<VertexFileData>& vertexData, std::uint32_t vertexCount,
+		vfc::IndexType indexType, const std::vector<IndexFileData>& indexData);
+
+	// Evicts the least recently used entries until the cache is within the maximum size.
+	void evict();
+
+	// Evicts if enough time has passed since the last eviction, avoiding scanning the full cache
+	// for every entry that's stored.
+	void evictIfDue();
+
+private:
+	std::string m_directory;
+	std::uint64_t m_maxSize;
+	std::mutex m_evictMutex;
+};
@@ -0,0 +1,185 @@
+/*
+ * Copyright 2026 Aaron Barany
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "InputData.h"
+#include <fstream>
+#include <limits>
+
+#if VFC_WINDOWS
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <Windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+InputData::InputData(InputData&& other) noexcept
+	: m_buffer(std::move(other.m_buffer))
+	, m_data(other.m_data)
+	, m_size(other.m_size)
+	, m_mapping(other.m_mapping)
+{
+	other.m_data = nullptr;
+	other.m_size = 0;
+	other.m_mapping = nullptr;
+}
+
+InputData& InputData::operator=(InputData&& other) noexcept
+{
+	if (this == &other)
+		return *this;
+
+	reset();
+	m_buffer = std::move(other.m_buffer);
+	m_data = other.m_data;
+	m_size = other.m_size;
+	m_mapping = other.m_mapping;
+	other.m_data = nullptr;
+	other.m_size = 0;
+	other.m_mapping = nullptr;
+	return *this;
+}
+
+InputData::~InputData()
+{
+	reset();
+}
+
+bool InputData::loadFile(const std::string& fileName, bool allowMapping)
+{
+	reset();
+	if (allowMapping && mapFile(fileName))
+		return true;
+
+	return readFile(fileName);
+}
+
+void InputData::setData(std::vector<std::uint8_t> data)
+{
+	reset();
+	m_buffer = std::move(data);
+	m_data = m_buffer.data();
+	m_size = m_buffer.size();
+}
+
+void InputData::setView(const void* data, std::size_t size)
+{
+	reset();
+	m_data = reinterpret_cast<const std::uint8_t*>(data);
+	m_size = size;
+}
+
+void InputData::reset()
+{
+	if (m_mapping)
+	{
+#if VFC_WINDOWS
+		UnmapViewOfFile(m_mapping);
+#else
+		munmap(m_mapping, m_size);
+#endif
+		m_mapping = nullptr;
+	}
+
+	m_buffer.clear();
+	m_buffer.shrink_to_fit();
+	m_data = nullptr;
+	m_size = 0;
+}
+
+bool InputData::mapFile(const std::string& fileName)
+{
+#if VFC_WINDOWS
+	HANDLE file = CreateFileA(fileName.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+		OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+	if (file == INVALID_HANDLE_VALUE)
+		return false;
+
+	LARGE_INTEGER fileSize;
+	// Empty files can't be mapped, and will be handled when reading.
+	if (!GetFileSizeEx(file, &fileSize) || fileSize.QuadPart == 0 ||
+		static_cast<std::uint64_t>(fileSize.QuadPart) > std::numeric_limits<std::size_t>::max())
+	{
+		CloseHandle(file);
+		return false;
+	}
+
+	// The view keeps a reference to the mapping, so the handles can be closed immediately.
+	HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+	CloseHandle(file);
+	if (!mapping)
+		return false;
+
+	void* view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+	CloseHandle(mapping);
+	if (!view)
+		return false;
+
+	m_mapping = view;
+	m_size = static_cast<std::size_t>(fileSize.QuadPart);
+#else
+	int fd = open(fileName.c_str(), O_RDONLY);
+	if (fd < 0)
+		return false;
+
+	struct stat fileStat;
+	// Empty files can't be mapped, and will be handled when reading.
+	if (fstat(fd, &fileStat) != 0 || !S_ISREG(fileStat.st_mode) || fileStat.st_size == 0 ||
+		static_cast<std::uint64_t>(fileStat.st_size) > std::numeric_limits<std::size_t>::max())
+	{
+		close(fd);
+		return false;
+	}
+
+	auto size = static_cast<std::size_t>(fileStat.st_size);
+	// The mapping stays valid after closing the file.
+	void* mapping = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+	close(fd);
+	if (mapping == MAP_FAILED)
+		return false;
+
+	m_mapping = mapping;
+	m_size = size;
+#endif
+
+	m_data = reinterpret_cast<const std::uint8_t*>(m_mapping);
+	return true;
+}
+
+bool InputData::readFile(const std::string& fileName)
+{
+	std::ifstream stream(fileName, std::ios_base::in | std::ios_base::binary | std::ios_base::ate);
+	if (!stream.is_open())
+		return false;
+
+	std::streamoff size = stream.tellg();
+	if (size < 0 ||
+		static_cast<std::uint64_t>(size) > std::numeric_limits<std::size_t>::max())
+	{
+		return false;
+	}
+
+	std::vector<std::uint8_t> data(static_cast<std::size_t>(size));
+	stream.seekg(0);
+	if (!data.empty() && !stream.read(reinterpret_cast<char*>(data.data()), size))
+		return false;
+
+	setData(std::move(data));
+	return true;
+}
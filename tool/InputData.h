@@ -0,0 +1,70 @@
+/*
+ * Copyright 2026 Aaron Barany
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <VFC/Config.h>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Input data for a vertex or index stream. Files are memory-mapped when possible to avoid copying
+// them into memory, falling back to reading the full file with a single read. A view references
+// data owned elsewhere, such as a vertex stream within an input container.
+class InputData
+{
+public:
+	InputData() = default;
+	InputData(const InputData&) = delete;
+	InputData& operator=(const InputData&) = delete;
+	InputData(InputData&& other) noexcept;
+	InputData& operator=(InputData&& other) noexcept;
+	~InputData();
+
+	bool loadFile(const std::string& fileName, bool allowMapping = true);
+	void setData(std::vector<std::uint8_t> data);
+	void setView(const void* data, std::size_t size);
+	void reset();
+
+	const std::uint8_t* data() const
+	{
+		return m_data;
+	}
+
+	std::size_t size() const
+	{
+		return m_size;
+	}
+
+	bool empty() const
+	{
+		return m_size == 0;
+	}
+
+	bool isMapped() const
+	{
+		return m_mapping != nullptr;
+	}
+
+private:
+	bool mapFile(const std::string& fileName);
+	bool readFile(const std::string& fileName);
+
+	std::vector<std::uint8_t> m_buffer;
+	const std::uint8_t* m_data = nullptr;
+	std::size_t m_size = 0;
+	void* m_mapping = nullptr;
+};
@@ -0,0 +1,189 @@
+/*
+ * Copyright 2026 Aaron Barany
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "JobPool.h"
+#include <algorithm>
+#include <deque>
+#include <limits>
+#include <memory>
+#include <thread>
+
+#if VFC_WINDOWS
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <Windows.h>
+#else
+#include <unistd.h>
+#endif
+
+namespace
+{
+
+struct JobQueue
+{
+	std::mutex mutex;
+	std::deque<std::size_t> jobs;
+};
+
+bool popJob(std::size_t& outJob, JobQueue& queue)
+{
+	std::lock_guard<std::mutex> lock(queue.mutex);
+	if (queue.jobs.empty())
+		return false;
+
+	outJob = queue.jobs.front();
+	queue.jobs.pop_front();
+	return true;
+}
+
+void runThread(std::vector<std::unique_ptr<JobQueue>>& queues,
+	const std::vector<std::uint64_t>& priorities, const JobPool::JobFunction& function,
+	unsigned int thread)
+{
+	auto threadCount = static_cast<unsigned int>(queues.size());
+	while (true)
+	{
+		std::size_t job;
+		if (!popJob(job, *queues[thread]))
+		{
+			// Steal the highest priority job from the other queues. Jobs are never added once
+			// running, so all jobs have been started once the queues are empty.
+			bool found;
+			do
+			{
+				found = false;
+				std::uint64_t bestPriority = 0;
+				unsigned int bestThread = 0;
+				for (unsigned int i = 1; i < threadCount; ++i)
+				{
+					unsigned int otherThread = (thread + i) % threadCount;
+					JobQueue& queue = *queues[otherThread];
+					std::lock_guard<std::mutex> lock(queue.mutex);
+					if (queue.jobs.empty())
+						continue;
+
+					std::uint64_t priority = priorities[queue.jobs.front()];
+					if (!found || priority > bestPriority)
+					{
+						found = true;
+						bestPriority = priority;
+						bestThread = otherThread;
+					}
+				}
+
+				// Another thread may have taken the job in the meantime, so try again if so.
+				if (found && popJob(job, *queues[bestThread]))
+					break;
+			} while (found);
+
+			if (!found)
+				return;
+		}
+
+		function(job, thread);
+	}
+}
+
+} // namespace
+
+void JobPool::run(unsigned int threadCount, const std::vector<std::uint64_t>& priorities,
+	const JobFunction& function)
+{
+	if (threadCount > priorities.size())
+		threadCount = static_cast<unsigned int>(priorities.size());
+	if (threadCount == 0)
+		threadCount = 1;
+
+	std::vector<std::size_t> order(priorities.size());
+	for (std::size_t i = 0; i < order.size(); ++i)
+		order[i] = i;
+	std::stable_sort(order.begin(), order.end(),
+		[&priorities](std::size_t left, std::size_t right)
+		{
+			return priorities[left] > priorities[right];
+		});
+
+	// Deal out the jobs so each thread starts with a similar mix of large and small jobs.
+	std::vector<std::unique_ptr<JobQueue>> queues(threadCount);
+	for (std::unique_ptr<JobQueue>& queue : queues)
+		queue.reset(new JobQueue);
+	for (std::size_t i = 0; i < order.size(); ++i)
+		queues[i % threadCount]->jobs.push_back(order[i]);
+
+	std::vector<std::thread> threads;
+	threads.reserve(threadCount - 1);
+	for (unsigned int i = 1; i < threadCount; ++i)
+	{
+		threads.emplace_back(runThread, std::ref(queues), std::cref(priorities),
+			std::cref(function), i);
+	}
+
+	runThread(queues, priorities, function, 0);
+	for (std::thread& thread : threads)
+		thread.join();
+}
+
+MemoryBudget::MemoryBudget(std::uint64_t budget)
+	: m_budget(budget)
+{
+}
+
+std::uint64_t MemoryBudget::defaultBudget()
+{
+	std::uint64_t memorySize = 0;
+#if VFC_WINDOWS
+	MEMORYSTATUSEX status;
+	status.dwLength = sizeof(status);
+	if (GlobalMemoryStatusEx(&status))
+		memorySize = status.ullTotalPhys;
+#else
+	long pageCount = sysconf(_SC_PHYS_PAGES);
+	long pageSize = sysconf(_SC_PAGE_SIZE);
+	if (pageCount > 0 && pageSize > 0)
+		memorySize = static_cast<std::uint64_t>(pageCount)*static_cast<std::uint64_t>(pageSize);
+#endif
+
+	if (memorySize == 0)
+		return std::numeric_limits<std::uint64_t>::max();
+	return memorySize/2;
+}
+
+std::uint64_t MemoryBudget::getUsed() const
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+	return m_used;
+}
+
+void MemoryBudget::acquire(std::uint64_t size)
+{
+	std::unique_lock<std::mutex> lock(m_mutex);
+	m_condition.wait(lock, [this, size]()
+		{
+			return m_used == 0 || (m_used <= m_budget && size <= m_budget - m_used);
+		});
+	m_used += size;
+}
+
+void MemoryBudget::release(std::uint64_t size)
+{
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_used -= size;
+	}
+
+	// Waiting jobs may need different sizes, so each checks whether it now fits.
+	m_condition.notify_all();
+}
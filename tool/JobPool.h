@@ -0,0 +1,109 @@
+/*
+ * Copyright 2026 Aaron Barany
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <VFC/Config.h>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <vector>
+
+// Runs jobs across multiple threads with work stealing. Jobs are run in order of their priority,
+// highest first, and are distributed between the threads up front. A thread that runs out of jobs
+// steals the highest priority job remaining in another thread's queue.
+class JobPool
+{
+public:
+	using JobFunction = std::function<void(std::size_t job, unsigned int thread)>;
+
+	// Runs the jobs and waits for them to complete. The calling thread is used as thread 0.
+	static void run(unsigned int threadCount, const std::vector<std::uint64_t>& priorities,
+		const JobFunction& function);
+};
+
+// Limits the memory used by jobs running at the same time. A job larger than the budget is still
+// run once no other jobs hold memory.
+class MemoryBudget
+{
+public:
+	explicit MemoryBudget(std::uint64_t budget);
+	MemoryBudget(const MemoryBudget&) = delete;
+	MemoryBudget& operator=(const MemoryBudget&) = delete;
+
+	// Half of the physical memory, or no limit if it couldn't be queried.
+	static std::uint64_t defaultBudget();
+
+	std::uint64_t getBudget() const
+	{
+		return m_budget;
+	}
+
+	std::uint64_t getUsed() const;
+
+	void acquire(std::uint64_t size);
+	void release(std::uint64_t size);
+
+private:
+	std::uint64_t m_budget;
+	std::uint64_t m_used = 0;
+	mutable std::mutex m_mutex;
+	std::condition_variable m_condition;
+};
+
+// Acquires memory from a budget for the lifetime of the object.
+class MemoryReservation
+{
+public:
+	MemoryReservation(MemoryBudget* budget, std::uint64_t size)
+		: m_budget(budget)
+		, m_size(size)
+	{
+		if (m_budget)
+			m_budget->acquire(m_size);
+	}
+
+	MemoryReservation(const MemoryReservation&) = delete;
+	MemoryReservation& operator=(const MemoryReservation&) = delete;
+
+	~MemoryReservation()
+	{
+		if (m_budget)
+			m_budget->release(m_size);
+	}
+
+	// Corrects the size once the actual memory usage is known. Growing releases the reservation
+	// before acquiring the new size so that jobs growing at the same time can't deadlock.
+	void resize(std::uint64_t size)
+	{
+		if (!m_budget || size == m_size)
+			return;
+
+		if (size < m_size)
+			m_budget->release(m_size - size);
+		else
+		{
+			m_budget->release(m_size);
+			m_budget->acquire(size);
+		}
+		m_size = size;
+	}
+
+private:
+	MemoryBudget* m_budget;
+	std::uint64_t m_size;
+};
@@ -0,0 +1,182 @@
+/*
+ * Copyright 2026 Aaron Barany
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "OutputFile.h"
+#include <VFC/Trace.h>
+#include <fstream>
+
+#if VFC_WINDOWS
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <Windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+OutputFile::OutputFile(OutputFile&& other) noexcept
+	: m_fileName(std::move(other.m_fileName))
+	, m_buffer(std::move(other.m_buffer))
+	, m_data(other.m_data)
+	, m_size(other.m_size)
+	, m_mapping(other.m_mapping)
+{
+	other.m_data = nullptr;
+	other.m_size = 0;
+	other.m_mapping = nullptr;
+}
+
+OutputFile& OutputFile::operator=(OutputFile&& other) noexcept
+{
+	if (this == &other)
+		return *this;
+
+	unmap();
+	m_fileName = std::move(other.m_fileName);
+	m_buffer = std::move(other.m_buffer);
+	m_data = other.m_data;
+	m_size = other.m_size;
+	m_mapping = other.m_mapping;
+	other.m_data = nullptr;
+	other.m_size = 0;
+	other.m_mapping = nullptr;
+	return *this;
+}
+
+OutputFile::~OutputFile()
+{
+	unmap();
+}
+
+bool OutputFile::create(const std::string& fileName, std::size_t size, bool allowMapping)
+{
+	VFC_TRACE_SCOPE_DETAIL("createFile", fileName);
+	unmap();
+	m_buffer.clear();
+	m_data = nullptr;
+	m_fileName = fileName;
+	m_size = size;
+
+	// Empty files can't be mapped.
+	if (size > 0 && allowMapping && mapFile())
+		return true;
+
+	// Create the file now to report errors early.
+	std::ofstream stream(fileName,
+		std::ios_base::out | std::ios_base::trunc | std::ios_base::binary);
+	if (!stream.is_open())
+		return false;
+
+	m_buffer.resize(size);
+	m_data = m_buffer.data();
+	return true;
+}
+
+bool OutputFile::close()
+{
+	VFC_TRACE_SCOPE_DETAIL("writeFile", m_fileName);
+	if (m_mapping)
+	{
+		unmap();
+		return true;
+	}
+
+	bool success = true;
+	if (!m_buffer.empty())
+	{
+		std::ofstream stream(m_fileName,
+			std::ios_base::out | std::ios_base::trunc | std::ios_base::binary);
+		stream.write(reinterpret_cast<const char*>(m_buffer.data()), m_buffer.size());
+		success = stream.good();
+	}
+
+	m_buffer.clear();
+	m_buffer.shrink_to_fit();
+	m_data = nullptr;
+	m_size = 0;
+	return success;
+}
+
+bool OutputFile::mapFile()
+{
+#if VFC_WINDOWS
+	HANDLE file = CreateFileA(m_fileName.c_str(), GENERIC_READ | GENERIC_WRITE, 0, nullptr,
+		CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr);
+	if (file == INVALID_HANDLE_VALUE)
+		return false;
+
+	// Creating the mapping extends the file to the full size. The view keeps a reference to the
+	// mapping, so the handles can be closed immediately.
+	auto size = static_cast<std::uint64_t>(m_size);
+	HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READWRITE,
+		static_cast<DWORD>(size >> 32), static_cast<DWORD>(size & 0xFFFFFFFF), nullptr);
+	CloseHandle(file);
+	if (!mapping)
+		return false;
+
+	void* view = MapViewOfFile(mapping, FILE_MAP_WRITE, 0, 0, 0);
+	CloseHandle(mapping);
+	if (!view)
+		return false;
+
+	m_mapping = view;
+#else
+	int fd = open(m_fileName.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0666);
+	if (fd < 0)
+		return false;
+
+	// Allocate the space up front when possible so running out of space is an error here rather
+	// than a signal when writing to the mapping.
+	auto size = static_cast<off_t>(m_size);
+	bool allocated = false;
+#if VFC_LINUX
+	allocated = posix_fallocate(fd, 0, size) == 0;
+#endif
+	if (!allocated && ftruncate(fd, size) != 0)
+	{
+		::close(fd);
+		return false;
+	}
+
+	// The mapping stays valid after closing the file.
+	void* mapping = mmap(nullptr, m_size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+	::close(fd);
+	if (mapping == MAP_FAILED)
+		return false;
+
+	m_mapping = mapping;
+#endif
+
+	m_data = reinterpret_cast<std::uint8_t*>(m_mapping);
+	return true;
+}
+
+void OutputFile::unmap()
+{
+	if (!m_mapping)
+		return;
+
+#if VFC_WINDOWS
+	UnmapViewOfFile(m_mapping);
+#else
+	munmap(m_mapping, m_size);
+#endif
+	m_mapping = nullptr;
+	m_data = nullptr;
+	m_size = 0;
+}
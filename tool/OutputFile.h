@@ -0,0 +1,68 @@
+/*
+ * Copyright 2026 Aaron Barany
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <VFC/Config.h>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Output data file that's created with its final size. The file is memory-mapped when possible so
+// the data can be written to it directly, falling back to writing a buffer in memory on close.
+class OutputFile
+{
+public:
+	OutputFile() = default;
+	OutputFile(const OutputFile&) = delete;
+	OutputFile& operator=(const OutputFile&) = delete;
+	OutputFile(OutputFile&& other) noexcept;
+	OutputFile& operator=(OutputFile&& other) noexcept;
+	~OutputFile();
+
+	bool create(const std::string& fileName, std::size_t size, bool allowMapping = true);
+	bool close();
+
+	const std::string& getFileName() const
+	{
+		return m_fileName;
+	}
+
+	std::uint8_t* data()
+	{
+		return m_data;
+	}
+
+	std::size_t size() const
+	{
+		return m_size;
+	}
+
+	bool isMapped() const
+	{
+		return m_mapping != nullptr;
+	}
+
+private:
+	bool mapFile();
+	void unmap();
+
+	std::string m_fileName;
+	std::vector<std::uint8_t> m_buffer;
+	std::uint8_t* m_data = nullptr;
+	std::size_t m_size = 0;
+	void* m_mapping = nullptr;
+};
@@ -1,5 +1,5 @@
 /*
- * Copyright 2020 Aaron Barany
+ * Copyright 2020-2026 Aaron Barany
  *
  * Licensed under the Apache License, Version 2.0 (the "License");
  * you may not use this file except in compliance with the License.
@@ -16,6 +16,27 @@
 
 #include "Path.h"
 
+#include <cstdio>
+#include <cstring>
+#include <errno.h>
+#include <sys/stat.h>
+
+#if VFC_WINDOWS
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <Windows.h>
+#include <direct.h>
+#include <sys/utime.h>
+#define mkdir(path, mode) _mkdir(path)
+#define getcwd _getcwd
+#define rmdir _rmdir
+#define utime _utime
+#else
+#include <dirent.h>
+#include <unistd.h>
+#include <utime.h>
+#endif
+
 #if VFC_WINDOWS
 static const char pathSeps[] = "\\/";
 static char prefPathSep = '\\';
@@ -93,4 +114,94 @@ std::string join(const std::string& left, const std::string& right)
 	return finalPath;
 }
 
+std::string makeAbsolute(const std::string& path)
+{
+	if (isAbsolute(path))
+		return path;
+
+	char buffer[4096];
+	if (!getcwd(buffer, sizeof(buffer)))
+		return path;
+
+	return join(buffer, path);
+}
+
+bool createDirectories(const std::string& directory)
+{
+	std::string parentDir = getParentDirectory(directory);
+	if (parentDir == directory)
+		return true;
+
+	if (!parentDir.empty() && !createDirectories(parentDir))
+		return false;
+
+	return mkdir(directory.c_str(), 0755) == 0 || errno == EEXIST;
+}
+
+bool listDirectory(std::vector<std::string>& outNames, const std::string& directory)
+{
+	outNames.clear();
+#if VFC_WINDOWS
+	WIN32_FIND_DATAA findData;
+	HANDLE find = FindFirstFileA(join(directory, "*").c_str(), &findData);
+	if (find == INVALID_HANDLE_VALUE)
+		return false;
+
+	do
+	{
+		if (std::strcmp(findData.cFileName, ".") != 0 && std::strcmp(findData.cFileName, "..") != 0)
+			outNames.push_back(findData.cFileName);
+	} while (FindNextFileA(find, &findData));
+	FindClose(find);
+#else
+	DIR* dir = opendir(directory.c_str());
+	if (!dir)
+		return false;
+
+	while (dirent* entry = readdir(dir))
+	{
+		if (std::strcmp(entry->d_name, ".") != 0 && std::strcmp(entry->d_name, "..") != 0)
+			outNames.push_back(entry->d_name);
+	}
+	closedir(dir);
+#endif
+
+	return true;
+}
+
+bool getFileInfo(std::uint64_t& outSize, std::int64_t& outModifiedTime, const std::string& path)
+{
+	struct stat fileStat;
+	if (stat(path.c_str(), &fileStat) != 0)
+		return false;
+
+	outSize = static_cast<std::uint64_t>(fileStat.st_size);
+	outModifiedTime = static_cast<std::int64_t>(fileStat.st_mtime);
+	return true;
+}
+
+bool touchFile(const std::string& path)
+{
+	return utime(path.c_str(), nullptr) == 0;
+}
+
+bool renamePath(const std::string& from, const std::string& to)
+{
+#if VFC_WINDOWS
+	return MoveFileExA(from.c_str(), to.c_str(), 0) != 0;
+#else
+	return rename(from.c_str(), to.c_str()) == 0;
+#endif
+}
+
+bool removeFile(const std::string& path)
+{
+	return std::remove(path.c_str()) == 0;
+}
+
+bool removeDirectory(const std::string& directory)
+{
+	return rmdir(directory.c_str()) == 0;
+}
+
 } // namespace path
@@ -1,5 +1,5 @@
 /*
- * Copyright 2020 Aaron Barany
+ * Copyright 2020-2026 Aaron Barany
  *
  * Licensed under the Apache License, Version 2.0 (the "License");
  * you may not use this file except in compliance with the License.
@@ -17,7 +17,9 @@
 #pragma once
 
 #include <VFC/Config.h>
+#include <cstdint>
 #include <string>
+#include <vector>
 
 namespace path
 {
@@ -26,5 +28,15 @@ bool isAbsolute(const std::string& path);
 std::string getFileName(const std::string& path);
 std::string getParentDirectory(const std::string& path);
 std::string join(const std::string& left, const std::string& right);
+std::string makeAbsolute(const std::string& path);
+bool createDirectories(const std::string& directory);
+
+// File system operations for managing directories of files. Modification times are in seconds.
+bool listDirectory(std::vector<std::string>& outNames, const std::string& directory);
+bool getFileInfo(std::uint64_t& outSize, std::int64_t& outModifiedTime, const std::string& path);
+bool touchFile(const std::string& path);
+bool renamePath(const std::string& from, const std::string& to);
+bool removeFile(const std::string& path);
+bool removeDirectory(const std::string& directory);
 
 } // namespace path
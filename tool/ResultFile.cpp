@@ -1,5 +1,5 @@
 /*
- * Copyright 2020-2021 Aaron Barany
+ * Copyright 2020-2026 Aaron Barany
  *
  * Licensed under the Apache License, Version 2.0 (the "License");
  * you may not use this file except in compliance with the License.
@@ -15,102 +15,336 @@
  */
 
 #include "ResultFile.h"
-#include <rapidjson/document.h>
+#include "Base64.h"
+#include <VFC/Trace.h>
 #include <rapidjson/prettywriter.h>
+#include <rapidjson/writer.h>
+#include <algorithm>
 #include <cassert>
+#include <cstring>
 
-std::string resultFile(const std::vector<vfc::VertexFormat>& vertexFormat,
-	const std::vector<std::vector<Bounds>>& bounds, const std::vector<std::string>& vertexData,
+namespace
+{
+
+// Output stream for the JSON writer that buffers the output for a file or string.
+class ResultStream
+{
+public:
+	typedef char Ch;
+
+	explicit ResultStream(std::FILE* file)
+		: m_file(file)
+		, m_buffer(bufferSize)
+	{
+	}
+
+	explicit ResultStream(std::string& string)
+		: m_string(&string)
+		, m_buffer(bufferSize)
+	{
+	}
+
+	void Put(Ch c)
+	{
+		if (m_size == m_buffer.size())
+			Flush();
+		m_buffer[m_size++] = c;
+	}
+
+	void write(const Ch* data, std::size_t size)
+	{
+		if (size > m_buffer.size() - m_size)
+		{
+			Flush();
+			if (size > m_buffer.size())
+			{
+				writeTarget(data, size);
+				return;
+			}
+		}
+
+		std::memcpy(m_buffer.data() + m_size, data, size);
+		m_size += size;
+	}
+
+	void Flush()
+	{
+		writeTarget(m_buffer.data(), m_size);
+		m_size = 0;
+	}
+
+	bool failed() const
+	{
+		return m_failed;
+	}
+
+private:
+	static const std::size_t bufferSize = 64*1024;
+
+	void writeTarget(const Ch* data, std::size_t size)
+	{
+		if (size == 0)
+			return;
+
+		if (m_file)
+			m_failed |= std::fwrite(data, 1, size, m_file) != size;
+		else
+			m_string->append(data, size);
+	}
+
+	std::FILE* m_file = nullptr;
+	std::string* m_string = nullptr;
+	std::vector<Ch> m_buffer;
+	std::size_t m_size = 0;
+	bool m_failed = false;
+};
+
+// Multiple of 3 bytes so the chunks can be encoded separately without padding.
+const std::size_t base64ChunkSize = 3*16*1024;
+
+template <typename WriterT>
+void writeData(WriterT& writer, ResultStream& stream, const char* key, const char* dataFile,
+	const void* data, std::size_t dataSize, const char* encoding, const char* containerFile)
+{
+	if (containerFile)
+		return;
+
+	if (encoding)
+	{
+		writer.Key("encoding");
+		writer.String(encoding);
+	}
+
+	writer.Key(key);
+	if (dataFile)
+	{
+		writer.String(dataFile);
+		return;
+	}
+
+	// Write the string contents directly to the stream so the base64 encoding of large data doesn't
+	// need to be held in memory all at once.
+	const char* prefix = "\"base64:";
+	writer.RawValue(prefix, std::strlen(prefix), rapidjson::kStringType);
+	auto bytes = reinterpret_cast<const std::uint8_t*>(data);
+	for (std::size_t offset = 0; offset < dataSize; offset += base64ChunkSize)
+	{
+		std::string encoded =
+			base64::encode(bytes + offset, std::min(base64ChunkSize, dataSize - offset));
+		stream.write(encoded.data(), encoded.size());
+	}
+	stream.Put('"');
+}
+
+template <typename WriterT>
+void writeIndexBuffers(WriterT& writer, ResultStream& stream,
+	const std::vector<IndexFileData>& indexData, const char* containerFile)
+{
+	writer.Key("indexBuffers");
+	writer.StartArray();
+	for (const IndexFileData& curData : indexData)
+	{
+		writer.StartObject();
+		writer.Key("indexCount");
+		writer.Uint(curData.count);
+		writer.Key("baseVertex");
+		writer.Int(curData.baseVertex);
+		writeData(writer, stream, "indexData", curData.dataFile, curData.data, curData.dataSize,
+			curData.encoding, containerFile);
+		writer.EndObject();
+	}
+	writer.EndArray();
+}
+
+template <typename WriterT>
+void writeResult(WriterT& writer, ResultStream& stream,
+	const std::vector<vfc::VertexFormat>& vertexFormat,
+	const std::vector<std::vector<Bounds>>& bounds, const std::vector<VertexFileData>& vertexData,
 	std::uint32_t vertexCount, vfc::IndexType indexType,
-	const std::vector<IndexFileData>& indexData)
+	const std::vector<IndexFileData>& indexData, const vfc::Converter::Stats* stats,
+	const char* containerFile, const std::vector<LodFileData>* lods)
 {
 	assert(vertexFormat.size() == vertexData.size());
 	assert(vertexFormat.size() == bounds.size());
-	rapidjson::Document document(rapidjson::kObjectType);
+	writer.StartObject();
 
-	rapidjson::Value vertexArray(rapidjson::kArrayType);
-	vertexArray.Reserve(static_cast<std::uint32_t>(vertexFormat.size()),
-		document.GetAllocator());
+	if (containerFile)
+	{
+		writer.Key("container");
+		writer.String(containerFile);
+	}
+
+	writer.Key("vertices");
+	writer.StartArray();
 	for (std::size_t i = 0; i < vertexFormat.size(); ++i)
 	{
 		const vfc::VertexFormat& curFormat = vertexFormat[i];
 		const std::vector<Bounds>& curBounds = bounds[i];
-		const std::string& curData = vertexData[i];
+		const VertexFileData& curData = vertexData[i];
 		assert(curFormat.size() == curBounds.size());
 
-		rapidjson::Value vertexInfo(rapidjson::kObjectType);
-		rapidjson::Value vertexFormatArray(rapidjson::kArrayType);
-		vertexFormatArray.Reserve(static_cast<std::uint32_t>(vertexFormat.size()),
-			document.GetAllocator());
+		writer.StartObject();
+		writer.Key("vertexFormat");
+		writer.StartArray();
 		for (std::size_t j = 0; j < curFormat.size(); ++j)
 		{
 			const vfc::VertexElement& element = curFormat[j];
-			rapidjson::Value elementObject(rapidjson::kObjectType);
-			elementObject.MemberReserve(6, document.GetAllocator());
-			elementObject.AddMember("name", rapidjson::StringRef(element.name.c_str()),
-				document.GetAllocator());
-			elementObject.AddMember("layout",
-				rapidjson::StringRef(vfc::elementLayoutName(element.layout)), document.GetAllocator());
-			elementObject.AddMember("type",
-				rapidjson::StringRef(vfc::elementTypeName(element.type)), document.GetAllocator());
-			elementObject.AddMember("offset", element.offset, document.GetAllocator());
-
-			rapidjson::Value minBoundsArray(rapidjson::kArrayType);
-			rapidjson::Value maxBoundsArray(rapidjson::kArrayType);
-			minBoundsArray.Reserve(4, document.GetAllocator());
-			maxBoundsArray.Reserve(4, document.GetAllocator());
+			writer.StartObject();
+			writer.Key("name");
+			writer.String(element.name.c_str());
+			writer.Key("layout");
+			writer.String(vfc::elementLayoutName(element.layout));
+			writer.Key("type");
+			writer.String(vfc::elementTypeName(element.type));
+			writer.Key("offset");
+			writer.Uint(element.offset);
+
+			writer.Key("minValue");
+			writer.StartArray();
 			for (unsigned int k = 0; k < 4; ++k)
-			{
-				minBoundsArray.PushBack(curBounds[j].min[k], document.GetAllocator());
-				maxBoundsArray.PushBack(curBounds[j].max[k], document.GetAllocator());
-			}
-			elementObject.AddMember("minValue", minBoundsArray, document.GetAllocator());
-			elementObject.AddMember("maxValue", maxBoundsArray, document.GetAllocator());
+				writer.Double(curBounds[j].min[k]);
+			writer.EndArray();
 
-			vertexFormatArray.PushBack(elementObject, document.GetAllocator());
+			writer.Key("maxValue");
+			writer.StartArray();
+			for (unsigned int k = 0; k < 4; ++k)
+				writer.Double(curBounds[j].max[k]);
+			writer.EndArray();
+			writer.EndObject();
 		}
-		vertexInfo.AddMember("vertexFormat", vertexFormatArray, document.GetAllocator());
-		vertexInfo.AddMember("vertexStride", curFormat.stride(), document.GetAllocator());
-		vertexInfo.AddMember("vertexData", rapidjson::StringRef(curData.c_str()),
-			document.GetAllocator());
-		vertexArray.PushBack(vertexInfo, document.GetAllocator());
+		writer.EndArray();
+
+		writer.Key("vertexStride");
+		writer.Uint(curFormat.stride());
+		writeData(writer, stream, "vertexData", curData.dataFile, curData.data, curData.dataSize,
+			curData.encoding, containerFile);
+		writer.EndObject();
 	}
-	document.AddMember("vertices", vertexArray, document.GetAllocator());
-	document.AddMember("vertexCount", vertexCount, document.GetAllocator());
+	writer.EndArray();
+
+	writer.Key("vertexCount");
+	writer.Uint(vertexCount);
 
 	switch (indexType)
 	{
 		case vfc::IndexType::UInt16:
-			document.AddMember("indexType", "UInt16", document.GetAllocator());
+			writer.Key("indexType");
+			writer.String("UInt16");
 			break;
 		case vfc::IndexType::UInt32:
-			document.AddMember("indexType", "UInt32", document.GetAllocator());
+			writer.Key("indexType");
+			writer.String("UInt32");
 			break;
 		default:
 			break;
 	}
 
 	if (indexType != vfc::IndexType::NoIndices && !indexData.empty())
+		writeIndexBuffers(writer, stream, indexData, containerFile);
+
+	if (lods && !lods->empty())
 	{
-		rapidjson::Value indexDataArray(rapidjson::kArrayType);
-		indexDataArray.Reserve(static_cast<std::uint32_t>(indexData.size()),
-			document.GetAllocator());
-		for (const IndexFileData& curData : indexData)
+		writer.Key("lods");
+		writer.StartArray();
+		for (const LodFileData& lod : *lods)
 		{
-			rapidjson::Value indexDataObject(rapidjson::kObjectType);
-			indexDataObject.MemberReserve(3, document.GetAllocator());
-			indexDataObject.AddMember("indexCount", curData.count, document.GetAllocator());
-			indexDataObject.AddMember("baseVertex", curData.baseVertex,
-				document.GetAllocator());
-			indexDataObject.AddMember("indexData", rapidjson::StringRef(curData.dataFile),
-				document.GetAllocator());
-			indexDataArray.PushBack(indexDataObject, document.GetAllocator());
+			writer.StartObject();
+			writer.Key("ratio");
+			writer.Double(lod.ratio);
+			writer.Key("error");
+			writer.Double(lod.error);
+			writeIndexBuffers(writer, stream, lod.indexBuffers, containerFile);
+			writer.EndObject();
 		}
-		document.AddMember("indexBuffers", indexDataArray, document.GetAllocator());
+		writer.EndArray();
+	}
+
+	if (stats)
+	{
+		writer.Key("stats");
+		writer.StartObject();
+		writer.Key("validateTime");
+		writer.Double(stats->validateTime);
+		writer.Key("boundsTime");
+		writer.Double(stats->boundsTime);
+		writer.Key("reserveTime");
+		writer.Double(stats->reserveTime);
+		writer.Key("encodeTime");
+		writer.Double(stats->encodeTime);
+		writer.Key("dedupTime");
+		writer.Double(stats->dedupTime);
+		writer.Key("carryOverTime");
+		writer.Double(stats->carryOverTime);
+		writer.Key("splitStreamsTime");
+		writer.Double(stats->splitStreamsTime);
+		writer.Key("totalTime");
+		writer.Double(stats->totalTime);
+		writer.Key("hashProbes");
+		writer.Uint64(stats->hashProbes);
+		writer.Key("dedupHits");
+		writer.Uint64(stats->dedupHits);
+		writer.Key("uniqueVertices");
+		writer.Uint64(stats->uniqueVertices);
+		writer.Key("carriedOverVertices");
+		writer.Uint64(stats->carriedOverVertices);
+		writer.Key("indexBuffers");
+		writer.Uint64(stats->indexBuffers);
+		writer.Key("peakVertexBytes");
+		writer.Uint64(stats->peakVertexBytes);
+		writer.Key("peakIndexBytes");
+		writer.Uint64(stats->peakIndexBytes);
+		writer.EndObject();
+	}
+
+	writer.EndObject();
+}
+
+bool writeResult(ResultStream& stream, const std::vector<vfc::VertexFormat>& vertexFormat,
+	const std::vector<std::vector<Bounds>>& bounds, const std::vector<VertexFileData>& vertexData,
+	std::uint32_t vertexCount, vfc::IndexType indexType,
+	const std::vector<IndexFileData>& indexData, const vfc::Converter::Stats* stats,
+	bool compact, const char* containerFile, const std::vector<LodFileData>* lods)
+{
+	VFC_TRACE_SCOPE("resultFile");
+	if (compact)
+	{
+		rapidjson::Writer<ResultStream> writer(stream);
+		writeResult(writer, stream, vertexFormat, bounds, vertexData, vertexCount, indexType,
+			indexData, stats, containerFile, lods);
+	}
+	else
+	{
+		rapidjson::PrettyWriter<ResultStream> writer(stream);
+		writeResult(writer, stream, vertexFormat, bounds, vertexData, vertexCount, indexType,
+			indexData, stats, containerFile, lods);
 	}
 
-	rapidjson::StringBuffer buffer;
-	rapidjson::PrettyWriter<rapidjson::StringBuffer> writer(buffer);
-	document.Accept(writer);
-	return buffer.GetString();
+	stream.Flush();
+	return !stream.failed();
+}
+
+} // namespace
+
+std::string resultFile(const std::vector<vfc::VertexFormat>& vertexFormat,
+	const std::vector<std::vector<Bounds>>& bounds, const std::vector<VertexFileData>& vertexData,
+	std::uint32_t vertexCount, vfc::IndexType indexType,
+	const std::vector<IndexFileData>& indexData, const vfc::Converter::Stats* stats, bool compact,
+	const char* containerFile, const std::vector<LodFileData>* lods)
+{
+	std::string result;
+	ResultStream stream(result);
+	writeResult(stream, vertexFormat, bounds, vertexData, vertexCount, indexType, indexData, stats,
+		compact, containerFile, lods);
+	return result;
+}
+
+bool writeResultFile(std::FILE* file, const std::vector<vfc::VertexFormat>& vertexFormat,
+	const std::vector<std::vector<Bounds>>& bounds, const std::vector<VertexFileData>& vertexData,
+	std::uint32_t vertexCount, vfc::IndexType indexType,
+	const std::vector<IndexFileData>& indexData, const vfc::Converter::Stats* stats, bool compact,
+	const char* containerFile, const std::vector<LodFileData>* lods)
+{
+	ResultStream stream(file);
+	return writeResult(stream, vertexFormat, bounds, vertexData, vertexCount, indexType,
+		indexData, stats, compact, containerFile, lods);
 }
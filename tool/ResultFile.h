@@ -1,5 +1,5 @@
 /*
- * Copyright 2020-2021 Aaron Barany
+ * Copyright 2020-2026 Aaron Barany
  *
  * Licensed under the Apache License, Version 2.0 (the "License");
  * you may not use this file except in compliance with the License.
@@ -17,15 +17,39 @@
 #pragma once
 
 #include <VFC/Config.h>
+#include <VFC/Converter.h>
 #include <VFC/IndexData.h>
 #include <VFC/VertexFormat.h>
 #include <VFC/VertexValue.h>
+#include <cstdio>
+
+// Data is embedded with base64 encoding when dataFile is null. When a container file is provided,
+// the data is in the container rather than the vertex and index data. The encoding is null for raw
+// data.
+struct VertexFileData
+{
+	const char* dataFile;
+	const void* data;
+	std::size_t dataSize;
+	const char* encoding;
+};
 
 struct IndexFileData
 {
 	std::uint32_t count;
 	std::int32_t baseVertex;
 	const char* dataFile;
+	const void* data;
+	std::size_t dataSize;
+	const char* encoding;
+};
+
+// Simplified index buffers for a level of detail, using the same vertices as the full mesh.
+struct LodFileData
+{
+	double ratio;
+	double error;
+	std::vector<IndexFileData> indexBuffers;
 };
 
 struct Bounds
@@ -35,6 +59,16 @@ struct Bounds
 };
 
 std::string resultFile(const std::vector<vfc::VertexFormat>& vertexFormat,
-	const std::vector<std::vector<Bounds>>& bounds, const std::vector<std::string>& vertexData,
+	const std::vector<std::vector<Bounds>>& bounds, const std::vector<VertexFileData>& vertexData,
+	std::uint32_t vertexCount, vfc::IndexType indexType,
+	const std::vector<IndexFileData>& indexData, const vfc::Converter::Stats* stats = nullptr,
+	bool compact = false, const char* containerFile = nullptr,
+	const std::vector<LodFileData>* lods = nullptr);
+
+// Writes the result directly to a file, encoding embedded data in chunks.
+bool writeResultFile(std::FILE* file, const std::vector<vfc::VertexFormat>& vertexFormat,
+	const std::vector<std::vector<Bounds>>& bounds, const std::vector<VertexFileData>& vertexData,
 	std::uint32_t vertexCount, vfc::IndexType indexType,
-	const std::vector<IndexFileData>& indexData);
+	const std::vector<IndexFileData>& indexData, const vfc::Converter::Stats* stats = nullptr,
+	bool compact = false, const char* containerFile = nullptr,
+	const std::vector<LodFileData>* lods = nullptr);
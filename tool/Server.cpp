@@ -0,0 +1,505 @@
+/*
+ * Copyright 2026 Aaron Barany
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "Server.h"
+#include <rapidjson/document.h>
+#include <rapidjson/stringbuffer.h>
+#include <rapidjson/writer.h>
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <thread>
+
+#if !VFC_WINDOWS
+#include <errno.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+#define VFC_HAS_UNIX_SOCKETS 1
+
+#ifndef MSG_NOSIGNAL
+#define MSG_NOSIGNAL 0
+#endif
+#else
+#define VFC_HAS_UNIX_SOCKETS 0
+#endif
+
+namespace server
+{
+
+#if VFC_HAS_UNIX_SOCKETS
+
+namespace
+{
+
+// Larger messages are rejected to avoid allocating memory for a bad size. Request headers only
+// hold the options, so they're limited further. Response headers may hold any number of errors.
+const std::uint32_t maxMessageSize = 0x7FFFFFFF;
+const std::uint32_t maxRequestHeaderSize = 64*1024;
+
+// Messages are read in chunks so memory is only allocated as the data arrives.
+const std::size_t messageChunkSize = 1024*1024;
+
+// Time to wait for connections before checking whether to stop, and to back off when out of
+// resources to accept connections.
+const int pollTimeoutMs = 100;
+
+// The socket is closed by the server once the thread is joined so the socket may be shut down
+// when stopping without the descriptor being re-used.
+struct Connection
+{
+	Connection()
+		: socket(-1)
+		, finished(false)
+	{
+	}
+
+	int socket;
+	std::atomic<bool> finished;
+	std::thread thread;
+};
+
+// Platforms without MSG_NOSIGNAL disable SIGPIPE on the socket instead. Clients disconnecting are
+// handled when writing responses.
+#ifdef SO_NOSIGPIPE
+void disableSigPipe(int socket)
+{
+	int value = 1;
+	setsockopt(socket, SOL_SOCKET, SO_NOSIGPIPE, &value, sizeof(value));
+}
+#else
+void disableSigPipe(int)
+{
+}
+#endif
+
+bool writeAll(int socket, const void* data, std::size_t size)
+{
+	auto bytes = reinterpret_cast<const char*>(data);
+	while (size > 0)
+	{
+		ssize_t written = ::send(socket, bytes, size, MSG_NOSIGNAL);
+		if (written < 0)
+		{
+			if (errno == EINTR)
+				continue;
+			return false;
+		}
+
+		bytes += written;
+		size -= static_cast<std::size_t>(written);
+	}
+
+	return true;
+}
+
+bool readAll(int socket, void* data, std::size_t size)
+{
+	auto bytes = reinterpret_cast<char*>(data);
+	while (size > 0)
+	{
+		ssize_t readSize = ::recv(socket, bytes, size, 0);
+		if (readSize < 0 && errno == EINTR)
+			continue;
+		if (readSize <= 0)
+			return false;
+
+		bytes += readSize;
+		size -= static_cast<std::size_t>(readSize);
+	}
+
+	return true;
+}
+
+// Sizes are sent as little endian.
+bool writeMessage(int socket, const std::string& message)
+{
+	if (message.size() > maxMessageSize)
+		return false;
+
+	auto size = static_cast<std::uint32_t>(message.size());
+	std::uint8_t sizeBytes[4];
+	for (unsigned int i = 0; i < 4; ++i)
+		sizeBytes[i] = static_cast<std::uint8_t>(size >> (i*8));
+	return writeAll(socket, sizeBytes, sizeof(sizeBytes)) &&
+		writeAll(socket, message.data(), message.size());
+}
+
+bool readMessage(std::string& outMessage, int socket, std::uint32_t maxSize)
+{
+	std::uint8_t sizeBytes[4];
+	if (!readAll(socket, sizeBytes, sizeof(sizeBytes)))
+		return false;
+
+	std::uint32_t size = 0;
+	for (unsigned int i = 0; i < 4; ++i)
+		size |= static_cast<std::uint32_t>(sizeBytes[i]) << (i*8);
+	if (size > maxSize)
+		return false;
+
+	// The size comes from the other side of the connection, so don't allocate it all up front.
+	outMessage.clear();
+	while (outMessage.size() < size)
+	{
+		std::size_t offset = outMessage.size();
+		std::size_t chunkSize = std::min(size - offset, messageChunkSize);
+		outMessage.resize(offset + chunkSize);
+		if (!readAll(socket, &outMessage[offset], chunkSize))
+			return false;
+	}
+
+	return true;
+}
+
+bool setSocketAddress(sockaddr_un& outAddress, const std::string& socketPath)
+{
+	std::memset(&outAddress, 0, sizeof(outAddress));
+	outAddress.sun_family = AF_UNIX;
+	if (socketPath.size() >= sizeof(outAddress.sun_path))
+	{
+		std::fprintf(stderr, "error: Socket path '%s' is too long.\n", socketPath.c_str());
+		return false;
+	}
+
+	std::memcpy(outAddress.sun_path, socketPath.c_str(), socketPath.size() + 1);
+	return true;
+}
+
+std::string writeRequestHeader(const Request& request)
+{
+	rapidjson::StringBuffer buffer;
+	rapidjson::Writer<rapidjson::StringBuffer> writer(buffer);
+	writer.StartObject();
+	writer.Key("configName");
+	writer.String(request.configName.c_str());
+	writer.Key("configDir");
+	writer.String(request.configDir.c_str());
+	writer.Key("output");
+	writer.String(request.output.c_str());
+	writer.Key("stats");
+	writer.Bool(request.printStats);
+	writer.Key("compact");
+	writer.Bool(request.compact);
+	writer.Key("container");
+	writer.Bool(request.container);
+	writer.Key("compress");
+	writer.Bool(request.compress);
+	writer.Key("lods");
+	writer.StartArray();
+	for (double ratio : request.lodRatios)
+		writer.Double(ratio);
+	writer.EndArray();
+	writer.Key("lodPosition");
+	writer.String(request.lodPosition.c_str());
+	writer.EndObject();
+	return buffer.GetString();
+}
+
+bool readRequestHeader(Request& outRequest, const std::string& header)
+{
+	rapidjson::Document document;
+	document.Parse(header.c_str());
+	if (document.HasParseError() || !document.IsObject())
+		return false;
+
+	auto configName = document.FindMember("configName");
+	auto configDir = document.FindMember("configDir");
+	auto output = document.FindMember("output");
+	auto stats = document.FindMember("stats");
+	auto compact = document.FindMember("compact");
+	auto container = document.FindMember("container");
+	auto compress = document.FindMember("compress");
+	auto lods = document.FindMember("lods");
+	auto lodPosition = document.FindMember("lodPosition");
+	if (configName == document.MemberEnd() || !configName->value.IsString() ||
+		configDir == document.MemberEnd() || !configDir->value.IsString() ||
+		output == document.MemberEnd() || !output->value.IsString() ||
+		stats == document.MemberEnd() || !stats->value.IsBool() ||
+		compact == document.MemberEnd() || !compact->value.IsBool() ||
+		container == document.MemberEnd() || !container->value.IsBool() ||
+		compress == document.MemberEnd() || !compress->value.IsBool() ||
+		lods == document.MemberEnd() || !lods->value.IsArray() ||
+		lodPosition == document.MemberEnd() || !lodPosition->value.IsString())
+	{
+		return false;
+	}
+
+	outRequest.lodRatios.clear();
+	for (unsigned int i = 0; i < lods->value.Size(); ++i)
+	{
+		const rapidjson::Value& ratio = lods->value[i];
+		if (!ratio.IsNumber())
+			return false;
+		outRequest.lodRatios.push_back(ratio.GetDouble());
+	}
+
+	outRequest.configName = configName->value.GetString();
+	outRequest.configDir = configDir->value.GetString();
+	outRequest.output = output->value.GetString();
+	outRequest.printStats = stats->value.GetBool();
+	outRequest.compact = compact->value.GetBool();
+	outRequest.container = container->value.GetBool();
+	outRequest.compress = compress->value.GetBool();
+	outRequest.lodPosition = lodPosition->value.GetString();
+	return true;
+}
+
+std::string writeResponseHeader(const Response& response)
+{
+	rapidjson::StringBuffer buffer;
+	rapidjson::Writer<rapidjson::StringBuffer> writer(buffer);
+	writer.StartObject();
+	writer.Key("success");
+	writer.Bool(response.success);
+	writer.Key("errors");
+	writer.String(response.errors.c_str());
+	writer.EndObject();
+	return buffer.GetString();
+}
+
+bool readResponseHeader(Response& outResponse, const std::string& header)
+{
+	rapidjson::Document document;
+	document.Parse(header.c_str());
+	if (document.HasParseError() || !document.IsObject())
+		return false;
+
+	auto success = document.FindMember("success");
+	auto errors = document.FindMember("errors");
+	if (success == document.MemberEnd() || !success->value.IsBool() ||
+		errors == document.MemberEnd() || !errors->value.IsString())
+	{
+		return false;
+	}
+
+	outResponse.success = success->value.GetBool();
+	outResponse.errors = errors->value.GetString();
+	return true;
+}
+
+void handleConnection(Connection& connection, const RequestHandler& handler)
+{
+	int socket = connection.socket;
+	std::string header;
+	Request request;
+	Response response;
+	while (readMessage(header, socket, maxRequestHeaderSize) &&
+		readMessage(request.config, socket, maxMessageSize))
+	{
+		response = Response();
+		if (readRequestHeader(request, header))
+			handler(request, response);
+		else
+			response.errors = "error: Invalid request header.\n";
+
+		if (!writeMessage(socket, writeResponseHeader(response)) ||
+			!writeMessage(socket, response.result))
+		{
+			break;
+		}
+	}
+
+	connection.finished = true;
+}
+
+void finishConnection(Connection& connection)
+{
+	connection.thread.join();
+	::close(connection.socket);
+}
+
+} // namespace
+
+bool isSupported()
+{
+	return true;
+}
+
+bool serve(const std::string& socketPath, const RequestHandler& handler,
+	const std::atomic<bool>& stop)
+{
+	sockaddr_un address;
+	if (!setSocketAddress(address, socketPath))
+		return false;
+
+	// Remove a socket left behind by a previous server, but not other files.
+	struct stat fileStat;
+	if (lstat(socketPath.c_str(), &fileStat) == 0 && S_ISSOCK(fileStat.st_mode))
+		unlink(socketPath.c_str());
+
+	int listenSocket = socket(AF_UNIX, SOCK_STREAM, 0);
+	if (listenSocket < 0 ||
+		bind(listenSocket, reinterpret_cast<const sockaddr*>(&address), sizeof(address)) != 0 ||
+		listen(listenSocket, SOMAXCONN) != 0)
+	{
+		std::fprintf(stderr, "error: Couldn't listen on socket '%s'.\n", socketPath.c_str());
+		if (listenSocket >= 0)
+			::close(listenSocket);
+		return false;
+	}
+
+	bool success = true;
+	std::vector<std::unique_ptr<Connection>> connections;
+	while (!stop)
+	{
+		for (auto it = connections.begin(); it != connections.end();)
+		{
+			if ((*it)->finished)
+			{
+				finishConnection(**it);
+				it = connections.erase(it);
+			}
+			else
+				++it;
+		}
+
+		pollfd pollInfo;
+		pollInfo.fd = listenSocket;
+		pollInfo.events = POLLIN;
+		pollInfo.revents = 0;
+		int pollResult = poll(&pollInfo, 1, pollTimeoutMs);
+		if (pollResult == 0 || (pollResult < 0 && errno == EINTR))
+			continue;
+
+		int clientSocket = pollResult > 0 ? accept(listenSocket, nullptr, nullptr) : -1;
+		if (clientSocket < 0)
+		{
+			if (errno == EINTR || errno == ECONNABORTED)
+				continue;
+
+			// Running out of file descriptors or memory is temporary, such as when under heavy
+			// load, so wait for connections to finish.
+			if (errno == EMFILE || errno == ENFILE || errno == ENOBUFS || errno == ENOMEM)
+			{
+				std::this_thread::sleep_for(std::chrono::milliseconds(pollTimeoutMs));
+				continue;
+			}
+
+			std::fprintf(stderr, "error: Couldn't accept connection on socket '%s'.\n",
+				socketPath.c_str());
+			success = false;
+			break;
+		}
+
+		disableSigPipe(clientSocket);
+		std::unique_ptr<Connection> connection(new Connection);
+		connection->socket = clientSocket;
+		connection->thread = std::thread(&handleConnection, std::ref(*connection),
+			std::cref(handler));
+		connections.push_back(std::move(connection));
+	}
+
+	::close(listenSocket);
+	unlink(socketPath.c_str());
+
+	// Stop reading requests, but allow the requests in progress to write their responses.
+	for (const std::unique_ptr<Connection>& connection : connections)
+		shutdown(connection->socket, SHUT_RD);
+	for (const std::unique_ptr<Connection>& connection : connections)
+		finishConnection(*connection);
+	return success;
+}
+
+Client::~Client()
+{
+	close();
+}
+
+bool Client::connect(const std::string& socketPath)
+{
+	close();
+	sockaddr_un address;
+	if (!setSocketAddress(address, socketPath))
+		return false;
+
+	m_socket = socket(AF_UNIX, SOCK_STREAM, 0);
+	if (m_socket < 0 ||
+		::connect(m_socket, reinterpret_cast<const sockaddr*>(&address), sizeof(address)) != 0)
+	{
+		std::fprintf(stderr, "error: Couldn't connect to socket '%s'.\n", socketPath.c_str());
+		close();
+		return false;
+	}
+
+	disableSigPipe(m_socket);
+	return true;
+}
+
+bool Client::send(Response& outResponse, const Request& request)
+{
+	std::string header;
+	if (m_socket < 0 || !writeMessage(m_socket, writeRequestHeader(request)) ||
+		!writeMessage(m_socket, request.config) ||
+		!readMessage(header, m_socket, maxMessageSize) ||
+		!readResponseHeader(outResponse, header) ||
+		!readMessage(outResponse.result, m_socket, maxMessageSize))
+	{
+		std::fprintf(stderr, "error: Couldn't communicate with the server.\n");
+		return false;
+	}
+
+	return true;
+}
+
+void Client::close()
+{
+	if (m_socket >= 0)
+	{
+		::close(m_socket);
+		m_socket = -1;
+	}
+}
+
+#else
+
+bool isSupported()
+{
+	return false;
+}
+
+bool serve(const std::string&, const RequestHandler&, const std::atomic<bool>&)
+{
+	std::fprintf(stderr, "error: Server mode isn't supported on this platform.\n");
+	return false;
+}
+
+Client::~Client()
+{
+}
+
+bool Client::connect(const std::string&)
+{
+	std::fprintf(stderr, "error: Server mode isn't supported on this platform.\n");
+	return false;
+}
+
+bool Client::send(Response&, const Request&)
+{
+	return false;
+}
+
+void Client::close()
+{
+}
+
+#endif
+
+} // namespace server
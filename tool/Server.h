@@ -0,0 +1,83 @@
+/*
+ * Copyright 2026 Aaron Barany
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <VFC/Config.h>
+#include <atomic>
+#include <functional>
+#include <string>
+#include <vector>
+
+// Local server to process inputs in a persistent process, avoiding the startup cost for each input.
+// Requests are sent over a Unix domain socket, with each message prefixed by its size. A request
+// is a JSON header with the options, limited to 64 KiB, followed by the config JSON. The response
+// is a JSON header with the success and errors followed by the result JSON. Multiple requests may
+// be sent over the same connection. Only supported on platforms with Unix domain sockets.
+namespace server
+{
+
+// The config name is used for error messages. Relative paths within the config are relative to
+// configDir.
+struct Request
+{
+	std::string configName;
+	std::string configDir;
+	std::string output;
+	bool printStats = false;
+	bool compact = false;
+	bool container = false;
+	bool compress = false;
+	std::vector<double> lodRatios;
+	std::string lodPosition;
+	std::string config;
+};
+
+struct Response
+{
+	bool success = false;
+	std::string errors;
+	std::string result;
+};
+
+// Called on a separate thread for each connection.
+using RequestHandler = std::function<void(const Request& request, Response& response)>;
+
+bool isSupported();
+
+// Runs the server until stop is set, which may be done from a signal handler. Once stopped, no new
+// requests are read, and the requests in progress are finished before returning. Returns true if
+// the server was stopped without error.
+bool serve(const std::string& socketPath, const RequestHandler& handler,
+	const std::atomic<bool>& stop);
+
+class Client
+{
+public:
+	Client() = default;
+	Client(const Client&) = delete;
+	Client& operator=(const Client&) = delete;
+	~Client();
+
+	bool connect(const std::string& socketPath);
+	bool send(Response& outResponse, const Request& request);
+	void close();
+
+private:
+	int m_socket = -1;
+};
+
+} // namespace server
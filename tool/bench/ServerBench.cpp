@@ -0,0 +1,172 @@
+/*
+ * Copyright 2026 Aaron Barany
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "Path.h"
+#include "Server.h"
+#include <benchmark/benchmark.h>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <signal.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+namespace
+{
+
+const char* socketPath = "vfc_tool_bench.sock";
+
+// Grid of positions with shared vertices, written next to a config file to convert it.
+std::string writeGridInput(std::uint32_t size)
+{
+	std::string baseName = "vfc_tool_bench." + std::to_string(size);
+	std::vector<float> positions;
+	for (std::uint32_t y = 0; y <= size; ++y)
+	{
+		for (std::uint32_t x = 0; x <= size; ++x)
+			positions.insert(positions.end(), {static_cast<float>(x), 0.0f, static_cast<float>(y)});
+	}
+
+	std::vector<std::uint32_t> indices;
+	for (std::uint32_t y = 0; y < size; ++y)
+	{
+		for (std::uint32_t x = 0; x < size; ++x)
+		{
+			std::uint32_t i = y*(size + 1) + x;
+			indices.insert(indices.end(),
+				{i, i + 1, i + size + 1, i + 1, i + size + 2, i + size + 1});
+		}
+	}
+
+	std::ofstream(baseName + ".positions.dat", std::ios_base::binary).write(
+		reinterpret_cast<const char*>(positions.data()),
+		static_cast<std::streamsize>(positions.size()*sizeof(float)));
+	std::ofstream(baseName + ".indices.dat", std::ios_base::binary).write(
+		reinterpret_cast<const char*>(indices.data()),
+		static_cast<std::streamsize>(indices.size()*sizeof(std::uint32_t)));
+
+	std::string configName = baseName + ".json";
+	std::ofstream config(configName);
+	config <<
+		"{\n"
+		"  \"vertexFormat\": [[{\"name\": \"position\", \"layout\": \"X16Y16Z16\", "
+			"\"type\": \"Float\"}]],\n"
+		"  \"indexType\": \"UInt16\",\n"
+		"  \"vertexStreams\": [{\n"
+		"    \"vertexFormat\": [{\"name\": \"position\", \"layout\": \"X32Y32Z32\", "
+			"\"type\": \"Float\"}],\n"
+		"    \"vertexData\": \"" << baseName << ".positions.dat\",\n"
+		"    \"indexType\": \"UInt32\",\n"
+		"    \"indexData\": \"" << baseName << ".indices.dat\"\n"
+		"  }]\n"
+		"}\n";
+	return configName;
+}
+
+// Server process shared by the benchmarks, stopped on exit.
+class ServerProcess
+{
+public:
+	~ServerProcess()
+	{
+		if (m_pid > 0)
+		{
+			kill(m_pid, SIGTERM);
+			waitpid(m_pid, nullptr, 0);
+		}
+	}
+
+	bool connect(server::Client& client)
+	{
+		if (m_pid <= 0)
+		{
+			m_pid = fork();
+			if (m_pid == 0)
+			{
+				execl(VFC_TOOL_PATH, VFC_TOOL_PATH, "--serve", socketPath, nullptr);
+				_exit(1);
+			}
+		}
+
+		// Wait for the server to start listening.
+		for (int i = 0; i < 1000; ++i)
+		{
+			if (access(socketPath, F_OK) == 0 && client.connect(socketPath))
+				return true;
+			std::this_thread::sleep_for(std::chrono::milliseconds(10));
+		}
+		return false;
+	}
+
+private:
+	pid_t m_pid = -1;
+};
+
+ServerProcess serverProcess;
+
+void BM_ProcessPerInput(benchmark::State& state)
+{
+	std::string configName = writeGridInput(static_cast<std::uint32_t>(state.range(0)));
+	std::string command = VFC_TOOL_PATH " -i " + configName + " > /dev/null";
+	for (auto _ : state)
+	{
+		if (std::system(command.c_str()) != 0)
+		{
+			state.SkipWithError("Running vfc failed.");
+			break;
+		}
+	}
+}
+
+void BM_ServerRequest(benchmark::State& state)
+{
+	std::string configName = writeGridInput(static_cast<std::uint32_t>(state.range(0)));
+	server::Client client;
+	if (!serverProcess.connect(client))
+	{
+		state.SkipWithError("Couldn't connect to the server.");
+		return;
+	}
+
+	// Include reading the config in the time, as the client would do for each input.
+	server::Request request;
+	request.configName = configName;
+	request.configDir = path::makeAbsolute(".");
+	server::Response response;
+	for (auto _ : state)
+	{
+		std::ifstream stream(configName);
+		request.config.assign(std::istreambuf_iterator<char>(stream),
+			std::istreambuf_iterator<char>());
+		if (!client.send(response, request) || !response.success)
+		{
+			state.SkipWithError("Server request failed.");
+			break;
+		}
+		benchmark::DoNotOptimize(response.result.data());
+	}
+}
+
+} // namespace
+
+BENCHMARK(BM_ProcessPerInput)->Arg(1)->Arg(10)->Arg(100)->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_ServerRequest)->Arg(1)->Arg(10)->Arg(100)->Unit(benchmark::kMicrosecond);
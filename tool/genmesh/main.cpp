@@ -0,0 +1,357 @@
+/*
+ * Copyright 2026 Aaron Barany
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "MeshGenerator.h"
+#include "Path.h"
+
+#include <VFC/InputContainer.h>
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+
+#if VFC_WINDOWS
+#include <string.h>
+#define strcasecmp(x, y) _stricmp(x, y)
+#else
+#include <strings.h>
+#endif
+
+namespace
+{
+
+void printHelp(const char* argv0)
+{
+	std::printf("Usage: %s -o <dir> [OPTIONS]\n\n", path::getFileName(argv0).c_str());
+	std::printf("Generates a synthetic mesh as input for vfc, for testing and benchmarking.\n");
+
+	std::printf("\nOptions:\n");
+	std::printf("-h, --help                   Prints this help message and exits.\n");
+	std::printf("-o, --output <dir>           Path to a directory to output the input JSON and\n");
+	std::printf("                             data files to. The directory will be created if\n");
+	std::printf("                             it doesn't exist.\n");
+	std::printf("-n, --name <name>            The base name of the output files. Defaults to\n");
+	std::printf("                             mesh.\n");
+	std::printf("-s, --shape <shape>          The shape of the mesh: Grid, Sphere, or Noise.\n");
+	std::printf("                             Defaults to Grid.\n");
+	std::printf("-p, --primitive-type <type>  The primitive type. Defaults to TriangleList.\n");
+	std::printf("-c, --index-count <count>    The approximate number of indices. Defaults to\n");
+	std::printf("                             6000.\n");
+	std::printf("--split-indices              Use separate position, normal, and texCoord\n");
+	std::printf("                             streams with their own indices.\n");
+	std::printf("--duplicate-ratio <ratio>    Fraction of indices in the range [0, 1] that\n");
+	std::printf("                             reference duplicate vertices. Defaults to 0.\n");
+	std::printf("--restart-density <density>  Probability in the range [0, 1] of a primitive\n");
+	std::printf("                             restart after each strip or fan primitive.\n");
+	std::printf("                             Defaults to 0.\n");
+	std::printf("--input-index-type <type>    The index type of the generated data: UInt16 or\n");
+	std::printf("                             UInt32. Defaults to UInt32.\n");
+	std::printf("--output-index-type <type>   The index type for vfc to output: UInt16, UInt32,\n");
+	std::printf("                             or None. Defaults to UInt32.\n");
+	std::printf("--seed <seed>                The seed for random values. Defaults to 0.\n");
+	std::printf("--container                  Write a binary input container to\n");
+	std::printf("                             <dir>/<name>.vfci rather than the input JSON and\n");
+	std::printf("                             data files.\n");
+
+	std::printf("\nThe input JSON is written to <dir>/<name>.json, which converts the position\n");
+	std::printf("to X32Y32Z32 Float, the normal to W2X10Y10Z10 SNorm, and the texCoord to\n");
+	std::printf("X16Y16 UNorm.\n");
+}
+
+bool parseIndexType(vfc::IndexType& outType, const char* str, bool allowNone)
+{
+	if (strcasecmp(str, "UInt16") == 0)
+		outType = vfc::IndexType::UInt16;
+	else if (strcasecmp(str, "UInt32") == 0)
+		outType = vfc::IndexType::UInt32;
+	else if (allowNone && strcasecmp(str, "None") == 0)
+		outType = vfc::IndexType::NoIndices;
+	else
+		return false;
+	return true;
+}
+
+bool parseShape(vfc::MeshShape& outShape, const char* str)
+{
+	if (strcasecmp(str, "Grid") == 0)
+		outShape = vfc::MeshShape::Grid;
+	else if (strcasecmp(str, "Sphere") == 0)
+		outShape = vfc::MeshShape::Sphere;
+	else if (strcasecmp(str, "Noise") == 0)
+		outShape = vfc::MeshShape::Noise;
+	else
+		return false;
+	return true;
+}
+
+bool parsePrimitiveType(vfc::PrimitiveType& outType, const char* str)
+{
+	for (unsigned int i = 0; i < vfc::primitiveTypeCount; ++i)
+	{
+		auto type = static_cast<vfc::PrimitiveType>(i);
+		if (strcasecmp(str, vfc::primitiveTypeName(type)) == 0)
+		{
+			outType = type;
+			return true;
+		}
+	}
+
+	return false;
+}
+
+bool parseNumber(double& outValue, const char* str)
+{
+	char* end;
+	outValue = std::strtod(str, &end);
+	return end != str && *end == 0;
+}
+
+bool parseInteger(std::uint64_t& outValue, const char* str)
+{
+	char* end;
+	outValue = std::strtoull(str, &end, 10);
+	return end != str && *end == 0 && *str != '-';
+}
+
+const char* indexTypeName(vfc::IndexType type)
+{
+	switch (type)
+	{
+		case vfc::IndexType::UInt16:
+			return "UInt16";
+		case vfc::IndexType::UInt32:
+			return "UInt32";
+		default:
+			return nullptr;
+	}
+}
+
+bool writeFile(const std::vector<std::uint8_t>& data, const std::string& fileName)
+{
+	std::ofstream stream(fileName,
+		std::ios_base::out | std::ios_base::trunc | std::ios_base::binary);
+	if (!stream.is_open())
+		return false;
+
+	stream.write(reinterpret_cast<const char*>(data.data()), data.size());
+	return stream.good();
+}
+
+void writeVertexFormat(std::ostream& stream, const vfc::VertexFormat& vertexFormat,
+	const char* indent)
+{
+	stream << "[\n";
+	for (std::size_t i = 0; i < vertexFormat.size(); ++i)
+	{
+		const vfc::VertexElement& element = vertexFormat[i];
+		stream << indent << "\t{\"name\": \"" << element.name << "\", \"layout\": \"" <<
+			vfc::elementLayoutName(element.layout) << "\", \"type\": \"" <<
+			vfc::elementTypeName(element.type) << "\"}" <<
+			(i == vertexFormat.size() - 1 ? "\n" : ",\n");
+	}
+	stream << indent << "]";
+}
+
+vfc::VertexFormat createOutputFormat()
+{
+	vfc::VertexFormat outputFormat;
+	outputFormat.appendElement("position", vfc::ElementLayout::X32Y32Z32,
+		vfc::ElementType::Float);
+	outputFormat.appendElement("normal", vfc::ElementLayout::W2X10Y10Z10,
+		vfc::ElementType::SNorm);
+	outputFormat.appendElement("texCoord", vfc::ElementLayout::X16Y16, vfc::ElementType::UNorm);
+	return outputFormat;
+}
+
+bool writeContainer(const vfc::GeneratedMesh& mesh, const std::string& outputDir,
+	const std::string& name, vfc::IndexType outputIndexType)
+{
+	vfc::InputContainerWriter writer(std::vector<vfc::VertexFormat>{createOutputFormat()},
+		outputIndexType, mesh.primitiveType);
+	for (const vfc::GeneratedStream& stream : mesh.streams)
+	{
+		writer.addVertexStream(stream.vertexFormat, stream.vertices.data(),
+			static_cast<std::uint32_t>(stream.vertices.size()/stream.vertexFormat.stride()),
+			mesh.indexType, stream.indices.data(),
+			static_cast<std::uint32_t>(stream.indices.size()/vfc::indexSize(mesh.indexType)));
+	}
+
+	std::string containerPath = path::join(outputDir, name + ".vfci");
+	std::vector<std::uint8_t> data(writer.getSize());
+	if (data.empty() || !writer.write(data.data(), data.size()) ||
+		!writeFile(data, containerPath))
+	{
+		std::fprintf(stderr, "error: Couldn't write input container '%s'.\n",
+			containerPath.c_str());
+		return false;
+	}
+
+	return true;
+}
+
+bool writeMesh(const vfc::GeneratedMesh& mesh, const std::string& outputDir,
+	const std::string& name, vfc::IndexType outputIndexType)
+{
+	for (std::size_t i = 0; i < mesh.streams.size(); ++i)
+	{
+		const vfc::GeneratedStream& stream = mesh.streams[i];
+		std::string baseName = name + "." + std::to_string(i);
+		std::string vertexPath = path::join(outputDir, baseName + ".vertices.dat");
+		std::string indexPath = path::join(outputDir, baseName + ".indices.dat");
+		if (!writeFile(stream.vertices, vertexPath) || !writeFile(stream.indices, indexPath))
+		{
+			std::fprintf(stderr, "error: Couldn't write data files for '%s'.\n",
+				baseName.c_str());
+			return false;
+		}
+	}
+
+	std::string jsonPath = path::join(outputDir, name + ".json");
+	std::ofstream stream(jsonPath, std::ios_base::out | std::ios_base::trunc);
+	if (!stream.is_open())
+	{
+		std::fprintf(stderr, "error: Couldn't write input file '%s'.\n", jsonPath.c_str());
+		return false;
+	}
+
+	vfc::VertexFormat outputFormat = createOutputFormat();
+	stream << "{\n\t\"vertexFormat\": [\n\t\t";
+	writeVertexFormat(stream, outputFormat, "\t\t");
+	stream << "\n\t],\n";
+	const char* outputIndexName = indexTypeName(outputIndexType);
+	if (outputIndexName)
+		stream << "\t\"indexType\": \"" << outputIndexName << "\",\n";
+	stream << "\t\"primitiveType\": \"" << vfc::primitiveTypeName(mesh.primitiveType) << "\",\n";
+	stream << "\t\"vertexStreams\": [\n";
+	for (std::size_t i = 0; i < mesh.streams.size(); ++i)
+	{
+		std::string baseName = name + "." + std::to_string(i);
+		stream << "\t\t{\n\t\t\t\"vertexFormat\": ";
+		writeVertexFormat(stream, mesh.streams[i].vertexFormat, "\t\t\t");
+		stream << ",\n\t\t\t\"vertexData\": \"" << baseName << ".vertices.dat\",\n";
+		stream << "\t\t\t\"indexType\": \"" << indexTypeName(mesh.indexType) << "\",\n";
+		stream << "\t\t\t\"indexData\": \"" << baseName << ".indices.dat\"\n";
+		stream << "\t\t}" << (i == mesh.streams.size() - 1 ? "\n" : ",\n");
+	}
+	stream << "\t]\n}\n";
+
+	if (!stream.good())
+	{
+		std::fprintf(stderr, "error: Couldn't write input file '%s'.\n", jsonPath.c_str());
+		return false;
+	}
+
+	return true;
+}
+
+} // namespace
+
+int main(int argc, const char** argv)
+{
+	std::string output;
+	std::string name = "mesh";
+	vfc::MeshOptions options;
+	vfc::IndexType outputIndexType = vfc::IndexType::UInt32;
+	bool container = false;
+	for (int i = 1; i < argc; ++i)
+	{
+		const char* arg = argv[i];
+		if (std::strcmp(arg, "-h") == 0 || std::strcmp(arg, "--help") == 0)
+		{
+			printHelp(argv[0]);
+			return 0;
+		}
+		else if (std::strcmp(arg, "--split-indices") == 0)
+		{
+			options.splitIndices = true;
+			continue;
+		}
+		else if (std::strcmp(arg, "--container") == 0)
+		{
+			container = true;
+			continue;
+		}
+
+		if (i == argc - 1)
+		{
+			std::fprintf(stderr, "error: Unknown argument or missing value for '%s'.\n", arg);
+			return 1;
+		}
+
+		const char* value = argv[++i];
+		bool valid = true;
+		if (std::strcmp(arg, "-o") == 0 || std::strcmp(arg, "--output") == 0)
+			output = value;
+		else if (std::strcmp(arg, "-n") == 0 || std::strcmp(arg, "--name") == 0)
+			name = value;
+		else if (std::strcmp(arg, "-s") == 0 || std::strcmp(arg, "--shape") == 0)
+			valid = parseShape(options.shape, value);
+		else if (std::strcmp(arg, "-p") == 0 || std::strcmp(arg, "--primitive-type") == 0)
+			valid = parsePrimitiveType(options.primitiveType, value);
+		else if (std::strcmp(arg, "-c") == 0 || std::strcmp(arg, "--index-count") == 0)
+			valid = parseInteger(options.indexCount, value);
+		else if (std::strcmp(arg, "--duplicate-ratio") == 0)
+			valid = parseNumber(options.duplicateRatio, value);
+		else if (std::strcmp(arg, "--restart-density") == 0)
+			valid = parseNumber(options.restartDensity, value);
+		else if (std::strcmp(arg, "--input-index-type") == 0)
+			valid = parseIndexType(options.indexType, value, false);
+		else if (std::strcmp(arg, "--output-index-type") == 0)
+			valid = parseIndexType(outputIndexType, value, true);
+		else if (std::strcmp(arg, "--seed") == 0)
+		{
+			std::uint64_t seed;
+			valid = parseInteger(seed, value) && seed <= 0xFFFFFFFF;
+			options.seed = static_cast<std::uint32_t>(seed);
+		}
+		else
+		{
+			std::fprintf(stderr, "error: Unknown argument '%s'.\n", arg);
+			return 1;
+		}
+
+		if (!valid)
+		{
+			std::fprintf(stderr, "error: Invalid value '%s' for %s.\n", value, arg);
+			return 1;
+		}
+	}
+
+	if (output.empty())
+	{
+		std::fprintf(stderr, "error: --output is required.\n");
+		return 1;
+	}
+
+	vfc::GeneratedMesh mesh;
+	std::string error;
+	if (!vfc::generateMesh(mesh, options, error))
+	{
+		std::fprintf(stderr, "error: %s\n", error.c_str());
+		return 1;
+	}
+
+	if (!path::createDirectories(output))
+	{
+		std::fprintf(stderr, "error: Couldn't create output path '%s'.\n", output.c_str());
+		return 1;
+	}
+
+	if (container)
+		return writeContainer(mesh, output, name, outputIndexType) ? 0 : 1;
+	return writeMesh(mesh, output, name, outputIndexType) ? 0 : 1;
+}
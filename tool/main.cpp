@@ -1,5 +1,5 @@
 /*
- * Copyright 2020-2021 Aaron Barany
+ * Copyright 2020-2026 Aaron Barany
  *
  * Licensed under the Apache License, Version 2.0 (the "License");
  * you may not use this file except in compliance with the License.
@@ -14,28 +14,39 @@
  * limitations under the License.
  */
 
+#include <VFC/Compression.h>
+#include <VFC/Container.h>
 #include <VFC/Converter.h>
+#include <VFC/Simplifier.h>
+#include <VFC/Trace.h>
 
-#include "Base64.h"
 #include "ConfigFile.h"
+#include "ContentHash.h"
+#include "ConversionCache.h"
+#include "InputData.h"
+#include "JobPool.h"
+#include "OutputFile.h"
 #include "Path.h"
 #include "ResultFile.h"
+#include "Server.h"
 
+#include <rapidjson/document.h>
+
+#include <atomic>
+#include <csignal>
+#include <cstdarg>
 #include <cstdio>
+#include <cstdlib>
 #include <cstring>
 #include <fstream>
 #include <iostream>
-
-#include <errno.h>
-#include <sys/stat.h>
+#include <iterator>
+#include <memory>
+#include <mutex>
 
 #if VFC_WINDOWS
-#include <direct.h>
-#include <string.h>
-#define mkdir(path, mode) _mkdir(path)
-#define strncasecmp(x, y, n) _strnicmp(x, y, n)
-#else
-#include <string.h>
+#include <fcntl.h>
+#include <io.h>
 #endif
 
 void printHelp(const char* argv0)
@@ -45,12 +56,56 @@ void printHelp(const char* argv0)
 
 	std::printf("\nOptions:\n");
 	std::printf("-h, --help          Prints this help message and exits.\n");
-	std::printf("-i, --input <file>  Path to a JSON file that defines the input to process. If\n");
-	std::printf("                    not provided, input will be read from stdin.\n");
+	std::printf("-i, --input <file>  Path to a JSON file or binary input container that defines\n");
+	std::printf("                    the input to process. If not provided, input will be read\n");
+	std::printf("                    from stdin.\n");
 	std::printf("-o, --output <dir>  Path to a directory to output the results to. The directory\n");
 	std::printf("                    will be created if it doesn't exist. If not provided, data\n");
 	std::printf("                    will be embedded directly in the output JSON with base64\n");
 	std::printf("                    encoding.\n");
+	std::printf("--batch <file>      Path to a JSON lines file with an input to process on each\n");
+	std::printf("                    line. Each line is an object with an 'input' path to the\n");
+	std::printf("                    input JSON and an optional 'output' directory. The output\n");
+	std::printf("                    is a compact JSON result on each line, or null if the input\n");
+	std::printf("                    failed. May not be used with --input or --output.\n");
+	std::printf("-j, --jobs <count>  The number of inputs to process at the same time with\n");
+	std::printf("                    --batch. Defaults to 1.\n");
+	std::printf("--memory-budget <MiB>\n");
+	std::printf("                    The estimated memory that may be used by inputs processed\n");
+	std::printf("                    at the same time with --jobs or --serve. Defaults to half\n");
+	std::printf("                    of the physical memory.\n");
+	std::printf("--serve <socket>    Runs a server that processes inputs sent to a Unix domain\n");
+	std::printf("                    socket until interrupted. This avoids the startup cost for\n");
+	std::printf("                    each input. May not be used with --input, --output, or\n");
+	std::printf("                    --batch.\n");
+	std::printf("--connect <socket>  Sends the input to a server started with --serve rather\n");
+	std::printf("                    than processing it in this process.\n");
+	std::printf("--cache-dir <dir>   Path to a directory to cache conversion results. Inputs\n");
+	std::printf("                    with the same config and input data re-use the cached\n");
+	std::printf("                    result rather than converting again. The cache may be\n");
+	std::printf("                    shared between processes. Not used with --stats.\n");
+	std::printf("--cache-size <MiB>  The maximum size of the cache, evicting the least recently\n");
+	std::printf("                    used results when exceeded. Defaults to 1024.\n");
+	std::printf("--stats             Adds statistics for the conversion to the output JSON.\n");
+	std::printf("--compact           Writes the output JSON without whitespace.\n");
+	std::printf("--container         Writes the vertex and index data to a single binary\n");
+	std::printf("                    container file named mesh.vfc in the output directory\n");
+	std::printf("                    rather than a data file for each buffer. Requires\n");
+	std::printf("                    --output, or an output for each input with --batch.\n");
+	std::printf("--compress          Compresses the vertex and index data for each buffer, which\n");
+	std::printf("                    may be decompressed with vfc::decompress(). May not be used\n");
+	std::printf("                    with --container.\n");
+	std::printf("--lod <ratio>[,<ratio>...]\n");
+	std::printf("                    Generates simplified index buffers for levels of detail,\n");
+	std::printf("                    keeping the ratio of triangles for each. Ratios are in the\n");
+	std::printf("                    range (0, 1] in decreasing order. Requires the TriangleList\n");
+	std::printf("                    primitive type and may not be used with --container.\n");
+	std::printf("--lod-position <name>\n");
+	std::printf("                    The name of the position element to simplify with --lod.\n");
+	std::printf("                    Defaults to 'position'.\n");
+	std::printf("--trace <file>      Writes a trace of the time spent in each stage to a file in\n");
+	std::printf("                    the Chrome trace event JSON format. Requires building with\n");
+	std::printf("                    the VFC_ENABLE_TRACING CMake option.\n");
 
 	std::printf("\nInput:\n");
 	std::printf("The primary input is in the form of a JSON configuration. The file has the\n");
@@ -93,6 +148,13 @@ void printHelp(const char* argv0)
 	std::printf("- If the vertexData or indexData string starts with 'base64:', the rest of the\n");
 	std::printf("  string is the base64-encoded data rather than a path to a file.\n");
 
+	std::printf("\nBinary input container:\n");
+	std::printf("The input may instead be a binary input container, as written by\n");
+	std::printf("vfc::InputContainerWriter or 'vfc-genmesh --container'. It holds the same\n");
+	std::printf("information as the JSON configuration with the vertex and index data for each\n");
+	std::printf("vertex stream embedded, and is detected by its 'VFCI' magic number. The data is\n");
+	std::printf("used in place without parsing or opening separate data files.\n");
+
 	std::printf("\nSupported vertex layouts:\n");
 	for (unsigned int i = 0; i < vfc::elementLayoutCount; ++i)
 		std::printf("- %s\n", vfc::elementLayoutName(static_cast<vfc::ElementLayout>(i)));
@@ -118,6 +180,9 @@ void printHelp(const char* argv0)
 
 	std::printf("\nOutput:\n");
 	std::printf("The general output is printed to stdout as JSON with the following layout:\n");
+	std::printf("- container: (set with the --container option) The path to the binary\n");
+	std::printf("  container with the vertex and index data. The vertexData and indexData members\n");
+	std::printf("  are omitted in this case.\n");
 	std::printf("- vertices: The vertex output. It is an array of objects with the following\n");
 	std::printf("  members:\n");
 	std::printf("  - vertexFormat: The verex format that was output. It is an array of objects\n");
@@ -130,6 +195,8 @@ void printHelp(const char* argv0)
 	std::printf("    - maxValue: The maximum vertex value for this element as 4-element array.\n");
 	std::printf("  - vertexStride: The size in bytes of each vertex.\n");
 	std::printf("  - vertexData: The path to a data file or base64 encoded output vertices.\n");
+	std::printf("  - encoding: (set with the --compress option) The encoding of the vertex data,\n");
+	std::printf("    which is 'vfc-compressed'.\n");
 	std::printf("- vertexCount: The number of vertices that were output.\n");
 	std::printf("- indexType: (set if indexType was set on input) The type of the index data.\n");
 	std::printf("- indexBuffers: (set if indexType was set on input) The index buffers that were\n");
@@ -138,87 +205,186 @@ void printHelp(const char* argv0)
 	std::printf("  - baseVertex: The value to add to each index value to get the final vertex\n");
 	std::printf("    index. This can be applied when drawing the mesh.\n");
 	std::printf("  - indexData: The path to a data file or base 64 encoded output indices.\n");
+	std::printf("  - encoding: (set with the --compress option) The encoding of the index data,\n");
+	std::printf("    which is 'vfc-compressed'.\n");
+	std::printf("- lods: (set with the --lod option) The levels of detail. It is an array of\n");
+	std::printf("  objects with the following members:\n");
+	std::printf("  - ratio: The target ratio of triangles that was requested.\n");
+	std::printf("  - error: The approximate distance from the original surface.\n");
+	std::printf("  - indexBuffers: The simplified index buffers, with the same layout as the\n");
+	std::printf("    indexBuffers above and an index buffer for each of the original index\n");
+	std::printf("    buffers. The vertices are shared with the full mesh.\n");
+	std::printf("- stats: (set with the --stats option) Statistics for the conversion, with\n");
+	std::printf("  the time in seconds for each phase and counters for de-duplication.\n");
 
 	std::printf("\nAll output files are placed in the directory provided by the --output command-\n");
 	std::printf("line option.\n");
 }
 
-bool mkdirRecursive(const std::string& directory)
+// State that's re-used between inputs to avoid re-allocating memory when processing a batch.
+// The converter is destroyed before the storage since it may still be validating the input data.
+struct ProcessState
 {
-	std::string parentDir = path::getParentDirectory(directory);
-	if (parentDir == directory)
-		return true;
+	std::string input;
+	std::vector<InputData> storage;
+	std::unique_ptr<vfc::Converter> converter;
+	std::vector<OutputFile> vertexFiles;
+	std::vector<OutputFile> indexFiles;
+	std::vector<std::vector<std::uint8_t>> compressedData;
+	std::unique_ptr<vfc::Simplifier> simplifier;
+	std::vector<LodFileData> lods;
+	std::vector<std::string> lodFileNames;
+	std::vector<std::vector<std::uint8_t>> compressedLodData;
+};
 
-	if (!parentDir.empty() && !mkdirRecursive(parentDir))
-		return false;
+// Options shared between all inputs.
+struct ProcessOptions
+{
+	bool printStats = false;
+	bool compact = false;
+	bool container = false;
+	bool compress = false;
+	std::vector<double> lodRatios;
+	std::string lodPosition = "position";
+	ConversionCache* cache = nullptr;
+};
+
+// The converted data is assumed to be similar in size to the input, with both the staged and final
+// vertices allocated.
+std::uint64_t estimateMemoryUsage(std::uint64_t inputSize)
+{
+	return inputSize*3;
+}
 
-	return mkdir(directory.c_str(), 0755) == 0 || errno == EEXIST;
+void hashVertexFormat(ContentHash& hash, const vfc::VertexFormat& vertexFormat)
+{
+	hash.addValue(static_cast<std::uint64_t>(vertexFormat.size()));
+	for (const vfc::VertexElement& element : vertexFormat)
+	{
+		hash.add(element.name);
+		hash.addValue(static_cast<std::int32_t>(element.layout));
+		hash.addValue(static_cast<std::int32_t>(element.type));
+	}
 }
 
-const char* base64EncodedString(const std::string& dataStr)
+// The input data for each vertex stream is added when setting up the converter.
+void hashConfig(ContentHash& hash, const ConfigFile& configFile)
 {
-	const char* prefix = "base64:";
-	const std::size_t prefixLen = 7;
-	const char* dataCStr = dataStr.c_str();
-	if (strncasecmp(dataCStr, prefix, prefixLen) != 0)
-		return nullptr;
+	hash.addValue(ConversionCache::version);
+	hash.addValue(static_cast<std::uint64_t>(configFile.getVertexFormat().size()));
+	for (const vfc::VertexFormat& vertexFormat : configFile.getVertexFormat())
+		hashVertexFormat(hash, vertexFormat);
+	hash.addValue(static_cast<std::int32_t>(configFile.getIndexType()));
+	hash.addValue(static_cast<std::int32_t>(configFile.getPrimitiveType()));
+	hash.addValue(configFile.getPatchPoints());
+
+	hash.addValue(static_cast<std::uint64_t>(configFile.getTransforms().size()));
+	for (const auto& transform : configFile.getTransforms())
+	{
+		hash.add(transform.first);
+		hash.addValue(static_cast<std::int32_t>(transform.second));
+	}
+
+	hash.addValue(static_cast<std::uint64_t>(configFile.getVertexStreams().size()));
+}
 
-	return dataCStr + prefixLen;
+void hashInputData(ContentHash& hash, const InputData& data)
+{
+	hash.addValue(static_cast<std::uint64_t>(data.size()));
+	hash.add(data.data(), data.size());
 }
 
-bool loadData(std::vector<std::uint8_t>& outData,  const std::string& configFilePath,
-	const std::string& configFileDir, const std::string& dataStr, const char* dataType)
+// Errors are written to stderr unless captured on the current thread, such as for server requests.
+thread_local std::string* capturedErrors = nullptr;
+
+void printError(const char* format, ...)
 {
-	const char* base64Str = base64EncodedString(dataStr);
-	if (base64Str)
+	va_list args;
+	va_start(args, format);
+	if (capturedErrors)
 	{
-		if (!base64::decode(outData, base64Str))
+		va_list sizeArgs;
+		va_copy(sizeArgs, args);
+		int length = std::vsnprintf(nullptr, 0, format, sizeArgs);
+		va_end(sizeArgs);
+		if (length > 0)
 		{
-			std::fprintf(stderr, "%s: error: Invalid base64 encoding for %s data.\n",
-				configFilePath.c_str(), dataType);
-			return false;
+			std::size_t start = capturedErrors->size();
+			capturedErrors->resize(start + static_cast<std::size_t>(length) + 1);
+			std::vsnprintf(&(*capturedErrors)[start], static_cast<std::size_t>(length) + 1,
+				format, args);
+			capturedErrors->resize(start + static_cast<std::size_t>(length));
 		}
-		return true;
 	}
+	else
+		std::vfprintf(stderr, format, args);
+	va_end(args);
+}
+
+void printErrorMessage(const char* message)
+{
+	printError("%s\n", message);
+}
 
-	std::string dataFilePath = path::join(configFileDir, dataStr);
-	std::ifstream stream(dataFilePath, std::ios_base::in | std::ios_base::binary);
-	if (stream.is_open())
+bool loadData(InputData& outData, const std::string& configFilePath,
+	const std::string& configFileDir, const std::string& dataPath,
+	std::vector<std::uint8_t>& decodedData, const char* dataType)
+{
+	// The path is empty when the data was embedded in the config file.
+	if (dataPath.empty())
 	{
-		outData.insert(outData.end(), std::istreambuf_iterator<char>(stream), {});
-		if (stream.good() || stream.eof())
-			return true;
+		outData.setData(std::move(decodedData));
+		return true;
 	}
 
-	std::fprintf(stderr, "%s: error: Couldn't read %s data file '%s'.\n",
+	std::string dataFilePath = path::join(configFileDir, dataPath);
+	VFC_TRACE_SCOPE_DETAIL("loadData", dataFilePath);
+	if (outData.loadFile(dataFilePath))
+		return true;
+
+	printError("%s: error: Couldn't read %s data file '%s'.\n",
 		configFilePath.c_str(), dataType, dataFilePath.c_str());
 	return false;
 }
 
-bool setupConverter(vfc::Converter& converter, const ConfigFile& configFile,
+bool setupConverter(vfc::Converter& converter, ConfigFile& configFile,
 	const std::string& configFilePath, const std::string& configFileDir,
-	std::vector<std::vector<std::uint8_t>>& storage)
+	std::vector<InputData>& storage, ContentHash* hash)
 {
-	for (const ConfigFile::VertexStream& vertexStream : configFile.getVertexStreams())
+	for (ConfigFile::VertexStream& vertexStream : configFile.getVertexStreams())
 	{
-		std::vector<std::uint8_t> vertexData;
-		if (!loadData(vertexData, configFilePath, configFileDir, vertexStream.vertexData, "vertex"))
+		// Data within an input container is used in place.
+		InputData vertexData;
+		if (vertexStream.containerVertexData)
+		{
+			vertexData.setView(vertexStream.containerVertexData,
+				vertexStream.containerVertexDataSize);
+		}
+		else if (!loadData(vertexData, configFilePath, configFileDir, vertexStream.vertexData,
+				vertexStream.decodedVertexData, "vertex"))
+		{
 			return false;
+		}
 
 		if (vertexData.size() % vertexStream.vertexFormat.stride() != 0)
 		{
-			std::fprintf(stderr,
+			printError(
 				"%s: error: Vertex data isn't divisible by the vertex format size.\n",
 				configFilePath.c_str());
 			return false;
 		}
 
-		std::vector<std::uint8_t> indexData;
+		InputData indexData;
 		unsigned int indexSize = 1; // Avoid divide by 0 when no indices.
 		if (vertexStream.indexType != vfc::IndexType::NoIndices)
 		{
-			if (!loadData(
-					indexData, configFilePath, configFileDir, vertexStream.indexData, "index"))
+			if (vertexStream.containerIndexData)
+			{
+				indexData.setView(vertexStream.containerIndexData,
+					vertexStream.containerIndexDataSize);
+			}
+			else if (!loadData(indexData, configFilePath, configFileDir, vertexStream.indexData,
+					vertexStream.decodedIndexData, "index"))
 			{
 				return false;
 			}
@@ -226,13 +392,15 @@ bool setupConverter(vfc::Converter& converter, const ConfigFile& configFile,
 			indexSize = vfc::indexSize(vertexStream.indexType);
 			if (indexData.size() % indexSize != 0)
 			{
-				std::fprintf(stderr,
+				printError(
 					"%s: error: Index data isn't divisible by the index format size.\n",
 					configFilePath.c_str());
 				return false;
 			}
 		}
 
+		// The converter validates the stream on a background task, so hash the data and load the
+		// next stream in the meantime.
 		auto vertexCount =
 			static_cast<std::uint32_t>(vertexData.size()/vertexStream.vertexFormat.stride());
 		auto indexCount = static_cast<std::uint32_t>(indexData.size()/indexSize);
@@ -242,16 +410,30 @@ bool setupConverter(vfc::Converter& converter, const ConfigFile& configFile,
 			return false;
 		}
 
-		storage.push_back(std::move(vertexData));
-		if (!indexData.empty())
+		if (hash)
+		{
+			hashVertexFormat(*hash, vertexStream.vertexFormat);
+			hash->addValue(static_cast<std::int32_t>(vertexStream.indexType));
+			hashInputData(*hash, vertexData);
+			hashInputData(*hash, indexData);
+		}
+
+		if (!vertexStream.containerVertexData)
+			storage.push_back(std::move(vertexData));
+		if (!indexData.empty() && !vertexStream.containerIndexData)
 			storage.push_back(std::move(indexData));
 	}
 
+	// Keep the input container alive after the config file is cleared.
+	InputData containerData = configFile.takeContainerData();
+	if (!containerData.empty())
+		storage.push_back(std::move(containerData));
+
 	for (const auto& transform : configFile.getTransforms())
 	{
 		if (!converter.setElementTransform(transform.first, transform.second))
 		{
-			std::fprintf(stderr,
+			printError(
 				"%s: error: No vertex element '%s' found for vertex format.\n",
 				configFilePath.c_str(), transform.first.c_str());
 			return false;
@@ -261,187 +443,1360 @@ bool setupConverter(vfc::Converter& converter, const ConfigFile& configFile,
 	return true;
 }
 
-bool writeFile(const void* data, std::size_t size, const std::string& fileName)
+bool writeFile(const std::string& fileName, const std::vector<std::uint8_t>& data)
 {
+	VFC_TRACE_SCOPE_DETAIL("writeFile", fileName);
 	std::ofstream stream(fileName,
 		std::ios_base::out | std::ios_base::trunc | std::ios_base::binary);
-	if (!stream.is_open())
+	stream.write(reinterpret_cast<const char*>(data.data()), data.size());
+	return stream.good();
+}
+
+bool closeOutputFiles(std::vector<OutputFile>& files, std::vector<std::string>& outFileNames,
+	const char* dataType)
+{
+	outFileNames.reserve(files.size());
+	for (OutputFile& file : files)
+	{
+		if (!file.close())
+		{
+			printError("error: Couldn't write %s output file '%s'.\n", dataType,
+				file.getFileName().c_str());
+			return false;
+		}
+		outFileNames.push_back(file.getFileName());
+	}
+
+	files.clear();
+	return true;
+}
+
+bool writeResult(const std::vector<vfc::VertexFormat>& vertexFormat,
+	const std::vector<std::vector<Bounds>>& bounds, const std::vector<VertexFileData>& vertexData,
+	std::uint32_t vertexCount, vfc::IndexType indexType,
+	const std::vector<IndexFileData>& indexData, const vfc::Converter::Stats* stats,
+	bool compact, const char* containerFile, const std::vector<LodFileData>* lods,
+	std::string* outResult)
+{
+	if (outResult)
+	{
+		*outResult = resultFile(vertexFormat, bounds, vertexData, vertexCount, indexType,
+			indexData, stats, compact, containerFile, lods);
+		return true;
+	}
+
+	if (!writeResultFile(stdout, vertexFormat, bounds, vertexData, vertexCount, indexType,
+			indexData, stats, compact, containerFile, lods) ||
+		std::fputc('\n', stdout) == EOF || std::fflush(stdout) != 0)
+	{
+		printError("error: Couldn't write output JSON.\n");
 		return false;
+	}
 
-	stream.write(reinterpret_cast<const char*>(data), size);
-	return stream.good();
+	return true;
 }
 
-std::string writeOutput(const vfc::Converter& converter, const std::string& outputDir)
+// Writes the vertex and index data to a single container file in the output directory.
+bool writeContainer(std::string& outFileName, const std::string& output,
+	const vfc::Converter& converter, const std::vector<std::vector<Bounds>>& bounds,
+	const std::vector<VertexFileData>& vertexData, std::uint32_t vertexCount,
+	const std::vector<IndexFileData>& indexData)
 {
-	const std::vector<std::vector<std::uint8_t>>& vertices = converter.getVertices();
-	std::vector<std::string> vertexData;
-	vertexData.reserve(vertices.size());
-	if (outputDir.empty())
+	const std::vector<vfc::VertexFormat>& vertexFormat = converter.getVertexFormat();
+	std::vector<std::vector<vfc::VertexValue>> minValues(vertexFormat.size());
+	std::vector<std::vector<vfc::VertexValue>> maxValues(vertexFormat.size());
+	vfc::ContainerWriter writer(vertexCount, converter.getIndexType(),
+		converter.getPrimitiveType(), converter.getPatchPoints());
+	for (std::size_t i = 0; i < vertexFormat.size(); ++i)
 	{
-		for (const std::vector<std::uint8_t>& curVertices : vertices)
+		for (const Bounds& curBounds : bounds[i])
 		{
-			std::string curData = "base64:";
-			curData.append(base64::encode(curVertices.data(), curVertices.size()));
-			vertexData.push_back(std::move(curData));
+			minValues[i].push_back(curBounds.min);
+			maxValues[i].push_back(curBounds.max);
 		}
+		writer.addVertexStream(vertexFormat[i], minValues[i].data(), maxValues[i].data(),
+			vertexData[i].data, vertexData[i].dataSize);
 	}
-	else
+
+	for (const IndexFileData& curData : indexData)
+	{
+		writer.addIndexBuffer(vfc::IndexData{curData.data, converter.getIndexType(),
+			curData.count, curData.baseVertex});
+	}
+
+	outFileName = path::join(output, "mesh.vfc");
+	OutputFile file;
+	if (!file.create(outFileName, writer.getSize()) || !writer.write(file.data(), file.size()) ||
+		!file.close())
+	{
+		printError("error: Couldn't write container file '%s'.\n", outFileName.c_str());
+		return false;
+	}
+
+	return true;
+}
+
+template <typename T>
+bool writeDataFiles(std::vector<OutputFile>& outFiles, const std::string& output,
+	const char* prefix, const T* data, std::size_t count, const char* dataType)
+{
+	outFiles.resize(count);
+	for (std::size_t i = 0; i < count; ++i)
 	{
-		std::string fileName;
-		for (std::size_t i = 0; i < vertices.size(); ++i)
+		std::string fileName = prefix;
+		fileName += std::to_string(i);
+		fileName += ".dat";
+		std::string outPath = path::join(output, fileName);
+		if (!outFiles[i].create(outPath, data[i].size()))
 		{
-			const std::vector<std::uint8_t>& curVertices = vertices[i];
-			fileName = "vertices.";
-			fileName += std::to_string(i);
-			fileName += ".dat";
-			std::string outPath = path::join(outputDir, fileName);
-			if (!writeFile(curVertices.data(), curVertices.size(), outPath))
-			{
-				std::fprintf(stderr, "error: Couldn't write vertex output file '%s'.\n",
-					outPath.c_str());
-				return "";
-			}
-			vertexData.push_back(std::move(outPath));
+			printError("error: Couldn't write %s output file '%s'.\n", dataType,
+				outPath.c_str());
+			return false;
 		}
+
+		if (!data[i].empty())
+			std::memcpy(outFiles[i].data(), data[i].data(), data[i].size());
+	}
+
+	return true;
+}
+
+// Simplifies the index buffers for each level of detail. The simplified indices are compressed
+// and written to files the same as the full index buffers.
+bool generateLods(ProcessState& state, const std::vector<std::vector<Bounds>>& bounds,
+	const std::vector<VertexFileData>& vertexData, std::uint32_t vertexCount,
+	const std::vector<IndexFileData>& indexData, const std::string& output,
+	const ProcessOptions& options)
+{
+	std::vector<LodFileData>& lods = state.lods;
+	lods.clear();
+	if (options.lodRatios.empty())
+		return true;
+
+	VFC_TRACE_SCOPE("generateLods");
+	const vfc::Converter& converter = *state.converter;
+	if (converter.getIndexType() == vfc::IndexType::NoIndices)
+	{
+		printError("%s: error: Levels of detail require an index type.\n", state.input.c_str());
+		return false;
 	}
 
 	const std::vector<vfc::VertexFormat>& vertexFormat = converter.getVertexFormat();
-	std::vector<std::vector<Bounds>> bounds(vertexFormat.size());
-	for (std::size_t i = 0; i < vertexFormat.size(); ++i)
+	const char* positionName = options.lodPosition.c_str();
+	std::size_t stream = 0;
+	vfc::VertexFormat::const_iterator positionElement;
+	for (; stream < vertexFormat.size(); ++stream)
 	{
-		const vfc::VertexFormat& curFormat = vertexFormat[i];
-		std::vector<Bounds>& curBounds = bounds[i];
-		curBounds.resize(curFormat.size());
-		for (std::size_t j = 0; j < curFormat.size(); ++j)
-			converter.getVertexElementBounds(curBounds[j].min, curBounds[j].max, i, j);
+		positionElement = vertexFormat[stream].find(positionName);
+		if (positionElement != vertexFormat[stream].end())
+			break;
+	}
+
+	if (stream == vertexFormat.size())
+	{
+		printError("%s: error: No vertex element '%s' found for the LOD position.\n",
+			state.input.c_str(), positionName);
+		return false;
+	}
+
+	if (!state.simplifier)
+	{
+		const std::string& curInput = state.input;
+		state.simplifier.reset(new vfc::Simplifier(
+			[&curInput](const char* message)
+			{
+				printError("%s: error: %s\n", curInput.c_str(), message);
+			}));
+	}
+
+	std::vector<vfc::IndexData> indices;
+	indices.reserve(indexData.size());
+	for (const IndexFileData& curData : indexData)
+	{
+		indices.push_back(vfc::IndexData{curData.data, converter.getIndexType(), curData.count,
+			curData.baseVertex});
+	}
+
+	vfc::Simplifier& simplifier = *state.simplifier;
+	const Bounds& positionBounds = bounds[stream][positionElement - vertexFormat[stream].begin()];
+	simplifier.setPositionTransform(converter.getElementTransform(positionName),
+		positionBounds.min, positionBounds.max);
+	if (!simplifier.simplify(vertexFormat[stream], vertexData[stream].data, vertexCount,
+			positionName, indices, converter.getPrimitiveType(), options.lodRatios))
+	{
+		return false;
 	}
 
-	std::vector<IndexFileData> indexFileData;
-	std::vector<std::string> indexStrings;
-	indexFileData.reserve(converter.getIndices().size());
-	indexStrings.reserve(indexFileData.size());
-	if (outputDir.empty())
+	std::size_t bufferCount = 0;
+	lods.resize(simplifier.getLodCount());
+	for (std::size_t i = 0; i < lods.size(); ++i)
 	{
-		for (const vfc::IndexData& indexData : converter.getIndices())
+		LodFileData& lod = lods[i];
+		lod.ratio = options.lodRatios[i];
+		lod.error = simplifier.getLodError(i);
+		for (const vfc::IndexData& curIndices : simplifier.getLodIndices(i))
 		{
 			std::size_t indexSize =
-				static_cast<std::size_t>(indexData.count)*vfc::indexSize(indexData.type);
-			std::string encodedData = "base64:";
-			encodedData.append(base64::encode(indexData.data, indexSize));
-			indexFileData.push_back(
-				IndexFileData{indexData.count, indexData.baseVertex, encodedData.c_str()});
-			indexStrings.push_back(std::move(encodedData));
+				static_cast<std::size_t>(curIndices.count)*vfc::indexSize(curIndices.type);
+			lod.indexBuffers.push_back(IndexFileData{curIndices.count, curIndices.baseVertex,
+				nullptr, curIndices.data, indexSize});
 		}
+		bufferCount += lod.indexBuffers.size();
 	}
-	else
+
+	if (options.compress)
 	{
-		std::string fileName;
-		for (const vfc::IndexData& indexData : converter.getIndices())
+		const char* const encoding = "vfc-compressed";
+		std::vector<std::vector<std::uint8_t>>& compressedData = state.compressedLodData;
+		compressedData.resize(bufferCount);
+		std::size_t index = 0;
+		for (LodFileData& lod : lods)
 		{
-			fileName = "indices.";
-			fileName += std::to_string(indexFileData.size());
-			fileName += ".dat";
-			std::string indexDataPath = path::join(outputDir, fileName);
-			std::size_t indexSize =
-				static_cast<std::size_t>(indexData.count)*vfc::indexSize(indexData.type);
-			if (!writeFile(indexData.data, indexSize, indexDataPath))
+			for (IndexFileData& curData : lod.indexBuffers)
+			{
+				std::vector<std::uint8_t>& curCompressed = compressedData[index++];
+				if (!vfc::compressIndices(curCompressed, curData.data, curData.count,
+						converter.getIndexType()))
+				{
+					printError("error: Couldn't compress index data.\n");
+					return false;
+				}
+
+				curData.data = curCompressed.data();
+				curData.dataSize = curCompressed.size();
+				curData.encoding = encoding;
+			}
+		}
+	}
+
+	if (output.empty())
+		return true;
+
+	// The result refers to the file names, so they can't be re-allocated.
+	std::vector<std::string>& fileNames = state.lodFileNames;
+	fileNames.clear();
+	fileNames.reserve(bufferCount);
+	for (std::size_t i = 0; i < lods.size(); ++i)
+	{
+		std::vector<IndexFileData>& indexBuffers = lods[i].indexBuffers;
+		for (std::size_t j = 0; j < indexBuffers.size(); ++j)
+		{
+			IndexFileData& curData = indexBuffers[j];
+			std::string fileName = "lod" + std::to_string(i + 1) + ".indices." +
+				std::to_string(j) + ".dat";
+			fileNames.push_back(path::join(output, fileName));
+			OutputFile file;
+			if (!file.create(fileNames.back(), curData.dataSize))
+			{
+				printError("error: Couldn't write index output file '%s'.\n",
+					fileNames.back().c_str());
+				return false;
+			}
+
+			if (curData.dataSize > 0)
+				std::memcpy(file.data(), curData.data, curData.dataSize);
+			if (!file.close())
 			{
-				std::fprintf(stderr, "error: Couldn't write index output file '%s'.\n",
-					indexDataPath.c_str());
-				return "";
+				printError("error: Couldn't write index output file '%s'.\n",
+					fileNames.back().c_str());
+				return false;
 			}
 
-			indexFileData.push_back(
-				IndexFileData{indexData.count, indexData.baseVertex, indexDataPath.c_str()});
-			indexStrings.push_back(std::move(indexDataPath));
+			curData.dataFile = fileNames.back().c_str();
+			curData.data = nullptr;
+			curData.dataSize = 0;
 		}
 	}
 
-	return resultFile(converter.getVertexFormat(), bounds, vertexData, converter.getVertexCount(),
-		converter.getIndexType(), indexFileData);
+	return true;
 }
 
-int main(int argc, const char** argv)
+// Compresses the vertex and index data, writing it to files in the output directory or embedding
+// it in the result without an output directory.
+bool writeCompressedOutput(ProcessState& state, const std::vector<std::vector<Bounds>>& bounds,
+	std::vector<VertexFileData>& vertexData, std::uint32_t vertexCount,
+	std::vector<IndexFileData>& indexData, const vfc::Converter::Stats* stats,
+	const std::string& output, const ProcessOptions& options, std::string* outResult)
 {
-	std::string input;
-	std::string output;
-	for (int i = 1; i < argc; ++i)
+	const char* const encoding = "vfc-compressed";
+	const vfc::Converter& converter = *state.converter;
+	const std::vector<vfc::VertexFormat>& vertexFormat = converter.getVertexFormat();
+	std::vector<std::vector<std::uint8_t>>& compressedData = state.compressedData;
+	compressedData.resize(vertexData.size() + indexData.size());
+	const std::vector<std::uint8_t>* compressedVertices = compressedData.data();
+	const std::vector<std::uint8_t>* compressedIndices = compressedData.data() + vertexData.size();
+	for (std::size_t i = 0; i < vertexData.size(); ++i)
 	{
-		if (std::strcmp(argv[i], "-h") == 0 || std::strcmp(argv[i], "--help") == 0)
+		auto stride = static_cast<std::uint32_t>(vertexFormat[i].stride());
+		if (!vfc::compressVertices(compressedData[i], vertexData[i].data,
+				static_cast<std::uint32_t>(vertexData[i].dataSize/stride), stride))
 		{
-			printHelp(argv[0]);
-			return 0;
+			printError("error: Couldn't compress vertex data.\n");
+			return false;
 		}
-		else if (std::strcmp(argv[i], "-i") == 0 || std::strcmp(argv[i], "--input") == 0)
-		{
-			if (i == argc - 1)
-			{
-				std::fprintf(stderr, "error: --input requires an argument.\n");
-				return 1;
-			}
+	}
 
-			input = argv[++i];
+	for (std::size_t i = 0; i < indexData.size(); ++i)
+	{
+		if (!vfc::compressIndices(compressedData[vertexData.size() + i], indexData[i].data,
+				indexData[i].count, converter.getIndexType()))
+		{
+			printError("error: Couldn't compress index data.\n");
+			return false;
 		}
-		else if (std::strcmp(argv[i], "-o") == 0 || std::strcmp(argv[i], "--output") == 0)
+	}
+
+	std::vector<std::string> vertexFileNames;
+	std::vector<std::string> indexFileNames;
+	if (output.empty())
+	{
+		for (std::size_t i = 0; i < vertexData.size(); ++i)
 		{
-			if (i == argc - 1)
-			{
-				std::fprintf(stderr, "error: --output requires an argument.\n");
-				return 1;
-			}
+			vertexData[i] = VertexFileData{nullptr, compressedVertices[i].data(),
+				compressedVertices[i].size(), encoding};
+		}
 
-			output = argv[++i];
+		for (std::size_t i = 0; i < indexData.size(); ++i)
+		{
+			indexData[i].data = compressedIndices[i].data();
+			indexData[i].dataSize = compressedIndices[i].size();
+			indexData[i].encoding = encoding;
 		}
-		else
+	}
+	else
+	{
+		if (!writeDataFiles(state.vertexFiles, output, "vertices.", compressedVertices,
+				vertexData.size(), "vertex") ||
+			!writeDataFiles(state.indexFiles, output, "indices.", compressedIndices,
+				indexData.size(), "index") ||
+			!closeOutputFiles(state.vertexFiles, vertexFileNames, "vertex") ||
+			!closeOutputFiles(state.indexFiles, indexFileNames, "index"))
 		{
-			std::fprintf(stderr, "error: Unknown argument '%s'.\n", argv[i]);
-			return 1;
+			return false;
+		}
+
+		for (std::size_t i = 0; i < vertexData.size(); ++i)
+			vertexData[i] = VertexFileData{vertexFileNames[i].c_str(), nullptr, 0, encoding};
+		for (std::size_t i = 0; i < indexData.size(); ++i)
+		{
+			indexData[i].dataFile = indexFileNames[i].c_str();
+			indexData[i].data = nullptr;
+			indexData[i].dataSize = 0;
+			indexData[i].encoding = encoding;
 		}
 	}
 
-	ConfigFile configFile;
-	std::string configFileDir;
-	bool configLoadResult = false;
-	if (input.empty())
+	return writeResult(vertexFormat, bounds, vertexData, vertexCount, converter.getIndexType(),
+		indexData, stats, options.compact, nullptr, &state.lods, outResult);
+}
+
+bool writeOutput(ProcessState& state, const vfc::Converter::Stats* stats,
+	const std::string& output, const ProcessOptions& options, const std::string& cacheKey,
+	std::string* outResult)
+{
+	const vfc::Converter& converter = *state.converter;
+	std::vector<OutputFile>& vertexFiles = state.vertexFiles;
+	std::vector<OutputFile>& indexFiles = state.indexFiles;
+
+	// Output files were filled directly during conversion, otherwise the data is embedded. A single
+	// vertex stream is kept by the converter rather than copied to an output file.
+	bool embedData = !converter.getOutputBufferFunction();
+	const std::vector<std::vector<std::uint8_t>>& vertices = converter.getVertices();
+	const std::vector<vfc::VertexFormat>& vertexFormat = converter.getVertexFormat();
+	std::vector<VertexFileData> vertexData(vertexFormat.size());
+	std::vector<std::vector<Bounds>> bounds(vertexFormat.size());
+	for (std::size_t i = 0; i < vertexFormat.size(); ++i)
 	{
-		configLoadResult = configFile.load(std::cin, "stdin");
-		input = "stdin";
+		if (embedData || i >= vertexFiles.size())
+			vertexData[i] = VertexFileData{nullptr, vertices[i].data(), vertices[i].size()};
+		else
+			vertexData[i] = VertexFileData{nullptr, vertexFiles[i].data(), vertexFiles[i].size()};
+
+		const vfc::VertexFormat& curFormat = vertexFormat[i];
+		std::vector<Bounds>& curBounds = bounds[i];
+		curBounds.resize(curFormat.size());
+		for (std::size_t j = 0; j < curFormat.size(); ++j)
+			converter.getVertexElementBounds(curBounds[j].min, curBounds[j].max, i, j);
 	}
-	else
+
+	const std::vector<vfc::IndexData>& indices = converter.getIndices();
+	std::vector<IndexFileData> indexData;
+	indexData.reserve(indices.size());
+	for (const vfc::IndexData& curIndices : indices)
 	{
-		configLoadResult = configFile.load(input.c_str());
-		configFileDir = path::getParentDirectory(input.c_str());
+		std::size_t indexSize =
+			static_cast<std::size_t>(curIndices.count)*vfc::indexSize(curIndices.type);
+		indexData.push_back(IndexFileData{curIndices.count, curIndices.baseVertex, nullptr,
+			curIndices.data, indexSize});
+	}
+
+	// Store in the cache while the output files are still open. Failing to store only means the
+	// next conversion isn't cached.
+	if (options.cache)
+	{
+		options.cache->store(cacheKey, vertexFormat, bounds, vertexData,
+			converter.getVertexCount(), converter.getIndexType(), indexData);
+		options.cache->evictIfDue();
+	}
+
+	if (!generateLods(state, bounds, vertexData, converter.getVertexCount(), indexData, output,
+			options))
+	{
+		return false;
+	}
+
+	if (options.compress)
+	{
+		return writeCompressedOutput(state, bounds, vertexData, converter.getVertexCount(),
+			indexData, stats, output, options, outResult);
 	}
-	if (!configLoadResult)
-		return 1;
 
-	vfc::Converter converter(configFile.getVertexFormat(), configFile.getIndexType(),
-		configFile.getPrimitiveType(), configFile.getPatchPoints(),
-		[&input](const char* message)
+	std::string containerFile;
+	if (options.container)
+	{
+		if (!writeContainer(containerFile, output, converter, bounds, vertexData,
+				converter.getVertexCount(), indexData))
 		{
-			std::fprintf(stderr, "%s: error: %s\n", input.c_str(), message);
-		});
-	std::vector<std::vector<std::uint8_t>> storage;
-	if (!converter || !setupConverter(converter, configFile, input, configFileDir, storage))
-		return 1;
+			return false;
+		}
 
-	// Config file can contain base64 data, so clear out memory.
-	configFile = ConfigFile();
+		return writeResult(vertexFormat, bounds, vertexData, converter.getVertexCount(),
+			converter.getIndexType(), indexData, stats, options.compact, containerFile.c_str(),
+			nullptr, outResult);
+	}
 
-	if (!output.empty() && !mkdirRecursive(output))
+	std::vector<std::string> vertexFileNames;
+	std::vector<std::string> indexFileNames;
+	if (!embedData)
 	{
-		std::fprintf(stderr, "error: Couldn't create output path '%s'.\n", output.c_str());
-		return 1;
+		if (!closeOutputFiles(vertexFiles, vertexFileNames, "vertex") ||
+			!closeOutputFiles(indexFiles, indexFileNames, "index"))
+		{
+			return false;
+		}
+
+		for (std::size_t i = vertexFileNames.size(); i < vertices.size(); ++i)
+		{
+			vertexFileNames.push_back(
+				path::join(output, "vertices." + std::to_string(i) + ".dat"));
+			if (!writeFile(vertexFileNames.back(), vertices[i]))
+			{
+				printError("error: Couldn't write vertex output file '%s'.\n",
+					vertexFileNames.back().c_str());
+				return false;
+			}
+		}
+
+		for (std::size_t i = 0; i < vertexData.size(); ++i)
+			vertexData[i] = VertexFileData{vertexFileNames[i].c_str(), nullptr, 0};
+		for (std::size_t i = 0; i < indexData.size(); ++i)
+		{
+			indexData[i].dataFile = indexFileNames[i].c_str();
+			indexData[i].data = nullptr;
+			indexData[i].dataSize = 0;
+		}
 	}
 
-	if (!converter.convert())
-		return 1;
+	return writeResult(vertexFormat, bounds, vertexData, converter.getVertexCount(),
+		converter.getIndexType(), indexData, stats, options.compact, nullptr, &state.lods,
+		outResult);
+}
 
-	std::string result = writeOutput(converter, output);
-	if (result.empty())
-		return 1;
+// Loads the data for a cache entry. This fails if the entry was evicted in the meantime.
+bool loadCachedData(std::vector<InputData>& outData, const ConversionCache::Entry& entry,
+	const std::vector<vfc::VertexFormat>& vertexFormat)
+{
+	if (entry.bounds.size() != vertexFormat.size())
+		return false;
+
+	for (std::size_t i = 0; i < vertexFormat.size(); ++i)
+	{
+		if (entry.bounds[i].size() != vertexFormat[i].size())
+			return false;
+	}
+
+	outData.clear();
+	outData.resize(entry.vertexFiles.size() + entry.indexFiles.size());
+	for (std::size_t i = 0; i < entry.vertexFiles.size(); ++i)
+	{
+		if (!outData[i].loadFile(entry.vertexFiles[i]))
+			return false;
+	}
+
+	for (std::size_t i = 0; i < entry.indexFiles.size(); ++i)
+	{
+		if (!outData[entry.vertexFiles.size() + i].loadFile(entry.indexFiles[i]))
+			return false;
+	}
 
-	std::printf("%s\n", result.c_str());
-	return 0;
+	return true;
+}
+
+bool writeCachedOutput(ProcessState& state, const ConversionCache::Entry& entry,
+	const std::vector<InputData>& cachedData, const std::string& output,
+	const ProcessOptions& options, std::string* outResult)
+{
+	const vfc::Converter& converter = *state.converter;
+	const std::vector<vfc::VertexFormat>& vertexFormat = converter.getVertexFormat();
+	const InputData* vertexInputs = cachedData.data();
+	const InputData* indexInputs = cachedData.data() + entry.vertexFiles.size();
+	std::vector<VertexFileData> vertexData(entry.vertexFiles.size());
+	std::vector<IndexFileData> indexData = entry.indexBuffers;
+	std::vector<std::string> vertexFileNames;
+	std::vector<std::string> indexFileNames;
+	std::string containerFile;
+	for (std::size_t i = 0; i < vertexData.size(); ++i)
+		vertexData[i] = VertexFileData{nullptr, vertexInputs[i].data(), vertexInputs[i].size()};
+	for (std::size_t i = 0; i < indexData.size(); ++i)
+	{
+		indexData[i].data = indexInputs[i].data();
+		indexData[i].dataSize = indexInputs[i].size();
+	}
+
+	// Levels of detail aren't cached since they're quick to generate compared to converting.
+	if (!generateLods(state, entry.bounds, vertexData, entry.vertexCount, indexData, output,
+			options))
+	{
+		return false;
+	}
+
+	if (output.empty() || options.container || options.compress)
+	{
+		if (options.compress)
+		{
+			return writeCompressedOutput(state, entry.bounds, vertexData, entry.vertexCount,
+				indexData, nullptr, output, options, outResult);
+		}
+
+		if (options.container &&
+			!writeContainer(containerFile, output, converter, entry.bounds, vertexData,
+				entry.vertexCount, indexData))
+		{
+			return false;
+		}
+	}
+	else
+	{
+		if (!writeDataFiles(state.vertexFiles, output, "vertices.", vertexInputs,
+				vertexData.size(), "vertex") ||
+			!writeDataFiles(state.indexFiles, output, "indices.", indexInputs, indexData.size(),
+				"index") ||
+			!closeOutputFiles(state.vertexFiles, vertexFileNames, "vertex") ||
+			!closeOutputFiles(state.indexFiles, indexFileNames, "index"))
+		{
+			return false;
+		}
+
+		for (std::size_t i = 0; i < vertexData.size(); ++i)
+			vertexData[i] = VertexFileData{vertexFileNames[i].c_str(), nullptr, 0};
+		for (std::size_t i = 0; i < indexData.size(); ++i)
+		{
+			indexData[i].dataFile = indexFileNames[i].c_str();
+			indexData[i].data = nullptr;
+			indexData[i].dataSize = 0;
+		}
+	}
+
+	return writeResult(vertexFormat, entry.bounds, vertexData, entry.vertexCount,
+		converter.getIndexType(), indexData, nullptr, options.compact,
+		containerFile.empty() ? nullptr : containerFile.c_str(), &state.lods, outResult);
+}
+
+// The result is written to stdout unless outResult is provided.
+// The memory reservation, if any, is taken before loading the input with an estimated size, and
+// corrected once the input is loaded.
+bool processConfig(ProcessState& state, ConfigFile& configFile, std::string input,
+	const std::string& configFileDir, const std::string& output, const ProcessOptions& options,
+	std::string* outResult, MemoryReservation* memoryReservation)
+{
+	// The error function refers to the state's input so the converter can be re-used.
+	state.input = std::move(input);
+	if (state.converter)
+	{
+		state.converter->reset(configFile.getVertexFormat(), configFile.getIndexType(),
+			configFile.getPrimitiveType(), configFile.getPatchPoints());
+	}
+	else
+	{
+		const std::string& curInput = state.input;
+		state.converter.reset(new vfc::Converter(configFile.getVertexFormat(),
+			configFile.getIndexType(), configFile.getPrimitiveType(),
+			configFile.getPatchPoints(),
+			[&curInput](const char* message)
+			{
+				printError("%s: error: %s\n", curInput.c_str(), message);
+			}));
+	}
+
+	ContentHash hash;
+	ContentHash* cacheHash = nullptr;
+	if (options.cache)
+	{
+		hashConfig(hash, configFile);
+		cacheHash = &hash;
+	}
+
+	vfc::Converter& converter = *state.converter;
+	converter.setBackgroundValidationEnabled(true);
+	std::vector<InputData>& storage = state.storage;
+	storage.clear();
+	if (!converter ||
+		!setupConverter(converter, configFile, state.input, configFileDir, storage, cacheHash))
+	{
+		return false;
+	}
+
+	// Config file can contain decoded base64 data, so clear out memory.
+	configFile = ConfigFile();
+
+	std::vector<OutputFile>& vertexFiles = state.vertexFiles;
+	std::vector<OutputFile>& indexFiles = state.indexFiles;
+	vertexFiles.clear();
+	indexFiles.clear();
+	if (!output.empty() && !path::createDirectories(output))
+	{
+		printError("error: Couldn't create output path '%s'.\n", output.c_str());
+		return false;
+	}
+
+	// Stats are only available when converting.
+	std::string cacheKey;
+	if (options.cache)
+	{
+		cacheKey = hash.finishHex();
+		ConversionCache::Entry entry;
+		std::vector<InputData> cachedData;
+		if (!options.printStats && options.cache->find(entry, cacheKey) &&
+			loadCachedData(cachedData, entry, converter.getVertexFormat()))
+		{
+			converter.waitForValidation();
+			storage.clear();
+			return writeCachedOutput(state, entry, cachedData, output, options, outResult);
+		}
+	}
+
+	if (memoryReservation)
+	{
+		std::uint64_t inputSize = 0;
+		for (const InputData& data : storage)
+			inputSize += data.size();
+		memoryReservation->resize(estimateMemoryUsage(inputSize));
+	}
+
+	// Write the output data directly to the output files when converting. The container and
+	// compressed data are written after converting once the size of each buffer is known.
+	bool fileError = false;
+	converter.setOutputBufferFunction(nullptr);
+	if (!output.empty() && !options.container && !options.compress)
+	{
+		converter.setOutputBufferFunction(
+			[&](vfc::Converter::OutputBufferType type, std::size_t index, std::size_t size)
+			{
+				bool vertices = type == vfc::Converter::OutputBufferType::Vertices;
+				std::string fileName = vertices ? "vertices." : "indices.";
+				fileName += std::to_string(index);
+				fileName += ".dat";
+
+				std::vector<OutputFile>& files = vertices ? vertexFiles : indexFiles;
+				files.emplace_back();
+				OutputFile& file = files.back();
+				std::string outPath = path::join(output, fileName);
+				if (!file.create(outPath, size))
+				{
+					printError("error: Couldn't write %s output file '%s'.\n",
+						vertices ? "vertex" : "index", outPath.c_str());
+					fileError = true;
+				}
+				return file.data();
+			});
+	}
+
+	vfc::Converter::Stats stats;
+	bool success = converter.convert(options.printStats ? &stats : nullptr) && !fileError &&
+		writeOutput(state, options.printStats ? &stats : nullptr, output, options, cacheKey,
+			outResult);
+
+	// The output buffer function refers to local variables.
+	converter.setOutputBufferFunction(nullptr);
+	storage.clear();
+	return success;
+}
+
+// Batch and server inputs may not have an output, so --container is checked for each input.
+bool checkContainerOutput(const std::string& input, const std::string& output,
+	const ProcessOptions& options)
+{
+	if (options.container && output.empty())
+	{
+		printError("%s: error: --container requires an output directory.\n", input.c_str());
+		return false;
+	}
+
+	return true;
+}
+
+bool processInput(ProcessState& state, std::string input, const std::string& output,
+	const ProcessOptions& options, std::string* outResult = nullptr,
+	MemoryReservation* memoryReservation = nullptr)
+{
+	if (!checkContainerOutput(input, output, options))
+		return false;
+
+	ConfigFile configFile;
+	std::string configFileDir;
+	bool configLoadResult = false;
+	{
+		VFC_TRACE_SCOPE("ConfigFile::load");
+		if (input.empty())
+		{
+			configLoadResult = configFile.load(std::cin, "stdin", &printErrorMessage);
+			input = "stdin";
+		}
+		else
+		{
+			configLoadResult = configFile.load(input.c_str(), &printErrorMessage);
+			configFileDir = path::getParentDirectory(input.c_str());
+		}
+	}
+	if (!configLoadResult)
+		return false;
+
+	return processConfig(state, configFile, std::move(input), configFileDir, output, options,
+		outResult, memoryReservation);
+}
+
+bool writeResultLine(const std::string& result)
+{
+	if (std::fwrite(result.data(), 1, result.size(), stdout) != result.size() ||
+		std::fputc('\n', stdout) == EOF || std::fflush(stdout) != 0)
+	{
+		std::fprintf(stderr, "error: Couldn't write output JSON.\n");
+		return false;
+	}
+
+	return true;
+}
+
+std::uint64_t fileSize(const std::string& fileName)
+{
+	std::ifstream stream(fileName, std::ios_base::in | std::ios_base::binary | std::ios_base::ate);
+	if (!stream.is_open())
+		return 0;
+
+	std::streamoff size = stream.tellg();
+	return size > 0 ? static_cast<std::uint64_t>(size) : 0;
+}
+
+std::uint64_t dataFilesSize(const ConfigFile& configFile, const std::string& configFileDir)
+{
+	std::uint64_t size = 0;
+	for (const ConfigFile::VertexStream& vertexStream : configFile.getVertexStreams())
+	{
+		if (!vertexStream.vertexData.empty())
+			size += fileSize(path::join(configFileDir, vertexStream.vertexData));
+		if (!vertexStream.indexData.empty())
+			size += fileSize(path::join(configFileDir, vertexStream.indexData));
+	}
+	return size;
+}
+
+std::atomic<bool> stopServer(false);
+
+void stopServerSignal(int)
+{
+	stopServer = true;
+}
+
+// Converters are kept in a pool to re-use between requests. Memory is reserved based on the size of
+// the config and its data files before loading the data, similar to batches.
+bool serve(const std::string& socketPath, const ProcessOptions& options,
+	std::uint64_t memoryBudget)
+{
+	std::signal(SIGINT, &stopServerSignal);
+	std::signal(SIGTERM, &stopServerSignal);
+
+	MemoryBudget budget(memoryBudget);
+	std::mutex poolMutex;
+	std::vector<std::unique_ptr<ProcessState>> statePool;
+	return server::serve(socketPath,
+		[&](const server::Request& request, server::Response& response)
+		{
+			std::unique_ptr<ProcessState> state;
+			{
+				std::lock_guard<std::mutex> lock(poolMutex);
+				if (!statePool.empty())
+				{
+					state = std::move(statePool.back());
+					statePool.pop_back();
+				}
+			}
+			if (!state)
+				state.reset(new ProcessState);
+
+			ProcessOptions requestOptions = options;
+			requestOptions.printStats = request.printStats;
+			requestOptions.compact = request.compact;
+			requestOptions.container = request.container;
+			requestOptions.compress = request.compress;
+			requestOptions.lodRatios = request.lodRatios;
+			requestOptions.lodPosition = request.lodPosition;
+
+			capturedErrors = &response.errors;
+			MemoryReservation memoryReservation(&budget,
+				estimateMemoryUsage(request.config.size()));
+			ConfigFile configFile;
+			response.success = checkContainerOutput(request.configName, request.output,
+				requestOptions);
+			if (response.success)
+			{
+				VFC_TRACE_SCOPE("ConfigFile::load");
+				response.success = configFile.load(request.config.data(), request.config.size(),
+					request.configName.c_str(), &printErrorMessage);
+			}
+			if (response.success)
+			{
+				memoryReservation.resize(estimateMemoryUsage(request.config.size() +
+					dataFilesSize(configFile, request.configDir)));
+				response.success = processConfig(*state, configFile, request.configName,
+					request.configDir, request.output, requestOptions, &response.result,
+					&memoryReservation);
+			}
+			capturedErrors = nullptr;
+
+			std::lock_guard<std::mutex> lock(poolMutex);
+			statePool.push_back(std::move(state));
+		}, stopServer);
+}
+
+bool readFile(std::string& outContents, const std::string& fileName)
+{
+	std::ifstream stream(fileName, std::ios_base::in | std::ios_base::binary);
+	if (!stream.is_open())
+		return false;
+
+	outContents.assign(std::istreambuf_iterator<char>(stream), std::istreambuf_iterator<char>());
+	return !stream.bad();
+}
+
+// Sends the input to a server rather than processing it in this process.
+bool processInputWithServer(const std::string& socketPath, const std::string& input,
+	const std::string& output, const ProcessOptions& options)
+{
+	server::Request request;
+	if (input.empty())
+	{
+		request.configName = "stdin";
+		request.configDir = path::makeAbsolute(".");
+		request.config.assign(std::istreambuf_iterator<char>(std::cin),
+			std::istreambuf_iterator<char>());
+	}
+	else
+	{
+		request.configName = input;
+		request.configDir = path::makeAbsolute(path::getParentDirectory(input));
+		if (!readFile(request.config, input))
+		{
+			std::fprintf(stderr, "error: Couldn't open config file '%s'.\n", input.c_str());
+			return false;
+		}
+	}
+
+	if (!output.empty())
+		request.output = path::makeAbsolute(output);
+	request.printStats = options.printStats;
+	request.compact = options.compact;
+	request.container = options.container;
+	request.compress = options.compress;
+	request.lodRatios = options.lodRatios;
+	request.lodPosition = options.lodPosition;
+
+	server::Client client;
+	server::Response response;
+	if (!client.connect(socketPath) || !client.send(response, request))
+		return false;
+
+	std::fputs(response.errors.c_str(), stderr);
+	if (!response.success)
+		return false;
+
+	return writeResultLine(response.result);
+}
+
+bool readBatchString(std::string& outString, const rapidjson::Value& object, const char* name,
+	const std::string& batchFile, unsigned int line)
+{
+	auto it = object.FindMember(name);
+	if (it == object.MemberEnd())
+		return true;
+
+	if (!it->value.IsString())
+	{
+		std::fprintf(stderr, "%s:%u: error: Member '%s' must be a string.\n",
+			batchFile.c_str(), line, name);
+		return false;
+	}
+
+	outString = it->value.GetString();
+	return true;
+}
+
+// Estimates the size of an input to process the largest inputs first. Config files that reference
+// data files are small, so those are loaded to add the size of the data files.
+std::uint64_t estimateInputSize(const std::string& input)
+{
+	const std::uint64_t maxReferenceConfigSize = 64*1024;
+	std::uint64_t size = fileSize(input);
+	if (size > maxReferenceConfigSize)
+		return size;
+
+	// Errors will be reported when processing the input.
+	ConfigFile configFile;
+	if (!configFile.load(input.c_str(), [](const char*) {}))
+		return size;
+
+	return size + dataFilesSize(configFile, path::getParentDirectory(input));
+}
+
+struct BatchJob
+{
+	std::string input;
+	std::string output;
+};
+
+bool readBatchFile(std::vector<BatchJob>& outJobs, const std::string& batchFile)
+{
+	std::ifstream stream(batchFile);
+	if (!stream.is_open())
+	{
+		std::fprintf(stderr, "error: Couldn't open batch file '%s'.\n", batchFile.c_str());
+		return false;
+	}
+
+	// Paths are relative to the batch file. Invalid lines are kept with an empty input so the
+	// results match up with the batch file.
+	std::string batchDir = path::getParentDirectory(batchFile);
+	bool success = true;
+	std::string lineStr;
+	unsigned int line = 0;
+	while (std::getline(stream, lineStr))
+	{
+		++line;
+		if (lineStr.find_first_not_of(" \t\r") == std::string::npos)
+			continue;
+
+		outJobs.emplace_back();
+		BatchJob& job = outJobs.back();
+		rapidjson::Document document;
+		document.Parse(lineStr.c_str());
+		if (document.HasParseError() || !document.IsObject())
+		{
+			std::fprintf(stderr, "%s:%u: error: Batch line must be a JSON object.\n",
+				batchFile.c_str(), line);
+			success = false;
+			continue;
+		}
+
+		if (!readBatchString(job.input, document, "input", batchFile, line) ||
+			!readBatchString(job.output, document, "output", batchFile, line))
+		{
+			job.input.clear();
+			success = false;
+			continue;
+		}
+
+		if (job.input.empty())
+		{
+			std::fprintf(stderr, "%s:%u: error: Batch line must have an 'input' member.\n",
+				batchFile.c_str(), line);
+			success = false;
+			continue;
+		}
+
+		job.input = path::join(batchDir, job.input);
+		if (!job.output.empty())
+			job.output = path::join(batchDir, job.output);
+	}
+
+	return success;
+}
+
+bool processBatch(const std::string& batchFile, const ProcessOptions& options,
+	unsigned int jobCount, std::uint64_t memoryBudget)
+{
+	std::vector<BatchJob> jobs;
+	bool success = readBatchFile(jobs, batchFile);
+	if (jobs.empty())
+		return success;
+
+	// Results are written in the same order as the batch file. When processing in parallel,
+	// results are held until all earlier results are written.
+	std::mutex outputMutex;
+	std::vector<std::string> results;
+	std::vector<bool> resultsReady;
+	std::size_t nextResult = 0;
+	std::vector<std::uint64_t> priorities(jobs.size(), 0);
+	if (jobCount > 1)
+	{
+		results.resize(jobs.size());
+		resultsReady.resize(jobs.size());
+		for (std::size_t i = 0; i < jobs.size(); ++i)
+		{
+			if (!jobs[i].input.empty())
+				priorities[i] = estimateInputSize(jobs[i].input);
+		}
+	}
+
+	// Memory is reserved with the estimated input size before loading the input so large inputs
+	// aren't loaded at the same time.
+	MemoryBudget budget(memoryBudget);
+	ProcessOptions batchOptions = options;
+	// Results are compact to keep one per line.
+	batchOptions.compact = true;
+	std::vector<ProcessState> states(std::min(static_cast<std::size_t>(jobCount), jobs.size()));
+	JobPool::run(jobCount, priorities,
+		[&](std::size_t job, unsigned int thread)
+		{
+			const BatchJob& batchJob = jobs[job];
+			bool jobSuccess = false;
+			std::string result;
+			if (!batchJob.input.empty())
+			{
+				MemoryReservation memoryReservation(jobCount > 1 ? &budget : nullptr,
+					estimateMemoryUsage(priorities[job]));
+				jobSuccess = processInput(states[thread], batchJob.input, batchJob.output,
+					batchOptions, jobCount > 1 ? &result : nullptr, &memoryReservation);
+			}
+			if (!jobSuccess)
+				result = "null";
+
+			std::lock_guard<std::mutex> lock(outputMutex);
+			if (!jobSuccess)
+				success = false;
+
+			// Successful results are written directly when processing one at a time.
+			if (jobCount == 1)
+			{
+				if (!jobSuccess && !writeResultLine(result))
+					success = false;
+				return;
+			}
+
+			results[job] = std::move(result);
+			resultsReady[job] = true;
+			for (; nextResult < results.size() && resultsReady[nextResult]; ++nextResult)
+			{
+				if (!writeResultLine(results[nextResult]))
+					success = false;
+				std::string().swap(results[nextResult]);
+			}
+		});
+
+	return success;
+}
+
+// Ratios are separated by commas, each in the range (0, 1] and no larger than the previous ratio.
+bool parseLodRatios(std::vector<double>& outRatios, const char* str)
+{
+	outRatios.clear();
+	for (;;)
+	{
+		char* end;
+		double ratio = std::strtod(str, &end);
+		if (end == str || (*end && *end != ',') || !(ratio > 0.0 && ratio <= 1.0) ||
+			(!outRatios.empty() && ratio > outRatios.back()))
+		{
+			return false;
+		}
+
+		outRatios.push_back(ratio);
+		if (!*end)
+			return true;
+		str = end + 1;
+	}
+}
+
+bool writeTrace(const std::string& fileName)
+{
+	vfc::Trace::stop();
+	std::ofstream stream(fileName, std::ios_base::out | std::ios_base::trunc);
+	if (!stream.is_open() || !vfc::Trace::writeChromeTrace(stream))
+	{
+		std::fprintf(stderr, "error: Couldn't write trace file '%s'.\n", fileName.c_str());
+		return false;
+	}
+
+	return true;
+}
+
+int main(int argc, const char** argv)
+{
+#if VFC_WINDOWS
+	// Input containers may be piped through stdin, so line endings can't be translated.
+	_setmode(_fileno(stdin), _O_BINARY);
+#endif
+
+	std::string input;
+	std::string output;
+	std::string trace;
+	std::string batch;
+	std::string cacheDir;
+	std::string serveSocket;
+	std::string connectSocket;
+	std::uint64_t cacheSize = 1024ULL*1024*1024;
+	unsigned int jobCount = 1;
+	std::uint64_t memoryBudget = MemoryBudget::defaultBudget();
+	ProcessOptions options;
+	for (int i = 1; i < argc; ++i)
+	{
+		if (std::strcmp(argv[i], "-h") == 0 || std::strcmp(argv[i], "--help") == 0)
+		{
+			printHelp(argv[0]);
+			return 0;
+		}
+		else if (std::strcmp(argv[i], "-i") == 0 || std::strcmp(argv[i], "--input") == 0)
+		{
+			if (i == argc - 1)
+			{
+				std::fprintf(stderr, "error: --input requires an argument.\n");
+				return 1;
+			}
+
+			input = argv[++i];
+		}
+		else if (std::strcmp(argv[i], "-o") == 0 || std::strcmp(argv[i], "--output") == 0)
+		{
+			if (i == argc - 1)
+			{
+				std::fprintf(stderr, "error: --output requires an argument.\n");
+				return 1;
+			}
+
+			output = argv[++i];
+		}
+		else if (std::strcmp(argv[i], "--batch") == 0)
+		{
+			if (i == argc - 1)
+			{
+				std::fprintf(stderr, "error: --batch requires an argument.\n");
+				return 1;
+			}
+
+			batch = argv[++i];
+		}
+		else if (std::strcmp(argv[i], "-j") == 0 || std::strcmp(argv[i], "--jobs") == 0)
+		{
+			if (i == argc - 1)
+			{
+				std::fprintf(stderr, "error: --jobs requires an argument.\n");
+				return 1;
+			}
+
+			char* end;
+			unsigned long value = std::strtoul(argv[++i], &end, 10);
+			if (*end || value == 0 || value > 1024)
+			{
+				std::fprintf(stderr, "error: Invalid job count '%s'.\n", argv[i]);
+				return 1;
+			}
+
+			jobCount = static_cast<unsigned int>(value);
+		}
+		else if (std::strcmp(argv[i], "--memory-budget") == 0)
+		{
+			if (i == argc - 1)
+			{
+				std::fprintf(stderr, "error: --memory-budget requires an argument.\n");
+				return 1;
+			}
+
+			char* end;
+			unsigned long long value = std::strtoull(argv[++i], &end, 10);
+			if (*end || value == 0 || value > (1ULL << 44))
+			{
+				std::fprintf(stderr, "error: Invalid memory budget '%s'.\n", argv[i]);
+				return 1;
+			}
+
+			memoryBudget = static_cast<std::uint64_t>(value)*1024*1024;
+		}
+		else if (std::strcmp(argv[i], "--trace") == 0)
+		{
+			if (i == argc - 1)
+			{
+				std::fprintf(stderr, "error: --trace requires an argument.\n");
+				return 1;
+			}
+
+			trace = argv[++i];
+		}
+		else if (std::strcmp(argv[i], "--serve") == 0)
+		{
+			if (i == argc - 1)
+			{
+				std::fprintf(stderr, "error: --serve requires an argument.\n");
+				return 1;
+			}
+
+			serveSocket = argv[++i];
+		}
+		else if (std::strcmp(argv[i], "--connect") == 0)
+		{
+			if (i == argc - 1)
+			{
+				std::fprintf(stderr, "error: --connect requires an argument.\n");
+				return 1;
+			}
+
+			connectSocket = argv[++i];
+		}
+		else if (std::strcmp(argv[i], "--cache-dir") == 0)
+		{
+			if (i == argc - 1)
+			{
+				std::fprintf(stderr, "error: --cache-dir requires an argument.\n");
+				return 1;
+			}
+
+			cacheDir = argv[++i];
+		}
+		else if (std::strcmp(argv[i], "--cache-size") == 0)
+		{
+			if (i == argc - 1)
+			{
+				std::fprintf(stderr, "error: --cache-size requires an argument.\n");
+				return 1;
+			}
+
+			char* end;
+			unsigned long long value = std::strtoull(argv[++i], &end, 10);
+			if (*end || value == 0 || value > (1ULL << 44))
+			{
+				std::fprintf(stderr, "error: Invalid cache size '%s'.\n", argv[i]);
+				return 1;
+			}
+
+			cacheSize = static_cast<std::uint64_t>(value)*1024*1024;
+		}
+		else if (std::strcmp(argv[i], "--stats") == 0)
+			options.printStats = true;
+		else if (std::strcmp(argv[i], "--compact") == 0)
+			options.compact = true;
+		else if (std::strcmp(argv[i], "--container") == 0)
+			options.container = true;
+		else if (std::strcmp(argv[i], "--compress") == 0)
+			options.compress = true;
+		else if (std::strcmp(argv[i], "--lod") == 0)
+		{
+			if (i == argc - 1)
+			{
+				std::fprintf(stderr, "error: --lod requires an argument.\n");
+				return 1;
+			}
+
+			if (!parseLodRatios(options.lodRatios, argv[++i]))
+			{
+				std::fprintf(stderr, "error: Invalid LOD ratios '%s'.\n", argv[i]);
+				return 1;
+			}
+		}
+		else if (std::strcmp(argv[i], "--lod-position") == 0)
+		{
+			if (i == argc - 1)
+			{
+				std::fprintf(stderr, "error: --lod-position requires an argument.\n");
+				return 1;
+			}
+
+			options.lodPosition = argv[++i];
+		}
+		else
+		{
+			std::fprintf(stderr, "error: Unknown argument '%s'.\n", argv[i]);
+			return 1;
+		}
+	}
+
+	if (!batch.empty() && (!input.empty() || !output.empty()))
+	{
+		std::fprintf(stderr, "error: --batch may not be used with --input or --output.\n");
+		return 1;
+	}
+
+	if (!serveSocket.empty() && (!input.empty() || !output.empty() || !batch.empty() ||
+			!connectSocket.empty()))
+	{
+		std::fprintf(stderr,
+			"error: --serve may not be used with --input, --output, --batch, or --connect.\n");
+		return 1;
+	}
+
+	if (!connectSocket.empty() && !batch.empty())
+	{
+		std::fprintf(stderr, "error: --connect may not be used with --batch.\n");
+		return 1;
+	}
+
+	if (options.container && output.empty() && batch.empty() && serveSocket.empty())
+	{
+		std::fprintf(stderr, "error: --container requires --output.\n");
+		return 1;
+	}
+
+	if (options.compress && options.container)
+	{
+		std::fprintf(stderr, "error: --compress may not be used with --container.\n");
+		return 1;
+	}
+
+	if (!options.lodRatios.empty() && options.container)
+	{
+		std::fprintf(stderr, "error: --lod may not be used with --container.\n");
+		return 1;
+	}
+
+	if (jobCount > 1 && batch.empty())
+	{
+		std::fprintf(stderr, "error: --jobs requires --batch.\n");
+		return 1;
+	}
+
+	if (!trace.empty())
+	{
+#if VFC_ENABLE_TRACING
+		vfc::Trace::start();
+#else
+		std::fprintf(stderr,
+			"error: --trace requires building with the VFC_ENABLE_TRACING CMake option.\n");
+		return 1;
+#endif
+	}
+
+	std::unique_ptr<ConversionCache> cache;
+	if (!cacheDir.empty())
+	{
+		cache.reset(new ConversionCache(cacheDir, cacheSize));
+		if (!cache->initialize())
+		{
+			std::fprintf(stderr, "error: Couldn't create cache directory '%s'.\n",
+				cacheDir.c_str());
+			return 1;
+		}
+		options.cache = cache.get();
+	}
+
+	bool success;
+	if (!serveSocket.empty())
+		success = serve(serveSocket, options, memoryBudget);
+	else if (!connectSocket.empty())
+		success = processInputWithServer(connectSocket, input, output, options);
+	else if (batch.empty())
+	{
+		ProcessState state;
+		success = processInput(state, input, output, options);
+	}
+	else
+		success = processBatch(batch, options, jobCount, memoryBudget);
+	if (!trace.empty() && !writeTrace(trace))
+		return 1;
+	return success ? 0 : 1;
 }
@@ -1,5 +1,5 @@
 /*
- * Copyright 2020 Aaron Barany
+ * Copyright 2020-2026 Aaron Barany
  *
  * Licensed under the Apache License, Version 2.0 (the "License");
  * you may not use this file except in compliance with the License.
@@ -15,8 +15,11 @@
  */
 
 #include "Base64.h"
+#include <algorithm>
+#include <chrono>
 #include <cstring>
 #include <gtest/gtest.h>
+#include <random>
 
 TEST(Base64Test, AllCharacters)
 {
@@ -77,3 +80,95 @@ TEST(Base64Test, DecodeError)
 	EXPECT_FALSE(base64::decode(data, "ABC=ABCD"));
 	EXPECT_FALSE(base64::decode(data, "A==="));
 }
+
+TEST(Base64Test, RandomRoundTrip)
+{
+	std::mt19937 random(1234);
+	std::uniform_int_distribution<unsigned int> byteDistribution(0, 255);
+	std::uniform_int_distribution<std::size_t> sizeDistribution(0, 300);
+	for (int i = 0; i < 1000; ++i)
+	{
+		std::vector<std::uint8_t> data(sizeDistribution(random));
+		for (std::uint8_t& byte : data)
+			byte = static_cast<std::uint8_t>(byteDistribution(random));
+
+		std::string encoded = base64::encode(data.data(), data.size());
+		ASSERT_EQ(base64::encodeScalar(data.data(), data.size()), encoded);
+		ASSERT_EQ((data.size() + 2)/3*4, encoded.size());
+
+		std::vector<std::uint8_t> decoded = {1, 2, 3};
+		ASSERT_TRUE(base64::decode(decoded, encoded.c_str()));
+		ASSERT_EQ(data.size() + 3, decoded.size());
+		EXPECT_TRUE(std::equal(data.begin(), data.end(), decoded.begin() + 3));
+
+		decoded.clear();
+		ASSERT_TRUE(base64::decodeScalar(decoded, encoded.c_str()));
+		EXPECT_EQ(data, decoded);
+	}
+}
+
+TEST(Base64Test, RandomDecodeError)
+{
+	// Invalid characters at every position of a string long enough for the SIMD paths.
+	std::vector<std::uint8_t> data(200);
+	for (std::size_t i = 0; i < data.size(); ++i)
+		data[i] = static_cast<std::uint8_t>(i*13);
+	std::string encoded = base64::encode(data.data(), data.size());
+
+	const char invalidChars[] = {'(', '=', '\x80', '\xFF', '-', '_', ' '};
+	for (std::size_t i = 0; i < encoded.size(); ++i)
+	{
+		for (char c : invalidChars)
+		{
+			std::string invalidEncoded = encoded;
+			invalidEncoded[i] = c;
+			// Padding is valid in the final characters.
+			if (c == '=' && i >= encoded.size() - 2)
+				continue;
+
+			std::vector<std::uint8_t> decoded;
+			EXPECT_FALSE(base64::decode(decoded, invalidEncoded.c_str())) << i << " " << c;
+			EXPECT_TRUE(decoded.empty());
+			EXPECT_FALSE(base64::decodeScalar(decoded, invalidEncoded.c_str()));
+		}
+	}
+}
+
+TEST(Base64Test, LargeRoundTrip)
+{
+	// Large enough to report a meaningful throughput for the SIMD and scalar implementations.
+	const std::size_t size = 16*1024*1024 + 1;
+	std::vector<std::uint8_t> data(size);
+	std::mt19937 random(5678);
+	for (std::uint8_t& byte : data)
+		byte = static_cast<std::uint8_t>(random());
+
+	using Clock = std::chrono::steady_clock;
+	auto recordThroughput = [](const char* name, Clock::time_point start, std::size_t bytes)
+	{
+		double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+		::testing::Test::RecordProperty(name,
+			std::to_string(static_cast<double>(bytes)/(1024*1024)/seconds) + " MB/s");
+	};
+
+	Clock::time_point start = Clock::now();
+	std::string encoded = base64::encode(data.data(), data.size());
+	recordThroughput("encode", start, size);
+
+	start = Clock::now();
+	std::string scalarEncoded = base64::encodeScalar(data.data(), data.size());
+	recordThroughput("encodeScalar", start, size);
+	ASSERT_EQ(scalarEncoded, encoded);
+
+	std::vector<std::uint8_t> decoded;
+	start = Clock::now();
+	ASSERT_TRUE(base64::decode(decoded, encoded.c_str()));
+	recordThroughput("decode", start, size);
+	EXPECT_EQ(data, decoded);
+
+	decoded.clear();
+	start = Clock::now();
+	ASSERT_TRUE(base64::decodeScalar(decoded, encoded.c_str()));
+	recordThroughput("decodeScalar", start, size);
+	EXPECT_EQ(data, decoded);
+}
@@ -1,5 +1,5 @@
 /*
- * Copyright 2020-2021 Aaron Barany
+ * Copyright 2020-2026 Aaron Barany
  *
  * Licensed under the Apache License, Version 2.0 (the "License");
  * you may not use this file except in compliance with the License.
@@ -14,8 +14,43 @@
  * limitations under the License.
  */
 
+#include "Base64.h"
 #include "ConfigFile.h"
+#include <VFC/InputContainer.h>
 #include <gtest/gtest.h>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+
+static std::string base64Config(const std::string& vertexData, const std::string& indexData)
+{
+	return
+		"{\n"
+		"    \"vertexFormat\": [[\n"
+		"        {\n"
+		"            \"name\": \"foo\",\n"
+		"            \"layout\": \"r8g8b8a8\",\n"
+		"            \"type\": \"unorm\"\n"
+		"        }\n"
+		"    ]],\n"
+		"    \"indexType\": \"uint16\",\n"
+		"    \"vertexStreams\": [\n"
+		"        {\n"
+		"            \"vertexFormat\": [\n"
+		"                {\n"
+		"                    \"name\": \"foo\",\n"
+		"                    \"layout\": \"r8g8b8a8\",\n"
+		"                    \"type\": \"unorm\"\n"
+		"                }\n"
+		"            ],\n"
+		"            \"vertexData\": \"" + vertexData + "\",\n"
+		"            \"indexType\": \"uint16\",\n"
+		"            \"indexData\": \"" + indexData + "\"\n"
+		"        }\n"
+		"    ]\n"
+		"}";
+}
 
 TEST(ConfigFileTest, CompleteConfig)
 {
@@ -109,6 +144,132 @@ TEST(ConfigFileTest, CompleteConfig)
 	EXPECT_EQ(expectedTransforms, configFile.getTransforms());
 }
 
+TEST(ConfigFileTest, Base64Data)
+{
+	// Large enough to span multiple reads from the stream.
+	std::vector<std::uint8_t> vertexData(100000);
+	for (std::size_t i = 0; i < vertexData.size(); ++i)
+		vertexData[i] = static_cast<std::uint8_t>(i*7);
+	std::vector<std::uint8_t> indexData = {0, 0, 1, 0, 2, 0};
+
+	std::stringstream stream(base64Config(
+		"base64:" + base64::encode(vertexData.data(), vertexData.size()),
+		"BASE64:" + base64::encode(indexData.data(), indexData.size())));
+	ConfigFile configFile;
+	ASSERT_TRUE(configFile.load(stream, "foo.json"));
+
+	const std::vector<ConfigFile::VertexStream>& vertexStreams = configFile.getVertexStreams();
+	ASSERT_EQ(1U, vertexStreams.size());
+	EXPECT_EQ("", vertexStreams[0].vertexData);
+	EXPECT_EQ("", vertexStreams[0].indexData);
+	EXPECT_EQ(vertexData, vertexStreams[0].decodedVertexData);
+	EXPECT_EQ(indexData, vertexStreams[0].decodedIndexData);
+}
+
+TEST(ConfigFileTest, InvalidBase64Data)
+{
+	std::vector<std::string> messages;
+	ConfigFile configFile;
+	EXPECT_FALSE(configFile.load(base64Config("base64:AAAA!", "index.dat").c_str(), "foo.json",
+		[&messages](const char* message) {messages.push_back(message);}));
+
+	std::vector<std::string> expectedMessages =
+	{
+		"foo.json: error: Invalid base64 encoding for vertex data."
+	};
+	EXPECT_EQ(expectedMessages, messages);
+
+	messages.clear();
+	EXPECT_FALSE(configFile.load(base64Config("vertex.dat", "base64:AA").c_str(), "foo.json",
+		[&messages](const char* message) {messages.push_back(message);}));
+
+	expectedMessages =
+	{
+		"foo.json: error: Invalid base64 encoding for index data."
+	};
+	EXPECT_EQ(expectedMessages, messages);
+}
+
+TEST(ConfigFileTest, InputContainer)
+{
+	std::vector<vfc::VertexFormat> vertexFormat(1);
+	ASSERT_EQ(vfc::VertexFormat::AddResult::Succeeded, vertexFormat[0].appendElement("foo",
+		vfc::ElementLayout::X8Y8Z8W8, vfc::ElementType::UNorm));
+	vfc::VertexFormat streamFormat;
+	ASSERT_EQ(vfc::VertexFormat::AddResult::Succeeded, streamFormat.appendElement("foo",
+		vfc::ElementLayout::X32Y32Z32W32, vfc::ElementType::Float));
+
+	float vertexData[] = {0.0f, 0.25f, 0.5f, 1.0f, 1.0f, 0.5f, 0.25f, 0.0f};
+	std::uint16_t indexData[] = {0, 1, 1};
+	vfc::InputContainerWriter writer(vertexFormat, vfc::IndexType::UInt32,
+		vfc::PrimitiveType::TriangleStrip);
+	writer.addVertexStream(streamFormat, vertexData, 2, vfc::IndexType::UInt16, indexData, 3);
+	writer.setElementTransform("foo", vfc::Converter::Transform::Bounds);
+	std::string container(writer.getSize(), 0);
+	ASSERT_TRUE(writer.write(&container[0], container.size()));
+
+	auto checkConfig = [&](ConfigFile& configFile)
+	{
+		EXPECT_EQ(vertexFormat, configFile.getVertexFormat());
+		EXPECT_EQ(vfc::IndexType::UInt32, configFile.getIndexType());
+		EXPECT_EQ(vfc::PrimitiveType::TriangleStrip, configFile.getPrimitiveType());
+
+		std::vector<std::pair<std::string, vfc::Converter::Transform>> expectedTransforms =
+			{{"foo", vfc::Converter::Transform::Bounds}};
+		EXPECT_EQ(expectedTransforms, configFile.getTransforms());
+
+		const std::vector<ConfigFile::VertexStream>& vertexStreams =
+			configFile.getVertexStreams();
+		ASSERT_EQ(1U, vertexStreams.size());
+		const ConfigFile::VertexStream& vertexStream = vertexStreams[0];
+		EXPECT_EQ(streamFormat, vertexStream.vertexFormat);
+		EXPECT_EQ(vfc::IndexType::UInt16, vertexStream.indexType);
+		EXPECT_EQ("", vertexStream.vertexData);
+		EXPECT_EQ("", vertexStream.indexData);
+		ASSERT_EQ(sizeof(vertexData), vertexStream.containerVertexDataSize);
+		EXPECT_EQ(0, std::memcmp(vertexData, vertexStream.containerVertexData,
+			sizeof(vertexData)));
+		ASSERT_EQ(sizeof(indexData), vertexStream.containerIndexDataSize);
+		EXPECT_EQ(0, std::memcmp(indexData, vertexStream.containerIndexData,
+			sizeof(indexData)));
+
+		// The vertex streams reference the container data.
+		InputData containerData = configFile.takeContainerData();
+		ASSERT_EQ(container.size(), containerData.size());
+		EXPECT_GE(vertexStream.containerVertexData, containerData.data());
+		EXPECT_LT(vertexStream.containerVertexData, containerData.data() + containerData.size());
+	};
+
+	ConfigFile configFile;
+	ASSERT_TRUE(configFile.load(container.data(), container.size(), "foo.vfci"));
+	checkConfig(configFile);
+
+	std::stringstream stream(container);
+	ASSERT_TRUE(configFile.load(stream, "stdin"));
+	checkConfig(configFile);
+
+	const char* fileName = "ConfigFileTest.vfci";
+	{
+		std::ofstream fileStream(fileName, std::ios_base::out | std::ios_base::binary);
+		ASSERT_TRUE(fileStream.is_open());
+		fileStream.write(container.data(), static_cast<std::streamsize>(container.size()));
+	}
+	bool loaded = configFile.load(fileName);
+	std::remove(fileName);
+	ASSERT_TRUE(loaded);
+	checkConfig(configFile);
+
+	std::vector<std::string> messages;
+	EXPECT_FALSE(configFile.load(container.data(), container.size() - 1, "foo.vfci",
+		[&messages](const char* message) {messages.push_back(message);}));
+
+	std::vector<std::string> expectedMessages =
+	{
+		"foo.vfci: error: Invalid input container."
+	};
+	EXPECT_EQ(expectedMessages, messages);
+}
+
 TEST(ConfigFileTest, InvalidJson)
 {
 	const char* json =
@@ -131,6 +292,28 @@ TEST(ConfigFileTest, InvalidJson)
 	EXPECT_EQ(expectedMessages, messages);
 }
 
+TEST(ConfigFileTest, InvalidJsonStream)
+{
+	// Error is past the first read from the stream.
+	std::string json = "{\n    \"test\": \"" + std::string(100000, 'a') + "\",\n    \"foo\" 1\n}";
+	std::stringstream stream(json);
+
+	std::vector<std::string> messages;
+	ConfigFile configFile;
+	EXPECT_FALSE(configFile.load(stream, "foo.json",
+		[&messages](const char* message) {messages.push_back(message);}));
+
+	std::vector<std::string> expectedMessages =
+	{
+#if VFC_WINDOWS
+		"foo.json(3, 11) : error: Missing ':' after object member name."
+#else
+		"foo.json:3:11: error: Missing ':' after object member name."
+#endif
+	};
+	EXPECT_EQ(expectedMessages, messages);
+}
+
 TEST(ConfigFileTest, InvalidVertexFormat)
 {
 	const char* json = "{}";
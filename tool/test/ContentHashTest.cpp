@@ -0,0 +1,80 @@
+/*
+ * Copyright 2026 Aaron Barany
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "ContentHash.h"
+#include <gtest/gtest.h>
+#include <vector>
+
+namespace
+{
+
+std::uint64_t hashString(const char* string, std::uint64_t seed = 0)
+{
+	ContentHash hash(seed);
+	hash.add(string, std::strlen(string));
+	return hash.finish();
+}
+
+} // namespace
+
+// Expected values are from the reference XXH64 implementation.
+TEST(ContentHashTest, KnownValues)
+{
+	EXPECT_EQ(0xEF46DB3751D8E999ULL, hashString(""));
+	EXPECT_EQ(0xD24EC4F1A98C6E5BULL, hashString("a"));
+	EXPECT_EQ(0x44BC2CF5AD770999ULL, hashString("abc"));
+	EXPECT_EQ(0x2151859F42F363E2ULL, hashString("abc", 1234));
+	EXPECT_EQ(0xFBCEA83C8A378BF1ULL, hashString("Nobody inspects the spammish repetition"));
+}
+
+TEST(ContentHashTest, Streaming)
+{
+	std::vector<std::uint8_t> data;
+	for (int i = 0; i < 3; ++i)
+	{
+		for (int j = 0; j < 256; ++j)
+			data.push_back(static_cast<std::uint8_t>(j));
+	}
+	data.push_back('x');
+	data.push_back('y');
+	data.push_back('z');
+
+	ContentHash fullHash;
+	fullHash.add(data.data(), data.size());
+	EXPECT_EQ(0xE921A1B45BD779F8ULL, fullHash.finish());
+	EXPECT_EQ("e921a1b45bd779f8", fullHash.finishHex());
+
+	// Split at sizes that cross the internal block boundaries.
+	for (std::size_t step : {1U, 5U, 31U, 33U, 100U})
+	{
+		ContentHash hash;
+		for (std::size_t i = 0; i < data.size(); i += step)
+			hash.add(data.data() + i, std::min(step, data.size() - i));
+		EXPECT_EQ(fullHash.finish(), hash.finish());
+	}
+}
+
+TEST(ContentHashTest, Strings)
+{
+	ContentHash firstHash;
+	firstHash.add(std::string("ab"));
+	firstHash.add(std::string("c"));
+
+	ContentHash secondHash;
+	secondHash.add(std::string("a"));
+	secondHash.add(std::string("bc"));
+	EXPECT_NE(firstHash.finish(), secondHash.finish());
+}
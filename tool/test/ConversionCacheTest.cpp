@@ -0,0 +1,207 @@
+/*
+ * Copyright 2026 Aaron Barany
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "ConversionCache.h"
+#include "InputData.h"
+#include "Path.h"
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <ctime>
+
+#if VFC_WINDOWS
+#include <sys/utime.h>
+#define utime _utime
+#define utimbuf _utimbuf
+#else
+#include <utime.h>
+#endif
+
+namespace
+{
+
+const char* testDir = "ConversionCacheTest";
+
+void removeTree(const std::string& directory)
+{
+	std::vector<std::string> names;
+	if (!path::listDirectory(names, directory))
+		return;
+
+	for (const std::string& name : names)
+	{
+		std::string curPath = path::join(directory, name);
+		if (!path::removeFile(curPath))
+			removeTree(curPath);
+	}
+	path::removeDirectory(directory);
+}
+
+void setModifiedTime(const std::string& fileName, std::time_t time)
+{
+	utimbuf times;
+	times.actime = time;
+	times.modtime = time;
+	ASSERT_EQ(0, utime(fileName.c_str(), &times));
+}
+
+std::vector<std::uint8_t> loadFile(const std::string& fileName)
+{
+	InputData data;
+	EXPECT_TRUE(data.loadFile(fileName));
+	return std::vector<std::uint8_t>(data.data(), data.data() + data.size());
+}
+
+class ConversionCacheTest : public testing::Test
+{
+protected:
+	void SetUp() override
+	{
+		removeTree(testDir);
+
+		vertexFormat.resize(2);
+		vertexFormat[0].appendElement("position", vfc::ElementLayout::X32Y32Z32,
+			vfc::ElementType::Float);
+		vertexFormat[1].appendElement("texCoord", vfc::ElementLayout::X16Y16,
+			vfc::ElementType::UNorm);
+		bounds =
+		{
+			{Bounds{vfc::VertexValue(-1.5, -2, -3), vfc::VertexValue(1, 2, 3.25)}},
+			{Bounds{vfc::VertexValue(0, 0), vfc::VertexValue(0.1, 1)}}
+		};
+
+		positions.resize(3*12);
+		texCoords.resize(3*4);
+		indices.resize(6*2);
+		for (std::size_t i = 0; i < positions.size(); ++i)
+			positions[i] = static_cast<std::uint8_t>(i);
+		for (std::size_t i = 0; i < texCoords.size(); ++i)
+			texCoords[i] = static_cast<std::uint8_t>(i*3);
+		for (std::size_t i = 0; i < indices.size(); ++i)
+			indices[i] = static_cast<std::uint8_t>(i*5);
+	}
+
+	void TearDown() override
+	{
+		removeTree(testDir);
+	}
+
+	bool store(ConversionCache& cache, const std::string& key)
+	{
+		std::vector<VertexFileData> vertexData =
+		{
+			{nullptr, positions.data(), positions.size()},
+			{nullptr, texCoords.data(), texCoords.size()}
+		};
+		std::vector<IndexFileData> indexData =
+		{
+			{3, 0, nullptr, indices.data(), 6},
+			{3, 2, nullptr, indices.data() + 6, 6}
+		};
+		return cache.store(key, vertexFormat, bounds, vertexData, 3, vfc::IndexType::UInt16,
+			indexData);
+	}
+
+	std::vector<vfc::VertexFormat> vertexFormat;
+	std::vector<std::vector<Bounds>> bounds;
+	std::vector<std::uint8_t> positions;
+	std::vector<std::uint8_t> texCoords;
+	std::vector<std::uint8_t> indices;
+};
+
+} // namespace
+
+TEST_F(ConversionCacheTest, StoreFind)
+{
+	ConversionCache cache(testDir, 1024*1024);
+	ASSERT_TRUE(cache.initialize());
+
+	ConversionCache::Entry entry;
+	EXPECT_FALSE(cache.find(entry, "0123456789abcdef"));
+	ASSERT_TRUE(store(cache, "0123456789abcdef"));
+	ASSERT_TRUE(cache.find(entry, "0123456789abcdef"));
+
+	EXPECT_EQ(3U, entry.vertexCount);
+	ASSERT_EQ(2U, entry.bounds.size());
+	for (std::size_t i = 0; i < bounds.size(); ++i)
+	{
+		ASSERT_EQ(1U, entry.bounds[i].size());
+		EXPECT_EQ(bounds[i][0].min, entry.bounds[i][0].min);
+		EXPECT_EQ(bounds[i][0].max, entry.bounds[i][0].max);
+	}
+
+	ASSERT_EQ(2U, entry.vertexFiles.size());
+	EXPECT_EQ(positions, loadFile(entry.vertexFiles[0]));
+	EXPECT_EQ(texCoords, loadFile(entry.vertexFiles[1]));
+
+	ASSERT_EQ(2U, entry.indexBuffers.size());
+	ASSERT_EQ(2U, entry.indexFiles.size());
+	EXPECT_EQ(3U, entry.indexBuffers[0].count);
+	EXPECT_EQ(0, entry.indexBuffers[0].baseVertex);
+	EXPECT_EQ(3U, entry.indexBuffers[1].count);
+	EXPECT_EQ(2, entry.indexBuffers[1].baseVertex);
+	EXPECT_EQ(std::vector<std::uint8_t>(indices.begin(), indices.begin() + 6),
+		loadFile(entry.indexFiles[0]));
+	EXPECT_EQ(std::vector<std::uint8_t>(indices.begin() + 6, indices.end()),
+		loadFile(entry.indexFiles[1]));
+
+	// Storing again keeps the existing entry.
+	EXPECT_TRUE(store(cache, "0123456789abcdef"));
+	EXPECT_TRUE(cache.find(entry, "0123456789abcdef"));
+
+	// Only the entry remains, without any temporary directories.
+	std::vector<std::string> names;
+	ASSERT_TRUE(path::listDirectory(names, testDir));
+	EXPECT_EQ(std::vector<std::string>{"0123456789abcdef"}, names);
+}
+
+TEST_F(ConversionCacheTest, Evict)
+{
+	const char* keys[] = {"0000000000000000", "1111111111111111", "2222222222222222"};
+	ConversionCache cache(testDir, 0);
+	ASSERT_TRUE(cache.initialize());
+	for (const char* key : keys)
+		ASSERT_TRUE(store(cache, key));
+
+	std::uint64_t entrySize = positions.size() + texCoords.size() + indices.size();
+	std::uint64_t resultSize;
+	std::int64_t time;
+	ASSERT_TRUE(path::getFileInfo(resultSize, time,
+		path::join(path::join(testDir, keys[0]), "result.json")));
+	entrySize += resultSize;
+
+	ConversionCache largeCache(testDir, entrySize*3);
+	largeCache.evict();
+	ConversionCache::Entry entry;
+	for (const char* key : keys)
+		EXPECT_TRUE(largeCache.find(entry, key));
+
+	// The second entry was used least recently, then the first.
+	std::time_t now = std::time(nullptr);
+	setModifiedTime(path::join(path::join(testDir, keys[0]), "result.json"), now - 100);
+	setModifiedTime(path::join(path::join(testDir, keys[1]), "result.json"), now - 200);
+	setModifiedTime(path::join(path::join(testDir, keys[2]), "result.json"), now);
+
+	ConversionCache smallCache(testDir, entrySize*2);
+	smallCache.evict();
+	EXPECT_FALSE(smallCache.find(entry, keys[1]));
+	EXPECT_TRUE(smallCache.find(entry, keys[0]));
+	EXPECT_TRUE(smallCache.find(entry, keys[2]));
+
+	cache.evict();
+	std::vector<std::string> names;
+	ASSERT_TRUE(path::listDirectory(names, testDir));
+	EXPECT_TRUE(names.empty());
+}
@@ -0,0 +1,125 @@
+/*
+ * Copyright 2026 Aaron Barany
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "InputData.h"
+#include <gtest/gtest.h>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+
+namespace
+{
+
+const char* testFileName = "InputDataTest.dat";
+
+void writeTestFile(const std::vector<std::uint8_t>& data)
+{
+	std::ofstream stream(testFileName,
+		std::ios_base::out | std::ios_base::trunc | std::ios_base::binary);
+	ASSERT_TRUE(stream.is_open());
+	stream.write(reinterpret_cast<const char*>(data.data()), data.size());
+	ASSERT_TRUE(stream.good());
+}
+
+std::vector<std::uint8_t> createTestData()
+{
+	std::vector<std::uint8_t> data(10000);
+	for (std::size_t i = 0; i < data.size(); ++i)
+		data[i] = static_cast<std::uint8_t>(i*7);
+	return data;
+}
+
+} // namespace
+
+TEST(InputDataTest, MapFile)
+{
+	std::vector<std::uint8_t> expectedData = createTestData();
+	writeTestFile(expectedData);
+
+	InputData data;
+	ASSERT_TRUE(data.loadFile(testFileName));
+	EXPECT_TRUE(data.isMapped());
+	ASSERT_EQ(expectedData.size(), data.size());
+	EXPECT_EQ(0, std::memcmp(expectedData.data(), data.data(), data.size()));
+
+	InputData movedData(std::move(data));
+	EXPECT_TRUE(data.empty());
+	ASSERT_EQ(expectedData.size(), movedData.size());
+	EXPECT_EQ(0, std::memcmp(expectedData.data(), movedData.data(), movedData.size()));
+
+	movedData.reset();
+	EXPECT_TRUE(movedData.empty());
+	EXPECT_FALSE(movedData.isMapped());
+	std::remove(testFileName);
+}
+
+TEST(InputDataTest, ReadFile)
+{
+	std::vector<std::uint8_t> expectedData = createTestData();
+	writeTestFile(expectedData);
+
+	InputData data;
+	ASSERT_TRUE(data.loadFile(testFileName, false));
+	EXPECT_FALSE(data.isMapped());
+	ASSERT_EQ(expectedData.size(), data.size());
+	EXPECT_EQ(0, std::memcmp(expectedData.data(), data.data(), data.size()));
+	std::remove(testFileName);
+}
+
+TEST(InputDataTest, EmptyFile)
+{
+	writeTestFile(std::vector<std::uint8_t>());
+
+	InputData data;
+	ASSERT_TRUE(data.loadFile(testFileName));
+	EXPECT_FALSE(data.isMapped());
+	EXPECT_TRUE(data.empty());
+	std::remove(testFileName);
+}
+
+TEST(InputDataTest, MissingFile)
+{
+	InputData data;
+	EXPECT_FALSE(data.loadFile("InputDataTestMissing.dat"));
+	EXPECT_TRUE(data.empty());
+}
+
+TEST(InputDataTest, SetData)
+{
+	std::vector<std::uint8_t> expectedData = createTestData();
+	InputData data;
+	data.setData(expectedData);
+	EXPECT_FALSE(data.isMapped());
+	ASSERT_EQ(expectedData.size(), data.size());
+	EXPECT_EQ(0, std::memcmp(expectedData.data(), data.data(), data.size()));
+}
+
+TEST(InputDataTest, SetView)
+{
+	std::vector<std::uint8_t> expectedData = createTestData();
+	InputData data;
+	data.setView(expectedData.data(), expectedData.size());
+	EXPECT_FALSE(data.isMapped());
+	EXPECT_EQ(expectedData.data(), data.data());
+	EXPECT_EQ(expectedData.size(), data.size());
+
+	InputData movedData(std::move(data));
+	EXPECT_TRUE(data.empty());
+	EXPECT_EQ(expectedData.data(), movedData.data());
+	movedData.reset();
+	EXPECT_TRUE(movedData.empty());
+	EXPECT_EQ(createTestData(), expectedData);
+}
@@ -0,0 +1,176 @@
+/*
+ * Copyright 2026 Aaron Barany
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "JobPool.h"
+#include <gtest/gtest.h>
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+TEST(JobPoolTest, RunSingleThread)
+{
+	std::vector<std::uint64_t> priorities = {1, 5, 3, 5, 0};
+	std::vector<std::size_t> order;
+	JobPool::run(1, priorities,
+		[&order](std::size_t job, unsigned int thread)
+		{
+			EXPECT_EQ(0U, thread);
+			order.push_back(job);
+		});
+
+	std::vector<std::size_t> expectedOrder = {1, 3, 2, 0, 4};
+	EXPECT_EQ(expectedOrder, order);
+}
+
+TEST(JobPoolTest, RunMultipleThreads)
+{
+	const unsigned int threadCount = 4;
+	std::vector<std::uint64_t> priorities(1000);
+	for (std::size_t i = 0; i < priorities.size(); ++i)
+		priorities[i] = i % 7;
+
+	std::vector<std::atomic<unsigned int>> runCounts(priorities.size());
+	for (std::atomic<unsigned int>& runCount : runCounts)
+		runCount = 0;
+
+	JobPool::run(threadCount, priorities,
+		[&runCounts, threadCount](std::size_t job, unsigned int thread)
+		{
+			EXPECT_GT(threadCount, thread);
+			++runCounts[job];
+			// Uneven job lengths so threads steal from each other.
+			if (thread == 0 && job % 10 == 0)
+				std::this_thread::sleep_for(std::chrono::microseconds(100));
+		});
+
+	for (const std::atomic<unsigned int>& runCount : runCounts)
+		EXPECT_EQ(1U, runCount);
+}
+
+TEST(JobPoolTest, RunNoJobs)
+{
+	bool called = false;
+	JobPool::run(4, std::vector<std::uint64_t>(),
+		[&called](std::size_t, unsigned int)
+		{
+			called = true;
+		});
+	EXPECT_FALSE(called);
+}
+
+TEST(JobPoolTest, MemoryBudget)
+{
+	const unsigned int threadCount = 4;
+	const std::uint64_t budgetSize = 100;
+	MemoryBudget budget(budgetSize);
+	std::atomic<std::uint64_t> maxUsed(0);
+	std::vector<std::uint64_t> priorities = {60, 60, 60, 30, 30, 30, 150, 10};
+	JobPool::run(threadCount, priorities,
+		[&](std::size_t job, unsigned int)
+		{
+			MemoryReservation reservation(&budget, priorities[job]);
+			std::uint64_t used = budget.getUsed();
+			std::uint64_t prevMaxUsed = maxUsed;
+			while (used > prevMaxUsed && !maxUsed.compare_exchange_weak(prevMaxUsed, used))
+			{
+			}
+
+			// Jobs larger than the budget run alone.
+			if (priorities[job] > budgetSize)
+				EXPECT_EQ(priorities[job], used);
+			else
+				EXPECT_GE(budgetSize, used);
+			std::this_thread::sleep_for(std::chrono::milliseconds(1));
+		});
+
+	EXPECT_EQ(0U, budget.getUsed());
+	EXPECT_EQ(150U, maxUsed);
+}
+
+TEST(JobPoolTest, MemoryReservationResize)
+{
+	MemoryBudget budget(100);
+	{
+		MemoryReservation reservation(&budget, 60);
+		EXPECT_EQ(60U, budget.getUsed());
+
+		reservation.resize(20);
+		EXPECT_EQ(20U, budget.getUsed());
+
+		// Only reservation, so growing beyond the budget doesn't wait.
+		reservation.resize(150);
+		EXPECT_EQ(150U, budget.getUsed());
+	}
+	EXPECT_EQ(0U, budget.getUsed());
+
+	MemoryReservation reservation(nullptr, 10);
+	reservation.resize(20);
+	EXPECT_EQ(0U, budget.getUsed());
+}
+
+TEST(JobPoolTest, MemoryBudgetWaitsForRelease)
+{
+	MemoryBudget budget(100);
+	budget.acquire(60);
+
+	std::atomic<bool> acquired(false);
+	std::thread thread([&]()
+		{
+			budget.acquire(60);
+			acquired = true;
+		});
+
+	std::this_thread::sleep_for(std::chrono::milliseconds(10));
+	EXPECT_FALSE(acquired);
+
+	budget.release(60);
+	thread.join();
+	EXPECT_TRUE(acquired);
+	EXPECT_EQ(60U, budget.getUsed());
+	budget.release(60);
+}
+
+TEST(JobPoolTest, MemoryReservedBeforeLoading)
+{
+	// Jobs reserve their estimated size before loading, like batch processing, then correct the
+	// size once loaded. Jobs over the budget must never load at the same time.
+	const std::uint64_t budgetSize = 100;
+	MemoryBudget budget(budgetSize);
+	std::atomic<unsigned int> loadingCount(0);
+	std::atomic<unsigned int> maxLoadingCount(0);
+	std::vector<std::uint64_t> priorities = {150, 120, 200, 110};
+	JobPool::run(4, priorities,
+		[&](std::size_t job, unsigned int)
+		{
+			MemoryReservation reservation(&budget, priorities[job]);
+			unsigned int loading = ++loadingCount;
+			unsigned int prevMaxLoading = maxLoadingCount;
+			while (loading > prevMaxLoading &&
+				!maxLoadingCount.compare_exchange_weak(prevMaxLoading, loading))
+			{
+			}
+
+			std::this_thread::sleep_for(std::chrono::milliseconds(5));
+			--loadingCount;
+
+			reservation.resize(priorities[job]*2);
+			EXPECT_EQ(priorities[job]*2, budget.getUsed());
+			std::this_thread::sleep_for(std::chrono::milliseconds(1));
+		});
+
+	EXPECT_EQ(1U, maxLoadingCount);
+	EXPECT_EQ(0U, budget.getUsed());
+}
@@ -0,0 +1,93 @@
+/*
+ * Copyright 2026 Aaron Barany
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "OutputFile.h"
+#include <gtest/gtest.h>
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+
+namespace
+{
+
+const char* testFileName = "OutputFileTest.dat";
+
+std::vector<std::uint8_t> readTestFile()
+{
+	std::ifstream stream(testFileName, std::ios_base::in | std::ios_base::binary);
+	EXPECT_TRUE(stream.is_open());
+	return std::vector<std::uint8_t>(std::istreambuf_iterator<char>(stream), {});
+}
+
+void fillData(OutputFile& file)
+{
+	for (std::size_t i = 0; i < file.size(); ++i)
+		file.data()[i] = static_cast<std::uint8_t>(i*7);
+}
+
+} // namespace
+
+TEST(OutputFileTest, MapFile)
+{
+	OutputFile file;
+	ASSERT_TRUE(file.create(testFileName, 10000));
+	EXPECT_TRUE(file.isMapped());
+	ASSERT_EQ(10000U, file.size());
+	fillData(file);
+
+	OutputFile movedFile(std::move(file));
+	EXPECT_EQ(nullptr, file.data());
+	ASSERT_TRUE(movedFile.close());
+	EXPECT_FALSE(movedFile.isMapped());
+
+	std::vector<std::uint8_t> data = readTestFile();
+	ASSERT_EQ(10000U, data.size());
+	for (std::size_t i = 0; i < data.size(); ++i)
+		EXPECT_EQ(static_cast<std::uint8_t>(i*7), data[i]);
+	std::remove(testFileName);
+}
+
+TEST(OutputFileTest, WriteFile)
+{
+	OutputFile file;
+	ASSERT_TRUE(file.create(testFileName, 10000, false));
+	EXPECT_FALSE(file.isMapped());
+	ASSERT_EQ(10000U, file.size());
+	fillData(file);
+	ASSERT_TRUE(file.close());
+
+	std::vector<std::uint8_t> data = readTestFile();
+	ASSERT_EQ(10000U, data.size());
+	for (std::size_t i = 0; i < data.size(); ++i)
+		EXPECT_EQ(static_cast<std::uint8_t>(i*7), data[i]);
+	std::remove(testFileName);
+}
+
+TEST(OutputFileTest, EmptyFile)
+{
+	OutputFile file;
+	ASSERT_TRUE(file.create(testFileName, 0));
+	EXPECT_FALSE(file.isMapped());
+	ASSERT_TRUE(file.close());
+	EXPECT_TRUE(readTestFile().empty());
+	std::remove(testFileName);
+}
+
+TEST(OutputFileTest, InvalidPath)
+{
+	OutputFile file;
+	EXPECT_FALSE(file.create("OutputFileTestMissing/test.dat", 100));
+}
@@ -71,3 +71,15 @@ TEST(PathTest, Join)
 	EXPECT_EQ("/bar", path::join("foo", "/bar"));
 #endif
 }
+
+TEST(PathTest, MakeAbsolute)
+{
+	std::string absolutePath = path::makeAbsolute("foo");
+	EXPECT_TRUE(path::isAbsolute(absolutePath));
+	EXPECT_EQ("foo", path::getFileName(absolutePath));
+#if VFC_WINDOWS
+	EXPECT_EQ("C:\\bar", path::makeAbsolute("C:\\bar"));
+#else
+	EXPECT_EQ("/bar", path::makeAbsolute("/bar"));
+#endif
+}
@@ -1,5 +1,5 @@
 /*
- * Copyright 2020-2021 Aaron Barany
+ * Copyright 2020-2026 Aaron Barany
  *
  * Licensed under the Apache License, Version 2.0 (the "License");
  * you may not use this file except in compliance with the License.
@@ -14,6 +14,7 @@
  * limitations under the License.
  */
 
+#include "Base64.h"
 #include "ResultFile.h"
 #include <gtest/gtest.h>
 
@@ -33,7 +34,7 @@ TEST(ResultFileTest, NoIndices)
 		{Bounds{vfc::VertexValue(0, 0), vfc::VertexValue(1, 1)}}
 	};
 
-	std::vector<std::string> vertexData = {"positions.dat", "texCoords.dat"};
+	std::vector<VertexFileData> vertexData = {{"positions.dat"}, {"texCoords.dat"}};
 
 	std::string result = resultFile(vertexFormat, bounds, vertexData, 6, vfc::IndexType::NoIndices,
 		{});
@@ -111,7 +112,7 @@ TEST(ResultFileTest, WithIndices)
 		{Bounds{vfc::VertexValue(0, 0), vfc::VertexValue(1, 1)}}
 	};
 
-	std::vector<std::string> vertexData = {"positions.dat", "texCoords.dat"};
+	std::vector<VertexFileData> vertexData = {{"positions.dat"}, {"texCoords.dat"}};
 
 	std::vector<IndexFileData> indexData =
 	{
@@ -191,3 +192,206 @@ TEST(ResultFileTest, WithIndices)
 		"}";
 	EXPECT_EQ(expectedResult, result);
 }
+
+TEST(ResultFileTest, WithStats)
+{
+	std::vector<vfc::VertexFormat> vertexFormat(1);
+	ASSERT_EQ(vfc::VertexFormat::AddResult::Succeeded,
+		vertexFormat[0].appendElement("position", vfc::ElementLayout::X32, vfc::ElementType::Float));
+
+	std::vector<std::vector<Bounds>> bounds =
+		{{Bounds{vfc::VertexValue(-1, 0, 0, 1), vfc::VertexValue(1, 0, 0, 1)}}};
+	std::vector<VertexFileData> vertexData = {{"positions.dat"}};
+
+	vfc::Converter::Stats stats;
+	stats.validateTime = 0.5;
+	stats.boundsTime = 1.0;
+	stats.reserveTime = 1.5;
+	stats.encodeTime = 2.0;
+	stats.dedupTime = 2.5;
+	stats.carryOverTime = 3.0;
+	stats.splitStreamsTime = 3.5;
+	stats.totalTime = 14.0;
+	stats.hashProbes = 1;
+	stats.dedupHits = 2;
+	stats.uniqueVertices = 3;
+	stats.carriedOverVertices = 4;
+	stats.indexBuffers = 5;
+	stats.peakVertexBytes = 6;
+	stats.peakIndexBytes = 7;
+
+	std::string result = resultFile(vertexFormat, bounds, vertexData, 3, vfc::IndexType::NoIndices,
+		{}, &stats);
+
+	const char* expectedResult =
+		"{\n"
+		"    \"vertices\": [\n"
+		"        {\n"
+		"            \"vertexFormat\": [\n"
+		"                {\n"
+		"                    \"name\": \"position\",\n"
+		"                    \"layout\": \"X32\",\n"
+		"                    \"type\": \"Float\",\n"
+		"                    \"offset\": 0,\n"
+		"                    \"minValue\": [\n"
+		"                        -1.0,\n"
+		"                        0.0,\n"
+		"                        0.0,\n"
+		"                        1.0\n"
+		"                    ],\n"
+		"                    \"maxValue\": [\n"
+		"                        1.0,\n"
+		"                        0.0,\n"
+		"                        0.0,\n"
+		"                        1.0\n"
+		"                    ]\n"
+		"                }\n"
+		"            ],\n"
+		"            \"vertexStride\": 4,\n"
+		"            \"vertexData\": \"positions.dat\"\n"
+		"        }\n"
+		"    ],\n"
+		"    \"vertexCount\": 3,\n"
+		"    \"stats\": {\n"
+		"        \"validateTime\": 0.5,\n"
+		"        \"boundsTime\": 1.0,\n"
+		"        \"reserveTime\": 1.5,\n"
+		"        \"encodeTime\": 2.0,\n"
+		"        \"dedupTime\": 2.5,\n"
+		"        \"carryOverTime\": 3.0,\n"
+		"        \"splitStreamsTime\": 3.5,\n"
+		"        \"totalTime\": 14.0,\n"
+		"        \"hashProbes\": 1,\n"
+		"        \"dedupHits\": 2,\n"
+		"        \"uniqueVertices\": 3,\n"
+		"        \"carriedOverVertices\": 4,\n"
+		"        \"indexBuffers\": 5,\n"
+		"        \"peakVertexBytes\": 6,\n"
+		"        \"peakIndexBytes\": 7\n"
+		"    }\n"
+		"}";
+	EXPECT_EQ(expectedResult, result);
+}
+
+TEST(ResultFileTest, EmbeddedDataCompact)
+{
+	std::vector<vfc::VertexFormat> vertexFormat(1);
+	ASSERT_EQ(vfc::VertexFormat::AddResult::Succeeded,
+		vertexFormat[0].appendElement("position", vfc::ElementLayout::X32,
+			vfc::ElementType::Float));
+
+	std::vector<std::vector<Bounds>> bounds =
+		{{Bounds{vfc::VertexValue(-1, 0, 0, 1), vfc::VertexValue(1, 0, 0, 1)}}};
+
+	// Large enough to be encoded in multiple chunks.
+	std::vector<std::uint8_t> vertices(200002);
+	for (std::size_t i = 0; i < vertices.size(); ++i)
+		vertices[i] = static_cast<std::uint8_t>(i*13);
+	std::vector<VertexFileData> vertexData = {{nullptr, vertices.data(), vertices.size()}};
+
+	std::uint16_t indices[] = {0, 1, 2};
+	std::vector<IndexFileData> indexData = {{3, 0, nullptr, indices, sizeof(indices)}};
+
+	std::string result = resultFile(vertexFormat, bounds, vertexData, 50000,
+		vfc::IndexType::UInt16, indexData, nullptr, true);
+
+	std::string expectedResult =
+		"{\"vertices\":[{\"vertexFormat\":[{\"name\":\"position\",\"layout\":\"X32\","
+		"\"type\":\"Float\",\"offset\":0,\"minValue\":[-1.0,0.0,0.0,1.0],"
+		"\"maxValue\":[1.0,0.0,0.0,1.0]}],\"vertexStride\":4,\"vertexData\":\"base64:" +
+		base64::encode(vertices.data(), vertices.size()) + "\"}],\"vertexCount\":50000,"
+		"\"indexType\":\"UInt16\",\"indexBuffers\":[{\"indexCount\":3,\"baseVertex\":0,"
+		"\"indexData\":\"base64:" + base64::encode(indices, sizeof(indices)) + "\"}]}";
+	EXPECT_EQ(expectedResult, result);
+}
+
+TEST(ResultFileTest, Container)
+{
+	std::vector<vfc::VertexFormat> vertexFormat(1);
+	ASSERT_EQ(vfc::VertexFormat::AddResult::Succeeded,
+		vertexFormat[0].appendElement("position", vfc::ElementLayout::X32,
+			vfc::ElementType::Float));
+
+	std::vector<std::vector<Bounds>> bounds =
+		{{Bounds{vfc::VertexValue(-1, 0, 0, 1), vfc::VertexValue(1, 0, 0, 1)}}};
+
+	float vertices[] = {-1.0f, 0.0f, 1.0f};
+	std::vector<VertexFileData> vertexData = {{nullptr, vertices, sizeof(vertices)}};
+
+	std::uint16_t indices[] = {0, 1, 2};
+	std::vector<IndexFileData> indexData = {{3, 0, nullptr, indices, sizeof(indices)}};
+
+	std::string result = resultFile(vertexFormat, bounds, vertexData, 3, vfc::IndexType::UInt16,
+		indexData, nullptr, true, "output/mesh.vfc");
+
+	const char* expectedResult =
+		"{\"container\":\"output/mesh.vfc\",\"vertices\":[{\"vertexFormat\":[{\"name\":"
+		"\"position\",\"layout\":\"X32\",\"type\":\"Float\",\"offset\":0,"
+		"\"minValue\":[-1.0,0.0,0.0,1.0],\"maxValue\":[1.0,0.0,0.0,1.0]}],\"vertexStride\":4}],"
+		"\"vertexCount\":3,\"indexType\":\"UInt16\",\"indexBuffers\":[{\"indexCount\":3,"
+		"\"baseVertex\":0}]}";
+	EXPECT_EQ(expectedResult, result);
+}
+
+TEST(ResultFileTest, Encoding)
+{
+	std::vector<vfc::VertexFormat> vertexFormat(1);
+	ASSERT_EQ(vfc::VertexFormat::AddResult::Succeeded,
+		vertexFormat[0].appendElement("position", vfc::ElementLayout::X32,
+			vfc::ElementType::Float));
+
+	std::vector<std::vector<Bounds>> bounds =
+		{{Bounds{vfc::VertexValue(-1, 0, 0, 1), vfc::VertexValue(1, 0, 0, 1)}}};
+
+	std::vector<VertexFileData> vertexData =
+		{{"vertices.0.dat", nullptr, 0, "vfc-compressed"}};
+
+	std::uint8_t indices[] = {1, 2, 3, 4};
+	std::vector<IndexFileData> indexData =
+		{{3, 0, nullptr, indices, sizeof(indices), "vfc-compressed"}};
+
+	std::string result = resultFile(vertexFormat, bounds, vertexData, 3, vfc::IndexType::UInt16,
+		indexData, nullptr, true);
+
+	std::string expectedResult =
+		"{\"vertices\":[{\"vertexFormat\":[{\"name\":\"position\",\"layout\":\"X32\","
+		"\"type\":\"Float\",\"offset\":0,\"minValue\":[-1.0,0.0,0.0,1.0],"
+		"\"maxValue\":[1.0,0.0,0.0,1.0]}],\"vertexStride\":4,\"encoding\":\"vfc-compressed\","
+		"\"vertexData\":\"vertices.0.dat\"}],\"vertexCount\":3,\"indexType\":\"UInt16\","
+		"\"indexBuffers\":[{\"indexCount\":3,\"baseVertex\":0,\"encoding\":\"vfc-compressed\","
+		"\"indexData\":\"base64:" + base64::encode(indices, sizeof(indices)) + "\"}]}";
+	EXPECT_EQ(expectedResult, result);
+}
+
+TEST(ResultFileTest, Lods)
+{
+	std::vector<vfc::VertexFormat> vertexFormat(1);
+	ASSERT_EQ(vfc::VertexFormat::AddResult::Succeeded,
+		vertexFormat[0].appendElement("position", vfc::ElementLayout::X32,
+			vfc::ElementType::Float));
+
+	std::vector<std::vector<Bounds>> bounds =
+		{{Bounds{vfc::VertexValue(-1, 0, 0, 1), vfc::VertexValue(1, 0, 0, 1)}}};
+
+	std::vector<VertexFileData> vertexData = {{"vertices.0.dat", nullptr, 0}};
+	std::vector<IndexFileData> indexData = {{6, 0, "indices.0.dat", nullptr, 0}};
+
+	std::uint16_t indices[] = {0, 1, 2};
+	std::vector<LodFileData> lods = {{0.5, 0.25, {{3, 0, "lod1.indices.0.dat", nullptr, 0}}},
+		{0.25, 0.5, {{3, 0, nullptr, indices, sizeof(indices)}}}};
+
+	std::string result = resultFile(vertexFormat, bounds, vertexData, 3, vfc::IndexType::UInt16,
+		indexData, nullptr, true, nullptr, &lods);
+
+	std::string expectedResult =
+		"{\"vertices\":[{\"vertexFormat\":[{\"name\":\"position\",\"layout\":\"X32\","
+		"\"type\":\"Float\",\"offset\":0,\"minValue\":[-1.0,0.0,0.0,1.0],"
+		"\"maxValue\":[1.0,0.0,0.0,1.0]}],\"vertexStride\":4,"
+		"\"vertexData\":\"vertices.0.dat\"}],\"vertexCount\":3,\"indexType\":\"UInt16\","
+		"\"indexBuffers\":[{\"indexCount\":6,\"baseVertex\":0,\"indexData\":\"indices.0.dat\"}],"
+		"\"lods\":[{\"ratio\":0.5,\"error\":0.25,\"indexBuffers\":[{\"indexCount\":3,"
+		"\"baseVertex\":0,\"indexData\":\"lod1.indices.0.dat\"}]},{\"ratio\":0.25,"
+		"\"error\":0.5,\"indexBuffers\":[{\"indexCount\":3,\"baseVertex\":0,"
+		"\"indexData\":\"base64:" + base64::encode(indices, sizeof(indices)) + "\"}]}]}";
+	EXPECT_EQ(expectedResult, result);
+}
@@ -0,0 +1,223 @@
+/*
+ * Copyright 2026 Aaron Barany
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "Path.h"
+#include "Server.h"
+#include <gtest/gtest.h>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <thread>
+
+namespace
+{
+
+void echoRequest(const server::Request& request, server::Response& response)
+{
+	response.success = request.printStats;
+	response.errors = request.configName + ";" + request.configDir + ";" + request.output;
+	response.result = request.config;
+	if (request.compact)
+		response.result += " compact";
+	if (request.container)
+		response.result += " container";
+	if (request.compress)
+		response.result += " compress";
+	for (double ratio : request.lodRatios)
+		response.result += " " + std::to_string(ratio);
+	if (!request.lodPosition.empty())
+		response.result += " " + request.lodPosition;
+}
+
+bool connectClient(server::Client& client, const std::string& socketPath)
+{
+	for (int i = 0; i < 500; ++i)
+	{
+		if (client.connect(socketPath))
+			return true;
+		std::this_thread::sleep_for(std::chrono::milliseconds(10));
+	}
+
+	return false;
+}
+
+} // namespace
+
+TEST(ServerTest, RoundTrip)
+{
+	if (!server::isSupported())
+		return;
+
+	std::string socketPath = path::join(testing::TempDir(), "vfc_server_test.sock");
+	std::atomic<bool> stop(false);
+	bool serveResult = false;
+	std::thread serverThread([&]()
+		{
+			serveResult = server::serve(socketPath, &echoRequest, stop);
+		});
+
+	server::Client client;
+	if (!connectClient(client, socketPath))
+	{
+		stop = true;
+		serverThread.join();
+		FAIL() << "Couldn't connect to the server.";
+	}
+
+	server::Request request;
+	request.configName = "test.json";
+	request.configDir = "/configs";
+	request.output = "/output";
+	request.printStats = true;
+	request.config = "{\"vertexFormat\": []}";
+
+	server::Response response;
+	EXPECT_TRUE(client.send(response, request));
+	EXPECT_TRUE(response.success);
+	EXPECT_EQ("test.json;/configs;/output", response.errors);
+	EXPECT_EQ(request.config, response.result);
+
+	// Multiple requests on the same connection, including an empty config.
+	request.printStats = false;
+	request.compact = true;
+	request.container = true;
+	request.config.clear();
+	EXPECT_TRUE(client.send(response, request));
+	EXPECT_FALSE(response.success);
+	EXPECT_EQ(" compact container", response.result);
+
+	// Multiple connections at once.
+	server::Client otherClient;
+	EXPECT_TRUE(otherClient.connect(socketPath));
+	request.container = false;
+	request.compress = true;
+	request.lodRatios = {0.5, 0.25};
+	request.lodPosition = "position";
+	request.config = "other";
+	EXPECT_TRUE(otherClient.send(response, request));
+	EXPECT_EQ("other compact compress 0.500000 0.250000 position", response.result);
+	otherClient.close();
+
+	// Stopping closes the connections that are still open and removes the socket.
+	stop = true;
+	serverThread.join();
+	EXPECT_TRUE(serveResult);
+	EXPECT_FALSE(client.send(response, request));
+	EXPECT_FALSE(client.connect(socketPath));
+	std::remove(socketPath.c_str());
+}
+
+TEST(ServerTest, MessageSizes)
+{
+	if (!server::isSupported())
+		return;
+
+	std::string socketPath = path::join(testing::TempDir(), "vfc_server_size_test.sock");
+	std::atomic<bool> stop(false);
+	bool serveResult = false;
+	std::thread serverThread([&]()
+		{
+			serveResult = server::serve(socketPath, &echoRequest, stop);
+		});
+
+	server::Client client;
+	if (!connectClient(client, socketPath))
+	{
+		stop = true;
+		serverThread.join();
+		FAIL() << "Couldn't connect to the server.";
+	}
+
+	// Configs larger than the chunk size for reading messages.
+	server::Request request;
+	request.config.resize(3*1024*1024 + 5);
+	for (std::size_t i = 0; i < request.config.size(); ++i)
+		request.config[i] = static_cast<char>('a' + i % 26);
+
+	server::Response response;
+	EXPECT_TRUE(client.send(response, request));
+	EXPECT_EQ(request.config, response.result);
+
+	// Request headers are limited in size, closing the connection.
+	request.config = "config";
+	request.configName.assign(128*1024, 'a');
+	EXPECT_FALSE(client.send(response, request));
+
+	server::Client otherClient;
+	EXPECT_TRUE(otherClient.connect(socketPath));
+	request.configName = "test.json";
+	EXPECT_TRUE(otherClient.send(response, request));
+	EXPECT_EQ("config", response.result);
+	otherClient.close();
+
+	stop = true;
+	serverThread.join();
+	EXPECT_TRUE(serveResult);
+	std::remove(socketPath.c_str());
+}
+
+TEST(ServerTest, StopFinishesRequests)
+{
+	if (!server::isSupported())
+		return;
+
+	std::string socketPath = path::join(testing::TempDir(), "vfc_server_stop_test.sock");
+	std::atomic<bool> stop(false);
+	std::atomic<bool> handlingRequest(false);
+	bool serveResult = false;
+	std::thread serverThread([&]()
+		{
+			serveResult = server::serve(socketPath,
+				[&](const server::Request& request, server::Response& response)
+				{
+					// Stop the server while the request is in progress.
+					handlingRequest = true;
+					while (!stop)
+						std::this_thread::sleep_for(std::chrono::milliseconds(1));
+					std::this_thread::sleep_for(std::chrono::milliseconds(10));
+					echoRequest(request, response);
+				}, stop);
+		});
+
+	server::Client client;
+	if (!connectClient(client, socketPath))
+	{
+		stop = true;
+		serverThread.join();
+		FAIL() << "Couldn't connect to the server.";
+	}
+
+	std::thread stopThread([&]()
+		{
+			while (!handlingRequest)
+				std::this_thread::sleep_for(std::chrono::milliseconds(1));
+			stop = true;
+		});
+
+	server::Request request;
+	request.printStats = true;
+	request.config = "config";
+	server::Response response;
+	EXPECT_TRUE(client.send(response, request));
+	EXPECT_TRUE(response.success);
+	EXPECT_EQ("config", response.result);
+
+	stopThread.join();
+	serverThread.join();
+	EXPECT_TRUE(serveResult);
+	EXPECT_FALSE(client.send(response, request));
+	std::remove(socketPath.c_str());
+}
@@ -0,0 +1,85 @@
+@echo off
+setlocal
+
+set PREV_DIR=%cd%
+set DIR=%~dp0
+cd "%DIR%"
+
+set VFC=%1
+set VFC=%VFC:/=\%
+set GENMESH=%2
+set GENMESH=%GENMESH:/=\%
+set OUTPUT_DIR=%DIR%genmesh-output
+rem Set VFC_GENMESH_INDEX_COUNT to scale the size of the generated meshes.
+set INDEX_COUNT=%VFC_GENMESH_INDEX_COUNT%
+if "%INDEX_COUNT%"=="" set INDEX_COUNT=100000
+
+call :runTest grid || goto :error
+call :runTest sphere -s Sphere --split-indices || goto :error
+call :runContainerTest sphere -s Sphere --split-indices || goto :error
+call :runTest noise -s Noise --duplicate-ratio 0.25 --seed 1 || goto :error
+call :runTest points -p PointList --output-index-type None || goto :error
+call :runTest lines -p LineList -s Sphere --output-index-type UInt16 || goto :error
+call :runTest line-strip -p LineStrip --restart-density 0.1 --output-index-type UInt16 ^
+	|| goto :error
+call :runTest strip -p TriangleStrip -s Noise --restart-density 0.05 --output-index-type UInt16 ^
+	|| goto :error
+call :runTest fan -p TriangleFan --split-indices --duplicate-ratio 0.1 ^
+	--input-index-type UInt16 --output-index-type UInt16 || goto :error
+
+cd %PREV_DIR%
+exit /B 0
+
+:error
+set RESULT=%ERRORLEVEL%
+if %RESULT% equ 0 set RESULT=1
+cd %PREV_DIR%
+exit /B %RESULT%
+
+:runTest
+set NAME=%1
+shift
+set ARGS=
+:collectArgs
+if "%~1"=="" goto :runArgs
+set ARGS=%ARGS% %1
+shift
+goto :collectArgs
+:runArgs
+"%GENMESH%" -o "%OUTPUT_DIR%" -n %NAME% -c %INDEX_COUNT% %ARGS%
+if %ERRORLEVEL% neq 0 exit /B %ERRORLEVEL%
+"%VFC%" -i "%OUTPUT_DIR%\%NAME%.json" -o "%OUTPUT_DIR%\%NAME%" > "%OUTPUT_DIR%\%NAME%.output.json"
+if %ERRORLEVEL% neq 0 exit /B %ERRORLEVEL%
+findstr /C:"\"vertexCount\"" "%OUTPUT_DIR%\%NAME%.output.json" > nul
+if %ERRORLEVEL% neq 0 exit /B %ERRORLEVEL%
+exit /B 0
+
+rem Converts the same mesh from an input container, both as a file and through stdin, which should
+rem match the output from the JSON input.
+:runContainerTest
+set NAME=%1
+shift
+set ARGS=
+:collectContainerArgs
+if "%~1"=="" goto :runContainerArgs
+set ARGS=%ARGS% %1
+shift
+goto :collectContainerArgs
+:runContainerArgs
+"%GENMESH%" -o "%OUTPUT_DIR%" -n %NAME% -c %INDEX_COUNT% --container %ARGS%
+if %ERRORLEVEL% neq 0 exit /B %ERRORLEVEL%
+"%VFC%" -i "%OUTPUT_DIR%\%NAME%.vfci" -o "%OUTPUT_DIR%\%NAME%-container" ^
+	> "%OUTPUT_DIR%\%NAME%-container.output.json"
+if %ERRORLEVEL% neq 0 exit /B %ERRORLEVEL%
+"%VFC%" -o "%OUTPUT_DIR%\%NAME%-stdin" < "%OUTPUT_DIR%\%NAME%.vfci" ^
+	> "%OUTPUT_DIR%\%NAME%-stdin.output.json"
+if %ERRORLEVEL% neq 0 exit /B %ERRORLEVEL%
+fc /B "%OUTPUT_DIR%\%NAME%\vertices.0.dat" "%OUTPUT_DIR%\%NAME%-container\vertices.0.dat" > nul
+if %ERRORLEVEL% neq 0 exit /B %ERRORLEVEL%
+fc /B "%OUTPUT_DIR%\%NAME%\indices.0.dat" "%OUTPUT_DIR%\%NAME%-container\indices.0.dat" > nul
+if %ERRORLEVEL% neq 0 exit /B %ERRORLEVEL%
+fc /B "%OUTPUT_DIR%\%NAME%\vertices.0.dat" "%OUTPUT_DIR%\%NAME%-stdin\vertices.0.dat" > nul
+if %ERRORLEVEL% neq 0 exit /B %ERRORLEVEL%
+fc /B "%OUTPUT_DIR%\%NAME%\indices.0.dat" "%OUTPUT_DIR%\%NAME%-stdin\indices.0.dat" > nul
+if %ERRORLEVEL% neq 0 exit /B %ERRORLEVEL%
+exit /B 0
@@ -0,0 +1,50 @@
+#!/usr/bin/env bash
+set -e
+
+DIR="$( cd "$( dirname "${BASH_SOURCE[0]}" )" >/dev/null && pwd )"
+cd "$DIR"
+
+VFC=$1
+GENMESH=$2
+OUTPUT_DIR="$DIR/genmesh-output"
+# Set VFC_GENMESH_INDEX_COUNT to scale the size of the generated meshes.
+INDEX_COUNT=${VFC_GENMESH_INDEX_COUNT:-100000}
+
+run_test()
+{
+	NAME=$1
+	shift
+	"$GENMESH" -o "$OUTPUT_DIR" -n "$NAME" -c "$INDEX_COUNT" "$@"
+	"$VFC" -i "$OUTPUT_DIR/$NAME.json" -o "$OUTPUT_DIR/$NAME" > "$OUTPUT_DIR/$NAME.output.json"
+	grep -q '"vertexCount"' "$OUTPUT_DIR/$NAME.output.json"
+	test -s "$OUTPUT_DIR/$NAME/vertices.0.dat"
+}
+
+# Converts the same mesh from an input container, both as a file and through stdin, which should
+# match the output from the JSON input.
+run_container_test()
+{
+	NAME=$1
+	shift
+	"$GENMESH" -o "$OUTPUT_DIR" -n "$NAME" -c "$INDEX_COUNT" --container "$@"
+	"$VFC" -i "$OUTPUT_DIR/$NAME.vfci" -o "$OUTPUT_DIR/$NAME-container" > \
+		"$OUTPUT_DIR/$NAME-container.output.json"
+	"$VFC" -o "$OUTPUT_DIR/$NAME-stdin" < "$OUTPUT_DIR/$NAME.vfci" > \
+		"$OUTPUT_DIR/$NAME-stdin.output.json"
+	for OUTPUT in container stdin
+	do
+		cmp "$OUTPUT_DIR/$NAME/vertices.0.dat" "$OUTPUT_DIR/$NAME-$OUTPUT/vertices.0.dat"
+		cmp "$OUTPUT_DIR/$NAME/indices.0.dat" "$OUTPUT_DIR/$NAME-$OUTPUT/indices.0.dat"
+	done
+}
+
+run_test grid
+run_test sphere -s Sphere --split-indices
+run_container_test sphere -s Sphere --split-indices
+run_test noise -s Noise --duplicate-ratio 0.25 --seed 1
+run_test points -p PointList --output-index-type None
+run_test lines -p LineList -s Sphere --output-index-type UInt16
+run_test line-strip -p LineStrip --restart-density 0.1 --output-index-type UInt16
+run_test strip -p TriangleStrip -s Noise --restart-density 0.05 --output-index-type UInt16
+run_test fan -p TriangleFan --split-indices --duplicate-ratio 0.1 --input-index-type UInt16 \
+	--output-index-type UInt16
@@ -40,5 +40,87 @@ if %ERRORLEVEL% neq 0 (
 	exit /B %ERRORLEVEL%
 )
 
+"%VFC%" -o "%OUTPUT_DIR%\container" --container -i "%DIR%\input.json" > NUL
+if %ERRORLEVEL% neq 0 (
+	cd %PREV_DIR%
+	exit /B %ERRORLEVEL%
+)
+
+fc /B "%DIR%\output.vfc" "%OUTPUT_DIR%\container\mesh.vfc"
+if %ERRORLEVEL% neq 0 (
+	cd %PREV_DIR%
+	exit /B %ERRORLEVEL%
+)
+
+rem Batch with valid, missing, and malformed lines. Failed lines output null and fail the batch.
+"%VFC%" --batch "%DIR%batch.jsonl" > "%OUTPUT_DIR%\batch-output.json" 2> NUL
+if %ERRORLEVEL% equ 0 (
+	echo Batch with invalid lines didn't fail.
+	cd %PREV_DIR%
+	exit /B 1
+)
+
+rem Compare with forward slashes since paths in the batch file are joined with a backslash.
+powershell -Command "(gc '%DIR%batch-output.json') -replace '\$OUTPUT_DIR', ('%OUTPUT_DIR%' -replace '\\', '/')" > "%OUTPUT_DIR%\expected-batch-output.json"
+powershell -Command "(gc '%OUTPUT_DIR%\batch-output.json') -replace '\\\\', '/'" > "%OUTPUT_DIR%\normalized-batch-output.json"
+
+fc /L "%OUTPUT_DIR%\expected-batch-output.json" "%OUTPUT_DIR%\normalized-batch-output.json"
+if %ERRORLEVEL% neq 0 (
+	cd %PREV_DIR%
+	exit /B %ERRORLEVEL%
+)
+
+fc /B "%DIR%\output.vertices.0.dat" "%OUTPUT_DIR%\batch\0\vertices.0.dat"
+if %ERRORLEVEL% neq 0 (
+	cd %PREV_DIR%
+	exit /B %ERRORLEVEL%
+)
+
+fc /B "%DIR%\output.indices.dat" "%OUTPUT_DIR%\batch\5\indices.0.dat"
+if %ERRORLEVEL% neq 0 (
+	cd %PREV_DIR%
+	exit /B %ERRORLEVEL%
+)
+
+rem Results are in the same order as the batch file when processed in parallel.
+"%VFC%" --batch "%DIR%batch.jsonl" -j 4 > "%OUTPUT_DIR%\batch-output-jobs.json" 2> NUL
+if %ERRORLEVEL% equ 0 (
+	echo Batch with invalid lines didn't fail.
+	cd %PREV_DIR%
+	exit /B 1
+)
+
+fc /B "%OUTPUT_DIR%\batch-output.json" "%OUTPUT_DIR%\batch-output-jobs.json"
+if %ERRORLEVEL% neq 0 (
+	cd %PREV_DIR%
+	exit /B %ERRORLEVEL%
+)
+
+rem Inputs without an output fail with --container rather than embedding the data.
+"%VFC%" --batch "%DIR%batch.jsonl" --container > "%OUTPUT_DIR%\batch-container-output.json" 2> NUL
+if %ERRORLEVEL% equ 0 (
+	echo Batch with invalid lines didn't fail.
+	cd %PREV_DIR%
+	exit /B 1
+)
+
+powershell -Command "if ((gc '%OUTPUT_DIR%\batch-container-output.json')[4] -ne 'null') { exit 1 }"
+if %ERRORLEVEL% neq 0 (
+	cd %PREV_DIR%
+	exit /B %ERRORLEVEL%
+)
+
+fc /B "%DIR%\output.vfc" "%OUTPUT_DIR%\batch\0\mesh.vfc"
+if %ERRORLEVEL% neq 0 (
+	cd %PREV_DIR%
+	exit /B %ERRORLEVEL%
+)
+
+fc /B "%DIR%\output.vfc" "%OUTPUT_DIR%\batch\5\mesh.vfc"
+if %ERRORLEVEL% neq 0 (
+	cd %PREV_DIR%
+	exit /B %ERRORLEVEL%
+)
+
 cd %PREV_DIR%
 exit /B %ERRORLEVEL%
@@ -17,3 +17,33 @@ cmp "$OUTPUT_DIR/expected-output.json" "$DIR/run-output.json"
 cmp "$DIR/output.vertices.0.dat" "$OUTPUT_DIR/vertices.0.dat"
 cmp "$DIR/output.vertices.1.dat" "$OUTPUT_DIR/vertices.1.dat"
 cmp "$DIR/output.indices.dat" "$OUTPUT_DIR/indices.0.dat"
+
+"$VFC" -o "$OUTPUT_DIR/container" --container < "$DIR/input.json" > /dev/null
+cmp "$DIR/output.vfc" "$OUTPUT_DIR/container/mesh.vfc"
+
+# Batch with valid, missing, and malformed lines. Failed lines output null and fail the batch.
+if "$VFC" --batch "$DIR/batch.jsonl" > "$OUTPUT_DIR/batch-output.json" 2> /dev/null; then
+	echo "Batch with invalid lines didn't fail."
+	exit 1
+fi
+sed "s/\$OUTPUT_DIR/$SED_PATH/g" "$DIR/batch-output.json" > "$OUTPUT_DIR/expected-batch-output.json"
+cmp "$OUTPUT_DIR/expected-batch-output.json" "$OUTPUT_DIR/batch-output.json"
+cmp "$DIR/output.vertices.0.dat" "$OUTPUT_DIR/batch/0/vertices.0.dat"
+cmp "$DIR/output.indices.dat" "$OUTPUT_DIR/batch/5/indices.0.dat"
+
+# Results are in the same order as the batch file when processed in parallel.
+if "$VFC" --batch "$DIR/batch.jsonl" -j 4 > "$OUTPUT_DIR/batch-output-jobs.json" 2> /dev/null; then
+	echo "Batch with invalid lines didn't fail."
+	exit 1
+fi
+cmp "$OUTPUT_DIR/batch-output.json" "$OUTPUT_DIR/batch-output-jobs.json"
+
+# Inputs without an output fail with --container rather than embedding the data.
+if "$VFC" --batch "$DIR/batch.jsonl" --container > "$OUTPUT_DIR/batch-container-output.json" \
+	2> /dev/null; then
+	echo "Batch with invalid lines didn't fail."
+	exit 1
+fi
+test "`sed -n 5p "$OUTPUT_DIR/batch-container-output.json"`" = "null"
+cmp "$DIR/output.vfc" "$OUTPUT_DIR/batch/0/mesh.vfc"
+cmp "$DIR/output.vfc" "$OUTPUT_DIR/batch/5/mesh.vfc"